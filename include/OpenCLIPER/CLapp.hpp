@@ -108,6 +108,8 @@ inline cl::QueueProperties operator&(cl::QueueProperties lhs, cl::QueuePropertie
 namespace OpenCLIPER {
 
 class Data;
+class FFTPlanCache;
+class DeviceBufferPool;
 
 // Class to report CL-like exceptions. Storage is done in an std::string instead of a char*, so that a copy of the what() message is kept within the class.
 // This allows to construct variable error strings on the fly and use them in catch safely (CLError will lose the target to its char* once the stack is unwound and catch is reached)
@@ -208,11 +210,14 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
             /// Use HIP if available
 	    bool			useHIP = false;
 
+            /// Number of command queues to create in each device (processes bound to different queues may overlap)
+	    unsigned			queuesPerDevice = 1;
+
 	    /**
 	     * @brief Default constructor for struct fields initialization.
 	     */
-	    DeviceTraits(DeviceType t = DEVICE_TYPE_ANY, cl::QueueProperties p = cl::QueueProperties::None):
-		type(t), queueProperties(p) {}
+	    DeviceTraits(DeviceType t = DEVICE_TYPE_ANY, cl::QueueProperties p = cl::QueueProperties::None, unsigned q = 1):
+		type(t), queueProperties(p), queuesPerDevice(q) {}
 	};
 
 	struct KernelProperties {
@@ -251,12 +256,39 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	void		addKernelDir(const std::string& kernelDir);
 	void		loadKernels(const char* compilerOptionsArg = nullptr);
 
+	/**
+	 * @brief Enables or disables lazy kernel loading. In lazy mode, loadKernels() builds nothing and each kernel file is
+	 * built when getKernel() first asks for one of its kernels, so unused kernel files cost nothing at start-up. Kernels
+	 * whose declaration can't be found in the source (e.g. generated by macros) make all pending kernel files be built.
+	 * @param[in] enable true to enable lazy kernel loading
+	 */
+	void		setLazyKernelLoading(bool enable) {
+	    lazyKernelLoading = enable;
+	}
+
+	/**
+	 * @brief Checks whether lazy kernel loading is enabled (see setLazyKernelLoading())
+	 * @return true if lazy kernel loading is enabled
+	 */
+	bool		getLazyKernelLoading() const {
+	    return lazyKernelLoading;
+	}
+
+	cl::Program	buildProgram(const std::string& source, const char* compilerOptionsArg = nullptr);
+	cl::Kernel	getSpecializedKernel(const std::string& name, const std::shared_ptr<Data>& pShape);
+
 	// Data management
 	Data*					getData(DataHandle handle);
 	std::shared_ptr<DeviceDataProperties>   getDeviceDataProperties(DataHandle handle) const;
 	void					host2Device(DataHandle handle, bool copyData=true);
 	void					device2Host(std::shared_ptr<Data> pData, bool queueFinish = true);
 	void					device2Host(DataHandle handle, bool queueFinish = true);
+	cl::Event				host2Device(DataHandle handle, const DataRange& range, bool blocking = true);
+	cl::Event				device2Host(DataHandle handle, const DataRange& range, bool blocking = true);
+	cl::Event				getLastWriteEvent(DataHandle handle);
+	void					setLastWriteEvent(DataHandle handle, const cl::Event& event);
+	std::vector<cl::Event>			getReadEvents(DataHandle handle);
+	void					addReadEvent(DataHandle handle, const cl::Event& event);
 	cl::Buffer*				getDeviceBuffer(DataHandle handle, dimIndexType NDArrayIndex);
 	cl::Buffer*				getDeviceBuffer(DataHandle handle);
 	void*					getHIPDeviceBuffer(DataHandle handle);
@@ -264,6 +296,25 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	void* 					getHostBuffer(DataHandle handle, dimIndexType NDArrayIndex);
 	const void*				getDataDimsAndStridesHostBuffer(DataHandle handle);
 	cl::Buffer*				getDataDimsAndStridesDeviceBuffer(DataHandle handle);
+	HostMemoryPolicy			resolveHostMemoryPolicy(HostMemoryPolicy policy, size_t i = 0) const;
+
+	/**
+	 * @brief Sets the host memory policy of Data objects bound to this CLapp from now on (unless they set their own)
+	 * @param[in] policy host memory policy (HOST_MEMORY_DEFAULT is not valid here)
+	 */
+	void setHostMemoryPolicy(HostMemoryPolicy policy) {
+	    if(policy == HOST_MEMORY_DEFAULT)
+		BTTHROW(std::invalid_argument("HOST_MEMORY_DEFAULT is not a valid CLapp host memory policy"), "CLapp::setHostMemoryPolicy");
+	    hostMemoryPolicy = policy;
+	}
+
+	/**
+	 * @brief Gets the host memory policy of Data objects bound to this CLapp (unless they set their own)
+	 * @return host memory policy
+	 */
+	HostMemoryPolicy getHostMemoryPolicy() const {
+	    return hostMemoryPolicy;
+	}
 
 	// Error management
 	void				checkDataHandle(DataHandle handle, std::string specificMessage);
@@ -276,7 +327,7 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 
 	// Device-specific calculations
 	static cl::NDRange	calcLocalSize(const cl::Kernel& kernel, const cl::Device& device, const cl::NDRange& globalSize);
-	static 	cl_uint		roundUp(cl_uint numToRound, cl_uint baseNumber);
+	static 	size_t		roundUp(size_t numToRound, size_t baseNumber);
 	cl::NDRange		getMaxLocalWorkItemSizes(cl::NDRange globalSizes);
 	static long		score(const cl::Device& device);
 
@@ -289,8 +340,14 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	std::string		getDeviceVendor(size_t i = 0);
 	const			cl::Context& getContext() const;
 	cl::CommandQueue&	getCommandQueue(const size_t i = 0);
+	cl::CommandQueue&	getCommandQueue(const size_t device, const size_t q);
+	size_t			getNumCommandQueues(const size_t device = 0) const;
 	//const cl::Program&	getProgram(const size_t i = 0) const;
 	void 			dumpDeviceData() const;
+
+	// Shared resources for processes
+	std::shared_ptr<FFTPlanCache>	getFFTPlanCache();
+	std::shared_ptr<DeviceBufferPool>	getDeviceBufferPool();
 #ifdef HAVE_HIP
 	const hipDevice_t	getHIPDevice() const;
 #endif
@@ -306,6 +363,20 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	// The real work is done in the public create() methods
 	CLapp(): nextDataKey(FIRSTVALIDDATAHANDLE) {}
 
+	static const std::string	getCompilerOptions(const char* compilerOptionsArg);
+	static const std::string	getShapeOptions(const std::shared_ptr<Data>& pShape);
+
+	// Kernel loading and cache
+	typedef std::set<std::string> KernelPathList;
+	void				loadKernelFiles(const std::string& kernelName = "");
+	static bool			declaresKernel(const std::string& sourcePath, const std::string& kernelName);
+	static const std::string	findSourceFile(const std::string& file, const KernelPathList& kernelPaths);
+	cl::Program			loadProgram(const std::vector<std::string>& sourcePaths, const std::string& compilerOptions);
+	static uint64_t			hashString(const std::string& s, uint64_t hash = 0xcbf29ce484222325ULL);
+	static uint64_t			hashIncludes(const std::string& source, const std::string& dir, std::set<std::string>& hashedFiles, uint64_t hash);
+	static bool			readProgramBinaries(const std::string& cacheFile, cl::Program::Binaries& binaries);
+	static void			writeProgramBinaries(const std::string& cacheFile, const cl::Program& program);
+
 	/// OpenCL platform
 	cl::Platform			platform;
 
@@ -315,7 +386,7 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	/// List of OpenCL devices
 	std::vector<cl::Device>		devices;
 
-	/// List of "device strings". Used to generate hashes unique to each compiled CL program
+	/// List of "device strings" (one per device). Used to generate hashes unique to each compiled CL program
 	std::vector<std::string>	deviceStrings;
 
 	/// HIP device equivalent to first OpenCL device. We should maintain a vector of pairs or so here...
@@ -323,8 +394,8 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	hipDevice_t                         hipDevice;
 #endif
 
-	/// List of OpenCL command queues
-	std::vector<cl::CommandQueue>	commandQueues;
+	/// List of OpenCL command queues (DeviceTraits::queuesPerDevice queues per device)
+	std::vector<std::vector<cl::CommandQueue>>	commandQueues;
 
 	/// List of programs
 	//std::vector<std::shared_ptr<cl::Program>>	programs;
@@ -334,7 +405,6 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	KernelFileList			kernelFiles;
 
         /// List of directories to look into for kernel files
-	typedef std::set<std::string> KernelPathList;
 	KernelPathList			kernelDirs;
 
 	/// List of kernels
@@ -344,6 +414,18 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	/// True if loadKernels has returned successfully at least once
 	bool				kernelsLoaded = false;
 
+	/// True if kernel files must be built only when one of their kernels is first needed
+	bool				lazyKernelLoading = false;
+
+	/// Compiler options given to the last loadKernels() call, used for every kernel file built afterwards
+	std::string			kernelCompilerOptions;
+
+	/// Full paths of the source files compiled together with every kernel file (found by loadKernels)
+	std::vector<std::string>	extraSourcePaths;
+
+	/// Programs built by getSpecializedKernel(), with their source file and shape options as key
+	std::map<std::string, cl::Program>	specializedPrograms;
+
 	/// Map with data handles as keys and smart shared pointers to DeviceDataProperties objects as values
 	/// Access to dataMap must be protected by a mutex (std::map is not thread-safe)
 	std::map<DataHandle, std::shared_ptr<DeviceDataProperties>>     dataMap;
@@ -351,6 +433,15 @@ class CLapp: public std::enable_shared_from_this<CLapp> {
 	/// Current valid value for data keys (initially not valid)
 	std::atomic<DataHandle>		nextDataKey;
 
+	/// Baked FFT plans shared by all FFT processes bound to this CLapp (created on first use)
+	std::shared_ptr<FFTPlanCache>	fftPlanCache;
+
+	/// Device buffers of destroyed Data objects, to be reused by new ones (created on first use)
+	std::shared_ptr<DeviceBufferPool>	deviceBufferPool;
+
+	/// Host memory policy of Data objects that do not set their own
+	HostMemoryPolicy		hostMemoryPolicy = HOST_MEMORY_DEVICE;
+
 	/// Error strings for CL error codes
 	static std::map<const cl_int, const char*>	errStrings;
 };
@@ -39,6 +39,7 @@
 #include <iostream>
 #include <OpenCLIPER/defs.hpp>
 #include <OpenCLIPER/NDArray.hpp>
+#include <OpenCLIPER/MappedFile.hpp>
 
 #undef LPICL_DEBUG
 namespace OpenCLIPER {
@@ -73,6 +74,7 @@ class ConcreteNDArray : public NDArray {
 	ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<T>*& pHostData);
 	ConcreteNDArray(const std::string &completeFileName, std::vector<dimIndexType>*& pSpatialDims);
     ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
+	ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
 
 	// Don't remove this doxygen comments!! (needed here and in also in .cpp parameterized constructors, doxygen bug)
 	/**
@@ -92,38 +94,104 @@ class ConcreteNDArray : public NDArray {
 	 * @return a void pointer to data stored as a vector in host memory
 	 */
 	virtual void* getHostDataAsVoidPointer() const {
+	    if(pMappedData != nullptr)
+		return pMappedData;
 	    return pHostData.get()->data();
 	}
 
 	/**
-	 * @brief Gets pointer to data stored in host memory (vector of elements)
-	 * @return raw pointer to data stored in host
+	 * @brief Gets a typed pointer to data stored in host memory, wherever they are stored (a vector, a mapped file or
+	 * zero-copy device memory)
+	 * @return pointer to the first of size() elements
+	 */
+	const T* getHostDataPointer() const {
+	    return static_cast<const T*>(getHostDataAsVoidPointer());
+	}
+
+	/**
+	 * @brief Gets pointer to data stored in host memory as a vector of elements. Data backed by a mapped file or stored in
+	 * zero-copy device memory are not in a vector: use getHostDataPointer() to read them, or materializeHostData() to copy
+	 * them to one.
+	 * @return raw pointer to the vector storing host data (nullptr if data are not stored in a vector)
 	 */
 	const std::vector<T>* getHostData() const {
+	    if(pMappedData != nullptr)
+		return nullptr;
+	    return pHostData.get();
+	}
+
+	/**
+	 * @brief Copies data backed by a mapped file or stored in zero-copy device memory to a vector, which stores them from
+	 * then on (that memory is no longer used by this object, so changes to the vector are not seen by the device until the
+	 * next host to device transfer). Data already stored in a vector are not copied.
+	 * @return raw pointer to the vector storing host data
+	 */
+	std::vector<T>* materializeHostData() {
+	    if(pMappedData != nullptr) {
+		pHostData.reset(new std::vector<T>(pMappedData, pMappedData + size()));
+		pMappedData = nullptr;
+		pMappedFile.reset();
+		pExternalDataOwner.reset();
+	    }
 	    return pHostData.get();
 	}
 
     protected:
 	std::vector <dimIndexType>* calcUnaligned1DArrayStridesFromNDArrayDims() const ;
+
+	/**
+	 * @brief Starts reading data from the mapped file backing them (if any) in the background
+	 */
+	void prefetchHostData() const {
+	    if(pMappedFile != nullptr)
+		pMappedFile->prefetch(reinterpret_cast<char*>(pMappedData) - static_cast<char*>(pMappedFile->getData()),
+				      size() * sizeof(T));
+	}
 	void loadMatlabHostDataElement(matvar_t* matvar, dimIndexType offsetInBytes);
 	/**
 	 * @brief Sets hostData field. Uses move semantics.
 	 * @param[in,out] pHostData reference to pointer to vector of \<T\> type data
 	 */
 	void setHostData(std::vector<T>*& pHostData) {
+	    // Data no longer come from a mapped file or zero-copy memory (if they did)
+	    pMappedData = nullptr;
+	    pMappedFile.reset();
+	    pExternalDataOwner.reset();
 	    // gets ownership of pHostData, releases owned poiner
 	    this->pHostData.reset(pHostData);
 	    // set original pointer to null (release does not do it automatically)
 	    pHostData = nullptr;
 	}
 
+	/**
+	 * @brief Makes data in host memory live in external memory instead of in a vector (see NDArray::setExternalHostData())
+	 * @param[in] pExternalData external memory (at least size() elements long)
+	 * @param[in] pOwner object keeping pExternalData alive as long as this NDArray uses it
+	 */
+	void setExternalHostData(void* pExternalData, const std::shared_ptr<void>& pOwner) {
+	    pHostData.reset(new std::vector<T>());
+	    pMappedFile.reset();
+	    pMappedData = static_cast<T*>(pExternalData);
+	    pExternalDataOwner = pOwner;
+	}
+
     private:
 
 	const std::string elementToString(const void* elementsArray, dimIndexType index1D) const;
 	// Attributes
 
-	/** Data in host memory as a vector of \<T\> type elements */
+	/** Data in host memory as a vector of \<T\> type elements (unused if data are backed by a mapped file or stored in
+	 * external memory) */
 	std::unique_ptr<std::vector<T>> pHostData = std::unique_ptr<std::vector<T>>(new std::vector<T>());
+
+	/** Mapped file backing data of this object (if any), shared with other NDArrays read from the same file */
+	std::shared_ptr<MappedFile> pMappedFile = nullptr;
+
+	/** External memory (e.g. zero-copy device memory) data are stored in, if any: see setExternalHostData() */
+	std::shared_ptr<void> pExternalDataOwner = nullptr;
+
+	/** Data in host memory inside pMappedFile or pExternalDataOwner (nullptr if data are stored in pHostData) */
+	T* pMappedData = nullptr;
 };
 }
 #endif
@@ -34,11 +34,13 @@ template ConcreteNDArray<complexType>::ConcreteNDArray();
 template ConcreteNDArray<dimIndexType>::ConcreteNDArray();
 template ConcreteNDArray<realType>::ConcreteNDArray();
 template ConcreteNDArray<cl_uchar>::ConcreteNDArray();
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray();
 
 template ConcreteNDArray<complexType>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<complexType>*& pHostData);
 template ConcreteNDArray<dimIndexType>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<dimIndexType>*& pHostData);
 template ConcreteNDArray<realType>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<realType>*& pHostData);
 template ConcreteNDArray<cl_uchar>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<cl_uchar>*& pHostData);
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<complexHalfType>*& pHostData);
 
 template ConcreteNDArray<complexType>::ConcreteNDArray(const std::string &completeFileName,
 	std::vector<dimIndexType>*& pSpatialDims);
@@ -48,23 +50,35 @@ template ConcreteNDArray<realType>::ConcreteNDArray(const std::string &completeF
 	std::vector<dimIndexType>*& pSpatialDims);
 template ConcreteNDArray<cl_uchar>::ConcreteNDArray(const std::string &completeFileName,
 	std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray(const std::string &completeFileName,
+	std::vector<dimIndexType>*& pSpatialDims);
 
 template ConcreteNDArray<complexType>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
 template ConcreteNDArray<dimIndexType>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
 template ConcreteNDArray<realType>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
 template ConcreteNDArray<cl_uchar>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims);
+
+template ConcreteNDArray<complexType>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<dimIndexType>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<realType>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<cl_uchar>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims);
 
 template ConcreteNDArray<complexType>::ConcreteNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
 template ConcreteNDArray<dimIndexType>::ConcreteNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
 template ConcreteNDArray<realType>::ConcreteNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
 template ConcreteNDArray<cl_uchar>::ConcreteNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
+template ConcreteNDArray<complexHalfType>::ConcreteNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
 
 template ConcreteNDArray<complexType>::~ConcreteNDArray();
 template ConcreteNDArray<dimIndexType>::~ConcreteNDArray();
 template ConcreteNDArray<realType>::~ConcreteNDArray();
 template ConcreteNDArray<cl_uchar>::~ConcreteNDArray();
+template ConcreteNDArray<complexHalfType>::~ConcreteNDArray();
 
 template const std::string ConcreteNDArray<complexType>::elementToString(const void* pElementsArray, dimIndexType index1D) const;
 template const std::string ConcreteNDArray<dimIndexType>::elementToString(const void* pElementsArray, dimIndexType index1D) const;
 template const std::string ConcreteNDArray<realType>::elementToString(const void* pElementsArray, dimIndexType index1D) const;
 template const std::string ConcreteNDArray<cl_uchar>::elementToString(const void* pElementsArray, dimIndexType index1D) const;
+template const std::string ConcreteNDArray<complexHalfType>::elementToString(const void* pElementsArray, dimIndexType index1D) const;
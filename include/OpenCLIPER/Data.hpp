@@ -35,13 +35,17 @@
 #include <OpenCLIPER/NDArray.hpp>
 #include <OpenCLIPER/DeviceDataProperties.hpp>
 #include <OpenCLIPER/MatVarInfo.hpp>
+#include <OpenCLIPER/MatlabFileIndex.hpp>
 #include <OpenCLIPER/hostKernelFunctions.hpp>
 #include <LPISupport/Utils.hpp>
 #include <thread>
+#include <future>
+#include <functional>
 
 namespace OpenCLIPER {
 class CLapp;
 class NDArray;
+class DataWriter;
 
 /// Class Data - Class that includes data and properties common to k-space and x-space images.
 class Data: public std::enable_shared_from_this<Data> {
@@ -172,7 +176,7 @@ class Data: public std::enable_shared_from_this<Data> {
 	 * @brief Gets vector of spatial and temporal data dimensions stored in host memory.
 	 * @return pointer to vector of spatial and temporal data dimensions
 	 */
-	const std::vector<dimIndexType>* getDataDimsAndStridesVector() const {
+	const std::vector<index1DType>* getDataDimsAndStridesVector() const {
 	    return pDataDimsAndStridesVector.get();
 	}
 
@@ -186,10 +190,19 @@ class Data: public std::enable_shared_from_this<Data> {
 	    return elementDataType;
 	}
 
+	/**
+	 * @brief Gets the host memory policy requested for this object (HOST_MEMORY_DEFAULT means the policy of its CLapp)
+	 * @return host memory policy
+	 */
+	HostMemoryPolicy getHostMemoryPolicy() const {
+	    return hostMemoryPolicy;
+	}
+
 	//Setters
 	void setData(NDArray*& pNDArray, bool copyData = false);
 	void setData(std::vector<NDArray*>*& pNDArrays, bool copyData = false);
 	void setDynDims(std::vector<dimIndexType>*& pDynDims);
+	void setHostMemoryPolicy(HostMemoryPolicy policy);
 
 	//---------------------------------
 	// Other methods
@@ -228,8 +241,29 @@ class Data: public std::enable_shared_from_this<Data> {
 	}
 	const std::string hostBufferToString(std::string title, dimIndexType index);
 	virtual void device2Host(bool queueFinish = true);
+	cl::Event device2Host(const DataRange& range, bool blocking = true);
+	void host2Device();
+	cl::Event host2Device(const DataRange& range, bool blocking = true);
+	DataRange getFrameRange(dimIndexType frame);
 
 	void waitLoadEnd();
+	void waitSaveEnd();
+
+	/**
+	 * @brief Checks whether this object maps raw and CFL files into memory when loading data from them instead of reading
+	 * them (requested with the mapFiles parameter of constructors loading those files).
+	 *
+	 * Mapped NDArrays use the file pages as host memory instead of reading them into vectors, so large files are not held
+	 * twice in host memory (once in the vectors and once in mapped device buffers). Changes to mapped data never reach the
+	 * file, but the file must not be overwritten or truncated while this object uses it. Loading itself reads nothing:
+	 * data are read from disk NDArray by NDArray while they are copied to the device, so reading a coil or frame overlaps
+	 * the upload of the previous one (e.g. KData loaded with asyncLoad = true are ready after about max(disk read, upload)
+	 * time instead of their sum).
+	 * @return true if raw and CFL files are mapped
+	 */
+	bool getRawFileMapping() const {
+	    return rawFileMapping;
+	}
 
 	//---------------------------------
         // host/kernel functions
@@ -239,27 +273,27 @@ class Data: public std::enable_shared_from_this<Data> {
         uint getNumSpatialDims();
         uint getNumNDArrays();
         uint getNDArray1DIndex(uint coilIndex, uint temporalDimIndexes[]);
-        uint getNDArrayTotalSize(uint NDArray1DIndex);
+        index1DType getNDArrayTotalSize(uint NDArray1DIndex);
         uint getNDArrayStride();
-        uint getSpatialDimStride(uint spatialDimIndex, uint NDArray1DIndex);
+        index1DType getSpatialDimStride(uint spatialDimIndex, uint NDArray1DIndex);
         uint getSpatialDimSize(uint spatialDimIndex, uint NDArray1DIndex);
 
         // Functions related to coils
         uint getNumCoils();
         uint getCoilDim();
-        uint getCoilStride(uint NDArray1DIndex);
+        index1DType getCoilStride(uint NDArray1DIndex);
 
         // Functions related to temporal dimensions
         uint getNumTemporalDims();
         uint getTemporalDim(uint tempDim);
-        uint getTemporalDimStride(uint temporalDimIndex, uint NDArray1DIndex);
+        index1DType getTemporalDimStride(uint temporalDimIndex, uint NDArray1DIndex);
         uint getTemporalDimSize(uint temporalDimIndex);
 
         // Functions related to dimensions in general (not particular to spatial, coil or temporal dimensions)
         uint getDimSize(uint dimIndex, uint NDArray1DIndex);
-        uint getElementStride(uint NDArray1DIndex);
-        uint getDimStride(uint dimIndex, uint NDArray1DIndex);
-        const void* getNextElement(dimIndexType nDim, dimIndexType curNDArray, dimIndexType curOffset);
+        index1DType getElementStride(uint NDArray1DIndex);
+        index1DType getDimStride(uint dimIndex, uint NDArray1DIndex);
+        const void* getNextElement(dimIndexType nDim, dimIndexType curNDArray, index1DType curOffset);
 
 	//---------------------------------
 	// Show related stuff
@@ -287,6 +321,8 @@ class Data: public std::enable_shared_from_this<Data> {
 	void checkMatvarDims(matvar_t* matvar, const std::vector<dimIndexType>* pDims);
 
     protected:
+	std::shared_future<void> submitSave(const std::function<void()>& save, DataWriter* pWriter);
+
 	// Virtual "constructors"
 	virtual std::shared_ptr<Data> clone(bool deepCopy=true) const = 0;
 	virtual std::shared_ptr<Data> clone(ElementDataType newElementDataType) const = 0;
@@ -310,6 +346,9 @@ class Data: public std::enable_shared_from_this<Data> {
 	void checkValiditySpatialDimensions(const std::vector<dimIndexType>* pDims);
 	void checkValiditySpatialDimensions(const std::vector<std::vector<dimIndexType>*>* pArraysDims);
 	void loadMatlabHostData(matvar_t* matvar, dimIndexType numOfSpatialDimensions, dimIndexType numNDArraysToRead);
+	void loadMatlabHostData(const MatlabFileIndex& matlabFile, const std::string& variableName, dimIndexType numOfSpatialDimensions,
+				dimIndexType numNDArraysToRead);
+	static ElementDataType getMatlabElementDataType(const matvar_t* matvar);
 	void fillMatlabVarInfo(mat_t* matfp, std::string matVarname, MatVarInfo* pMatVarInfo);
 	void readDimsMatlabVar(const matvar_t* pDimsMatVar, std::vector<dimIndexType>* pCompleteSpatialDimsVector, numCoilsType& numCoils, std::vector<dimIndexType>* pTemporalDimsVector);
 
@@ -322,7 +361,10 @@ class Data: public std::enable_shared_from_this<Data> {
 	/** @brief Pointer to vector of temporal dimensions of the stored group of images */ // default is empty
 	std::unique_ptr<std::vector<dimIndexType>> pDynDims;
 	/** @brief image spatial and temporal dimensions and their strides (field data type is valid for kernel parameters) */
-	std::unique_ptr<std::vector<dimIndexType>> pDataDimsAndStridesVector;
+	std::unique_ptr<std::vector<index1DType>> pDataDimsAndStridesVector;
+	/** @brief true if raw and CFL files are mapped into memory instead of read (set by constructors loading them, see
+	 * getRawFileMapping()) */
+	bool rawFileMapping = false;
     private:
 	static constexpr const char* errorPrefix = "OpenCLIPER::Data::";
 	/**
@@ -339,12 +381,15 @@ class Data: public std::enable_shared_from_this<Data> {
 	/** @brief pointer to CLapp object */
 	std::shared_ptr<CLapp> pCLapp = nullptr;
 	DataHandle myDataHandle = INVALIDDATAHANDLE;
+	/// @brief Kind of memory device buffers are allocated in (see @ref HostMemoryPolicy)
+	HostMemoryPolicy hostMemoryPolicy = HOST_MEMORY_DEFAULT;
 	bool checkNDArrayIndex(dimIndexType index, dimIndexType nDArraySize);
 
 	void commonFieldInitialization(ElementDataType elementDataType);
 	void checkNDArraysSizesAndSetAllSizesEqual();
 	std::unique_ptr<std::thread> pFileLoaderThread = nullptr;
-	std::shared_ptr<Data> dataForSaving;
+	/// @brief Last save of this object run by a DataWriter (see submitSave())
+	std::shared_future<void> pendingSave;
 };
 }
 /* namespace OpenCLIPER */
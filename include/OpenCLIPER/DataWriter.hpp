@@ -0,0 +1,105 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef DATAWRITER_HPP
+#define DATAWRITER_HPP
+
+#include <OpenCLIPER/defs.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Background service that writes data to files (see e.g. XData::saveCFLDataAsync() or KData::matlabSaveAsync())
+ *
+ * Jobs are run in submission order by a pool of threads. The queue of pending jobs is bounded: submit() blocks while it
+ * is full, so producers faster than the disk are throttled instead of piling up data in memory. Every job gets a future
+ * which becomes ready when the job ends, and which rethrows any exception thrown by the job. Jobs must not submit new
+ * jobs to the writer running them.
+ *
+ * The destructor runs all pending jobs before returning.
+ */
+class DataWriter {
+    public:
+	explicit DataWriter(unsigned numThreads = 2, size_t maxQueuedJobs = 16);
+	~DataWriter();
+
+	DataWriter(const DataWriter&) = delete;
+	DataWriter& operator=(const DataWriter&) = delete;
+
+	std::shared_future<void>	submit(const std::function<void()>& job);
+	void				waitAll();
+	size_t				getNumPendingJobs();
+
+	static DataWriter&		getDefault();
+
+    private:
+	void workerLoop();
+
+	/// Jobs not started yet, in submission order
+	std::deque<std::packaged_task<void()>> jobs;
+
+	/// Maximum number of jobs not started yet
+	size_t maxQueuedJobs;
+
+	/// Number of jobs being run
+	size_t numRunningJobs = 0;
+
+	/// true when workers must end (after running all queued jobs)
+	bool stopping = false;
+
+	/// Protects jobs, numRunningJobs and stopping
+	std::mutex jobsMutex;
+
+	/// Notified when a job is queued (or workers must end)
+	std::condition_variable jobQueued;
+
+	/// Notified when a job is taken from the queue
+	std::condition_variable jobTaken;
+
+	/// Notified when there are no jobs left (queued or running)
+	std::condition_variable jobsDone;
+
+	/// Worker threads
+	std::vector<std::thread> workers;
+};
+
+} // namespace OpenCLIPER
+
+#endif // DATAWRITER_HPP
@@ -0,0 +1,117 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef DEVICEBUFFERPOOL_HPP
+#define DEVICEBUFFERPOOL_HPP
+
+#include <OpenCLIPER/CLapp.hpp>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Pool of device buffers, shared by all Data objects bound to the same CLapp
+ *
+ * Creating a device buffer (and mapping it) for every temporary Data object is expensive, and iterative algorithms create
+ * and destroy lots of them. Buffers of destroyed Data objects are kept here instead, so new Data objects of a compatible
+ * size get them back. Requested sizes are rounded up to size buckets (4 buckets per power of two, so at most ~25% of
+ * every buffer is wasted), and a buffer is reused only for requests in its very same bucket.
+ *
+ * Pooled (i.e. unused) memory is limited to maxPooledBytes: buffers released beyond that are freed. The whole pool is
+ * also emptied (and allocation retried) if the device runs out of memory.
+ *
+ * Buffers are only reused for requests with the same host memory policy (see HostMemoryPolicy). Zero-copy buffers are not
+ * pooled: their host memory is NDArray host storage, which outlives the buffer.
+ */
+class DeviceBufferPool {
+    public:
+	/// Pool usage statistics
+	struct Stats {
+	    /// Number of buffers requested
+	    size_t requests = 0;
+
+	    /// Number of requests served with a pooled buffer
+	    size_t hits = 0;
+
+	    /// Device memory currently allocated through this pool (in use plus pooled), in bytes
+	    size_t allocatedBytes = 0;
+
+	    /// Maximum value reached by allocatedBytes
+	    size_t peakAllocatedBytes = 0;
+
+	    /// Device memory currently pooled (i.e. not in use), in bytes
+	    size_t pooledBytes = 0;
+
+	    /**
+	     * @brief Fraction of requests served with a pooled buffer
+	     * @return hit rate (0 if there were no requests)
+	     */
+	    double hitRate() const {
+		return requests ? static_cast<double>(hits) / requests : 0.0;
+	    }
+	};
+
+	DeviceBufferPool(const cl::Context& context, size_t maxPooledBytes);
+
+	cl::Buffer	acquire(size_t size, HostMemoryPolicy policy = HOST_MEMORY_DEVICE);
+	void		release(const cl::Buffer& buffer);
+	void		clear();
+	Stats		getStats();
+
+	static size_t		getBucketSize(size_t size);
+	static cl_mem_flags	getMemFlags(HostMemoryPolicy policy);
+
+    private:
+	cl::Buffer	createBuffer(size_t size, cl_mem_flags flags);
+
+	/// Context buffers are created in
+	cl::Context	context;
+
+	/// Maximum amount of unused memory kept in the pool
+	size_t		maxPooledBytes;
+
+	/// Unused buffers, keyed by memory flags and bucket size
+	std::map<std::pair<cl_mem_flags, size_t>, std::vector<cl::Buffer>> freeBuffers;
+
+	/// Protects freeBuffers and stats
+	std::mutex	poolMutex;
+
+	Stats		stats;
+};
+
+} // namespace OpenCLIPER
+
+#endif // DEVICEBUFFERPOOL_HPP
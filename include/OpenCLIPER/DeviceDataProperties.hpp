@@ -57,6 +57,67 @@
 namespace OpenCLIPER {
 class CLapp;
 class Data;
+class DeviceBufferPool;
+
+/**
+ * @brief Kind of memory device buffers of Data objects are allocated in
+ *
+ * Data are always accessed from the host through a mapped pointer (see Data::getHostBuffer()); the policy decides where
+ * the memory behind that pointer lives and, therefore, what host/device transfers cost.
+ */
+enum HostMemoryPolicy {
+    /// Use the policy of the CLapp the Data object is bound to (only meaningful for Data objects)
+    HOST_MEMORY_DEFAULT,
+    /// Device memory; transfers are explicit copies between it and mapped host memory
+    HOST_MEMORY_DEVICE,
+    /// Device memory backed by pinned host memory (CL_MEM_ALLOC_HOST_PTR): copies are faster on discrete devices
+    HOST_MEMORY_PINNED,
+    /// Page-aligned host memory used directly by the device (CL_MEM_USE_HOST_PTR): device transfers are just map/unmap
+    /// operations, which do not copy anything on CPU and unified memory devices. That memory becomes the host storage of
+    /// NDArrays too (their host data are moved into it when the Data object is bound to a CLapp), so host and device data
+    /// are not held twice and later transfers do not copy them
+    HOST_MEMORY_ZEROCOPY,
+    /// HOST_MEMORY_ZEROCOPY on CPU and unified memory devices, HOST_MEMORY_DEVICE on any other device
+    HOST_MEMORY_AUTO
+};
+
+/**
+ * @brief Part of a Data object to be transferred between host and device memory: a range of consecutive NDArrays and,
+ * optionally, a rectangular region within each of them
+ */
+struct DataRange {
+    /// First NDArray of the range
+    dimIndexType firstNDArray = 0;
+
+    /// Number of NDArrays (0 means all NDArrays from firstNDArray on)
+    dimIndexType numNDArrays = 0;
+
+    /// Origin of the region within every NDArray (columns, rows, slices), in elements
+    dimIndexType origin[3] = {0, 0, 0};
+
+    /// Size of the region (columns, rows, slices), in elements. 0 means up to the end of the NDArray along that dimension
+    dimIndexType region[3] = {0, 0, 0};
+
+    /// Constructor (default range covers the whole Data object)
+    explicit DataRange(dimIndexType first = 0, dimIndexType num = 0): firstNDArray(first), numNDArrays(num) {}
+
+    /**
+     * @brief Builds a range for a rectangular region of consecutive NDArrays
+     * @param[in] first first NDArray
+     * @param[in] num number of NDArrays
+     * @param[in] x,y,z origin of the region, in elements
+     * @param[in] width,height,depth size of the region, in elements
+     * @return the range
+     */
+    static DataRange rect(dimIndexType first, dimIndexType num, dimIndexType x, dimIndexType y, dimIndexType z,
+			  dimIndexType width, dimIndexType height, dimIndexType depth = 1) {
+	DataRange range(first, num);
+	range.origin[0] = x; range.origin[1] = y; range.origin[2] = z;
+	range.region[0] = width; range.region[1] = height; range.region[2] = depth;
+	return range;
+    }
+};
+
 /// Class Data - Class that includes data and properties common to k-space and x-space images.
 class DeviceDataProperties {
 	friend class Data;
@@ -69,6 +130,8 @@ class DeviceDataProperties {
 	~DeviceDataProperties();
 	void host2Device(bool copyDataToDevice);
 	void device2Host(bool queueFinish = true);
+	cl::Event host2Device(const DataRange& range, bool blocking = true);
+	cl::Event device2Host(const DataRange& range, bool blocking = true);
 
 	/**
 	 * @brief Gets pointer to spatial and temporal data dimensions and their strides stored in host memory as an array.
@@ -99,11 +162,19 @@ class DeviceDataProperties {
 	    return pHIPDeviceBuffer;
 	}
 
+	/**
+	 * @brief Gets the (resolved, i.e. neither default nor auto) policy device memory was allocated with
+	 * @return the host memory policy
+	 */
+	HostMemoryPolicy getHostMemoryPolicy() const {
+	    return hostMemoryPolicy;
+	}
+
 	/**
 	 * @brief Gets the offset to start of NDArray data inside the contiguous device memory buffer
 	 * @return the offset to first NDArray
 	 */
-	dimIndexType getDataStartOffset() {
+	size_t getDataStartOffset() {
 	    return dataStartOffset;
 	}
 
@@ -111,10 +182,39 @@ class DeviceDataProperties {
 	 * @brief Gets the offset to dimensions and strides array inside the contiguous device memory buffer
 	 * @return the offset to dimensions and strides array
 	 */
-	dimIndexType getDataDimsAndStridesOffset() {
+	size_t getDataDimsAndStridesOffset() {
 	    return dataDimsAndStridesOffset;
 	}
 
+	/**
+	 * @brief Gets the event of the last command that wrote this data in device memory (a null event if none was recorded)
+	 * @return the last writer event
+	 */
+	const cl::Event& getLastWriteEvent() const {
+	    return lastWriteEvent;
+	}
+
+	/**
+	 * @brief Sets the event of the last command that wrote this data in device memory. The writer must have waited for
+	 * the readers recorded so far, which are forgotten
+	 * @param[in] event the last writer event
+	 */
+	void setLastWriteEvent(const cl::Event& event) {
+	    lastWriteEvent = event;
+	    readEvents.clear();
+	}
+
+	/**
+	 * @brief Gets the events of the last commands (one per command queue) that read this data in device memory since it
+	 * was last written
+	 * @return the reader events
+	 */
+	const std::vector<cl::Event>& getReadEvents() const {
+	    return readEvents;
+	}
+
+	void addReadEvent(const cl::Event& event);
+
     protected:
 	Data* getData() {
 	    return pData;
@@ -149,6 +249,10 @@ class DeviceDataProperties {
 	bool device2HostCommonChecksForElement(dimIndexType& width, dimIndexType& height,
 					       dimIndexType& depth, const dimIndexType index);
 	void device2HostCommon();
+	cl::Event transferRange(const DataRange& range, bool blocking, bool toDevice);
+	cl::Event syncMappedMemory(bool blocking, const std::vector<cl::Event>* waitList);
+	void copyHostDataRegionToMappedHostBuffer(dimIndexType index, const dimIndexType origin[3], const size_t region[3]);
+	cl::Buffer createZeroCopyBuffer(size_t size);
 
 	void delApp();
 
@@ -156,6 +260,22 @@ class DeviceDataProperties {
 	cl::Context context;
 	cl::Device selected_device;
 
+	/// Event of the last command that wrote this data in device memory (a process launch or a host to device transfer)
+	cl::Event lastWriteEvent;
+
+	/// Events of the last commands (one per command queue) that read this data in device memory since lastWriteEvent
+	std::vector<cl::Event> readEvents;
+
+	/// Pool pCompleteDeviceBuffer is taken from (and given back to)
+	std::shared_ptr<DeviceBufferPool> pBufferPool;
+
+	/// Kind of memory pCompleteDeviceBuffer is allocated in
+	HostMemoryPolicy hostMemoryPolicy = HOST_MEMORY_DEVICE;
+
+	/// Host memory behind a zero-copy pCompleteDeviceBuffer, shared with the NDArrays using it as host storage (it is
+	/// freed when neither the buffer nor any of them use it anymore)
+	std::shared_ptr<void> pZeroCopyHostMemory;
+
 #ifdef HAVE_HIP
 	cl::Kernel cl2hipKernel;
 	hipDevice_t hipDevice;
@@ -178,10 +298,10 @@ class DeviceDataProperties {
 	std::vector<cl::Buffer*>* pDeviceBuffers = new std::vector<cl::Buffer*>();
 
 	/** @brief Offset from buffer beginning to start of dimensions and strides array */
-	dimIndexType dataStartOffset = -1;
+	size_t dataStartOffset = -1;
 
 	/** @brief offset from beginning of contiguous device memory to start of dimensions and strides array */
-	dimIndexType dataDimsAndStridesOffset = -1;
+	size_t dataDimsAndStridesOffset = -1;
 
 
 	/** @brief spatial and temporal image dimensions and their strides in host memory as a void* type*/
@@ -197,9 +317,9 @@ class DeviceDataProperties {
 	/// @brief stores CL_DEVICE_MEM_BASE_ADDR_ALIGN device property
 	dimIndexType deviceMemBaseAddrAlignInBytes = 0;
 
-	dimIndexType dimsAndStridesArraySubbuferRoundedSize = 0;
+	size_t dimsAndStridesArraySubbuferRoundedSize = 0;
 
-	dimIndexType allNDArraysRoundedSizeInBytes = 0;
+	size_t allNDArraysRoundedSizeInBytes = 0;
 	void* pCompleteHostBuffer;
 };
 }
@@ -0,0 +1,125 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef FFTPLANCACHE_HPP
+#define FFTPLANCACHE_HPP
+
+#include <OpenCLIPER/CLapp.hpp>
+#include <clFFT.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Cache of baked clFFT plans, shared by all FFT processes bound to the same CLapp
+ *
+ * Baking a clFFT plan means generating and compiling its OpenCL kernels, which takes far longer than the transform itself.
+ * Plans are keyed by the device of the queue they are requested for (a plan is baked for the devices of its bake queues
+ * only) and by transform dimensions, sizes, strides, batch layout, precision, placement, scales and centering, so every
+ * FFT process asking for an equivalent plan on the same device gets the one baked first. Plans live as long as the
+ * cache (i.e. the CLapp).
+ *
+ * On top of that, clFFT's own binary cache is pointed at $HOME/KERNEL_USER_DIR/cache/clfft (unless the user has already
+ * set CLFFT_CACHE_PATH), so kernels baked in previous runs are loaded from disk instead of being recompiled.
+ */
+class FFTPlanCache {
+    public:
+	/// Everything that makes two clFFT plans interchangeable on the same device (the device is taken from the queue passed to getPlan)
+	struct PlanParameters {
+	    /// Transform dimensionality
+	    clfftDim dim = CLFFT_1D;
+
+	    /// Transform size along each dimension (only the first dim entries are used)
+	    size_t sizes[3] = {1, 1, 1};
+
+	    /// Input/output strides along each dimension (only the first dim entries are used)
+	    size_t strides[3] = {1, 1, 1};
+
+	    /// Number of transforms per enqueue
+	    size_t batchSize = 1;
+
+	    /// Distance between consecutive transforms of the same batch
+	    size_t batchDistance = 0;
+
+	    /// Floating point precision
+	    clfftPrecision precision = CLFFT_SINGLE;
+
+	    /// In-place or out-of-place transform
+	    clfftResultLocation placement = CLFFT_INPLACE;
+
+	    /// Scale applied by the forward transform
+	    cl_float forwardScale = 1.0f;
+
+	    /// Scale applied by the backward transform
+	    cl_float backwardScale = 1.0f;
+
+	    /// Centered transform (fftshift(FFT(ifftshift(x)))), done by checkerboard modulation in clFFT pre/post callbacks. Sizes must be even
+	    bool centered = false;
+
+	    const std::string key() const;
+	};
+
+	FFTPlanCache(const cl::Context& context);
+	~FFTPlanCache();
+
+	clfftPlanHandle	getPlan(const PlanParameters& parameters, cl::CommandQueue& queue);
+
+	/// Number of requests served with an already baked plan
+	size_t		getHits() const { return hits; }
+
+	/// Number of requests which needed a new plan to be baked
+	size_t		getMisses() const { return misses; }
+
+    private:
+	/// Context plans are created in
+	cl::Context	context;
+
+	/// Baked plans, keyed by device and PlanParameters::key()
+	std::map<std::string, clfftPlanHandle> plans;
+
+	/// Protects plans (std::map is not thread-safe)
+	std::mutex	plansMutex;
+
+	/// Dummy user data for clFFT callbacks (clFFT requires a valid cl_mem even if callbacks don't use it)
+	cl::Buffer	callbackUserData;
+
+	size_t		hits = 0;
+	size_t		misses = 0;
+};
+
+} // namespace OpenCLIPER
+
+#endif // FFTPLANCACHE_HPP
@@ -114,14 +114,14 @@ class KData: public Data {
 	KData(const std::shared_ptr< CLapp >& pCLapp, const std::shared_ptr<KData>& sourceData, ElementDataType newElementDataType);
 
 	// From the filesystem
-	KData(const std::shared_ptr< CLapp >& pCLapp, const std::string& fileName, bool asyncLoad = false);
+	KData(const std::shared_ptr< CLapp >& pCLapp, const std::string& fileName, bool asyncLoad = false, bool mapFiles = false);
 	KData(const std::shared_ptr< CLapp >& pCLapp, const std::string& dataFileNamePrefix,
 	      std::vector<std::vector< dimIndexType >*>*& pArraysDims, numCoilsType numCoils,
 	      std::vector <dimIndexType>*& pDynDims,
 	      uint dataToLoad = OpenCLIPER::KData::LOADNONE,
 	      const std::vector<std::string>& otherFieldsFileNamePrefixes = {"SensitivityMap_", "SamplingMask_"},
 	      const std::string& coilsFileNameSuffix = "_coil", const std::string& framesFileNameSuffix = "_frame",
-	      const std::string& fileNameExtension = ".raw");
+	      const std::string& fileNameExtension = ".raw", bool mapFiles = false);
 
 	virtual ~KData() {}
 
@@ -294,7 +294,9 @@ class KData: public Data {
 				   numCoilsType numCoilsSyncSou);
 	// Save to matlab file
 	void matlabSave(const std::string &fileName);
+	std::shared_future<void> matlabSaveAsync(const std::string &fileName, DataWriter* pWriter = nullptr);
 	void saveCFLData(const std::string &baseFileName);
+	std::shared_future<void> saveCFLDataAsync(const std::string &baseFileName, DataWriter* pWriter = nullptr);
 	void saveCFLHeader(const std::string &fileName);
 
 	// Sum all images from different coils and same time (calls process XImageSum)
@@ -320,6 +322,9 @@ class KData: public Data {
 			     const std::string &framesFileNameSuffix = "_frame", const std::string &fileNameExtension = ".raw");
 	void initInternalProcesses();
 	void checkMatVarDims(matvar_t* matvar);
+	void writeCFLData(const std::string &baseFileName);
+	void prepareMatlabSave();
+	void matlabWrite(const std::string &fileName);
 
 	// Associations
 	/// Pointer to object containing coils sensitivity maps
@@ -0,0 +1,85 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <OpenCLIPER/defs.hpp>
+#include <string>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief A whole file mapped into host memory (see Data::getRawFileMapping())
+ *
+ * The mapping is private: NDArrays backed by it may be written to, but changes are never written back to the file (only
+ * modified pages take up memory of their own; the rest are file pages that the OS can drop and read again at will).
+ * The file must not be truncated while it is mapped.
+ */
+class MappedFile {
+    public:
+	explicit MappedFile(const std::string& fileName);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * @brief Gets the address the file is mapped at
+	 * @return address of the first byte of the file (nullptr for an empty file)
+	 */
+	void* getData() const {
+	    return pData;
+	}
+
+	/**
+	 * @brief Gets the size of the mapped file
+	 * @return file size in bytes
+	 */
+	size_t size() const {
+	    return fileSize;
+	}
+
+	void prefetch(size_t offsetInBytes, size_t sizeInBytes) const;
+
+    private:
+	/// Address the file is mapped at
+	void*	pData = nullptr;
+
+	/// File size in bytes
+	size_t	fileSize = 0;
+};
+
+} // namespace OpenCLIPER
+
+#endif // MAPPEDFILE_HPP
@@ -119,7 +119,7 @@ class MatVarInfo {
 	    return matlabStrides[key];
 	}
 
-	void set(const dimIndexType* pDimsAndStridesInfo, dimIndexType nDArrayOffsetInElements, const NDArray* pNDArray,
+	void set(const index1DType* pDimsAndStridesInfo, dimIndexType nDArrayOffsetInElements, const NDArray* pNDArray,
 		const void* pNDArrayData);
 	void updateDimsAndRank(const std::vector<dimIndexType>* pDimsVectorArg);
     private:
@@ -0,0 +1,87 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef MATLABFILEINDEX_HPP
+#define MATLABFILEINDEX_HPP
+
+#include <OpenCLIPER/defs.hpp>
+#include <map>
+#include <string>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Index of the variables stored in a matlab file, built by reading only their headers
+ *
+ * Variables are decoded only when they are requested (readVariable()), and big ones can be read in slabs of consecutive
+ * elements (readVariableSlab()) so that they never have to be held in memory as a whole. The file stays open while this
+ * object exists.
+ */
+class MatlabFileIndex {
+    public:
+	explicit MatlabFileIndex(const std::string& fileName);
+	~MatlabFileIndex();
+
+	MatlabFileIndex(const MatlabFileIndex&) = delete;
+	MatlabFileIndex& operator=(const MatlabFileIndex&) = delete;
+
+	/**
+	 * @brief Checks whether a variable is stored in the file
+	 * @param[in] variableName name of the variable
+	 * @return true if the variable exists
+	 */
+	bool contains(const std::string& variableName) const {
+	    return variablesInfo.count(variableName) != 0;
+	}
+
+	matvar_t* getVariableInfo(const std::string& variableName) const;
+	matvar_t* readVariable(const std::string& variableName) const;
+	matvar_t* readVariableSlab(const std::string& variableName, size_t firstElement, size_t numElements,
+				   dimIndexType numOfSlabDims) const;
+
+    private:
+	void close();
+
+	/// Name of the matlab file
+	std::string fileName;
+
+	/// Open matlab file
+	mat_t* matfp = nullptr;
+
+	/// Headers (without data) of the variables stored in the file, by name
+	std::map<std::string, matvar_t*> variablesInfo;
+};
+
+} // namespace OpenCLIPER
+
+#endif // MATLABFILEINDEX_HPP
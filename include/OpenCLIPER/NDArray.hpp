@@ -44,6 +44,8 @@
 #include <OpenCLIPER/MatVarInfo.hpp>
 
 namespace OpenCLIPER {
+class MappedFile;
+
 /// @brief class NDArray - n-dimensional matrix of data (abstract class, data type of data elements
 /// is specific of subclasses).
 class NDArray {
@@ -65,6 +67,8 @@ class NDArray {
 
 	static NDArray* createNDArray(const std::string &completeFileName, std::vector<dimIndexType>*& pSpatialDims, ElementDataType elementDataType);
 	static NDArray* createNDArray(std::fstream &f, std::vector<dimIndexType>*& pSpatialDims, ElementDataType elementDataType);
+	static NDArray* createNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims,
+				      ElementDataType elementDataType);
 	static NDArray* createNDArray(const NDArray* pSourceData, bool copyData, ElementDataType elementDataType);
 	static NDArray* createNDArray(const void* pSourceData, std::vector<dimIndexType>*& pSpatialDims, ElementDataType elementDataType);
 	static NDArray* createNDArray(matvar_t* matvar, dimIndexType numOfSpatialDims, dimIndexType nDArrayOffsetInElements);
@@ -78,6 +82,10 @@ class NDArray {
 	// Getters
 	const numberOfDimensionsType getNDims() const;
 	static dimIndexType          getElementSize(ElementDataType elementDataType);
+
+	// Conversions for complexHalfType elements
+	static cl_half floatToHalf(float value);
+	static float   halfToFloat(cl_half value);
 	const index1DType            size() const;
 
 	/**
@@ -105,6 +113,20 @@ class NDArray {
 	*/
 	virtual void* getHostDataAsVoidPointer() const = 0;
 
+	/**
+	* @brief Asks for data in host memory to be read in advance if they are not in memory yet (e.g. they are backed by a
+	* mapped file), without waiting for them. Default implementation does nothing.
+	*/
+	virtual void prefetchHostData() const {
+	}
+	/**
+	* @brief Makes data in host memory live in external memory (e.g. zero-copy device memory, see HOST_MEMORY_ZEROCOPY)
+	* instead of in a vector. Current data are not copied: they must have been copied to that memory before.
+	* @param[in] pExternalData external memory (at least size() elements long)
+	* @param[in] pOwner object keeping pExternalData alive as long as this NDArray uses it
+	*/
+	virtual void setExternalHostData(void* pExternalData, const std::shared_ptr<void>& pOwner) = 0;
+
 	/**
 	* @brief Sets pDims (spatial dimensions) field. Use move semantics, parameter value will be nullptr after executing this method.
 	* @param[in,out] pDims reference to pointer to new vector with data spatial dimensions
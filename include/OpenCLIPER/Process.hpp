@@ -56,6 +56,16 @@ class Process: public ProcessCore {
 
         virtual const std::string getKernelFile() const;
 
+	/**
+	 * @brief Enables building this process' kernels for the shape of its Data objects (see CLapp::getSpecializedKernel()).
+	 *
+	 * Takes effect at the next init(). A specialized process must only be launched on Data of the shape it was initialized with.
+	 * @param[in] enable true to build shape-specialized kernels, false to use the generic ones
+	 */
+	void setShapeSpecialization(bool enable) {
+	    shapeSpecialization = enable;
+	}
+
 	/**
 	 * @brief Creates a process object
 	 * @param[in] pCLapp the CLapp in which this process will operate
@@ -102,9 +112,14 @@ class Process: public ProcessCore {
 	Process(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<Data>& pInputData, const std::shared_ptr<Data>& pOutputData,
                 const std::shared_ptr<ProfileParameters>& pPP = nullptr);
 
+	cl::Kernel getShapeKernel(const std::string& name, bool outputShape = false);
+
     private:
         /// The CLapp in which this process lives
 	std::shared_ptr<CLapp> pCLapp = nullptr;
+
+	/// True if kernels must be built for the shape of the Data objects of this process
+	bool shapeSpecialization = false;
 };
 } // namespace OpenCLIPER
 #endif // PROCESS_HPP
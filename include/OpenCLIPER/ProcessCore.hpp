@@ -122,7 +122,12 @@ class ProcessCore {
 	    return pLaunchParameters;
 	}
 
-	void setCommandQueue(const cl::CommandQueue& cq) { queue = cq; }
+	/**
+	* @brief Binds this process to a command queue (by default, the first queue of the first device). Processes which launch
+	* other processes must redefine this method so that their subprocesses are bound to the same queue.
+	* @param[in] cq command queue (must belong to the CLapp's context)
+	*/
+	virtual void setCommandQueue(const cl::CommandQueue& cq) { queue = cq; }
 	virtual void setApp(const std::shared_ptr<CLapp>& pCLapp) = 0;
 	void setInput(std::shared_ptr<Data> pInputData);
 	void setOutput(std::shared_ptr<Data> pOutputData);
@@ -151,11 +156,16 @@ class ProcessCore {
                 BTTHROW(std::invalid_argument("Invalid CLapp pointer"), "ProcessCore::init");
 	}
 
+	void launch();
+
 	/**
-	* @brief Method that runs OpenCL kernel(s) associated to this process (subclasses must implement it)
-	* @param[in] profileParameters parameters related to profiling of kernel execution
-	*/
-	virtual void launch() = 0;
+	 * @brief Tells if this process accepts half precision complex (TYPEID_COMPLEXHALF) input and output data (launch()
+	 * throws otherwise)
+	 * @return true if half precision data are supported
+	 */
+	virtual bool supportsHalfData() const {
+	    return false;
+	}
 
 	/**
 	* @brief Gets infoItems class variable value
@@ -194,7 +204,18 @@ class ProcessCore {
 	    return outHandle;
 	}
 
+	/**
+	* @brief Method that enqueues OpenCL kernel(s) associated to this process (subclasses must implement it). It is called
+	* from launch() once this process' queue waits for previous accesses to input and output data
+	*/
+	virtual void doLaunch() = 0;
+
+	void waitForDataDependencies(const std::vector<std::shared_ptr<Data>>& readList,
+				     const std::vector<std::shared_ptr<Data>>& writeList = {});
+	void recordDataRead(const std::shared_ptr<Data>& pData, const cl::Event& event = cl::Event());
+	void recordDataWrite(const std::shared_ptr<Data>& pData, const cl::Event& event = cl::Event());
 	void checkCommonLaunchParameters();
+	void checkHalfData();
 	void checkXDataLaunchParameters(SyncSource syncSource = SYNCSOURCEDEFAULT);
 	void startProfiling();
 	void stopProfiling();
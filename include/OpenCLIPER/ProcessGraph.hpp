@@ -0,0 +1,152 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef PROCESSGRAPH_HPP
+#define PROCESSGRAPH_HPP
+
+#include <OpenCLIPER/Process.hpp>
+#include <vector>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Process that runs a sequence of processes connected by Data objects.
+ *
+ * Processes are added in execution order with addProcess(). Consecutive element-wise processes (ScalarMultiply,
+ * ComplexElementProd, ApplyMask, ComplexAbs, ComplexAbsPow2, ComplexPow and Complex2Real) where each one reads the result
+ * of the previous one, and nobody else needs that result, are fused by init() into a single generated kernel, so their
+ * intermediate results never go through global memory. All other processes are launched as usual.
+ *
+ * Temporary data between processes should be created with createIntermediate(): they are allocated once, reused by every
+ * launch and (unlike any other Data object) their contents are not expected to be preserved after a launch, so they are
+ * not even written if they end up inside a fused kernel.
+ */
+class ProcessGraph: public Process {
+    public:
+	void addProcess(const std::shared_ptr<Process>& pProcess, const std::shared_ptr<Data>& pIn, const std::shared_ptr<Data>& pOut,
+			const std::shared_ptr<LaunchParameters>& pLP = nullptr);
+	std::shared_ptr<Data> createIntermediate(const std::shared_ptr<Data>& pTemplate);
+
+	void init();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
+
+	/**
+	 * @brief Half precision data are checked by each process of the graph (they are never fused)
+	 * @return true
+	 */
+	bool supportsHalfData() const {
+	    return true;
+	}
+
+	/**
+	 * @brief Gets the number of fused kernels generated by init()
+	 * @return number of fused kernels
+	 */
+	size_t getNumFusedKernels() const {
+	    return fusedKernels.size();
+	}
+
+    private:
+	using Process::Process;
+
+	/// Types of element-wise processes which can be fused
+	enum StageType {
+	    STAGE_NONE,
+	    STAGE_SCALARMULTIPLY,
+	    STAGE_COMPLEXELEMENTPROD,
+	    STAGE_APPLYMASK,
+	    STAGE_COMPLEXABS,
+	    STAGE_COMPLEXABSPOW2,
+	    STAGE_COMPLEXPOW,
+	    STAGE_COMPLEX2REAL
+	};
+
+	/// A process in the graph, together with the Data objects it reads and writes
+	struct Node {
+	    std::shared_ptr<Process> pProcess;
+	    std::shared_ptr<Data> pIn;
+	    std::shared_ptr<Data> pOut;
+	    std::shared_ptr<LaunchParameters> pLP;
+	    StageType stageType;
+	};
+
+	/// A chain of consecutive nodes replaced by a single generated kernel
+	struct FusedKernel {
+	    size_t firstNode;
+	    size_t lastNode;
+	    cl::Kernel kernel;
+	    cl::NDRange globalSize;
+
+	    // Input (first node) and output (last node) layout
+	    cl_uint numVoxels;
+	    cl_uint inCoils;
+	    index1DType inStride;
+	    cl_uint outCoils;
+	    index1DType outStride;
+	};
+
+	/// An entry of the execution plan: a node launched on its own or a fused kernel
+	struct Step {
+	    size_t node;
+	    int fusedKernel;
+	};
+
+	static StageType	getStageType(const std::shared_ptr<Process>& pProcess);
+	static ElementDataType	getStageOutputType(StageType stageType, ElementDataType inputType);
+	static index1DType	getNDArrayDistance(const std::shared_ptr<Data>& pData);
+	bool			isElementWise(size_t node) const;
+	bool			isDeadAfterNextNode(size_t node) const;
+	bool			canFuse(size_t node) const;
+	const std::string	getFusedKernelSource(const FusedKernel& fusedKernel, const std::string& name) const;
+	void			launchFusedKernel(FusedKernel& fusedKernel);
+
+	/// Nodes, in execution order
+	std::vector<Node> nodes;
+
+	/// Data objects created with createIntermediate()
+	std::vector<std::shared_ptr<Data>> intermediates;
+
+	/// Fused kernels generated by init()
+	std::vector<FusedKernel> fusedKernels;
+
+	/// Execution plan generated by init()
+	std::vector<Step> steps;
+
+	/// Program holding all fused kernels
+	cl::Program fusedProgram;
+};
+
+} // namespace OpenCLIPER
+
+#endif // PROCESSGRAPH_HPP
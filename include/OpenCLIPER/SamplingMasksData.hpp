@@ -83,10 +83,11 @@ class SamplingMasksData: public Data {
 	SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNamePrefix,
 			  std::vector<std::vector< dimIndexType >*>*& pArraysDims, std::vector <dimIndexType>*& pDynDims,
 			  dimIndexType kDataNumCols, const std::string &framesFileNameSuffix = "_frame",
-			  const std::string &fileNameExtension = ".raw", ElementDataType elementDataTye = TYPEID_INDEX);
+			  const std::string &fileNameExtension = ".raw", ElementDataType elementDataTye = TYPEID_INDEX,
+			  bool mapFiles = false);
 	SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName,
 			const std::vector<dimIndexType>* pArraySpatialDims, const std::vector <dimIndexType>* pTemporalDims, dimIndexType kDataNumCols,
-			ElementDataType elementDataType);
+			ElementDataType elementDataType, bool mapFile = false);
 	SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, matvar_t* pMatlabVar,
 		const std::vector<dimIndexType>* pKDataSpatialDimensions);
 	SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<SamplingMasksData>& sourceData, bool copyData = false);
@@ -64,9 +64,9 @@ class SensitivityMapsData: public Data {
 	SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNamePrefix,
 			    std::vector<std::vector< dimIndexType >*>*& pArraysDims,
 			    numCoilsType numCoils, const std::string& coilsFileNameSuffix = "_coil",
-			    const std::string& fileNameExtension = ".raw");
+			    const std::string& fileNameExtension = ".raw", bool mapFiles = false);
 	SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName, const std::vector<dimIndexType>* pArraySpatialDims,
-			dimIndexType numCoils);
+			dimIndexType numCoils, bool mapFile = false);
 	SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, matvar_t* pMatlabVar,
 			const std::vector<dimIndexType>* pSpatialDimsFullySampled, dimIndexType nCoils);
 	virtual ~SensitivityMapsData();
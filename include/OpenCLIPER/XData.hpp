@@ -146,7 +146,8 @@ class XData: public Data {
 	XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& fileName, ElementDataType elementDataType = TYPEID_COMPLEX);
 	XData(const std::shared_ptr<CLapp>& pCLapp, const std::vector<std::string> &fileNames, ElementDataType elementDataType = TYPEID_COMPLEX);
 	XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNamePrefix, std::vector<std::vector< dimIndexType >*>*& pArraysDims, std::vector <dimIndexType>*& pDynDims,
-	      const std::string& framesFileNameSuffix = "_frame", const std::string& fileNameExtension = ".raw", ElementDataType elementDataType = TYPEID_COMPLEX);
+	      const std::string& framesFileNameSuffix = "_frame", const std::string& fileNameExtension = ".raw", ElementDataType elementDataType = TYPEID_COMPLEX,
+	      bool mapFiles = false);
 
 	virtual ~XData() {}
 
@@ -168,11 +169,13 @@ class XData: public Data {
 	void save(const std::vector<std::string> &fileNames);
 	void save(const std::string& prefixName, const std::string& extension);
 	void saveCFLData(const std::string &fileName, bool asyncSave = false);
+	std::shared_future<void> saveCFLDataAsync(const std::string &fileName, DataWriter* pWriter = nullptr);
 	void saveCFLHeader(const std::string &fileName);
 
 	void calcDataDims();
 	// Save in matlab file
 	void matlabSave(const std::string& fileName);
+	std::shared_future<void> matlabSaveAsync(const std::string& fileName, DataWriter* pWriter = nullptr);
 	static XData* genTestXData(const std::shared_ptr<CLapp>& pCLapp, dimIndexType width, dimIndexType height, dimIndexType numFrames, ElementDataType elementDataType,
 				   TypeOfGenData typeOfGenData = CONSTANT);
 
@@ -184,6 +187,8 @@ class XData: public Data {
 
     private:
 	void load(const std::vector<std::string> &fileNames);
+	void prepareMatlabSave();
+	void matlabWrite(const std::string& fileName);
 	void loadRawHostData(const std::string& fileNamePrefix, std::vector<std::vector< dimIndexType >*>*& pArraysDims,
 			     std::vector <dimIndexType>*& pDynDims,
 			     const std::string& framesFileNameSuffix = "_frame", const std::string& fileNameExtension = ".raw");
@@ -82,6 +82,10 @@
 /// Type used for storing complex values
 #define complexType std::complex<realType>
 
+/// Type used for storing complex values in half precision (storage only, kernels load them with vload_half2 and compute in
+/// single precision)
+#define complexHalfType cl_half2
+
 /// String with prefix for error messages (the name of the namespace)
 #define ERRORNAMESPACEPREFIX "OpenCLIPER::"
 
@@ -112,8 +116,13 @@ typedef uint32_t numCoilsType;
 /// data type to tell which coils are used in an acquisition
 typedef std::set<bool> usedCoilsType;
 
-/// data type for variables storing a 1-dimensional index calculated from indexes of several dimensions
+/// data type for variables storing a 1-dimensional index calculated from indexes of several dimensions (also used for
+/// sizes, strides and offsets, and for the dimensions and strides array stored in device buffers)
+#ifdef USE_INDEX64
+typedef uint64_t index1DType;
+#else
 typedef uint32_t index1DType;
+#endif
 
 /// data type for variables storing an index from a several dimensions image
 typedef uint32_t dimIndexType;
@@ -126,6 +135,7 @@ typedef uint32_t numberOfDimensionsType;
 #define TYPEID_REAL std::type_index(typeid(realType))
 #define TYPEID_INDEX std::type_index(typeid(dimIndexType))
 #define TYPEID_CL_UCHAR std::type_index(typeid(cl_uchar))
+#define TYPEID_COMPLEXHALF std::type_index(typeid(complexHalfType))
 
 // common names for CFL format files
 #define CFLSensMapsSuffix "_SensitivityMaps.cfl"
@@ -194,8 +204,17 @@ extern "C" {
  ****************************************************************************************/
 #ifdef DOUBLE_PREC
     typedef double2 complexType;
+    #define convert_complexType convert_double2
 #else
     typedef float2 complexType;
+    #define convert_complexType convert_float2
+#endif
+
+// Must match the host definition (USE_INDEX64 is passed to kernels by CLapp when the library is built with it)
+#ifdef USE_INDEX64
+    typedef ulong index1DType;
+#else
+    typedef uint index1DType;
 #endif
 
 #endif // __cplusplus
@@ -241,10 +260,10 @@ enum DimsPos {
 #define PNDARRAY0 getData()->at(0)
 
 /// Type of array with Data dimensions information
-typedef uint* dimsInfo_t;
+typedef index1DType* dimsInfo_t;
 
 /// Type of array with Data stride dimensions information
-typedef uint* stridesInfo_t;
+typedef index1DType* stridesInfo_t;
 
 /// Minimum number of positions of dimensions info array
 #define NUMINITIALPOSITIONSDIMSINFO 4
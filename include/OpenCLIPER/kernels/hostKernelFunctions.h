@@ -42,6 +42,56 @@ extern "C" {
     #define PRINTF(x) do {} while(0)
 #endif // DEBUGKERNEL
 
+#ifndef __cplusplus
+// Kernels built by CLapp::getSpecializedKernel() get the shape of a reference Data object as compile-time constants
+// (SHAPE_COLUMNS, SHAPE_ROWS, SHAPE_SLICES, SHAPE_NUMSPATIALDIMS, SHAPE_NUMCOILS, SHAPE_NUMFRAMES, SHAPE_COILSTRIDE and
+// SHAPE_FRAMESTRIDE), so the compiler can fold index arithmetic. Kernels opt in by wrapping their header lookups for that
+// reference buffer in SHAPE_OR; regular builds keep doing the lookup at run time.
+#ifdef SPECIALIZED_SHAPE
+    /// Shape field of the reference buffer: compile-time constant in specialized builds
+    #define SHAPE_OR(field, lookup) (SHAPE_##field)
+#else
+    /// Shape field of the reference buffer: run-time lookup in regular builds
+    #define SHAPE_OR(field, lookup) (lookup)
+#endif // SPECIALIZED_SHAPE
+
+// Buffers of complex elements may hold complexType or half precision complex elements (TYPEID_COMPLEXHALF, a pair of halfs).
+// Half precision is a storage format only: elements are converted to complexType on load and rounded back on store,
+// and all arithmetic is done in realType precision (no cl_khr_fp16 needed). isHalf should be uniform across the work-group.
+/// Loads element index (as a complexType) from a complex buffer in complexType (isHalf == 0) or half precision
+#define LOADCOMPLEX(buffer, index, isHalf) \
+    ((isHalf) ? convert_complexType(vload_half2((index), (global const half*) (buffer))) : \
+		((global const complexType*) (buffer))[index])
+/// Stores value (a complexType) as element index of a complex buffer in complexType (isHalf == 0) or half precision
+#define STORECOMPLEX(value, buffer, index, isHalf) \
+    do { \
+	if(isHalf) \
+	    vstore_half2_rte((value), (index), (global half*) (buffer)); \
+	else \
+	    ((global complexType*) (buffer))[index] = (value); \
+    } while(0)
+
+/// Combining operations for WORKGROUP_TREE_REDUCE
+#define COMBINE_SUM(a, b)	((a) + (b))
+#define COMBINE_MAX(a, b)	fmax((a), (b))
+#define COMBINE_MIN(a, b)	fmin((a), (b))
+
+/// Tree reduction of a local memory buffer (one operand per work item in dimension 0, work item id in lid) into scratch[0],
+/// using COMBINE(a, b) to combine operands. Works for any work-group size. Must be reached by every work item in the work group
+#define WORKGROUP_TREE_REDUCE(scratch, lid, COMBINE) \
+    do { \
+	for(uint currentSize = get_local_size(0); currentSize > 1; ) { \
+	    uint halfSize = (currentSize + 1) / 2; \
+	    barrier(CLK_LOCAL_MEM_FENCE); \
+	    /* Upper half is combined with lower half; middle element (if currentSize is odd) is left for next step */ \
+	    if((lid) < currentSize - halfSize) \
+		(scratch)[lid] = COMBINE((scratch)[lid], (scratch)[(lid) + halfSize]); \
+	    currentSize = halfSize; \
+	} \
+	barrier(CLK_LOCAL_MEM_FENCE); \
+    } while(0)
+#endif // __cplusplus
+
 // defines related to vector data types
 // moved to defs.hpp because it used for checking validity of NDArray spatial dimensions
 // (OpenCL vector operations are used for columns, rows or slices, so every spatial dimension has to be multiple of VECTORDATATYPESIZE/2, as
@@ -66,11 +116,11 @@ extern "C" {
 #define KERNELCOMPILEOPTS "-I../include/"
 
 struct __attribute__((packed)) dimsAndStridesKnownFields {
-    uint numSpatialDims;
-    uint allSizesEqual;
-    uint numCoils;
-    uint numTemporalDims;
-    uint firstTemporalDimSize;
+    index1DType numSpatialDims;
+    index1DType allSizesEqual;
+    index1DType numCoils;
+    index1DType numTemporalDims;
+    index1DType firstTemporalDimSize;
 };
 
 
@@ -78,53 +128,53 @@ struct __attribute__((packed)) dimsAndStridesKnownFields {
 // Internal functions
 // ---------------------------------------------------------------------------------------------------------------------------
 
-uint roundUp(uint numToRound, uint baseNumber);
-uint getDimsAndStridesArrayOffsetInBytes(global const void* buffer);
-global const uint* getDimsAndStridesArrayInBuffer(global const void* buffer);
+index1DType roundUp(index1DType numToRound, index1DType baseNumber);
+index1DType getDimsAndStridesArrayOffsetInBytes(global const void* buffer);
+global const index1DType* getDimsAndStridesArrayInBuffer(global const void* buffer);
 global const struct dimsAndStridesKnownFields* getDimsAndStridesStruct(global const void* buffer);
-global const uint* getStridesArray(global const void* buffer);
+global const index1DType* getStridesArray(global const void* buffer);
 
 
 // ---------------------------------------------------------------------------------------------------------------------------
 // Functions related to spatial dimensions
 // ---------------------------------------------------------------------------------------------------------------------------
 
-uint getNumSpatialDims(global const void* buffer);
-uint getNumNDArrays(global const void* buffer);
-uint getNDArray1DIndex(global const void* buffer, uint coilIndex, uint temporalDimIndexes[]);
-uint getNDArrayTotalSize(global const void* buffer, uint NDArray1DIndex);
-uint getNDArrayStride(global const void* buffer);
-uint getSpatialDimStride(global const void* buffer, uint spatialDimIndex, uint NDArray1DIndex);
-uint getSpatialDimSize(global const void* buffer, uint spatialDimIndex, uint NDArray1DIndex);
+index1DType getNumSpatialDims(global const void* buffer);
+index1DType getNumNDArrays(global const void* buffer);
+index1DType getNDArray1DIndex(global const void* buffer, index1DType coilIndex, uint temporalDimIndexes[]);
+index1DType getNDArrayTotalSize(global const void* buffer, index1DType NDArray1DIndex);
+index1DType getNDArrayStride(global const void* buffer);
+index1DType getSpatialDimStride(global const void* buffer, index1DType spatialDimIndex, index1DType NDArray1DIndex);
+index1DType getSpatialDimSize(global const void* buffer, index1DType spatialDimIndex, index1DType NDArray1DIndex);
 
 
 // ---------------------------------------------------------------------------------------------------------------------------
 // Functions related to coils
 // ---------------------------------------------------------------------------------------------------------------------------
 
-uint getNumCoils(global const void* buffer);
-uint getCoilDim(global const void* buffer);
-uint getCoilStride(global const void* buffer, uint NDArray1DIndex);
+index1DType getNumCoils(global const void* buffer);
+index1DType getCoilDim(global const void* buffer);
+index1DType getCoilStride(global const void* buffer, index1DType NDArray1DIndex);
 
 
 // ---------------------------------------------------------------------------------------------------------------------------
 // Functions related to temporal dimensions
 // ---------------------------------------------------------------------------------------------------------------------------
 
-uint getNumTemporalDims(global const void* buffer);
-uint getTemporalDim(global const void* buffer, uint tempDim);
-uint getTemporalDimStride(global const void* buffer, uint temporalDimIndex, uint NDArray1DIndex);
-uint getTemporalDimSize(global const void* buffer, uint temporalDimIndex);
+index1DType getNumTemporalDims(global const void* buffer);
+index1DType getTemporalDim(global const void* buffer, index1DType tempDim);
+index1DType getTemporalDimStride(global const void* buffer, index1DType temporalDimIndex, index1DType NDArray1DIndex);
+index1DType getTemporalDimSize(global const void* buffer, index1DType temporalDimIndex);
 
 
 // ---------------------------------------------------------------------------------------------------------------------------
 // Functions related to dimensions in general (not particular to spatial, coil or temporal dimensions)
 // ---------------------------------------------------------------------------------------------------------------------------
 
-uint getDimSize(global const void* buffer, uint dimIndex, uint NDArray1DIndex);
-uint getElementStride(global const void* buffer, uint NDArray1DIndex);
-uint getDimStride(global const void* buffer, uint dimIndex, uint NDArray1DIndex);
-global const void* getNextElement(global const void* buffer, dimIndexType nDim, dimIndexType curNDArray, dimIndexType curOffset);
+index1DType getDimSize(global const void* buffer, index1DType dimIndex, index1DType NDArray1DIndex);
+index1DType getElementStride(global const void* buffer, index1DType NDArray1DIndex);
+index1DType getDimStride(global const void* buffer, index1DType dimIndex, index1DType NDArray1DIndex);
+global const void* getNextElement(global const void* buffer, dimIndexType nDim, dimIndexType curNDArray, index1DType curOffset);
 
 
 // ---------------------------------------------------------------------------------------------------------------------------
@@ -133,6 +183,8 @@ global const void* getNextElement(global const void* buffer, dimIndexType nDim,
 #ifdef __OPENCL_C_VERSION
     void printComplex(float2 complex, char* name);
     void printVector(__constant char name[], float* vector, uint numberOfElements);
+    void workgroupTreeSum(__local float* scratch);
+    void workgroupTreeMax(__local float* scratch);
 #endif //__OPENCL_C_VERSION
 
 #ifdef __cplusplus
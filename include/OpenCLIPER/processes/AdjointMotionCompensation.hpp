@@ -51,13 +51,19 @@ namespace OpenCLIPER {
  */
 class AdjointMotionCompensation : public Process {
     public:
+	struct InitParameters: Process::InitParameters {
+	    bool gather; ///< use the atomic-free (gather) adjoint interpolator
+	    InitParameters(bool gather = false): gather(gather) {}
+	};
+
         struct LaunchParameters: Process::LaunchParameters {
 	    ArgumentsMotionCompensation* argsMC;
 	    LaunchParameters(ArgumentsMotionCompensation* args): argsMC(args) {}
 	};
 
         void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
     private:
 	using Process::Process;
@@ -17,9 +17,10 @@ class ApplyMask: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "applyMask.cl"; }
+        bool supportsHalfData() const { return true; }
 
     private:
 	using Process::Process;
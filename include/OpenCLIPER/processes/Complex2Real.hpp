@@ -62,7 +62,7 @@ class Complex2Real: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "internalKernels.cl"; }
 
@@ -71,8 +71,8 @@ class Complex2Real: public Process {
 
 	// non-spatial size and stride (including coils, if any)
 	cl_uint batchSize;
-	cl_uint inBatchDistance;
-	cl_uint outBatchDistance;
+	index1DType inBatchDistance;
+	index1DType outBatchDistance;
 };
 
 } // namespace OpenCLIPER
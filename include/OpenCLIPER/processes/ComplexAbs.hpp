@@ -53,7 +53,7 @@ namespace OpenCLIPER {
 class ComplexAbs : public Process {
 	public:
 		void init();
-		void launch();
+		void doLaunch();
 		const std::string getKernelFile() const { return "complexAbs.cl"; }
 
 	private:
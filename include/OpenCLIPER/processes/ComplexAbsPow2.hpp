@@ -53,7 +53,7 @@ namespace OpenCLIPER {
 class ComplexAbsPow2 : public Process {
 	public:
 		void init();
-		void launch();
+		void doLaunch();
 		const std::string getKernelFile() const { return "complexAbsPow2.cl"; }
 
 	private:
@@ -87,9 +87,10 @@ class ComplexElementProd: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "complexElementProd.cl"; }
+        bool supportsHalfData() const { return true; }
 
     private:
         using Process::Process;
@@ -0,0 +1,68 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef COMPLEXHALFCONVERT_HPP
+#define COMPLEXHALFCONVERT_HPP
+
+#include <OpenCLIPER/Process.hpp>
+
+namespace OpenCLIPER {
+/**
+ * @brief Process class to convert complex data objects to half precision complex (complexHalfType) data objects or vice versa
+ *
+ * The direction of the conversion depends on the element data type of the input (TYPEID_COMPLEX or TYPEID_COMPLEXHALF); the
+ * output must have the other one (it can be created with clone(TYPEID_COMPLEXHALF) or clone(TYPEID_COMPLEX)). Half precision
+ * data take half the memory and bandwidth of single precision ones, but they are only a storage format: kernels reading them
+ * convert them to single precision and compute in single precision. Only ComplexElementProd and ApplyMask accept them; other
+ * processes throw if given half precision data (see Process::supportsHalfData()).
+ */
+class ComplexHalfConvert: public Process {
+    public:
+	void init();
+	void doLaunch();
+
+        const std::string getKernelFile() const { return "internalKernels.cl"; }
+        bool supportsHalfData() const { return true; }
+
+    private:
+	using Process::Process;
+
+	// non-spatial size and stride (including coils, if any)
+	cl_uint batchSize;
+	index1DType inBatchDistance;
+	index1DType outBatchDistance;
+};
+
+} // namespace OpenCLIPER
+
+#endif // COMPLEXHALFCONVERT_HPP
@@ -78,16 +78,34 @@ class FFT: public Process {
 	    BACKWARD = CLFFT_BACKWARD
 	};
 
+	/// Enumerated type with output normalization options (N is the number of elements of each transform)
+	enum Normalization {
+	    /// Backward transform scaled by 1/N, forward transform unscaled (clFFT's default)
+	    NORMALIZE_BACKWARD,
+	    /// Neither transform is scaled
+	    NORMALIZE_NONE,
+	    /// Both transforms scaled by 1/sqrt(N) (unitary transform)
+	    NORMALIZE_UNITARY
+	};
+
 	/// Parameters related to process initialization
 	struct InitParameters: Process::InitParameters {
 	    /// Do the FFT along this dimension only (-1 means all dimensions)
 	    int dim;
 
-	    /// For the special case of the first spatial dimension (i.e. rows), do the FFT at these lines only (nullptr means all rows)
+	    /// For the special case of the first spatial dimension (i.e. rows), do the FFT at these lines only (nullptr means all rows).
+	    /// Selected rows are packed together and transformed with a single batched FFT; rows not selected are set to zero in the output
 	    std::shared_ptr<SamplingMasksData> samplingMask;
 
+	    /// Centered transform: compute fftshift(FFT(ifftshift(x))) at no extra cost (transform sizes must be even)
+	    bool centered;
+
+	    /// Output normalization, applied by clFFT itself (no extra pass)
+	    Normalization normalization;
+
 	    /// constructor
-	    explicit InitParameters(int d = -1, std::shared_ptr<SamplingMasksData> s = nullptr): dim(d), samplingMask(s) {}
+	    explicit InitParameters(int d = -1, std::shared_ptr<SamplingMasksData> s = nullptr, bool c = false, Normalization n = NORMALIZE_BACKWARD):
+		dim(d), samplingMask(s), centered(c), normalization(n) {}
 	};
 
 	/// Parameters related to kernel execution
@@ -101,12 +119,14 @@ class FFT: public Process {
 
 	// Methods
 	void init();
-	void launch();
+	void doLaunch();
+
+	const std::string getKernelFile() const { return "fft.cl"; }
 
     private:
 	using Process::Process;
 
-	/// handle to FFT plan (FFT configuration)
+	/// handle to FFT plan (FFT configuration). Owned by the CLapp's FFT plan cache
 	clfftPlanHandle clPlanHandle;
 
 	/// number of batches needed to cover the whole volume (varies with specified dim and samplingMask values)
@@ -118,6 +138,31 @@ class FFT: public Process {
         // Work buffer
         std::shared_ptr<Data> clWorkBuffer = nullptr;
 
+	/// True if a sampling mask restricts the transform to some rows (gather, transform and scatter)
+	bool packedRowsMode = false;
+
+	/// Rows selected by the sampling mask, packed contiguously (transformed in-place)
+	std::shared_ptr<Data> packedData = nullptr;
+
+	/// Index (in the input) of every packed row
+	cl::Buffer packedRowsBuffer;
+
+	/// Value of rowMapBuffer for rows not selected by the sampling mask (must match FFT_UNSAMPLED_ROW in fft.cl)
+	static constexpr cl_uint UNSAMPLED_ROW = 0xFFFFFFFF;
+
+	/// Index (in packedData) of every row of the input, or UNSAMPLED_ROW
+	cl::Buffer rowMapBuffer;
+
+	/// Geometry of the rows in packed mode: number of packed rows, total rows and elements per row
+	cl_uint nPackedRows = 0, nRows = 0, rowLength = 0;
+
+	/// Geometry of the rows in packed mode: distance between rows and between elements (index1DType, since they are
+	/// multiplied by row and element indexes in fft.cl)
+	index1DType rowDistance = 0, elementStride = 0;
+
+	cl::Kernel gatherKernel;
+	cl::Kernel scatterKernel;
+
 #ifdef HAVE_ROCFFT
 	rocfft_plan     rocPlanHandleFW;
 	rocfft_plan     rocPlanHandleBW;
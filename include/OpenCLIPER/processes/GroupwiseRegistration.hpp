@@ -77,6 +77,8 @@
 #include <OpenCLIPER/processes/groupwiseRegistration/optimizer/GradientRegularization.hpp>
 #include <OpenCLIPER/processes/groupwiseRegistration/optimizer/GradientWithSmoothTerms.hpp>
 #include <OpenCLIPER/processes/groupwiseRegistration/optimizer/AdjointInterpolator.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/EvolutionStop.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/ProjectedGradientCost.hpp>
 
 #include <algorithm>
 #include <numeric> // Needed for gcc 7 (default compiler in Ubuntu 18.04)
@@ -97,6 +99,7 @@ struct ArgumentsMotionCompensation {
     std::shared_ptr<Data> TData;
     std::shared_ptr<Data> xData;
     std::vector<dimIndexType>* bound_box;
+    int stopIter = 0; //!< Optimizer iteration at which the stop condition was met
 };
 
 /**
@@ -152,9 +155,15 @@ class GroupwiseRegistration: public Process {
 	    float et; //!< Transformation norm threshold (in pixels)
 	    float eh; //!< Metric variation threshold (e.g. 0.005 => 0.5% of initial metric)
 	    std::vector<realType> lambda; //!< Smoothness terms (1st spatial, 2nd spatial, 1st temporal, 2nd temporal)
+	    bool deviceStop; //!< Evaluate evolution and stop condition on the device instead of reading back cost and displacement every iteration
+	    uint stopPollInterval; //!< If deviceStop is set, number of iterations between successive reads of the stop flag
+	    bool fusedCost; //!< Compute dH for all control points in a single kernel (ProjectedGradientCost) instead of four kernels per control point
 
 	    /// constructor
-	    explicit InitParameters(float W, bool flagW, uint radius, uint E, int* Dp, uint nmax, float et, float eh, const std::vector<realType>& lambda): W(W), flagW(flagW), radius(radius), E(E), Dp(Dp), nmax(nmax), et(et), eh(eh), lambda(lambda) {}
+	    explicit InitParameters(float W, bool flagW, uint radius, uint E, int* Dp, uint nmax, float et, float eh, const std::vector<realType>& lambda,
+				    bool deviceStop = false, uint stopPollInterval = 10, bool fusedCost = false):
+		W(W), flagW(flagW), radius(radius), E(E), Dp(Dp), nmax(nmax), et(et), eh(eh), lambda(lambda),
+		deviceStop(deviceStop), stopPollInterval(stopPollInterval), fusedCost(fusedCost) {}
 	};
         
         
@@ -168,7 +177,8 @@ class GroupwiseRegistration: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
 	// Getters
 	/** Returns struct containig weights for every regularization term
@@ -236,6 +246,8 @@ class GroupwiseRegistration: public Process {
 	std::shared_ptr<Process> pAuxiliarCost;
 	std::shared_ptr<Process> pCost6DReduction;
 	std::shared_ptr<Process> pCostReduction;
+	std::shared_ptr<Process> pEvolutionStop;
+	std::shared_ptr<Process> pProjectedGradientCost;
 	std::shared_ptr<Process> pTransformationAux;
 	std::shared_ptr<Process> pDeformation;
 	std::shared_ptr<Process> pDeformationAdjust;
@@ -277,11 +289,15 @@ class GroupwiseRegistration: public Process {
         std::shared_ptr<Data> cost2Data;
         std::shared_ptr<Data> dHData;
         std::shared_ptr<Data> DifData;
+        std::shared_ptr<Data> TdifHdifData;
         
         
         std::vector<dimIndexType>* bound_box;
         float Wn;
         bool flagW;
+        bool deviceStop;
+        uint stopPollInterval;
+        bool fusedCost;
         dimIndexType longr1;
         dimIndexType longr2;
         dimIndexType longr1margin;
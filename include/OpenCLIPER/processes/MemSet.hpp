@@ -66,7 +66,7 @@ class MemSet: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
     private:
 	using Process::Process;
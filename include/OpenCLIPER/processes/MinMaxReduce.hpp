@@ -0,0 +1,91 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef MINMAXREDUCE_HPP
+#define MINMAXREDUCE_HPP
+
+#include <OpenCLIPER/Process.hpp>
+#include <OpenCLIPER/processes/SumReduce.hpp>
+
+namespace OpenCLIPER {
+/**
+ * @brief Process class to reduce a Data object to the minimum and/or maximum of all its pixels
+ *
+ * Real input is reduced as is; complex input is reduced by magnitude. The result is left in device memory, in the
+ * output Data object: one element for MIN or MAX, or two ({min, max}) for MINMAX.
+ * Reductions are computed by SumReduce subprocesses (SumReduce::MIN and SumReduce::MAX over all dimensions).
+ * Input may change between launches as long as its element type does not (subprocesses are reinitialized if its
+ * sizes change).
+ */
+
+class CLapp;
+
+class MinMaxReduce: public Process {
+    public:
+	enum Operation { MIN = 0, MAX = 1, MINMAX = 2 };
+
+	struct InitParameters: Process::InitParameters {
+	    Operation op;
+
+	    InitParameters(Operation op = MAX): op(op) {}
+	};
+
+	void init();
+	void doLaunch();
+
+        const std::string getKernelFile() const { return "internalKernels.cl"; }
+
+	void setCommandQueue(const cl::CommandQueue& cq);
+
+    private:
+	void initReductions();
+
+	Operation op;
+
+	std::shared_ptr<SumReduce> pMinReduce;
+	std::shared_ptr<SumReduce> pMaxReduce;
+	// Results of both reductions for MINMAX, copied afterwards to the output
+	std::shared_ptr<Data> pMinData;
+	std::shared_ptr<Data> pMaxData;
+
+	// Input sizes the subprocesses were initialized for
+	index1DType initNDArraySize = 0;
+	dimIndexType initNumNDArrays = 0;
+
+    private:
+	using Process::Process;
+};
+
+} // namespace OpenCLIPER
+
+#endif // MINMAXREDUCE_HPP
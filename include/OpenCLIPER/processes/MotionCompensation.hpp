@@ -57,7 +57,8 @@ class MotionCompensation : public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
     private:
 	using Process::Process;
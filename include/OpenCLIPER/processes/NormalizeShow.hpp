@@ -61,7 +61,7 @@ class NormalizeShow: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "internalKernels.cl"; }
 
@@ -70,7 +70,7 @@ class NormalizeShow: public Process {
 
 	// non-spatial size and stride (including coils, if any)
 	cl_uint batchSize;
-	cl_uint batchDistance;
+	index1DType batchDistance;
 
 	cl::NDRange globalSize;
 	cl::NDRange localSize;
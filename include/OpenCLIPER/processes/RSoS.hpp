@@ -40,7 +40,7 @@ namespace OpenCLIPER {
 class RSoS: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
 
 	const std::string getKernelFile() const override { return "rss.cl"; }
 
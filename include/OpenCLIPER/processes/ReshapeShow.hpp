@@ -62,7 +62,7 @@ class ReshapeShow: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "internalKernels.cl"; }
 
@@ -60,7 +60,7 @@ class ScalarMultiply: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
         const std::string getKernelFile() const { return "internalKernels.cl"; }
 
     private:
@@ -68,7 +68,7 @@ class ScalarMultiply: public Process {
 
 	// non-spatial size and stride (including coils, if any)
 	cl_uint batchSize;
-	cl_uint batchDistance;
+	index1DType batchDistance;
 
 	cl::NDRange globalSize;
 };
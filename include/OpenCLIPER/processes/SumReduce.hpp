@@ -46,23 +46,57 @@ namespace OpenCLIPER {
 /**
  * @brief Process class to reduce a Data object by summing up all its pixels
  *
+ * By default, all pixels of a real Data object are summed up. InitParameters allow for other operations (maximum,
+ * minimum, L1 norm, squared L2 norm and dot product with a second Data object), real, complex or index element types,
+ * and for reducing over any subset of dimensions (spatial, coil and temporal dimensions, numbered as in
+ * Data::getDimSize). The output is written as a dense array with the sizes of the non-reduced dimensions, in order.
+ * Its element type is complex for sums and dot products of complex data, and real otherwise (maximum, minimum
+ * and L1 norm of complex data are computed over magnitudes).
  */
 
 class CLapp;
 
 class SumReduce: public Process {
     public:
+	enum Operation { SUM, MAX, MIN, L1, L2SQUARED, DOT };
+
+	struct InitParameters: Process::InitParameters {
+	    Operation op;
+	    std::vector<dimIndexType> reducedDims;	///< dimensions to reduce (all of them if empty)
+	    std::shared_ptr<Data> pSecondInput;		///< second operand for DOT (sum of conj(input) * pSecondInput)
+
+	    InitParameters(Operation op = SUM, const std::vector<dimIndexType>& reducedDims = {}, const std::shared_ptr<Data>& pSecondInput = nullptr):
+		op(op), reducedDims(reducedDims), pSecondInput(pSecondInput) {}
+	};
+
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "internalKernels.cl"; }
 
+    private:
+	void initGeneric(const std::shared_ptr<InitParameters>& pIP);
+	void launchGeneric();
+
+	// true unless a plain sum of all the pixels of real data was requested
+	bool generic;
+
+	// generic reduction
+	cl::Kernel finalKernel;
+	std::shared_ptr<Data> pSecondInput;
+	cl::Buffer layoutBuffer;	// reduced/kept dimension sizes and strides (see internalKernels.cl)
+	index1DType reduceSize;
+	index1DType nOutputs;
+	cl_uint groupsPerOutput;
+	cl::NDRange finalLocalSize;
+	size_t accElementSize;
+
     private:
 	// non-spatial size and stride (including coils, if any)
 	cl_uint batchSize;
-	cl_uint batchDistance;
+	index1DType batchDistance;
 
-	cl_uint realGlobalSize;
+	index1DType realGlobalSize;
 	cl::NDRange globalSize;
 	cl::NDRange localSize;
 
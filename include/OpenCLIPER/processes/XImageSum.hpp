@@ -44,7 +44,7 @@ namespace OpenCLIPER {
 class XImageSum: public Process {
     public:
 		void init();
-		void launch();
+		void doLaunch();
 
 		const std::string getKernelFile() const { return "xImageSum.cl"; }
 
@@ -43,7 +43,7 @@ namespace OpenCLIPER {
 class Negate: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
     
         const std::string getKernelFile() const override { return "examples/negate.cl"; }
 
@@ -34,14 +34,20 @@
 #define SIMPLEMRIRECON_HPP
 
 #include <OpenCLIPER/Process.hpp>
+#include <OpenCLIPER/ProcessGraph.hpp>
 
 namespace OpenCLIPER {
 
-/// @brief Class that makes a simple MRI reconstruction of a group of k-images captured by several coils.
+/**
+ * @brief Class that makes a simple MRI reconstruction of a group of k-images captured by several coils.
+ *
+ * Subprocesses are run through a ProcessGraph, so the element-wise ones are fused whenever possible.
+ */
 class SimpleMRIRecon: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
     private:
 	// We need to create subprocesses, so can't just inherit out parent class' constructors
@@ -60,6 +66,9 @@ class SimpleMRIRecon: public Process {
 
         /// Pointer to Process subclass in charge of adding images captured from all the coils at the same time frame
 	std::shared_ptr<Process> pProcAddXImages;
+
+	/// Graph running all subprocesses, built by init()
+	std::shared_ptr<ProcessGraph> pGraph;
 };
 
 } //namespace OpenCLIPER
@@ -42,7 +42,8 @@ namespace OpenCLIPER {
 class SimpleMRIReconSOS: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
     private:
 	// We need to create subprocesses, so can't just inherit out parent class' constructors
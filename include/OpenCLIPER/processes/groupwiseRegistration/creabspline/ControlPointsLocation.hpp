@@ -55,7 +55,7 @@ class ControlPointsLocation: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "creabspline.cl"; }
 
@@ -50,7 +50,7 @@ class CreateBBg: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "creabspline.cl"; }
 
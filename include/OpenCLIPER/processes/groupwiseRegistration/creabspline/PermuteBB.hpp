@@ -53,7 +53,7 @@ class PermuteBB: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "creabspline.cl"; }
 
@@ -47,7 +47,7 @@ namespace OpenCLIPER {
 class PermuteBBg: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "creabspline.cl"; }
 
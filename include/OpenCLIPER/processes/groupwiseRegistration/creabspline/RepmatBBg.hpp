@@ -46,7 +46,7 @@ namespace OpenCLIPER {
 class RepmatBBg: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "creabspline.cl"; }
 
@@ -50,7 +50,7 @@ class InitZero: public Process {
 	    LaunchParameters(cl::Buffer& o, std::vector<cl_uint>& dataSize): object(o), dataSize(dataSize) {}
 	};
 
-	void launch();
+	void doLaunch();
 	void init();
 
         const std::string getKernelFile() const { return "initialize.cl"; }
@@ -53,7 +53,7 @@ class InitZeroRect: public Process {
 	    LaunchParameters(std::vector<dimIndexType>* bound_box): bound_box(bound_box) {}
 	};
 
-	void launch();
+	void doLaunch();
 	void init();
 
         const std::string getKernelFile() const { return "initialize.cl"; }
@@ -43,9 +43,20 @@ namespace OpenCLIPER {
 /**
  * @brief Process class to perform the adjoint of an interpolation, in a determined region.
  *
+ * Two implementations are available: the default one scatters every pixel to its four neighbours using global float
+ * atomics; the gather one (selected with InitParameters::gather) makes every output pixel collect the contributions
+ * it receives, without atomics. The gather implementation is usually faster when float atomics are emulated or
+ * highly contended (e.g. CPU OpenCL runtimes) and displacements are small.
+ * The gather implementation assumes that the original mesh (LaunchParameters::xData) is the identity mesh, as built by
+ * GroupwiseRegistration; for any other mesh the scatter implementation is used instead.
  */
 class AdjointInterpolator: public Process {
     public:
+	struct InitParameters: Process::InitParameters {
+	    bool gather; ///< use the atomic-free gather implementation instead of the atomic scatter one
+	    InitParameters(bool gather = false): gather(gather) {}
+	};
+
 	struct LaunchParameters: Process::LaunchParameters {
 	    std::shared_ptr<Data> xnData;
 	    std::shared_ptr<Data> xData;
@@ -55,7 +66,7 @@ class AdjointInterpolator: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
@@ -64,6 +75,16 @@ class AdjointInterpolator: public Process {
 
         std::shared_ptr<Data> r1marginData;
         std::shared_ptr<Data> r2marginData;
+
+	bool gather = false;
+	cl::Kernel radiusKernel;
+	cl::Kernel gatherKernel;
+	cl::Buffer radiusBuffer;
+	cl::NDRange radiusLocalSize;
+
+	bool isIdentityMesh(const std::shared_ptr<Data>& xData);
+	std::weak_ptr<Data> checkedMesh; ///< last mesh checked by isIdentityMesh
+	bool checkedMeshIsIdentity = false; ///< result of the last isIdentityMesh check
 };
 
 } // namespace OpenCLIPER
@@ -53,7 +53,7 @@ class AuxiliarCost: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
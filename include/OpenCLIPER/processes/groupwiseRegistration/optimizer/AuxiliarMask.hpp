@@ -55,7 +55,7 @@ class AuxiliarMask: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
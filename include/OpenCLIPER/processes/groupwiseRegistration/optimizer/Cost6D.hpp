@@ -50,7 +50,7 @@ class Cost6D: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
@@ -66,7 +66,7 @@ class Deformation: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
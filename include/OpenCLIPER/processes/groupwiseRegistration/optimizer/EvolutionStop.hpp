@@ -0,0 +1,78 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef EVOLUTIONSTOP_HPP
+#define EVOLUTIONSTOP_HPP
+
+#include <OpenCLIPER/Process.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Process class to compute the evolution of the optimizer (norm of the transformation difference, metric variation and
+ * weight adaptation) and evaluate its stop condition on the device.
+ *
+ * Input is the metric cost for every iteration; output holds Tdif (first nmax elements) and Hdif (next nmax elements).
+ */
+class EvolutionStop: public Process {
+    public:
+	struct LaunchParameters: Process::LaunchParameters {
+	    std::shared_ptr<Data> DifData;
+	    cl::Buffer Wnobj;
+	    cl::Buffer stopObj;
+	    cl_float p2;
+	    cl_float eh;
+	    cl_int nmax;
+	    cl_int flagW;
+	    cl_int iter = 0; //!< Current iteration. Update it before every launch
+
+	    LaunchParameters(const std::shared_ptr<Data>& Dif, cl::Buffer& Wn, cl::Buffer& stop, cl_float p2, cl_float eh, cl_int nmax, cl_int flagW):
+		DifData(Dif), Wnobj(Wn), stopObj(stop), p2(p2), eh(eh), nmax(nmax), flagW(flagW) {}
+	};
+
+	void init();
+	void doLaunch();
+
+        const std::string getKernelFile() const { return "reductions.cl"; }
+
+    private:
+	using Process::Process;
+
+	/// The kernel is launched as a single work group of this size
+	cl::NDRange localSize;
+};
+
+} // namespace OpenCLIPER
+
+#endif // EVOLUTIONSTOP_HPP
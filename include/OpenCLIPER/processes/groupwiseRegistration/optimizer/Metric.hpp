@@ -45,7 +45,7 @@ namespace OpenCLIPER {
 class Metric: public Process {
     public:
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
 
@@ -0,0 +1,68 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef PROJECTEDGRADIENTCOST_HPP
+#define PROJECTEDGRADIENTCOST_HPP
+
+#include <OpenCLIPER/Process.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Process class to compute the projected gradient cost (dH) for every control point in a single kernel launch.
+ *
+ * This is equivalent to launching AuxiliarMask, AuxiliarCost, Cost6DReduction and Cost6D for every (l,k) control point.
+ * Input is dV (the permuted gradient is expected as its second NDArray), output is dH.
+ */
+class ProjectedGradientCost: public Process {
+    public:
+	struct LaunchParameters: Process::LaunchParameters {
+	    std::shared_ptr<Data> maskData;
+	    std::shared_ptr<Data> coefg;
+
+	    LaunchParameters(std::shared_ptr<Data>& X, std::shared_ptr<Data>& coefg): maskData(X), coefg(coefg) {}
+	};
+
+	void init();
+	void doLaunch();
+
+        const std::string getKernelFile() const { return "optimizer.cl"; }
+
+    private:
+	using Process::Process;
+};
+
+} // namespace OpenCLIPER
+
+#endif // PROJECTEDGRADIENTCOST_HPP
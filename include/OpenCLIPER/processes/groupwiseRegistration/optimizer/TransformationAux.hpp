@@ -62,7 +62,7 @@ class TransformationAux: public Process {
 		coef(coef) {}
 	};
 
-	void launch();
+	void doLaunch();
 	void init();
 
         const std::string getKernelFile() const { return "optimizer.cl"; }
@@ -46,7 +46,7 @@ class Cost6DReduction: public Process {
     public:
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "reductions.cl"; }
 
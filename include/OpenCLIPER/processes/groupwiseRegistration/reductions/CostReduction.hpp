@@ -36,6 +36,7 @@
 
 #include <OpenCLIPER/Process.hpp>
 #include <OpenCLIPER/CLapp.hpp>
+#include <OpenCLIPER/processes/SumReduce.hpp>
 
 namespace OpenCLIPER {
 
@@ -53,12 +54,27 @@ class CostReduction: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
         const std::string getKernelFile() const { return "reductions.cl"; }
 
     private:
 	using Process::Process;
+
+	/// Number of elements in the metric array
+	index1DType realGlobalSize;
+	cl::NDRange globalSize;
+	cl::NDRange localSize;
+
+	index1DType nWorkgroups;
+
+	/// Partial sums of the first pass (one per work group)
+	std::shared_ptr<Data> partialOutputs;
+	/// Total cost of the current iteration
+	std::shared_ptr<Data> pTotalCost;
+	/// Successive passes (reduction of partialOutputs into pTotalCost)
+	std::shared_ptr<Process> pSumReduce;
 };
 
 } // namespace OpenCLIPER
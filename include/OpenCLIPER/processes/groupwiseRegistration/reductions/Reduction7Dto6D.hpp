@@ -53,7 +53,7 @@ class Reduction7Dto6D: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "reductions.cl"; }
 
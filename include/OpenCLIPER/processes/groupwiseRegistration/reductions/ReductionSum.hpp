@@ -51,7 +51,7 @@ class ReductionSum: public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "reductions.cl"; }
 
@@ -50,8 +50,8 @@
 #include <OpenCLIPER/processes/GroupwiseRegistration.hpp>
 #include <OpenCLIPER/processes/MotionCompensation.hpp>
 #include <OpenCLIPER/processes/AdjointMotionCompensation.hpp>
-#include <OpenCLIPER/processes/ComplexAbsPow2.hpp>
-#include <OpenCLIPER/processes/ComplexAbs.hpp>
+#include <OpenCLIPER/processes/nesta/NestaUpdate.hpp>
+#include <OpenCLIPER/processes/MinMaxReduce.hpp>
 #include <clblast_c.h>
 #include <algorithm>
 
@@ -83,7 +83,8 @@ class NestaUp : public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
+	void setCommandQueue(const cl::CommandQueue& cq);
 
     private:
 	// We need to create subprocesses, so can't just inherit out parent class' constructors
@@ -113,10 +114,11 @@ class NestaUp : public Process {
 	std::shared_ptr<Process> pMotionCompensation;
 	std::shared_ptr<Process> pAdjointMotionCompensation;
 	std::shared_ptr<Process> pCopy;
-	std::shared_ptr<Process> pComplexAbsPow2;
-	std::shared_ptr<Process> pComplexAbs;
+	std::shared_ptr<Process> pNestaUpdate;
+	std::shared_ptr<Process> pMaxReduce;
 
 	std::shared_ptr<Data> pAuxFFT;
+	std::shared_ptr<Data> pMaxData;
 };
 
 } // namespace OpenCLIPER
@@ -0,0 +1,106 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#ifndef NESTAUPDATE_HPP
+#define NESTAUPDATE_HPP
+
+#include <OpenCLIPER/Process.hpp>
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Process class to apply the vector updates of a NESTA iteration in a single pass per vector
+ *
+ * The update to apply is selected by the type of the LaunchParameters object:
+ * - ResidualParameters: res = input * scale - b, output = res * rescale, sum |res|^2 to sumBuffer (input: A(xk), output: residual for A')
+ * - YkParameters: df = input * dfScale + aRes, output = xk - Lmu1 * df (input: df, output: yk)
+ * - ZkParameters: wk += apk * df, output = tauk * (xref - Lmu1 * wk) + (1 - tauk) * yk (input: df, output: xk)
+ */
+class NestaUpdate : public Process {
+    public:
+	struct ResidualParameters: Process::LaunchParameters {
+	    std::shared_ptr<Data> b;
+	    cl_float scale;
+	    cl_float rescale;
+	    cl::Buffer sumBuffer;
+
+	    ResidualParameters(const std::shared_ptr<Data>& b, cl_float scale, cl_float rescale, const cl::Buffer& sumBuffer):
+		b(b), scale(scale), rescale(rescale), sumBuffer(sumBuffer) {}
+	};
+
+	struct YkParameters: Process::LaunchParameters {
+	    std::shared_ptr<Data> aRes;
+	    std::shared_ptr<Data> xk;
+	    cl_float dfScale;
+	    cl_float Lmu1;
+
+	    YkParameters(const std::shared_ptr<Data>& aRes, const std::shared_ptr<Data>& xk, cl_float dfScale, cl_float Lmu1):
+		aRes(aRes), xk(xk), dfScale(dfScale), Lmu1(Lmu1) {}
+	};
+
+	struct ZkParameters: Process::LaunchParameters {
+	    std::shared_ptr<Data> wk;
+	    std::shared_ptr<Data> xref;
+	    std::shared_ptr<Data> yk;
+	    cl_float apk;
+	    cl_float Lmu1;
+	    cl_float tauk;
+
+	    ZkParameters(const std::shared_ptr<Data>& wk, const std::shared_ptr<Data>& xref, const std::shared_ptr<Data>& yk, cl_float apk, cl_float Lmu1, cl_float tauk):
+		wk(wk), xref(xref), yk(yk), apk(apk), Lmu1(Lmu1), tauk(tauk) {}
+	};
+
+	void init();
+	void doLaunch();
+
+        const std::string getKernelFile() const { return "nestaUpdate.cl"; }
+
+    private:
+	using Process::Process;
+
+	index1DType numElements(const std::shared_ptr<Data>& pData);
+
+	cl::Kernel residualKernel;
+	cl::Kernel sumKernel;
+	cl::Kernel ykKernel;
+	cl::Kernel zkKernel;
+
+	/// Partial sums of the residual (one per work group)
+	cl::Buffer partialSums;
+	cl::NDRange reductionLocalSize;
+	cl_uint maxReductionGroups = 256;
+};
+
+} // namespace OpenCLIPER
+
+#endif // NESTAUPDATE_HPP
@@ -52,7 +52,7 @@ class VectorNormalization : public Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "vectorNormalization.cl"; }
 
@@ -63,7 +63,7 @@ class ArrayAddProcess : public OpenCLIPER::Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
 
         const std::string getKernelFile() const { return "performanceTests/arrayAdd.cl"; }
 };
@@ -64,7 +64,7 @@ class ArrayMultProcess : public OpenCLIPER::Process {
 	};
 
 	void init();
-	void launch();
+	void doLaunch();
   
         const std::string getKernelFile() const { return "performanceTests/arrayMult.cl"; }
 };
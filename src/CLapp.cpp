@@ -37,10 +37,19 @@
 #include <string>
 #include <map>
 #include <functional>
+#include <algorithm>
+#include <iomanip>
+#include <regex>
+#include <thread>
+#include <future>
+#include <cerrno>
+#include <sys/stat.h>
 #include <OpenCLIPER/DeviceDataProperties.hpp>
 #include <OpenCLIPER/CLapp.hpp>
 #include <OpenCLIPER/Data.hpp>
 #include <OpenCLIPER/Process.hpp>
+#include <OpenCLIPER/FFTPlanCache.hpp>
+#include <OpenCLIPER/DeviceBufferPool.hpp>
 #include <OpenCLIPER/processes/Complex2Real.hpp>
 #include <LPISupport/ProgramConfig.hpp>
 
@@ -71,6 +80,19 @@ cl_int __wrap_clEnqueueNDRangeKernel(cl_command_queue command_queue, cl_kernel k
 // We need a mutex to protect the CLapp::dataMap structure (std::map is not thread-safe)
 std::mutex dataMapMutex;
 
+// Protects lazy creation of the FFT plan cache
+std::mutex fftPlanCacheMutex;
+
+// Protects lazy creation of the device buffer pool
+std::mutex deviceBufferPoolMutex;
+
+// Protects the CLapp::specializedPrograms map
+std::mutex specializedProgramsMutex;
+
+// Protects the CLapp::kernels and CLapp::kernelFiles maps, which lazy kernel loading modifies from getKernel() (recursive,
+// as getKernel() and addKernelFile() may end up calling loadKernels())
+std::recursive_mutex kernelsMutex;
+
 namespace OpenCLIPER {
 
 /// Map with OpenCL error number as keys and strings describing errors as values
@@ -163,6 +185,18 @@ CLapp::~CLapp() {
 
     dataMap.erase(dataMap.begin(), dataMap.end());
 
+    // Plans must be released while the context is still alive
+    fftPlanCache = nullptr;
+
+#ifdef CLAPP_DEBUG
+    if(deviceBufferPool) {
+	auto stats = deviceBufferPool->getStats();
+	std::cerr << "Device buffer pool: " << stats.requests << " requests, hit rate " << stats.hitRate() << ", peak footprint "
+		  << stats.peakAllocatedBytes << " bytes" << std::endl;
+    }
+#endif
+    deviceBufferPool = nullptr;
+
 #ifdef CLAPP_DEBUG
     std::cerr<<"Done" << std::endl;
     dataMapSize = dataMap.size();
@@ -484,8 +518,9 @@ void CLapp::init(const PlatformTraits& platformTraits, const DeviceTraits& devic
     // Each different combination of platform, platform version, device, device version and driver version must yield a different hash for cached kernels.
     // Precompute the common part here
     auto p = cl::Platform(platform);
-    deviceStrings.push_back(p.getInfo<CL_PLATFORM_NAME>() + "/" + p.getInfo<CL_PLATFORM_VERSION>() + "/" + devices[0].getInfo<CL_DEVICE_NAME>() + "/" +
-			    devices[0].getInfo<CL_DEVICE_VERSION>() + "/" + devices[0].getInfo<CL_DRIVER_VERSION>() + "/");
+    for(auto&& d: devices)
+	deviceStrings.push_back(p.getInfo<CL_PLATFORM_NAME>() + "/" + p.getInfo<CL_PLATFORM_VERSION>() + "/" + d.getInfo<CL_DEVICE_NAME>() + "/" +
+				d.getInfo<CL_DEVICE_VERSION>() + "/" + d.getInfo<CL_DRIVER_VERSION>() + "/");
 
     // Try to get PCIe bus id for the chosen device so that we can choose the same device for HIP.
     // There is no C++ wrapper for these calls, so use the C API
@@ -559,13 +594,17 @@ void CLapp::init(const PlatformTraits& platformTraits, const DeviceTraits& devic
 
 
     //----------------------------------------------------------------------------------------
-    // 4. Create a CL context for all the selected devices and a command queue in each of them
+    // 4. Create a CL context for all the selected devices and a pool of command queues in each of them
     //----------------------------------------------------------------------------------------
     context = cl::Context(devices); //,nullptr,nullptr,nullptr,&err);
 
     const auto& constDevices = devices;
-    for(auto&& i : constDevices)
-	commandQueues.push_back(cl::CommandQueue(context, i, deviceTraits.queueProperties));
+    for(auto&& i : constDevices) {
+	std::vector<cl::CommandQueue> deviceQueues;
+	for(unsigned q = 0; q < std::max(deviceTraits.queuesPerDevice, 1u); q++)
+	    deviceQueues.push_back(cl::CommandQueue(context, i, deviceTraits.queueProperties));
+	commandQueues.push_back(deviceQueues);
+    }
 }
 
 
@@ -575,11 +614,16 @@ void CLapp::init(const PlatformTraits& platformTraits, const DeviceTraits& devic
 * @return reference to selected kernel
 */
 cl::Kernel& CLapp::getKernel(const size_t i) {
+    const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
     if(!kernelsLoaded) {
 	CERR("Automatically loading kernels at first getKernel() call\n");
 	loadKernels();
     }
 
+    // Kernel indexes refer to the full list of kernels
+    if(lazyKernelLoading)
+	loadKernelFiles();
+
     KernelList::iterator j(kernels.begin());
     std::advance(j, i);
     if(j != kernels.end())
@@ -599,12 +643,17 @@ cl::Kernel& CLapp::getKernel(const size_t i) {
  */
 cl::Kernel&
 CLapp::getKernel(const std::string& name) {
+    const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
     if(!kernelsLoaded) {
 	CERR("Automatically loading kernels at first getKernel() call\n");
 	loadKernels();
     }
 
     KernelList::iterator j(kernels.find(name));
+    if((j == kernels.end()) && lazyKernelLoading) {
+	loadKernelFiles(name);
+	j = kernels.find(name);
+    }
     if(j != kernels.end())
 	return j->second.kernel;
     else {
@@ -620,10 +669,11 @@ CLapp::getKernel(const std::string& name) {
 void CLapp::addKernelFile(const std::string& sourceFile) {
     // Processes without a kernel will report an empty string as their kernel file
     if(!sourceFile.empty()) {
+        const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
         if(!kernelFiles.count(sourceFile)) {
             kernelFiles.insert({sourceFile, KernelFileProperties()});
 
-            if(kernelsLoaded) {
+            if(kernelsLoaded && !lazyKernelLoading) {
                 std::cerr << "Warning: forcing extra kernel load due to new kernel file [" << sourceFile << "] added after loadKernels(). This will stall the queue!\n";
                 loadKernels();
             }
@@ -640,11 +690,62 @@ void CLapp::addKernelDir(const std::string& kernelDir) {
     kernelDirs.insert(kernelDir);
 }
 
+/**
+ * @brief Composes the options passed to the CL compiler for every program
+ * @param[in] compilerOptionsArg extra compiler options (may be null)
+ * @return compiler options
+ */
+const std::string CLapp::getCompilerOptions(const char* compilerOptionsArg) {
+    // Add include path to compiler options
+    std::string compilerOptions;
+    compilerOptions.append("-I " KERNEL_INCLUDE_DIR);
+
+#ifdef USE_INDEX64
+    // Kernels must read dimensions and strides arrays with the same index width the host writes them
+    compilerOptions.append(" -DUSE_INDEX64");
+#endif
+
+#ifdef NDEBUG
+    // Add fast math option to compiler options in release mode. Note: this enables optimizations that are unsafe if math arguments and results
+    // are not valid (e.g. inf or nan)
+    compilerOptions.append(" -cl-fast-relaxed-math");
+#endif
+    if(compilerOptionsArg != nullptr) {
+	// A space must be added to separate options
+	compilerOptions.append(" ");
+	compilerOptions.append(compilerOptionsArg);
+    }
+    return compilerOptions;
+}
+
 /**
  * @brief Loads kernels for currently existing processes
+ *
+ * In lazy mode (see setLazyKernelLoading()) this just stores the compiler options: every kernel file will be built by
+ * getKernel() when one of its kernels is first needed.
  * @param[in] compilerOptionsArg text string with compiler options
  */
 void CLapp::loadKernels(const char* compilerOptionsArg) {
+    const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
+    kernelCompilerOptions = getCompilerOptions(compilerOptionsArg);
+
+    if(lazyKernelLoading)
+	kernelsLoaded = true;
+    else
+	loadKernelFiles();
+}
+
+/**
+ * @brief Builds pending kernel files and adds their kernels to the list of kernels
+ *
+ * Every kernel file is built together with the extra source files (host/kernel functions) into its own program, which is
+ * taken from the kernel cache if possible (see loadProgram()). Programs are built concurrently.
+ * @param[in] kernelName if not empty, only the kernel file declaring this kernel is built (or every pending file, if no
+ * file declares it in a way declaresKernel() recognizes)
+ */
+void CLapp::loadKernelFiles(const std::string& kernelName) {
+    const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
+
     // Measure kernel load/compilation times starting now
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -669,21 +770,6 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
 	return;
     }
 
-    // Add include path to compiler options
-    std::string compilerOptions;
-    compilerOptions.append("-I " KERNEL_INCLUDE_DIR);
-
-#ifdef NDEBUG
-    // Add fast math option to compiler options in release mode. Note: this enables optimizations that are unsafe if math arguments and results
-    // are not valid (e.g. inf or nan)
-    compilerOptions.append(" -cl-fast-relaxed-math");
-#endif
-    if(compilerOptionsArg != nullptr) {
-	// A space must be added to separate options
-	compilerOptions.append(" ");
-	compilerOptions.append(compilerOptionsArg);
-    }
-
     // The implementation of common header files must be compiled together with every kernel file given by the user.
     // Add any such files here (for now, we only need the host/kernel functions file)
     std::vector<std::string> extraSourceFiles;
@@ -711,7 +797,7 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
     if(home)
 	kernelPaths.insert(std::string(home) + "/" KERNEL_USER_DIR "/");
     else
-	std::cerr<<"No $HOME environment variable. Can't use kernel cache\n";
+	std::cerr<<"No $HOME environment variable. Can't use user kernel cache\n";
 
     // Add compile-time kernel dir
     kernelPaths.insert(KERNEL_SOURCE_DIR "/");
@@ -719,388 +805,69 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
     //////////////////////////////////////////////////////////////
     // Look for extra source files and store their full path names
     //////////////////////////////////////////////////////////////
-    time_t extraFilesTimestamp = 0;
-    bool allExtraFilesFound = true;
-
     for(auto&& file: extraSourceFiles) {
-	struct stat statBuf;
-	bool thisFileFound = false;
-
-	// If we are given a full pathname, we don't have to iterate through a list of possible locations
-	if(file[0] == '/') {
-	    if(::stat(file.c_str(), &statBuf) == 0) {
-		thisFileFound = true;
-
-		// Set extra files' timestamp to that of the most recent file
-		if(statBuf.st_mtim.tv_sec > extraFilesTimestamp)
-		    extraFilesTimestamp = statBuf.st_mtim.tv_sec;
-	    }
-	}
-
-	// If file is a bare file name, iterate through all possible locations
-	else {
-	    for(auto&& dir: kernelPaths) {
-		std::string path = dir + file;
-
-		if(::stat(path.c_str(), &statBuf) == 0) {
-		    thisFileFound = true;
-
-		    // Substitute bare file name with its full path
-		    file = path;
-
-		    // Set extra files' timestamp to that of the most recent file
-		    if(statBuf.st_mtim.tv_sec > extraFilesTimestamp)
-			extraFilesTimestamp = statBuf.st_mtim.tv_sec;
-		}
-	    }
-	}
-
-	if(!thisFileFound) {
-	    allExtraFilesFound = false;
-
-#ifdef CLAPP_DEBUG
+	std::string path = findSourceFile(file, kernelPaths);
+	if(path.empty()) {
 	    std::ostringstream s;
-	    s << "Couldn't find extra source file [" << file << "]\n";
-	    s << "Paths tried: [";
-	    auto j = kernelPaths.begin();
-	    s << *j;
-	    ++j;
-	    while (j != kernelPaths.end()) {
-		s << ',' << *j;
-		j++;
-	    }
-	    s << "]\n";
-	    std::cerr << s.str();
-#endif
+	    s << "Couldn't find needed source file [" << file << "]\n";
+	    BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
 	}
+	file = path;
     }
+    extraSourcePaths = extraSourceFiles;
 
     /////////////////////////////////////////////////////////////////////////////////////////
-    // Iterate through kernel files given by the user.
-    // Use a cached version if available and up to date; compile and store in cache otherwise
+    // Look for kernel files given by the user (in lazy mode, keep only the one we need)
     /////////////////////////////////////////////////////////////////////////////////////////
-    cl::Program::Sources sources;
-    bool extraSourceFilesLoaded = false;
-    size_t totalLoadedKernels = 0;
-
-    // Some CL compilers (read: AMD) generate _s_l_o_w_ code if all sources are compiled together.
-    // Whatever the reason, let's compile each source file on its own (together with host/kernel functions)
+    std::vector<KernelFileList::value_type> filesToBuild;
     for(auto&& currentFile: pendingKernelFiles) {
-	std::unique_ptr<cl::Program> program;
-	std::string cacheFile, cacheSubdir;
-
-        ///////////////////////////////////////////////////////////
-        // Look for a previously cached version of this kernel file
-        ///////////////////////////////////////////////////////////
-        bool cacheFileFound = false;
-	time_t cacheFileTimestamp = 0;
-	size_t cacheFileSize;
-
-	if(home) {
-	    // Compose file name for the cached version of this kernel file
-	    std::stringstream s;
-	    s << std::hex << std::hash<std::string>{}(deviceStrings[0] + currentFile.first);
-	    cacheSubdir = std::string(KERNEL_USER_DIR "/cache/") + s.str()[0] + "/" + s.str()[1];
-	    cacheFile = std::string(home) + "/" + cacheSubdir + "/" + s.str().substr(2);
-
-	    // Get timestamp of cached kernel file (or 0 otherwise)
-	    struct stat statBuf;
-	    if(::stat(cacheFile.c_str(), &statBuf) == 0) {
-		cacheFileFound = true;
-		cacheFileTimestamp = statBuf.st_mtim.tv_sec;
-		cacheFileSize = statBuf.st_size;
-	    }
-	    else
-		CLAPP_CERR("Cached version of kernel file " << currentFile.first << " (" << cacheFile << ") not found\n");
-	}
-
-
-        ///////////////////////////////////////////////////////////
-        // Look for the kernel file itself (i.e. source code)
-        ///////////////////////////////////////////////////////////
-	bool sourceFileFound = false;
-	time_t sourceFileTimestamp = 0;
-	struct stat statBuf;
-
-	// If we are given a full pathname, we don't have to iterate through a list of possible locations
-	if(currentFile.first[0] == '/') {
-	    if(::stat(currentFile.first.c_str(), &statBuf) == 0) {
-		sourceFileFound = true;
-		sourceFileTimestamp = statBuf.st_mtim.tv_sec;
-
-		// Store full path of found kernel file
-		currentFile.second.sourcePath = currentFile.first;
-	    }
-	    else {
-                CLAPP_CERR("Couldn't find source file [" << currentFile.first << "]\n");
-	    }
-	}
-
-	// If file is a bare file name, iterate through all possible locations
-	else {
-	    for(auto dir = kernelPaths.begin(); dir != kernelPaths.end() && !sourceFileFound; dir++) {
-		std::string path = *dir + currentFile.first;
-
-		int err;
-		if((err=::stat(path.c_str(), &statBuf)) == 0) {
-		    sourceFileFound = true;
-		    sourceFileTimestamp = statBuf.st_mtim.tv_sec;
-
-		    // Store full path of found kernel file
-		    currentFile.second.sourcePath = path;
-		}
-	    }
-#ifdef CLAPP_DEBUG
-	    if(!sourceFileFound) {
-		std::ostringstream s;
-		s << "Couldn't find source file [" << currentFile.first << "]\n";
-		s << "Paths tried: [";
-		auto j = kernelPaths.begin();
-		s << *j;
-		++j;
-		while (j != kernelPaths.end()) {
-		    s << ',' << *j;
-		    j++;
-		}
-		s << "]\n";
-		std::cerr << s.str();
-	    }
-#endif
-	}
-
-        /////////////////////////////////////////////////////////////////
-        // Decide between loading cached version or compiling from source
-        /////////////////////////////////////////////////////////////////
-	if(cacheFileFound && (cacheFileTimestamp >= sourceFileTimestamp) && (cacheFileTimestamp >= extraFilesTimestamp)) {
-	    /////////////////////////////////////////////////////////////////
-	    // Load cached version
-	    /////////////////////////////////////////////////////////////////
-	    cl::Program::Binaries binaries;
-	    std::ifstream f;
-
-	    f.open(cacheFile, std::ios::in | std::ios::binary);
-	    if(f.is_open()) {
-		// cl::Program::Binaries is a vector<vector<unsigned char>>
-		auto buffer = new std::vector<unsigned char>(cacheFileSize);
-		f.read((char*) buffer->data(), cacheFileSize);
-		f.close();
-
-		binaries.clear();
-		binaries.push_back(*buffer);
-		delete(buffer);
-	    }
-	    else {
-		std::ostringstream s;
-		s << "Couldn't open cached kernel file [" << cacheFile << "]\n";
-		BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
-	    }
-
-	    // Create a program from cached binaries
-	    program = std::unique_ptr<cl::Program>(new cl::Program(context, devices, binaries));
-
-            /////////////////////////////////////////////////////////////////
-	    // Build program from cached binaries
-	    /////////////////////////////////////////////////////////////////
-#ifndef NDEBUG
-	    {
-		auto i = devices.begin();
-		std::cerr << "Building CL program for devices [" << i->getInfo<CL_DEVICE_NAME>();
-		++i;
-		while(i != devices.end()) {
-		    std::cerr << ',' << i->getInfo<CL_DEVICE_NAME>();
-		    ++i;
-		}
-		std::cerr << "] from cached binaries\n";
-	    }
-#endif
-
-	    try {
-		//Warning: AMD CL compiler may crash if using CL2.0 features in CL1.x compiler mode!
-		//Don't forget to pass -cl-std=CL2.0 in compilerOptions if using CL2.0 features.
-		program->build(devices, compilerOptions.c_str());
-
-#ifndef NDEBUG
-		// Always show compilation log in debug mode
-		{
-		    std::string buildLog;
-		    for(auto&& i: devices) {
-			buildLog = program->getBuildInfo<CL_PROGRAM_BUILD_LOG>(i);
-			std::cerr << "Build log for device " << i.getInfo<CL_DEVICE_NAME>() << ":";
-			if(!buildLog.empty()) {
-			    std::cerr << "\n----------------------------------------------------------------------\n"
-				    << buildLog << '\n'
-				    << "----------------------------------------------------------------------\n"
-				    << "\n\n";
-			}
-			else
-			    std::cerr << " <empty>\n";
-		    }
-		}
-#endif
-	    }
-	    catch(cl::BuildError& err) {
-		// Do we still need to do anything useful here?
-		throw;
-	    }
+	currentFile.second.sourcePath = findSourceFile(currentFile.first, kernelPaths);
+	if(currentFile.second.sourcePath.empty()) {
+	    std::ostringstream s;
+	    s << "Couldn't find needed source file [" << currentFile.first << "]\n";
+	    BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
 	}
-	else if(sourceFileFound && allExtraFilesFound) {
-	    /////////////////////////////////////////////////////////////////
-	    // Compile from source and store cached version
-	    // Each compilation unit is made of the user specified kernel files plus all common extra files
-	    /////////////////////////////////////////////////////////////////
-	    std::ifstream f;
-	    std::ostringstream currentFileBuffer;
-
-	    // Load extra source files (if not already loaded) and store them in sources
-	    if(!extraSourceFilesLoaded) {
-		std::ostringstream extraFilesBuffer;
-		for(auto&& i: extraSourceFiles) {
-		    f.open(i.c_str(), std::ios::in | std::ios::binary);
-		    if(f.is_open()) {
-			extraFilesBuffer.str() = "";
-			extraFilesBuffer << f.rdbuf();
-			sources.push_back(extraFilesBuffer.str());
-			f.close();
-		    }
-		    else {
-			std::ostringstream s;
-			s << "Couldn't open needed source file [" << i.c_str() << "]\n";
-			BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
-		    }
-		}
-		extraSourceFilesLoaded = true;
-	    }
-
-	    // Load current kernel file and append it to sources
-	    f.open(currentFile.second.sourcePath, std::ios::in | std::ios::binary);
-	    if(f.is_open()) {
-		currentFileBuffer.str() = "";
-		currentFileBuffer << f.rdbuf();
-		sources.push_back(currentFileBuffer.str());
-		f.close();
-	    }
-	    else {
-		std::ostringstream s;
-		s << "Couldn't open needed source file [" << currentFile.first << "]\n";
-		BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
-	    }
 
-	    // Create a program from kernel file + extra sources
-	    program = std::unique_ptr<cl::Program>(new cl::Program(context, sources));
-
-	    // Pop kernel file away from sources, so only extra sources remain
-	    sources.pop_back();
-
-            /////////////////////////////////////////////////////////////////
-	    // Build program from sources
-	    /////////////////////////////////////////////////////////////////
-#ifndef NDEBUG
-	    {
-		auto i = devices.begin();
-		std::cerr << "Building CL program for devices [" << i->getInfo<CL_DEVICE_NAME>();
-		++i;
-		while(i != devices.end()) {
-		    std::cerr << ',' << i->getInfo<CL_DEVICE_NAME>();
-		    ++i;
-		}
-		std::cerr << "]...\n";
-	    }
-
-	    {
-		std::cerr << " from source file(s) [";
-		for(auto&& i: extraSourceFiles)
-		    std::cerr << i << ',';
-		std::cerr << currentFile.second.sourcePath << "]\n";
-	    }
-#endif
+	if(kernelName.empty() || declaresKernel(currentFile.second.sourcePath, kernelName))
+	    filesToBuild.push_back(currentFile);
+    }
 
-	    try {
-		//Warning: AMD CL compiler may crash if using CL2.0 features in CL1.x compiler mode!
-		//Don't forget to pass -cl-std=CL2.0 in compilerOptions if using CL2.0 features.
-		program->build(devices, compilerOptions.c_str());
+    // Kernels whose names are generated by macros (e.g. reduce_##NAME in internalKernels.cl) are not found by
+    // declaresKernel(). Build every pending file then, so that getKernel() only fails if the kernel really doesn't exist
+    if(!kernelName.empty() && filesToBuild.empty()) {
+	CLAPP_CERR("loadKernels: no pending kernel file declares kernel \"" << kernelName << "\". Building all of them\n");
+	for(auto&& currentFile: pendingKernelFiles)
+	    filesToBuild.push_back(currentFile);
+    }
 
-#ifndef NDEBUG
-		// Always show compilation log in debug mode
-		{
-		    std::string buildLog;
-		    for(auto&& i: devices) {
-			buildLog = program->getBuildInfo<CL_PROGRAM_BUILD_LOG>(i);
-			std::cerr << "Build log for device " << i.getInfo<CL_DEVICE_NAME>() << ":";
-			if(!buildLog.empty()) {
-			    std::cerr << "\n----------------------------------------------------------------------\n"
-				    << buildLog << '\n'
-				    << "----------------------------------------------------------------------\n"
-				    << "\n\n";
-			}
-			else
-			    std::cerr << " <empty>\n";
-		    }
-		}
-#endif
-	    }
-	    catch(cl::BuildError& err) {
-		// Do we still need to do anything useful here?
-		throw;
-	    }
+    /////////////////////////////////////////////////////////////////////////////////////////
+    // Build programs concurrently. Use a cached version if available; compile and store in cache otherwise
+    /////////////////////////////////////////////////////////////////////////////////////////
 
-            /////////////////////////////////////////////////////////////////
-	    // Save built program in the cache
-	    /////////////////////////////////////////////////////////////////
-	    if(home) {
-		// Check for existent cache directories and create them if necessary
-		struct stat statBuf;
-		int err = 0;
-		unsigned slashPos = 0;
-		while(slashPos < cacheSubdir.size()) {
-		    slashPos = cacheSubdir.find('/', slashPos + 1);
-		    auto dir = std::string(home) + "/" + cacheSubdir.substr(0, slashPos);
-
-		    if((::stat(dir.c_str(), &statBuf)) == -1) {
-			if(errno == ENOENT)
-			    err |= ::mkdir(dir.c_str(), 0755);
-			else
-			    err |= 1;	// If ::stat returned any other error than ENOENT, force a nonzero err so we show the appropriate error message (below)
-		    }
-		}
+    // Some CL compilers (read: AMD) generate _s_l_o_w_ code if all sources are compiled together.
+    // Whatever the reason, let's compile each source file on its own (together with host/kernel functions).
+    // Programs are independent from each other and most CL compilers are single threaded, so build them all at once
+    std::vector<std::future<cl::Program>> builds;
+    for(auto&& currentFile: filesToBuild) {
+	std::vector<std::string> sourcePaths(extraSourcePaths);
+	sourcePaths.push_back(currentFile.second.sourcePath);
+	builds.push_back(std::async(std::launch::async, &CLapp::loadProgram, this, sourcePaths, kernelCompilerOptions));
+    }
 
-		// Get program binaries and write them to a file
-		if(err == 0) {
-		    // A program was built for every requested device. compiledPrograms is a vector of char* (one pointer per device)
-		    auto compiledPrograms = program->getInfo<CL_PROGRAM_BINARIES>();
-		    auto compiledProgramsLen = program->getInfo<CL_PROGRAM_BINARY_SIZES>();
-
-		    // We only deal with one device for now. Save only first returned binary
-		    std::ofstream f;
-			f.open(cacheFile.c_str(), std::ios::out | std::ios::binary);
-			if(f.is_open()) {
-			    f.write(reinterpret_cast<char*>(compiledPrograms[0].data()), compiledProgramsLen[0]);
-			    f.close();
-			    CLAPP_CERR("Wrote kernel cache file " << cacheFile << "\n");
-			}
-			else {
-			    std::cerr << "Couldn't write cache file " << cacheFile << "\n";
-			}
-		}
-		else
-		    std::cerr << "Error creating cache directories. Not generating kernel cache files\n";
-	    }
-	    else {
-		// The user has already been warned if the HOME environment variable does not exist
-	    }
-	}
-	else {
-	    std::ostringstream s;
-	    s << "Couldn't find needed source file [" << currentFile.first << "] (or any dependencies) or a valid cached version\n";
-	    BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadKernels");
-	}
+    /////////////////////////////////////////////////////////////////////////////////////////
+    // Gather kernels from built programs, in file order
+    /////////////////////////////////////////////////////////////////////////////////////////
+    size_t totalLoadedKernels = 0;
 
+    for(size_t buildIndex = 0; buildIndex < builds.size(); buildIndex++) {
+	auto& currentFile = filesToBuild[buildIndex];
+	cl::Program program = builds[buildIndex].get();
 
 	/////////////////////////////////////////////////////////////////
 	// Create kernels from built program
 	/////////////////////////////////////////////////////////////////
         std::vector<cl::Kernel> programKernels;
-        program->createKernels(&programKernels);
-        //programs.push_back(program);
+        program.createKernels(&programKernels);
 
         // Only add compiled kernels to our list if they don't exist already (warn the user otherwise)
         std::set<std::string> loadedKernels;
@@ -1110,6 +877,7 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
             i.getInfo(CL_KERNEL_FUNCTION_NAME, &kernelName);
             if(!kernels.count(kernelName)) {
                 kernels[kernelName].kernel = i;
+                kernels[kernelName].sourceFile = currentFile.first;
                 loadedKernels.insert(kernelName);
 		++totalLoadedKernels;
             }
@@ -1134,6 +902,7 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
 
         // Don't recompile this source file in subsequent calls to loadKernels
         kernelFiles[currentFile.first].loaded = true;
+        kernelFiles[currentFile.first].sourcePath = currentFile.second.sourcePath;
     }
 
     // After first execution of loadKernels, subsequent calls to addKernelFile will trigger a warning about possible queue stalls
@@ -1146,6 +915,424 @@ void CLapp::loadKernels(const char* compilerOptionsArg) {
 
 }
 
+/**
+ * @brief Checks whether a kernel source file declares a kernel (without building it)
+ * @param[in] sourcePath full path name of the source file
+ * @param[in] kernelName name of the kernel
+ * @return true if the source file declares a kernel with that name
+ */
+bool CLapp::declaresKernel(const std::string& sourcePath, const std::string& kernelName) {
+    std::ifstream f(sourcePath, std::ios::in | std::ios::binary);
+    std::ostringstream buffer;
+    buffer << f.rdbuf();
+
+    const std::regex kernelRegex("\\b(__)?kernel\\s+void\\s+" + kernelName + "\\s*\\(");
+    return std::regex_search(buffer.str(), kernelRegex);
+}
+
+/**
+ * @brief Looks for a kernel source file
+ * @param[in] file full path name or bare file name of the source file
+ * @param[in] kernelPaths directories (with a trailing slash) where to look for bare file names, in order
+ * @return full path name of the source file, or an empty string if not found
+ */
+const std::string CLapp::findSourceFile(const std::string& file, const KernelPathList& kernelPaths) {
+    struct stat statBuf;
+
+    // If we are given a full pathname, we don't have to iterate through a list of possible locations
+    if(file[0] == '/')
+	return (::stat(file.c_str(), &statBuf) == 0) ? file : std::string();
+
+    // If file is a bare file name, iterate through all possible locations
+    for(auto&& dir: kernelPaths) {
+	std::string path = dir + file;
+	if(::stat(path.c_str(), &statBuf) == 0)
+	    return path;
+    }
+
+#ifdef CLAPP_DEBUG
+    std::ostringstream s;
+    s << "Couldn't find source file [" << file << "]\n";
+    s << "Paths tried: [";
+    for(auto&& dir: kernelPaths)
+	s << dir << ',';
+    s << "]\n";
+    std::cerr << s.str();
+#endif
+    return std::string();
+}
+
+/**
+ * @brief Gets a program built from some source files for all devices of this CLapp, using the kernel cache if possible.
+ *
+ * Cached programs are keyed by a hash of the sources (including every header they include from their own directory or from
+ * KERNEL_INCLUDE_DIR), the compiler options and the platform, device and driver of every device, so file timestamps play no
+ * part in deciding whether a cached program is valid. Programs are looked for first in the user's cache
+ * ($HOME/KERNEL_USER_DIR/cache) and then in the system-wide cache (KERNEL_SYSTEM_CACHE_DIR). The latter is never written to;
+ * it can be populated by copying a user's cache to it. Programs built from source are stored in the user's cache.
+ * @param[in] sourcePaths full path names of the source files, in compilation order
+ * @param[in] compilerOptions compiler options
+ * @return the built program
+ */
+cl::Program CLapp::loadProgram(const std::vector<std::string>& sourcePaths, const std::string& compilerOptions) {
+    /////////////////////////////////////////////////////////////////
+    // Load sources and compute cache key
+    /////////////////////////////////////////////////////////////////
+    cl::Program::Sources sources;
+    std::set<std::string> hashedFiles;
+    uint64_t hash = hashString(compilerOptions);
+    for(auto&& i: deviceStrings)
+	hash = hashString(i, hash);
+
+    for(auto&& path: sourcePaths) {
+	std::ifstream f(path, std::ios::in | std::ios::binary);
+	if(!f.is_open()) {
+	    std::ostringstream s;
+	    s << "Couldn't open needed source file [" << path << "]\n";
+	    BTTHROW(CLError(CL_BUILD_PROGRAM_FAILURE, s.str()), "CLapp::loadProgram");
+	}
+	std::ostringstream buffer;
+	buffer << f.rdbuf();
+	sources.push_back(buffer.str());
+	hash = hashString(sources.back(), hash);
+	hash = hashIncludes(sources.back(), path.substr(0, path.rfind('/') + 1), hashedFiles, hash);
+    }
+
+    std::ostringstream s;
+    s << std::hex << std::setw(16) << std::setfill('0') << hash;
+    const std::string key = s.str();
+    const std::string cacheSubpath = std::string("/") + key[0] + "/" + key[1] + "/" + key.substr(2);
+
+    std::vector<std::string> cacheDirs;
+    char* home = getenv("HOME");
+    if(home)
+	cacheDirs.push_back(std::string(home) + "/" KERNEL_USER_DIR "/cache");
+    cacheDirs.push_back(KERNEL_SYSTEM_CACHE_DIR);
+
+    /////////////////////////////////////////////////////////////////
+    // Build program from cached binaries if available
+    /////////////////////////////////////////////////////////////////
+    for(auto&& dir: cacheDirs) {
+	cl::Program::Binaries binaries;
+	const std::string cacheFile = dir + cacheSubpath;
+	if(readProgramBinaries(cacheFile, binaries) && (binaries.size() == devices.size())) {
+	    try {
+		cl::Program program(context, devices, binaries);
+		program.build(devices, compilerOptions.c_str());
+		CLAPP_CERR("Built program for [" << sourcePaths.back() << "] from cached binaries " << cacheFile << "\n");
+		return program;
+	    }
+	    catch(cl::Error& err) {
+		// A damaged cache file is not fatal: try the next cache or the sources
+		std::cerr << "Ignoring unusable cached kernel file " << cacheFile << "\n";
+	    }
+	}
+	else
+	    CLAPP_CERR("Cached version of kernel file " << sourcePaths.back() << " (" << cacheFile << ") not found\n");
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // Build program from sources
+    /////////////////////////////////////////////////////////////////
+#ifndef NDEBUG
+    {
+	auto i = devices.begin();
+	std::cerr << "Building CL program for devices [" << i->getInfo<CL_DEVICE_NAME>();
+	++i;
+	while(i != devices.end()) {
+	    std::cerr << ',' << i->getInfo<CL_DEVICE_NAME>();
+	    ++i;
+	}
+	std::cerr << "]...\n";
+
+	std::cerr << " from source file(s) [" << sourcePaths[0];
+	for(size_t j = 1; j < sourcePaths.size(); j++)
+	    std::cerr << ',' << sourcePaths[j];
+	std::cerr << "]\n";
+    }
+#endif
+
+    cl::Program program(context, sources);
+    try {
+	//Warning: AMD CL compiler may crash if using CL2.0 features in CL1.x compiler mode!
+	//Don't forget to pass -cl-std=CL2.0 in compilerOptions if using CL2.0 features.
+	program.build(devices, compilerOptions.c_str());
+
+#ifndef NDEBUG
+	// Always show compilation log in debug mode
+	{
+	    std::string buildLog;
+	    for(auto&& i: devices) {
+		buildLog = program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(i);
+		std::cerr << "Build log for device " << i.getInfo<CL_DEVICE_NAME>() << ":";
+		if(!buildLog.empty()) {
+		    std::cerr << "\n----------------------------------------------------------------------\n"
+			    << buildLog << '\n'
+			    << "----------------------------------------------------------------------\n"
+			    << "\n\n";
+		}
+		else
+		    std::cerr << " <empty>\n";
+	    }
+	}
+#endif
+    }
+    catch(cl::BuildError& err) {
+	dumpBuildError(err);
+	throw;
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // Save built program in the user's cache
+    /////////////////////////////////////////////////////////////////
+    if(home)
+	writeProgramBinaries(cacheDirs[0] + cacheSubpath, program);
+    else {
+	// The user has already been warned if the HOME environment variable does not exist
+    }
+
+    return program;
+}
+
+/**
+ * @brief Hashes a string with 64-bit FNV-1a. Unlike std::hash, results do not depend on the standard library, so
+ * cache keys remain valid across builds and can be shared between hosts.
+ * @param[in] s string to be hashed
+ * @param[in] hash hash of the preceding data (if the string continues previously hashed data)
+ * @return updated hash
+ */
+uint64_t CLapp::hashString(const std::string& s, uint64_t hash) {
+    for(unsigned char c: s) {
+	hash ^= c;
+	hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Adds the headers included by a source file to a hash, recursively.
+ *
+ * Headers are looked for in the directory of the including file and in KERNEL_INCLUDE_DIR. Headers not found there
+ * (e.g. those provided by the CL compiler) are identified by the compiler options and device strings instead.
+ * @param[in] source contents of the source file
+ * @param[in] dir directory of the source file (with a trailing slash)
+ * @param[in,out] hashedFiles headers already added to the hash (each header is only added once)
+ * @param[in] hash hash of the preceding data
+ * @return updated hash
+ */
+uint64_t CLapp::hashIncludes(const std::string& source, const std::string& dir, std::set<std::string>& hashedFiles, uint64_t hash) {
+    static const std::regex includeRegex("^\\s*#\\s*include\\s*[<\"]([^>\"]+)[>\"]");
+    std::istringstream lines(source);
+    std::string line;
+    std::smatch match;
+
+    while(std::getline(lines, line)) {
+	if(!std::regex_search(line, match, includeRegex))
+	    continue;
+
+	for(auto&& includeDir: {dir, std::string(KERNEL_INCLUDE_DIR "/")}) {
+	    const std::string path = includeDir + match[1].str();
+	    std::ifstream f(path, std::ios::in | std::ios::binary);
+	    if(f.is_open()) {
+		if(hashedFiles.insert(path).second) {
+		    std::ostringstream buffer;
+		    buffer << f.rdbuf();
+		    hash = hashString(path, hash);
+		    hash = hashString(buffer.str(), hash);
+		    hash = hashIncludes(buffer.str(), path.substr(0, path.rfind('/') + 1), hashedFiles, hash);
+		}
+		break;
+	    }
+	}
+    }
+    return hash;
+}
+
+/**
+ * @brief Reads program binaries from a cache file.
+ *
+ * Cache files hold the number of binaries followed by the size and contents of each binary (one binary per device, in
+ * the same order as the devices of the CLapp).
+ * @param[in] cacheFile full path name of the cache file
+ * @param[out] binaries program binaries
+ * @return true if the cache file exists and is complete (a truncated or corrupt file is just a cache miss)
+ */
+bool CLapp::readProgramBinaries(const std::string& cacheFile, cl::Program::Binaries& binaries) {
+    binaries.clear();
+    std::ifstream f(cacheFile, std::ios::in | std::ios::binary | std::ios::ate);
+    if(!f.is_open())
+	return false;
+
+    // Sizes read from the file are checked against what is left of it before allocating anything, so a corrupt size
+    // cannot make us allocate (or read) more than the file holds
+    std::streamoff remaining = f.tellg();
+    f.seekg(0);
+    try {
+	uint64_t numBinaries = 0;
+	f.read(reinterpret_cast<char*>(&numBinaries), sizeof(numBinaries));
+	remaining -= sizeof(numBinaries);
+	if(!f.good() || numBinaries == 0 || numBinaries > static_cast<uint64_t>(remaining) / sizeof(uint64_t))
+	    return false;
+	for(uint64_t i = 0; i < numBinaries; i++) {
+	    uint64_t size = 0;
+	    f.read(reinterpret_cast<char*>(&size), sizeof(size));
+	    remaining -= sizeof(size);
+	    if(!f.good() || size > static_cast<uint64_t>(remaining))
+		break;
+	    binaries.emplace_back(size);
+	    f.read(reinterpret_cast<char*>(binaries.back().data()), size);
+	    remaining -= size;
+	}
+	if(f.good() && binaries.size() == numBinaries)
+	    return true;
+    }
+    catch(std::exception& e) {
+	// e.g. std::bad_alloc: treated as a cache miss too
+    }
+    binaries.clear();
+    return false;
+}
+
+/**
+ * @brief Writes the binaries of a built program to a cache file (see readProgramBinaries() for its format).
+ *
+ * The file is written under a temporary name and then renamed, so that other processes sharing the cache never read
+ * an incomplete file. Errors are reported but not fatal.
+ * @param[in] cacheFile full path name of the cache file
+ * @param[in] program built program
+ */
+void CLapp::writeProgramBinaries(const std::string& cacheFile, const cl::Program& program) {
+    // Check for existent cache directories and create them if necessary
+    const std::string cacheDir = cacheFile.substr(0, cacheFile.rfind('/'));
+    size_t slashPos = 0;
+    while(slashPos != std::string::npos) {
+	slashPos = cacheDir.find('/', slashPos + 1);
+	auto dir = cacheDir.substr(0, slashPos);
+
+	// Another process may be creating the same directory right now, so EEXIST is fine
+	if((::mkdir(dir.c_str(), 0755) == -1) && (errno != EEXIST)) {
+	    std::cerr << "Error creating cache directory " << dir << ". Not generating kernel cache files\n";
+	    return;
+	}
+    }
+
+    // A program was built for every device. compiledPrograms holds one binary per device
+    auto compiledPrograms = program.getInfo<CL_PROGRAM_BINARIES>();
+    auto compiledProgramsLen = program.getInfo<CL_PROGRAM_BINARY_SIZES>();
+
+    std::ostringstream s;
+    s << cacheFile << ".tmp" << ::getpid() << '_' << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const std::string tmpFile = s.str();
+
+    std::ofstream f;
+    f.open(tmpFile.c_str(), std::ios::out | std::ios::binary);
+    if(f.is_open()) {
+	uint64_t numBinaries = compiledPrograms.size();
+	f.write(reinterpret_cast<const char*>(&numBinaries), sizeof(numBinaries));
+	for(size_t i = 0; i < compiledPrograms.size(); i++) {
+	    uint64_t size = compiledProgramsLen[i];
+	    f.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	    f.write(reinterpret_cast<const char*>(compiledPrograms[i].data()), size);
+	}
+	f.close();
+
+	if(f.good() && (::rename(tmpFile.c_str(), cacheFile.c_str()) == 0))
+	    CLAPP_CERR("Wrote kernel cache file " << cacheFile << "\n");
+	else {
+	    ::unlink(tmpFile.c_str());
+	    std::cerr << "Couldn't write cache file " << cacheFile << "\n";
+	}
+    }
+    else
+	std::cerr << "Couldn't write cache file " << cacheFile << "\n";
+}
+
+/**
+ * @brief Builds a CL program from source code generated at run time (e.g. fused kernels) for all devices of this CLapp.
+ *
+ * The same compiler options as for kernel files are used. Generated programs are not stored in the kernel cache.
+ * @param[in] source program source code
+ * @param[in] compilerOptionsArg extra compiler options (may be null)
+ * @return the built program
+ */
+cl::Program CLapp::buildProgram(const std::string& source, const char* compilerOptionsArg) {
+    cl::Program program(context, source);
+    try {
+	program.build(devices, getCompilerOptions(compilerOptionsArg).c_str());
+    }
+    catch(cl::BuildError& err) {
+	dumpBuildError(err);
+	throw;
+    }
+    return program;
+}
+
+/**
+ * @brief Composes the compiler options which make the dimensions and strides of a Data object compile-time constants
+ * (see SHAPE_OR in hostKernelFunctions.h)
+ * @param[in] pShape Data object whose shape is used
+ * @return compiler options
+ */
+const std::string CLapp::getShapeOptions(const std::shared_ptr<Data>& pShape) {
+    std::ostringstream s;
+    s << "-DSPECIALIZED_SHAPE"
+      << " -DSHAPE_NUMSPATIALDIMS=" << pShape->getNumSpatialDims()
+      << " -DSHAPE_COLUMNS=" << pShape->getSpatialDimSize(COLUMNS, 0)
+      << " -DSHAPE_ROWS=" << pShape->getSpatialDimSize(ROWS, 0)
+      << " -DSHAPE_SLICES=" << pShape->getSpatialDimSize(SLICES, 0)
+      << " -DSHAPE_NUMCOILS=" << pShape->getNumCoils()
+      << " -DSHAPE_NUMFRAMES=" << pShape->getTemporalDimSize(0)
+      << " -DSHAPE_COILSTRIDE=" << pShape->getCoilStride(0)
+      << " -DSHAPE_FRAMESTRIDE=" << pShape->getTemporalDimStride(0, 0);
+    return s.str();
+}
+
+/**
+ * @brief Gets a kernel built for the shape of a Data object.
+ *
+ * The source file of the kernel is rebuilt with the dimensions and strides of pShape as compile-time constants, so that
+ * the compiler can fold index arithmetic in kernels which use SHAPE_OR (other kernels behave as usual). Programs are
+ * cached by source file and shape (in memory and in the kernel cache), so Data objects with the same shape share them.
+ * Data objects whose NDArrays differ in size cannot be described by constants and get a kernel from the generic program
+ * instead.
+ * @param[in] name name of the kernel
+ * @param[in] pShape Data object the kernel will be launched on
+ * @return a new kernel object (created for every call), which can be used independently of the one returned by getKernel()
+ * and of those returned to other callers
+ */
+cl::Kernel CLapp::getSpecializedKernel(const std::string& name, const std::shared_ptr<Data>& pShape) {
+    // Load kernels if needed and check the kernel exists
+    std::string sourceFile, sourcePath;
+    {
+	const std::lock_guard<std::recursive_mutex> lock(kernelsMutex);
+	cl::Kernel& genericKernel = getKernel(name);
+
+	if(!pShape->getAllSizesEqual()) {
+	    CLAPP_CERR("getSpecializedKernel: NDArrays of different sizes. Using generic kernel " << name << "\n");
+	    // A copy of genericKernel would share its cl_kernel (and so its arguments) with every other caller
+	    return cl::Kernel(genericKernel.getInfo<CL_KERNEL_PROGRAM>(), name.c_str());
+	}
+
+	sourceFile = kernels[name].sourceFile;
+	sourcePath = kernelFiles[sourceFile].sourcePath;
+    }
+    const std::string shapeOptions = getShapeOptions(pShape);
+    const std::string key = sourceFile + ' ' + shapeOptions;
+
+    const std::lock_guard<std::mutex> lock(specializedProgramsMutex);
+    auto i = specializedPrograms.find(key);
+    if(i == specializedPrograms.end()) {
+	// Same compilation unit as loadKernels: extra source files followed by the kernel file. The shape options are part of
+	// the compiler options, so each shape gets its own entry in the kernel cache too
+	std::vector<std::string> sourcePaths(extraSourcePaths);
+	sourcePaths.push_back(sourcePath);
+
+	CLAPP_CERR("Building " << sourceFile << " with " << shapeOptions << "\n");
+	i = specializedPrograms.insert({key, loadProgram(sourcePaths, getCompilerOptions(shapeOptions.c_str()))}).first;
+    }
+    return cl::Kernel(i->second, name.c_str());
+}
+
 /**
  * @brief Shows info about OpenCL platforms and devices on standard output
  */
@@ -1714,9 +1901,9 @@ cl::NDRange CLapp::calcLocalSize(const cl::Kernel& kernel, const cl::Device& dev
  * @param[in] baseNumber value whose multiple nearest to numToRound is returned
  * @return rounded number (nearest multiple of baseNumber)
  */
-cl_uint CLapp::roundUp(cl_uint numToRound, cl_uint baseNumber) {
+size_t CLapp::roundUp(size_t numToRound, size_t baseNumber) {
     //assert(baseNumber);
-    cl_uint remainder = numToRound % baseNumber;
+    size_t remainder = numToRound % baseNumber;
     //CERR("remainder: " << remainder << std::endl);
     if(remainder == 0) {
 	return numToRound;
@@ -1753,6 +1940,26 @@ DataHandle CLapp::addData(Data* pData, bool copyDataToDevice) {
     pData->setHandle(thisDataKey);
     return thisDataKey;
 }
+/**
+ * @brief Resolves a host memory policy to the policy actually used for device buffers: HOST_MEMORY_DEFAULT becomes the
+ * policy of this CLapp, and HOST_MEMORY_AUTO becomes HOST_MEMORY_ZEROCOPY on CPU and unified memory devices
+ * (where device memory is host memory anyway) or HOST_MEMORY_DEVICE on any other device.
+ * @param[in] policy policy to resolve
+ * @param[in] i device index
+ * @return resolved policy (neither default nor auto)
+ */
+HostMemoryPolicy CLapp::resolveHostMemoryPolicy(HostMemoryPolicy policy, size_t i) const {
+    if(policy == HOST_MEMORY_DEFAULT)
+	policy = hostMemoryPolicy;
+    if(policy != HOST_MEMORY_AUTO)
+	return policy;
+
+    const cl::Device& device = getDevice(i);
+    if((device.getInfo<CL_DEVICE_TYPE>() & CL_DEVICE_TYPE_CPU) || device.getInfo<CL_DEVICE_HOST_UNIFIED_MEMORY>())
+	return HOST_MEMORY_ZEROCOPY;
+    return HOST_MEMORY_DEVICE;
+}
+
 /**
  * @brief Checks if handle exists in the data map. Throw exception if not exists.
  * @param[in] handle handle for an existing object subclass of Data class to be checked
@@ -1846,6 +2053,77 @@ void CLapp::device2Host(DataHandle handle, bool queueFinish) {
     dataMap[handle]->device2Host(queueFinish);
 }
 
+/**
+ * @brief Copies part of the data stored in host memory to device memory for a data represented by a handle
+ * @param[in] handle data handle of the data object
+ * @param[in] range NDArrays (and region within them) to copy
+ * @param[in] blocking true to return after the copy has finished
+ * @return event of the last enqueued write
+ */
+cl::Event CLapp::host2Device(DataHandle handle, const DataRange& range, bool blocking) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "host2Device aborted");
+    return dataMap[handle]->host2Device(range, blocking);
+}
+
+/**
+ * @brief Copies part of the data stored in device memory to host memory for a data represented by a handle
+ * @param[in] handle data handle of the data object
+ * @param[in] range NDArrays (and region within them) to copy
+ * @param[in] blocking true to return after the copy has finished
+ * @return event of the last enqueued read
+ */
+cl::Event CLapp::device2Host(DataHandle handle, const DataRange& range, bool blocking) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "device2Host aborted");
+    return dataMap[handle]->device2Host(range, blocking);
+}
+
+/**
+ * @brief Gets the event of the last command that wrote device memory of a data represented by a handle
+ * @param[in] handle data handle of the data object
+ * @return the last writer event (a null event if none was recorded)
+ */
+cl::Event CLapp::getLastWriteEvent(DataHandle handle) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "getLastWriteEvent aborted");
+    return dataMap[handle]->getLastWriteEvent();
+}
+
+/**
+ * @brief Sets the event of the last command that wrote device memory of a data represented by a handle
+ * @param[in] handle data handle of the data object
+ * @param[in] event the last writer event
+ */
+void CLapp::setLastWriteEvent(DataHandle handle, const cl::Event& event) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "setLastWriteEvent aborted");
+    dataMap[handle]->setLastWriteEvent(event);
+}
+
+/**
+ * @brief Gets the events of the last commands (one per command queue) that read device memory of a data represented by a
+ * handle since it was last written
+ * @param[in] handle data handle of the data object
+ * @return the reader events
+ */
+std::vector<cl::Event> CLapp::getReadEvents(DataHandle handle) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "getReadEvents aborted");
+    return dataMap[handle]->getReadEvents();
+}
+
+/**
+ * @brief Records a command that reads device memory of a data represented by a handle
+ * @param[in] handle data handle of the data object
+ * @param[in] event event of the reading command
+ */
+void CLapp::addReadEvent(DataHandle handle, const cl::Event& event) {
+    const std::lock_guard<std::mutex> lock(dataMapMutex);
+    checkDataHandle(handle, "addReadEvent aborted");
+    dataMap[handle]->addReadEvent(event);
+}
+
 /**
  * @brief Returns a string representing the device type of device with index i
  *
@@ -1948,12 +2226,36 @@ const hipDevice_t CLapp::getHIPDevice() const {
 #endif
 
 /**
-    * @brief Gets OpenCL command queue from list of command queues
-    * @param[in] i position of queue in the list of queues
+    * @brief Gets the default OpenCL command queue of a device (the first one in its pool)
+    * @param[in] i position of the device in the list of devices
     * @return reference to selected queue
     */
 cl::CommandQueue& CLapp::getCommandQueue(const size_t i) {
-    return commandQueues[i];
+    return commandQueues[i][0];
+}
+
+/**
+    * @brief Gets an OpenCL command queue from the pool of queues of a device
+    * @param[in] device position of the device in the list of devices
+    * @param[in] q position of the queue in the pool of queues of the device
+    * @return reference to selected queue
+    */
+cl::CommandQueue& CLapp::getCommandQueue(const size_t device, const size_t q) {
+    if(q >= commandQueues.at(device).size()) {
+	std::ostringstream s;
+	s << "Command queue #" << q << " does not exist (" << commandQueues[device].size() << " queues were created for device #" << device << ")";
+	BTTHROW(CLError(CL_INVALID_COMMAND_QUEUE, s.str()), "CLapp::getCommandQueue");
+    }
+    return commandQueues[device][q];
+}
+
+/**
+    * @brief Gets the number of command queues available in a device
+    * @param[in] device position of the device in the list of devices
+    * @return number of queues in the pool of queues of the device
+    */
+size_t CLapp::getNumCommandQueues(const size_t device) const {
+    return commandQueues.at(device).size();
 }
 
 /**
@@ -2126,6 +2428,29 @@ void CLapp::dumpDeviceData() const {
 	std::cerr<<i.first<<": "<<i.second->getData()->getNDArrays()->size()<<"; "<<i.second->pDeviceBuffer->getInfo<CL_MEM_SIZE>()<<'\n';
 }
 
+/**
+ * @brief Get the cache of baked FFT plans for this CLapp's context (plans are kept per device), creating it on first use
+ * @return smart shared pointer to the FFT plan cache
+ */
+std::shared_ptr<FFTPlanCache> CLapp::getFFTPlanCache() {
+    const std::lock_guard<std::mutex> lock(fftPlanCacheMutex);
+    if(!fftPlanCache)
+	fftPlanCache = std::make_shared<FFTPlanCache>(context);
+    return fftPlanCache;
+}
+
+/**
+ * @brief Get the pool of device buffers for Data objects bound to this CLapp, creating it on first use. Up to a quarter of
+ * the first device's global memory may be kept pooled
+ * @return smart shared pointer to the device buffer pool
+ */
+std::shared_ptr<DeviceBufferPool> CLapp::getDeviceBufferPool() {
+    const std::lock_guard<std::mutex> lock(deviceBufferPoolMutex);
+    if(!deviceBufferPool)
+	deviceBufferPool = std::make_shared<DeviceBufferPool>(context, devices[0].getInfo<CL_DEVICE_GLOBAL_MEM_SIZE>() / 4);
+    return deviceBufferPool;
+}
+
 } // namespace OpenCLIPER
 
 #undef CLAPP_DEBUG
@@ -121,6 +121,22 @@ ConcreteNDArray<cl_uchar>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialD
     setHostData(pHostUnsignedDataLocal);
 }
 
+/**
+ * @brief Constructor for storing spatial dimensions and empty data in class fields (element data type is complexHalfType).
+ *
+ * This constructor has move semantics (in spite of not using && notation):
+ * after call, parameters memory deallocation is responsibility of this class
+ * (parameters are set to nullptr at the end of the method).
+ * @param[in,out] pSpatialDims vector with sizes of each spatial dimension
+ */
+template <>
+ConcreteNDArray<complexHalfType>::ConcreteNDArray(std::vector<dimIndexType>*& pSpatialDims) {
+    setDims(pSpatialDims);
+    complexHalfType complexHalfZero = {{0, 0}}; // +0.0 in half precision is all bits zero
+    std::vector <complexHalfType>* pHostComplexHalfDataLocal = new std::vector <complexHalfType>(this->size(), complexHalfZero);
+    setHostData(pHostComplexHalfDataLocal);
+}
+
 /**
  * @brief Constructor for storing spatial dimensions and data in class fields.
  * This constructor has move semantics (in spite of not using && notation):
@@ -178,6 +194,23 @@ ConcreteNDArray<T>::ConcreteNDArray(std::fstream &f, std::vector<dimIndexType>*&
     setHostData(pTempData);
 }
 
+/**
+ * @brief Constructor that uses part of a mapped file as data, without copying them (see Data::getRawFileMapping()).
+ * @param[in] pMappedFile mapped file (shared by all NDArrays read from it)
+ * @param[in] offsetInBytes offset of the data of this object from the beginning of the file
+ * @param[in,out] pSpatialDims vector with NDArray spatial dimensions (move semantics, ownership of the vector is transferred from caller to this object)
+ * @throw std::invalid_argument if the file is too short
+ */
+template <class T>
+ConcreteNDArray<T>::ConcreteNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims) {
+    setDims(pSpatialDims); // store dimension vector and set parameter to nullptr (move semantics)
+    if(offsetInBytes + this->size() * sizeof(T) > pMappedFile->size()) {
+	BTTHROW(std::invalid_argument("mapped file is too short for the requested data\n"), "ConcreteNDArray::ConcreteNDArray");
+    }
+    this->pMappedFile = pMappedFile;
+    pMappedData = reinterpret_cast<T*>(static_cast<char*>(pMappedFile->getData()) + offsetInBytes);
+}
+
 /**
  * @brief Constructor that creates a copy of a ConcreteNDArray object  with complexType data type elements (dimensions are copied always,
  * image data only if copyData parameter is true).
@@ -191,7 +224,9 @@ ConcreteNDArray<complexType>::ConcreteNDArray(const NDArray* pSourceData, bool c
     std::vector<complexType>* pLocalHostData;
     if(copyData) {
 	const ConcreteNDArray<complexType>* pTypedSourceData = static_cast<const ConcreteNDArray<complexType>*>(pSourceData);
-	pLocalHostData = new std::vector<complexType>(*(pTypedSourceData->getHostData()));
+	// Copy from host memory wherever it is (vector or mapped file)
+	const complexType* pSourceElements = static_cast<const complexType*>(pTypedSourceData->getHostDataAsVoidPointer());
+	pLocalHostData = new std::vector<complexType>(pSourceElements, pSourceElements + pTypedSourceData->size());
     }
     else {
 	// Create image data initialized to a vector of complex values (0.0, 0.0) and with a number of values equal to the
@@ -215,7 +250,9 @@ ConcreteNDArray<dimIndexType>::ConcreteNDArray(const NDArray* pSourceData, bool
     std::vector<dimIndexType>* pLocalHostData;
     if(copyData) {
 	const ConcreteNDArray<dimIndexType>* pTypedSourceData = static_cast<const ConcreteNDArray<dimIndexType>*>(pSourceData);
-	pLocalHostData = new std::vector<dimIndexType>(*(pTypedSourceData->getHostData()));
+	// Copy from host memory wherever it is (vector or mapped file)
+	const dimIndexType* pSourceElements = static_cast<const dimIndexType*>(pTypedSourceData->getHostDataAsVoidPointer());
+	pLocalHostData = new std::vector<dimIndexType>(pSourceElements, pSourceElements + pTypedSourceData->size());
     }
     else {
 	dimIndexType zeroElement = 0;
@@ -237,7 +274,9 @@ ConcreteNDArray<realType>::ConcreteNDArray(const NDArray* pSourceData, bool copy
     std::vector<realType>* pLocalHostData;
     if(copyData) {
 	const ConcreteNDArray<realType>* pTypedSourceData = static_cast<const ConcreteNDArray<realType>*>(pSourceData);
-	pLocalHostData = new std::vector<realType>(*(pTypedSourceData->getHostData()));
+	// Copy from host memory wherever it is (vector or mapped file)
+	const realType* pSourceElements = static_cast<const realType*>(pTypedSourceData->getHostDataAsVoidPointer());
+	pLocalHostData = new std::vector<realType>(pSourceElements, pSourceElements + pTypedSourceData->size());
     }
     else {
 	realType zeroElement = 0.0;
@@ -259,7 +298,9 @@ ConcreteNDArray<cl_uchar>::ConcreteNDArray(const NDArray* pSourceData, bool copy
     std::vector<cl_uchar>* pLocalHostData;
     if(copyData) {
 	const ConcreteNDArray<cl_uchar>* pTypedSourceData = static_cast<const ConcreteNDArray<cl_uchar>*>(pSourceData);
-	pLocalHostData = new std::vector<cl_uchar>(*(pTypedSourceData->getHostData()));
+	// Copy from host memory wherever it is (vector or mapped file)
+	const cl_uchar* pSourceElements = static_cast<const cl_uchar*>(pTypedSourceData->getHostDataAsVoidPointer());
+	pLocalHostData = new std::vector<cl_uchar>(pSourceElements, pSourceElements + pTypedSourceData->size());
     }
     else {
 	cl_uchar zeroElement = 0;
@@ -268,6 +309,30 @@ ConcreteNDArray<cl_uchar>::ConcreteNDArray(const NDArray* pSourceData, bool copy
     setHostData(pLocalHostData);
 }
 
+/**
+ * @brief Constructor that creates a copy of a ConcreteNDArray object with complexHalfType data type elements (dimensions are copied
+ * always, image data only if copyData parameter is true).
+ * @param[in] pSourceData ConcreteNDArray object source of spatial and temporal dimensions (complexHalfType elements)
+ * @param[in] copyData data (not only dimensions) are copied if this parameter is true (default value: false)
+ */
+template <>
+ConcreteNDArray<complexHalfType>::ConcreteNDArray(const NDArray* pSourceData, bool copyData) {
+    std::vector<dimIndexType>* pLocalDims = new std::vector<dimIndexType>(*(pSourceData->getDims()));
+    setDims(pLocalDims);
+    std::vector<complexHalfType>* pLocalHostData;
+    if(copyData) {
+	const ConcreteNDArray<complexHalfType>* pTypedSourceData = static_cast<const ConcreteNDArray<complexHalfType>*>(pSourceData);
+	// Copy from host memory wherever it is (vector or mapped file)
+	const complexHalfType* pSourceElements = static_cast<const complexHalfType*>(pTypedSourceData->getHostDataAsVoidPointer());
+	pLocalHostData = new std::vector<complexHalfType>(pSourceElements, pSourceElements + pTypedSourceData->size());
+    }
+    else {
+	complexHalfType zeroElement = {{0, 0}};
+	pLocalHostData = new std::vector<complexHalfType>(pSourceData->size(), zeroElement);
+    }
+    setHostData(pLocalHostData);
+}
+
 /**
  * @brief Constructor for reading data from a matlab variable
  * @param[in] matvar matlab array variable read from file
@@ -343,6 +408,27 @@ inline void ConcreteNDArray<cl_uchar>::loadMatlabHostDataElement(matvar_t* matva
     CONCRETENDARRAY_CERR(element << std::endl);
 }
 
+/**
+ * @brief Gets one element from a matlab variable (previously read from a matlab file), base data type is complexHalfType
+ * (matlab data are complex single precision and they are rounded to half precision)
+ * @param[in] matvar matlab array variable previously read from file
+ * @param[in] offsetInBytes offset from beginning of matlab variable (in bytes) where element data must be read
+ */
+template <>
+inline void ConcreteNDArray<complexHalfType>::loadMatlabHostDataElement(matvar_t* matvar, dimIndexType offsetInBytes) {
+    mat_complex_split_t* complex_data = (mat_complex_split_t*) matvar->data;
+    char* pCharRealPart = (char*) complex_data->Re;
+    char* pCharImagPart = (char*) complex_data->Im;
+    float realPart, imagPart;
+    realPart = *((float*)(pCharRealPart + offsetInBytes));
+    imagPart = *((float*)(pCharImagPart + offsetInBytes));
+    complexHalfType complexHalfElement;
+    complexHalfElement.s[0] = floatToHalf(realPart);
+    complexHalfElement.s[1] = floatToHalf(imagPart);
+    pHostData->push_back(complexHalfElement);
+    CONCRETENDARRAY_CERR(realPart << "+" << imagPart << "i" << std::endl);
+}
+
 /**
  * @brief Destructor, frees all previously allocated memory
  */
@@ -384,6 +470,12 @@ template <class T> const std::string ConcreteNDArray<T>::elementToString(const v
 	pTypedArray = (cl_uchar*) pElementsArray;
 	stringValue = std::to_string(pTypedArray[index1D]);
     }
+    else if(typeid(T) == typeid(complexHalfType)) {
+	complexHalfType* pTypedArray;
+	pTypedArray = (complexHalfType*) pElementsArray;
+	stringValue = "(" + std::to_string(halfToFloat(pTypedArray[index1D].s[0])) + "," +
+		      std::to_string(halfToFloat(pTypedArray[index1D].s[1])) + ")";
+    }
     else {
 	BTTHROW(std::invalid_argument("element data type not supported in elementToString method: " + std::string(typeid(T).name())), "ConcreteNDArray::elementToString");
     }
@@ -408,6 +500,8 @@ std::vector <dimIndexType>* ConcreteNDArray<T>::calcUnaligned1DArrayStridesFromN
         acumStride = 1;// every column has 1 uint (instead of 2 floats, real and imaginary part of complex number, for a ComplexNDArray)
     } else if (typeid(T) == typeid(cl_uchar)) {
         acumStride = 1;// every column has 1 uint (instead of 2 floats, real and imaginary part of complex number, for a ComplexNDArray)
+    } else if (typeid(T) == typeid(complexHalfType)) {
+        acumStride = 1;// every column has 2 halfs (real and imaginary part of complex number) but strides should come in num. of complex elements
     } else {
 	BTTHROW(std::invalid_argument("Unsupported type in calcUnaligned1DArrayStridesFromNDArrayDims method: "
 				      + std::string(typeid(this).name())), "ConcreteNDArray::calcUnaligned1DArrayStridesFromNDArrayDims");
@@ -1,6 +1,7 @@
 #include<fstream>
 #include<sstream>
 #include<string>
+#include<algorithm>
 #include <OpenCLIPER/Data.hpp>
 #include <OpenCLIPER/XData.hpp>
 #include <OpenCLIPER/CLapp.hpp>
@@ -14,6 +15,8 @@
 #include <OpenCLIPER/MatVarDimsData.hpp>
 #include <OpenCLIPER/hostKernelFunctions.hpp>
 #include <OpenCLIPER/InvalidDimension.hpp>
+#include <OpenCLIPER/MappedFile.hpp>
+#include <OpenCLIPER/DataWriter.hpp>
 
 // Uncomment to show class-specific debug messages
 #define DATA_DEBUG
@@ -449,6 +452,7 @@ template Data::Data(std::vector<std::vector<dimIndexType>*>*& pSpatialDims, std:
 Data::Data(Data* sourceData, bool copyData, bool copyToDevice) {
 	sourceData->pCLapp->device2Host(sourceData->myDataHandle, true);
     commonFieldInitialization(sourceData->getElementDataType());
+    hostMemoryPolicy = sourceData->hostMemoryPolicy;
     pNDArraysForGet = new std::vector<const NDArray*>;
     std::vector<NDArray*>* pLocalData = new std::vector<NDArray*>;
     std::vector<dimIndexType>* pLocalDynDims = new std::vector<dimIndexType>(*(sourceData->getDynDims()));
@@ -512,6 +516,7 @@ Data::~Data() {
 
     // Must wait for load calls to end before trying to delete loaded data
     waitLoadEnd();
+    waitSaveEnd();
 
     if(myDataHandle != INVALIDDATAHANDLE) {
 	pCLapp->delData(myDataHandle);
@@ -617,34 +622,7 @@ void Data::loadMatlabHostData(matvar_t* matvar, dimIndexType numOfSpatialDimensi
     BEGIN_TIME(bTReadingKDataMatVar);
     DATA_CERR("  reading data from matlab variable... ");
 #endif
-    switch(matvar->class_type) {
-	case MAT_C_SINGLE:
-	    if(matvar->isComplex) {
-		elementDataType = TYPEID_COMPLEX;
-	    }
-	    else {
-		elementDataType = TYPEID_REAL;
-	    }
-	    break;
-	case MAT_C_UINT32:
-	    if(!matvar->isComplex) {
-		elementDataType = TYPEID_INDEX;
-	    }
-	    else {
-		BTTHROW(std::invalid_argument("Unsupported element data type in matlab data"), "Data::loadMatlabHostData");
-	    }
-	    break;
-	case MAT_C_UINT8:
-	    if(!matvar->isComplex) {
-		elementDataType = TYPEID_CL_UCHAR;
-	    }
-	    else {
-		BTTHROW(std::invalid_argument("Unsupported element data type in matlab data"), "Data::loadMatlabHostData");
-	    }
-	    break;
-	default:
-	    BTTHROW(std::invalid_argument("Unsupported element data type in matlab data"), "Data::loadMatlabHostData");
-    }
+    elementDataType = getMatlabElementDataType(matvar);
 
     // Note: commonFieldInitialization resets pDynDims, which is already set. Set elementDataType/elementSize here instead of calling it
     elementSize = NDArray::getElementSize(elementDataType);
@@ -675,6 +653,80 @@ void Data::loadMatlabHostData(matvar_t* matvar, dimIndexType numOfSpatialDimensi
 #endif
 }
 
+/**
+ * @brief Load contents of a matlab variable into a Data object reading it from a matlab file one NDArray at a time, so that
+ * the whole variable is never held in memory (it is read as a whole only if it cannot be read in slabs, e.g. it has an
+ * unsupported storage format)
+ * @param[in] matlabFile index of the open matlab file
+ * @param[in] variableName name of the matlab variable
+ * @param[in] numOfSpatialDimensions number of spatial dimensions in matlab variable (rest of dimensions can be temporal dimensions or
+ * number of coils)
+ * @param[in] numNDArraysToRead number of NDArrays to be read from matlab variable
+ * @throw std::out_of_range if the variable is not stored in the matlab file
+ * @throw std::invalid_argument if element datatype is not supported or the variable cannot be read
+ */
+void Data::loadMatlabHostData(const MatlabFileIndex& matlabFile, const std::string& variableName, dimIndexType numOfSpatialDimensions,
+			      dimIndexType numNDArraysToRead) {
+    const matvar_t* pMatVarInfo = matlabFile.getVariableInfo(variableName);
+    dimIndexType nDArrayNumElems = 1;
+    for(dimIndexType i = 0; i < numOfSpatialDimensions && i < static_cast<dimIndexType>(pMatVarInfo->rank); i ++) {
+	nDArrayNumElems *= pMatVarInfo->dims[i];
+    }
+
+    matvar_t* pSlabMatVar = matlabFile.readVariableSlab(variableName, 0, nDArrayNumElems, numOfSpatialDimensions);
+    if(pSlabMatVar == nullptr) {
+	loadMatlabHostData(matlabFile.readVariable(variableName), numOfSpatialDimensions, numNDArraysToRead);
+	return;
+    }
+    elementDataType = getMatlabElementDataType(pSlabMatVar);
+    elementSize = NDArray::getElementSize(elementDataType);
+
+    pNDArrays = std::unique_ptr <std::vector<std::unique_ptr<NDArray>>>(new std::vector<std::unique_ptr<NDArray>>);
+    for(dimIndexType i = 0; i < numNDArraysToRead; i++) {
+	if(i > 0) {
+	    pSlabMatVar = matlabFile.readVariableSlab(variableName, static_cast<size_t>(i) * nDArrayNumElems, nDArrayNumElems,
+						      numOfSpatialDimensions);
+	    if(pSlabMatVar == nullptr) {
+		BTTHROW(std::invalid_argument("Error reading matlab variable '" + variableName + "'"), "Data::loadMatlabHostData");
+	    }
+	}
+	// Every slab holds exactly one NDArray
+	pNDArrays->push_back(std::unique_ptr<NDArray>(NDArray::createNDArray(pSlabMatVar, numOfSpatialDimensions, 0)));
+	Mat_VarFree(pSlabMatVar);
+    }
+}
+
+/**
+ * @brief Gets the type of the elements of a Data object loaded from a matlab variable
+ * @param[in] matvar matlab variable
+ * @return element data type
+ * @throw std::invalid_argument if element datatype is not supported
+ */
+ElementDataType Data::getMatlabElementDataType(const matvar_t* matvar) {
+    switch(matvar->class_type) {
+	case MAT_C_SINGLE:
+	    if(matvar->isComplex) {
+		return TYPEID_COMPLEX;
+	    }
+	    else {
+		return TYPEID_REAL;
+	    }
+	case MAT_C_UINT32:
+	    if(!matvar->isComplex) {
+		return TYPEID_INDEX;
+	    }
+	    break;
+	case MAT_C_UINT8:
+	    if(!matvar->isComplex) {
+		return TYPEID_CL_UCHAR;
+	    }
+	    break;
+	default:
+	    break;
+    }
+    BTTHROW(std::invalid_argument("Unsupported element data type in matlab data"), "Data::loadMatlabHostData");
+}
+
 /**
  * @brief Read matlab variable with information about spatial and temporal dimensions of a KData or XData
  *
@@ -773,6 +825,23 @@ void Data::setApp(std::shared_ptr<CLapp> pCLapp, bool copyDataToDevice) {
     }
 }
 
+/**
+ * @brief Sets the kind of memory device buffers of this object are allocated in. If it is already bound to a CLapp,
+ * device memory is allocated again with the new policy and filled with NDArray host data (device contents not copied back
+ * to NDArray host data are lost).
+ * @param[in] policy host memory policy (HOST_MEMORY_DEFAULT to use the policy of the CLapp)
+ */
+void Data::setHostMemoryPolicy(HostMemoryPolicy policy) {
+    if(policy == hostMemoryPolicy)
+	return;
+    hostMemoryPolicy = policy;
+    if(pCLapp != nullptr && myDataHandle != INVALIDDATAHANDLE) {
+	// Host buffers are allocated again
+	waitSaveEnd();
+	setApp(pCLapp, true);
+    }
+}
+
 // Getters
 /**
  * @brief Gets a read-only pointer to images data.
@@ -943,6 +1012,8 @@ const std::string Data::hostBufferToString(std::string title, dimIndexType index
  * @param[in] copyData copy data from host to device after storing input data
  */
 void Data::internalSetData(std::vector<NDArray*>*& pNDArrays, bool copyDataToDevice) {
+    // Current NDArrays may still be being written to a file
+    waitSaveEnd();
     if(this->pNDArrays != nullptr) {
 	this->pNDArrays->resize(0); // empty the pNDArrays attribute
     }
@@ -1074,6 +1145,23 @@ void loadRawDataForThread(Data* pData, const std::string &fileName, const std::v
     pNDArrays = new std::vector<NDArray*>;
     std::vector<dimIndexType>* pAuxSpatialDims;
     NDArray* pAuxNDArray;
+
+    // Mapped files: every NDArray uses its own part of the file as host memory
+    if(pData->getRawFileMapping()) {
+	DATA_CERR("Mapping CFL file " << fileName << "... ");
+	auto pMappedFile = std::make_shared<MappedFile>(fileName);
+	size_t offsetInBytes = 0;
+	for(dimIndexType i = 0; i < numOfNDArrays ; i++) {
+	    pAuxSpatialDims = new std::vector<dimIndexType>(*(pArraySpatialDims)); // pDims parameter contents are copied to a new vector
+	    pAuxNDArray = NDArray::createNDArray(pMappedFile, offsetInBytes, pAuxSpatialDims, pData->getElementDataType());
+	    offsetInBytes += pAuxNDArray->size() * pData->getElementSize();
+	    pNDArrays->push_back(pAuxNDArray); // copy NDArray pointer and add it to vector
+	}
+	DATA_CERR("done" << std::endl);
+	pData->setData(pNDArrays);
+	return;
+    }
+
     DATA_CERR("Loading CFL file " << fileName << "... ");
     std::fstream f;
     LPISupport::Utils::openFile(fileName, f, std::ios::in|std::ios::binary, "Data::loadRawData");
@@ -1114,6 +1202,55 @@ void Data::waitLoadEnd() {
 	}
 }
 
+/**
+ * @brief Waits for the last save of this object run in the background (if any) to end. Errors of that save are reported
+ * by the future returned when it was submitted, not here.
+ */
+void Data::waitSaveEnd() {
+    if(pendingSave.valid()) {
+	pendingSave.wait();
+    }
+}
+
+/**
+ * @brief Runs a save of this object in a DataWriter. The object is kept alive until the save ends, and data are written
+ * straight from its (mapped) host buffers, without copying them: host buffers must not be modified meanwhile (copies
+ * between host and device through this object wait for it).
+ *
+ * Only objects owned by a std::shared_ptr can be kept alive by the writer; other objects (e.g. automatic variables) are
+ * saved synchronously, before returning.
+ * @param[in] save function writing data of this object to one or more files (run by a writer thread)
+ * @param[in] pWriter writer running the save (DataWriter::getDefault() if nullptr)
+ * @return future which becomes ready when data have been written (get() rethrows any error)
+ */
+std::shared_future<void> Data::submitSave(const std::function<void()>& save, DataWriter* pWriter) {
+    // Several saves of this object are run one after the other (and waitSaveEnd() only has to wait for the last one)
+    waitSaveEnd();
+    std::shared_ptr<Data> pThis;
+    try {
+	pThis = shared_from_this();
+    }
+    catch(std::bad_weak_ptr&) {
+	// Not owned by a shared_ptr: nothing would keep this object alive, so save it here
+	DATA_CERR("Data::submitSave: object not owned by a shared_ptr, saving synchronously\n");
+	std::promise<void> saved;
+	try {
+	    save();
+	    saved.set_value();
+	}
+	catch(...) {
+	    saved.set_exception(std::current_exception());
+	}
+	pendingSave = saved.get_future().share();
+	return pendingSave;
+    }
+    DataWriter& writer = (pWriter != nullptr) ? *pWriter : DataWriter::getDefault();
+    pendingSave = writer.submit([pThis, save]() {
+	save();
+    });
+    return pendingSave;
+}
+
 /**
  * @brief Load data of a group of files to hostData (every file contains one image and it is stored into a NDArray object).
  *
@@ -1147,7 +1284,10 @@ void Data::loadRawData(const std::string &fileNamePrefix, std::vector<std::vecto
 	fileNameStream << fileNameExtension;
 	std::string completeFileName = fileNameStream.str();
 	NDArray* pTempNDArray;
-	pTempNDArray = NDArray::createNDArray(completeFileName, pAuxDims, elementDataType);
+	if(rawFileMapping)
+	    pTempNDArray = NDArray::createNDArray(std::make_shared<MappedFile>(completeFileName), 0, pAuxDims, elementDataType);
+	else
+	    pTempNDArray = NDArray::createNDArray(completeFileName, pAuxDims, elementDataType);
 	pNDArrays->push_back(pTempNDArray); // copy NDArray pointer and add it to vector
     }
     DATA_CERR("done" << std::endl);
@@ -1315,7 +1455,7 @@ void Data::calcDataStrides(dimIndexType deviceMemBaseAddrAlignInBytes) {
 	// bytes per complex element (2 floats)
 	calcDataAlignedSize(NDArray1DIndex, deviceMemBaseAddrAlignInBytes);
 	//dimIndexType lastStride = pDataStridesVector->at(pDataStridesVector->size()-1);
-	dimIndexType lastStride = pDataDimsAndStridesVector->at(pDataDimsAndStridesVector->size() - 1);
+	index1DType lastStride = pDataDimsAndStridesVector->at(pDataDimsAndStridesVector->size() - 1);
 	dimIndexType numCoils = pDataDimsAndStridesVector->at(NumCoilsPos);
 	if(numCoils == 0) { // XData
 	    // Last stride is first temporal dimension stride for XData
@@ -1394,27 +1534,20 @@ std::map<std::string, matvar_t*>* Data::readMatlabVariablesFromFile(std::string
     BEGIN_TIME(bTReadingMatlabFile);
     DATA_CERR("Reading matlab file...\n");
 #endif
-    mat_t* matfp;
+    // Only the headers of all variables are read, then just the requested ones are decoded
+    MatlabFileIndex matlabFile(fileName);
     matvar_t* matvar;
     std::map<std::string, matvar_t*>* pMatlabVariablesMap = new std::map<std::string, matvar_t*>;
-    matfp = Mat_Open(fileName.c_str(), MAT_ACC_RDONLY);
-    if(NULL == matfp) {
-	BTTHROW(std::invalid_argument("Error opening MAT file '" + fileName + "'!"), "Data::readMatlabVariablesFromFile");
-	return pMatlabVariablesMap;
-    }
     for(auto variableName : variableNames) {
-	matvar = Mat_VarRead(matfp, variableName.c_str());
-	if(NULL == matvar) {
+	if(!matlabFile.contains(variableName)) {
 	    BTTHROW(std::invalid_argument("Variable '" + variableName + "' not found, or error reading MAT file"), "Data::readMatlabVariablesFromFile");
 	}
-	else {
-	    (*pMatlabVariablesMap)[variableName] = matvar;
+	matvar = matlabFile.readVariable(variableName);
+	(*pMatlabVariablesMap)[variableName] = matvar;
 #ifdef DATA_DEBUG
-	    Mat_VarPrint(matvar, 1);
+	Mat_VarPrint(matvar, 1);
 #endif
-	}
     }
-    Mat_Close(matfp);
 #ifdef DATA_DEBUG
     DATA_CERR("Done\n");
     END_TIME(eTReadingMatlabFile);
@@ -1470,7 +1603,7 @@ void Data::fillMatlabVarInfo(mat_t* matfp, std::string matVarName, MatVarInfo* p
     void* pNDArrayData;
     for(dimIndexType i = 0; i < getNDArrays()->size(); i++) {
 	pNDArrayData = getHostBuffer(i);
-	pMatVarInfo->set((const dimIndexType*) pDataDimsAndStridesVector.get()->data(),
+	pMatVarInfo->set(pDataDimsAndStridesVector.get()->data(),
 					    matlabNDArrayOffset, (const NDArray*) pNDArrays->at(i).get(), pNDArrayData);
 	matlabNDArrayOffset += numNDArrayElements;
     }
@@ -1491,9 +1624,56 @@ void Data::fillMatlabVarInfo(mat_t* matfp, std::string matVarName, MatVarInfo* p
  * copying data back to host memory
  */
 void Data::device2Host(bool queueFinish) {
+    // Host buffers may still be being written to a file
+    waitSaveEnd();
     pCLapp->device2Host(getHandle(), queueFinish);
 }
 
+/**
+ * @brief Copy part of the data stored in device memory to host memory (i.e. to the buffers returned by getHostBuffer() and
+ * to NDArray host data, so that later host to device copies do not restore stale values). Delegates task to CLapp object.
+ * @param[in] range NDArrays (and region within them) to copy (e.g. getFrameRange(f) for a single frame)
+ * @param[in] blocking true to return after the copy has finished; otherwise, the returned event must be waited for before
+ * reading host memory
+ * @return event of the last enqueued read
+ */
+cl::Event Data::device2Host(const DataRange& range, bool blocking) {
+    waitSaveEnd();
+    return pCLapp->device2Host(getHandle(), range, blocking);
+}
+
+/**
+ * @brief Copy data stored in host memory to device memory. Delegates task to CLapp object.
+ */
+void Data::host2Device() {
+    waitSaveEnd();
+    pCLapp->host2Device(getHandle());
+}
+
+/**
+ * @brief Copy part of the data stored in host memory to device memory. Delegates task to CLapp object.
+ * @param[in] range NDArrays (and region within them) to copy
+ * @param[in] blocking true to return after the copy has finished; otherwise, host data must not be modified until the
+ * returned event completes
+ * @return event of the last enqueued write
+ */
+cl::Event Data::host2Device(const DataRange& range, bool blocking) {
+    waitSaveEnd();
+    return pCLapp->host2Device(getHandle(), range, blocking);
+}
+
+/**
+ * @brief Gets the range of NDArrays holding a given frame (i.e. all of its coils, which are stored consecutively)
+ * @param[in] frame frame index (all temporal dimensions flattened)
+ * @return the range
+ */
+DataRange Data::getFrameRange(dimIndexType frame) {
+    dimIndexType numCoils = std::max(getNumCoils(), 1u);
+    if((frame + 1) * numCoils > getNDArrays()->size())
+	BTTHROW(std::out_of_range("frame index out of bounds"), "Data::getFrameRange");
+    return DataRange(frame * numCoils, numCoils);
+}
+
 
 //---------------------------------
 // host/kernel functions
@@ -1512,7 +1692,7 @@ uint Data::getNDArray1DIndex(uint coilIndex, uint temporalDimIndexes[]) {
     return ::getNDArray1DIndex(getHostBuffer(), coilIndex, temporalDimIndexes);
 }
 
-uint Data::getNDArrayTotalSize(uint NDArray1DIndex) {
+index1DType Data::getNDArrayTotalSize(uint NDArray1DIndex) {
     return ::getNDArrayTotalSize(getHostBuffer(), NDArray1DIndex);
 }
 
@@ -1520,7 +1700,7 @@ uint Data::getNDArrayStride() {
     return ::getNDArrayStride(getHostBuffer());
 }
 
-uint Data::getSpatialDimStride(uint spatialDimIndex, uint NDArray1DIndex) {
+index1DType Data::getSpatialDimStride(uint spatialDimIndex, uint NDArray1DIndex) {
     return ::getSpatialDimStride(getHostBuffer(), spatialDimIndex, NDArray1DIndex);
 }
 
@@ -1537,7 +1717,7 @@ uint Data::getCoilDim() {
     return ::getCoilDim(getHostBuffer());
 }
 
-uint Data::getCoilStride(uint NDArray1DIndex) {
+index1DType Data::getCoilStride(uint NDArray1DIndex) {
     return ::getCoilStride(getHostBuffer(), NDArray1DIndex);
 }
 
@@ -1550,7 +1730,7 @@ uint Data::getTemporalDim(uint tempDim) {
     return ::getTemporalDim(getHostBuffer(), tempDim);
 }
 
-uint Data::getTemporalDimStride(uint temporalDimIndex, uint NDArray1DIndex) {
+index1DType Data::getTemporalDimStride(uint temporalDimIndex, uint NDArray1DIndex) {
     return ::getTemporalDimStride(getHostBuffer(), temporalDimIndex, NDArray1DIndex);
 }
 
@@ -1563,15 +1743,15 @@ uint Data::getDimSize(uint dimIndex, uint NDArray1DIndex) {
     return ::getDimSize(getHostBuffer(), dimIndex, NDArray1DIndex);
 }
 
-uint Data::getElementStride(uint NDArray1DIndex) {
+index1DType Data::getElementStride(uint NDArray1DIndex) {
     return ::getElementStride(getHostBuffer(), NDArray1DIndex);
 }
 
-uint Data::getDimStride(uint dimIndex, uint NDArray1DIndex) {
+index1DType Data::getDimStride(uint dimIndex, uint NDArray1DIndex) {
     return ::getDimStride(getHostBuffer(), dimIndex, NDArray1DIndex);
 }
 
-const void* Data::getNextElement(dimIndexType nDim, dimIndexType curNDArray, dimIndexType curOffset) {
+const void* Data::getNextElement(dimIndexType nDim, dimIndexType curNDArray, index1DType curOffset) {
     return ::getNextElement(getHostBuffer(), nDim, curNDArray, curOffset);
 }
 
@@ -1710,8 +1890,7 @@ void Data::show(ShowParms* inParms) {
     else
 	tileCoords.push_back({0,0});
 
-    // Get data from device
-    pCLapp->getCommandQueue().finish();
+    // Get data from device (device2Host waits for its last writer)
     pShow->device2Host();
 
     // Get first, last, and number of frames to show
@@ -0,0 +1,152 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/DataWriter.hpp>
+
+#include <algorithm>
+
+// Uncomment to show class-specific debug messages
+//#define DATAWRITER_DEBUG
+
+#if !defined NDEBUG && defined DATAWRITER_DEBUG
+    #define DATAWRITER_CERR(x) CERR(x)
+#else
+    #define DATAWRITER_CERR(x)
+    #undef DATAWRITER_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Constructor, starts the worker threads
+ * @param[in] numThreads number of jobs run at the same time (at least 1)
+ * @param[in] maxQueuedJobs maximum number of jobs waiting to be run before submit() blocks (at least 1)
+ */
+DataWriter::DataWriter(unsigned numThreads, size_t maxQueuedJobs): maxQueuedJobs(std::max<size_t>(maxQueuedJobs, 1)) {
+    numThreads = std::max(numThreads, 1u);
+    for(unsigned i = 0; i < numThreads; i++)
+	workers.emplace_back(&DataWriter::workerLoop, this);
+}
+
+/**
+ * @brief Destructor, runs all pending jobs and stops the worker threads
+ */
+DataWriter::~DataWriter() {
+    {
+	std::lock_guard<std::mutex> lock(jobsMutex);
+	stopping = true;
+    }
+    jobQueued.notify_all();
+    for(auto& worker: workers)
+	worker.join();
+}
+
+/**
+ * @brief Queues a job, waiting for room in the queue if it is full
+ * @param[in] job function to be run by a worker thread
+ * @return future which becomes ready when the job ends (get() rethrows any exception thrown by the job)
+ */
+std::shared_future<void> DataWriter::submit(const std::function<void()>& job) {
+    std::packaged_task<void()> task(job);
+    std::shared_future<void> future = task.get_future().share();
+    {
+	std::unique_lock<std::mutex> lock(jobsMutex);
+	jobTaken.wait(lock, [this] { return jobs.size() < maxQueuedJobs; });
+	jobs.push_back(std::move(task));
+	DATAWRITER_CERR("DataWriter: job queued (" << jobs.size() << " waiting, " << numRunningJobs << " running)\n");
+    }
+    jobQueued.notify_one();
+    return future;
+}
+
+/**
+ * @brief Waits until all submitted jobs have ended
+ */
+void DataWriter::waitAll() {
+    std::unique_lock<std::mutex> lock(jobsMutex);
+    jobsDone.wait(lock, [this] { return jobs.empty() && numRunningJobs == 0; });
+}
+
+/**
+ * @brief Gets the number of jobs not ended yet
+ * @return number of queued plus running jobs
+ */
+size_t DataWriter::getNumPendingJobs() {
+    std::lock_guard<std::mutex> lock(jobsMutex);
+    return jobs.size() + numRunningJobs;
+}
+
+/**
+ * @brief Gets the writer used when none is given explicitly (2 threads, up to 16 queued jobs)
+ * @return process-wide writer
+ */
+DataWriter& DataWriter::getDefault() {
+    static DataWriter defaultWriter;
+    return defaultWriter;
+}
+
+/**
+ * @brief Runs queued jobs until the writer is destroyed
+ */
+void DataWriter::workerLoop() {
+    while(true) {
+	std::packaged_task<void()> task;
+	{
+	    std::unique_lock<std::mutex> lock(jobsMutex);
+	    jobQueued.wait(lock, [this] { return stopping || !jobs.empty(); });
+	    if(jobs.empty())
+		return;
+	    task = std::move(jobs.front());
+	    jobs.pop_front();
+	    numRunningJobs++;
+	}
+	jobTaken.notify_one();
+
+	// Exceptions are stored in the future of the job. The task (and whatever its job holds, e.g. the Data object being
+	// saved) is destroyed before the job counts as done
+	task();
+	task = std::packaged_task<void()>();
+
+	bool done;
+	{
+	    std::lock_guard<std::mutex> lock(jobsMutex);
+	    numRunningJobs--;
+	    done = jobs.empty() && numRunningJobs == 0;
+	}
+	if(done)
+	    jobsDone.notify_all();
+    }
+}
+
+} // namespace OpenCLIPER
+
+#undef DATAWRITER_DEBUG
@@ -0,0 +1,189 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/DeviceBufferPool.hpp>
+
+// Uncomment to show class-specific debug messages
+//#define DEVICEBUFFERPOOL_DEBUG
+
+#if !defined NDEBUG && defined DEVICEBUFFERPOOL_DEBUG
+    #define DEVICEBUFFERPOOL_CERR(x) CERR(x)
+#else
+    #define DEVICEBUFFERPOOL_CERR(x)
+    #undef DEVICEBUFFERPOOL_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/// Smallest bucket size (smaller requests get a buffer of this size)
+static constexpr size_t MINBUCKETSIZE = 4096;
+
+/**
+ * @brief Creates an empty pool
+ * @param[in] context context buffers are created in
+ * @param[in] maxPooledBytes maximum amount of unused memory kept in the pool
+ */
+DeviceBufferPool::DeviceBufferPool(const cl::Context& context, size_t maxPooledBytes): context(context), maxPooledBytes(maxPooledBytes) {
+}
+
+/**
+ * @brief Rounds a size up to its bucket size: the smallest multiple of a quarter of the largest power of two not greater
+ * than size (i.e. there are 4 buckets per power of two)
+ * @param[in] size requested size in bytes
+ * @return bucket size in bytes
+ */
+size_t DeviceBufferPool::getBucketSize(size_t size) {
+    if(size <= MINBUCKETSIZE)
+	return MINBUCKETSIZE;
+
+    size_t powerOfTwo = MINBUCKETSIZE;
+    while(powerOfTwo <= size / 2)
+	powerOfTwo *= 2;
+
+    size_t step = powerOfTwo / 4;
+    return (size + step - 1) / step * step;
+}
+
+/**
+ * @brief Gets the memory flags buffers are created with for a host memory policy
+ * @param[in] policy host memory policy (must be already resolved, i.e. neither default nor auto)
+ * @return memory flags
+ * @throw std::invalid_argument for HOST_MEMORY_ZEROCOPY (zero-copy buffers are not pooled)
+ */
+cl_mem_flags DeviceBufferPool::getMemFlags(HostMemoryPolicy policy) {
+    switch(policy) {
+	case HOST_MEMORY_PINNED:
+	    return CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR;
+	case HOST_MEMORY_ZEROCOPY:
+	    BTTHROW(std::invalid_argument("zero-copy buffers are not pooled"), "DeviceBufferPool::getMemFlags");
+	default:
+	    return CL_MEM_READ_WRITE;
+    }
+}
+
+/**
+ * @brief Creates a new buffer
+ * @param[in] size size in bytes
+ * @param[in] flags memory flags
+ * @return the buffer
+ */
+cl::Buffer DeviceBufferPool::createBuffer(size_t size, cl_mem_flags flags) {
+    return cl::Buffer(context, flags, size, NULL);
+}
+
+/**
+ * @brief Gets a device buffer at least size bytes long, from the pool if possible
+ * @param[in] size requested size in bytes
+ * @param[in] policy host memory policy of the buffer (must be already resolved, i.e. neither default nor auto, and cannot
+ * be zero-copy)
+ * @return the buffer (its actual size is getBucketSize(size))
+ */
+cl::Buffer DeviceBufferPool::acquire(size_t size, HostMemoryPolicy policy) {
+    size_t bucketSize = getBucketSize(size);
+    cl_mem_flags flags = getMemFlags(policy);
+    {
+	const std::lock_guard<std::mutex> lock(poolMutex);
+	stats.requests++;
+
+	auto bucket = freeBuffers.find(std::make_pair(flags, bucketSize));
+	if(bucket != freeBuffers.end() && !bucket->second.empty()) {
+	    cl::Buffer buffer = bucket->second.back();
+	    bucket->second.pop_back();
+	    stats.hits++;
+	    stats.pooledBytes -= bucketSize;
+	    DEVICEBUFFERPOOL_CERR("Reusing pooled buffer of " << bucketSize << " bytes\n");
+	    return buffer;
+	}
+    }
+
+    cl::Buffer buffer;
+    try {
+	buffer = createBuffer(bucketSize, flags);
+    }
+    catch(cl::Error& err) {
+	if(err.err() != CL_MEM_OBJECT_ALLOCATION_FAILURE && err.err() != CL_OUT_OF_RESOURCES)
+	    throw;
+
+	// Give all pooled memory back to the device and try again
+	clear();
+	buffer = createBuffer(bucketSize, flags);
+    }
+
+    const std::lock_guard<std::mutex> lock(poolMutex);
+    stats.allocatedBytes += bucketSize;
+    if(stats.allocatedBytes > stats.peakAllocatedBytes)
+	stats.peakAllocatedBytes = stats.allocatedBytes;
+    DEVICEBUFFERPOOL_CERR("Allocated new buffer of " << bucketSize << " bytes\n");
+    return buffer;
+}
+
+/**
+ * @brief Gives a buffer obtained with acquire() back to the pool. The caller must not use it anymore (neither must any
+ * command still pending in any queue)
+ * @param[in] buffer the buffer
+ */
+void DeviceBufferPool::release(const cl::Buffer& buffer) {
+    size_t bucketSize = buffer.getInfo<CL_MEM_SIZE>();
+    cl_mem_flags flags = buffer.getInfo<CL_MEM_FLAGS>();
+
+    const std::lock_guard<std::mutex> lock(poolMutex);
+    if(stats.pooledBytes + bucketSize > maxPooledBytes) {
+	// Let the buffer go (it is freed when its last reference disappears)
+	stats.allocatedBytes -= bucketSize;
+	return;
+    }
+    freeBuffers[std::make_pair(flags, bucketSize)].push_back(buffer);
+    stats.pooledBytes += bucketSize;
+}
+
+/**
+ * @brief Frees all pooled buffers
+ */
+void DeviceBufferPool::clear() {
+    const std::lock_guard<std::mutex> lock(poolMutex);
+    freeBuffers.clear();
+    stats.allocatedBytes -= stats.pooledBytes;
+    stats.pooledBytes = 0;
+}
+
+/**
+ * @brief Gets pool usage statistics
+ * @return a copy of current statistics
+ */
+DeviceBufferPool::Stats DeviceBufferPool::getStats() {
+    const std::lock_guard<std::mutex> lock(poolMutex);
+    return stats;
+}
+
+} // namespace OpenCLIPER
+
+#undef DEVICEBUFFERPOOL_DEBUG
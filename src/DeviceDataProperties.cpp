@@ -39,8 +39,12 @@
 #include <OpenCLIPER/DeviceDataProperties.hpp>
 #include <OpenCLIPER/CLapp.hpp>
 #include <OpenCLIPER/Data.hpp>
+#include <OpenCLIPER/DeviceBufferPool.hpp>
 #include <OpenCLIPER/cl2hip.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 // Uncomment to show class-specific debug messages
 //#define DEVICEDATAPROPERTIES_DEBUG
 
@@ -52,10 +56,25 @@
 #endif
 
 namespace OpenCLIPER {
+
+/// Alignment of host memory allocated for zero-copy buffers (a page, as required by most implementations to avoid copies)
+static constexpr size_t ZEROCOPYHOSTMEMORYALIGNMENT = 4096;
+
+/**
+ * @brief Destructor callback of zero-copy buffers: drops the reference the buffer held to its host memory
+ * @param[in] memObject destroyed buffer (unused)
+ * @param[in] pHostMemoryOwner heap-allocated shared pointer to the host memory
+ */
+static void CL_CALLBACK releaseZeroCopyHostMemory(cl_mem memObject, void* pHostMemoryOwner) {
+    delete static_cast<std::shared_ptr<void>*>(pHostMemoryOwner);
+}
+
 DeviceDataProperties::DeviceDataProperties(const std::shared_ptr<CLapp>& pCLapp, std::shared_ptr<Data> pDataArg, bool copyDataToDevice) {
     queue = pCLapp->getCommandQueue();
     context = pCLapp->getContext();
     selected_device = pCLapp->getDevice();
+    pBufferPool = pCLapp->getDeviceBufferPool();
+    hostMemoryPolicy = pCLapp->resolveHostMemoryPolicy(pDataArg->getHostMemoryPolicy());
 #ifdef HAVE_HIP
     hipDevice = pCLapp->getHIPDevice();
     cl2hipKernel = pCLapp->getKernel("getDevicePointer");
@@ -72,6 +91,8 @@ DeviceDataProperties::DeviceDataProperties(const std::shared_ptr<CLapp>& pCLapp,
     queue = pCLapp->getCommandQueue();
     context = pCLapp->getContext();
     selected_device = pCLapp->getDevice();
+    pBufferPool = pCLapp->getDeviceBufferPool();
+    hostMemoryPolicy = pCLapp->resolveHostMemoryPolicy(pDataArg->getHostMemoryPolicy());
 #ifdef HAVE_HIP
     hipDevice = pCLapp->getHIPDevice();
     cl2hipKernel = pCLapp->getKernel("getDevicePointer");
@@ -156,18 +177,18 @@ void DeviceDataProperties::setApp(bool copyDataToDevice) {
 void DeviceDataProperties::createEmptyDeviceBuffers() {
     dimIndexType minIndex, maxIndex;
     dimIndexType numberOfNDArrays = pData->getNDArrays()->size();
-    dimIndexType sizeOfNDArrayInBytes;
+    size_t sizeOfNDArrayInBytes;
 
     minIndex = 0;
     maxIndex = numberOfNDArrays - 1;
-    dimIndexType offsetContiguousMemoryBetweenNDArraysInBytes;
-    dimIndexType totalSizeOfContiguousMemoryInBytes = 0;
+    size_t offsetContiguousMemoryBetweenNDArraysInBytes;
+    size_t totalSizeOfContiguousMemoryInBytes = 0;
 
     DEVICEDATAPROPERTIES_CERR("CL_DEVICE_MEM_BASE_ADDR_ALIGN: " << deviceMemBaseAddrAlignInBytes * 8 << " bits" << std::endl);
     try {
 	// Add size of dimensions and strides array plus offset rounded up to a multiple of CL_DEVICE_MEM_BASE_ADDR_ALIGN to size of contiguous
 	// device memory
-	dimsAndStridesArraySubbuferRoundedSize = CLapp::roundUp((pData->getDataDimsAndStridesVector()->size() + 1) * sizeof(dimIndexType), deviceMemBaseAddrAlignInBytes);
+	dimsAndStridesArraySubbuferRoundedSize = CLapp::roundUp((pData->getDataDimsAndStridesVector()->size() + 1) * sizeof(index1DType), deviceMemBaseAddrAlignInBytes);
 	totalSizeOfContiguousMemoryInBytes += dimsAndStridesArraySubbuferRoundedSize;
 
 	// Add size of every NDArray (every NDArray may have a different size) to size of contiguous device memory
@@ -178,9 +199,14 @@ void DeviceDataProperties::createEmptyDeviceBuffers() {
 	    allNDArraysRoundedSizeInBytes += offsetContiguousMemoryBetweenNDArraysInBytes;
 	}
 	totalSizeOfContiguousMemoryInBytes += allNDArraysRoundedSizeInBytes;
-	pCompleteDeviceBuffer = new cl::Buffer(context, CL_MEM_READ_WRITE, totalSizeOfContiguousMemoryInBytes, NULL);
-
-	dimIndexType offsetSubbufferInBytes = 0;
+	// The buffer may be bigger than requested if it comes from the pool (any extra space is simply not used). Zero-copy
+	// buffers are not pooled, as their host memory becomes NDArray host storage
+	if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY)
+	    pCompleteDeviceBuffer = new cl::Buffer(createZeroCopyBuffer(totalSizeOfContiguousMemoryInBytes));
+	else
+	    pCompleteDeviceBuffer = new cl::Buffer(pBufferPool->acquire(totalSizeOfContiguousMemoryInBytes, hostMemoryPolicy));
+
+	size_t offsetSubbufferInBytes = 0;
 	cl_buffer_region* pBufferCreateInfo;
 	// First subbuffer contains array of data dimensions and strides plus offset to this array from first NDArray subbuffer
 	pBufferCreateInfo = new cl_buffer_region({offsetSubbufferInBytes, dimsAndStridesArraySubbuferRoundedSize});
@@ -229,6 +255,24 @@ void DeviceDataProperties::createEmptyDeviceBuffers() {
     }
 }
 
+/**
+ * @brief Creates a zero-copy buffer (CL_MEM_USE_HOST_PTR) on newly allocated page-aligned host memory. That memory is kept in
+ * pZeroCopyHostMemory, so that NDArrays can share it (see host2Device()), and it is freed once neither the buffer nor any
+ * NDArray use it anymore.
+ * @param[in] size size in bytes
+ * @return the buffer
+ */
+cl::Buffer DeviceDataProperties::createZeroCopyBuffer(size_t size) {
+    void* pHostMemory = nullptr;
+    if(posix_memalign(&pHostMemory, ZEROCOPYHOSTMEMORYALIGNMENT, CLapp::roundUp(size, ZEROCOPYHOSTMEMORYALIGNMENT)) != 0)
+	throw cl::Error(CL_MEM_OBJECT_ALLOCATION_FAILURE, "posix_memalign");
+    pZeroCopyHostMemory = std::shared_ptr<void>(pHostMemory, free);
+
+    cl::Buffer buffer(context, CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, size, pHostMemory);
+    buffer.setDestructorCallback(releaseZeroCopyHostMemory, new std::shared_ptr<void>(pZeroCopyHostMemory));
+    return buffer;
+}
+
 /**
  * @brief Allocates a host memory region mapped to a device memory region previously allocated for a data OpenCL buffer (host
  * region is stored in pHostBuffer class field).
@@ -243,7 +287,7 @@ void DeviceDataProperties::mapDeviceBufferToHost() {
 				   CL_MAP_READ | CL_MAP_WRITE, 0,
 				   dimsAndStridesArraySubbuferRoundedSize + allNDArraysRoundedSizeInBytes);
 	char* pHostBuffer;
-	dimIndexType sizeOfNDArrayInBytes;
+	size_t sizeOfNDArrayInBytes;
 	// First buffer is for dimensions and strides; second and following for NDArrays data
 	pHostBuffer = ((char*) pCompleteHostBuffer) + dimsAndStridesArraySubbuferRoundedSize;
 	for(index1DType index = 0; index <= pData->getNDArrays()->size() - 1; index++) {
@@ -358,13 +402,16 @@ void DeviceDataProperties::host2DeviceCommon(const dimIndexType index) {
 	}
 
 	copyHostDataToMappedHostBuffer(index);
+	// Zero-copy device memory is mapped host memory itself (host2Device publishes it with a single map/unmap)
+	if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY)
+	    return;
 	// Force copy of hostBuffer to its mapped deviceBuffer
 	// (synchronization between device and mapped host memory
 	// is not automatic)
 	// queue.enqueueWriteBuffer(*(getDeviceBuffer(index)), CL_TRUE, 0,
 	queue.enqueueWriteBuffer(*(getDeviceBuffer(index)), CL_FALSE, 0,
 				 (pData->getNDArrays()->at(index)->size()) * pData->getElementSize(),
-				 getHostBuffer(index), { });
+				 getHostBuffer(index), { }, &lastWriteEvent);
 	// queue.flush is not needed because blocking_write parameter (second parameter) is set to CL_TRUE (operation is blocked
 	// until map is completed)
 	//queue.flush();
@@ -387,14 +434,40 @@ void DeviceDataProperties::host2Device(bool copyDataToDevice) {
     if(!host2DeviceCommonChecks()) {
 	return;
     }
+
+    // Don't overwrite mapped host buffers (or device data) still in use by the last writer or its readers
+    if(lastWriteEvent() != nullptr)
+	lastWriteEvent.wait();
+    if(!readEvents.empty())
+	cl::Event::waitForEvents(readEvents);
+    readEvents.clear();
+
+    // Writes are not waited for: consumers synchronize with them through lastWriteEvent (or our in-order queue)
     if (copyDataToDevice) {
     //if (true) {
-	for(dimIndexType i = 0; i < pData->getNDArrays()->size(); i++) {
+	// NDArrays (one per coil and/or frame) are uploaded as a pipeline: NDArray i+1 is being read from disk (if it is
+	// backed by a mapped file, see Data::getRawFileMapping()) while NDArray i is copied to the (pinned) mapped host
+	// buffer and NDArray i-1 is still being written to the device
+	std::vector<const NDArray*>* pNDArrays = pData->getNDArrays();
+	if(!pNDArrays->empty())
+	    pNDArrays->at(0)->prefetchHostData();
+	for(dimIndexType i = 0; i < pNDArrays->size(); i++) {
+	    if(i + 1 < pNDArrays->size())
+		pNDArrays->at(i + 1)->prefetchHostData();
 	    host2DeviceCommon(i);
 	}
     }
     copyDimsAndStridesVectorDataToMappedHostAndDeviceBuffer();
-    queue.finish();
+    if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY) {
+	// Zero-copy memory becomes NDArray host storage (their previous host data, if copied above, are freed), so host
+	// and device share data from now on and later transfers copy nothing
+	std::vector<const NDArray*>* pNDArrays = pData->getNDArrays();
+	for(dimIndexType i = 0; i < pNDArrays->size(); i++) {
+	    if(pNDArrays->at(i)->getHostDataAsVoidPointer() != getHostBuffer(i))
+		const_cast<NDArray*>(pNDArrays->at(i))->setExternalHostData(getHostBuffer(i), pZeroCopyHostMemory);
+	}
+	lastWriteEvent = syncMappedMemory(true, nullptr);
+    }
 }
 
 /**
@@ -406,6 +479,9 @@ void DeviceDataProperties::copyHostDataToMappedHostBuffer(dimIndexType i) {
     //void *memcpy(void *dest, const void *src, dimIndexType n)
     void* origin;
     origin = pData->getNDArray(i)->getHostDataAsVoidPointer();
+    // Zero-copy NDArray host data already are mapped host memory
+    if(origin == getHostBuffer(i))
+	return;
     memcpy(getHostBuffer(i), origin, (pData->getNDArrays()->at(i)->size()) * pData->getElementSize());
 }
 
@@ -415,20 +491,21 @@ void DeviceDataProperties::copyHostDataToMappedHostBuffer(dimIndexType i) {
  */
 void DeviceDataProperties::copyDimsAndStridesVectorDataToMappedHostAndDeviceBuffer() {
     try {    //void *memcpy(void *dest, const void *src, dimIndexType n)
-	memcpy(pDataDimsAndStridesHostBuffer, pData->getDataDimsAndStridesVector()->data(), pData->getDataDimsAndStridesVector()->size()*sizeof(dimIndexType));
+	memcpy(pDataDimsAndStridesHostBuffer, pData->getDataDimsAndStridesVector()->data(), pData->getDataDimsAndStridesVector()->size()*sizeof(index1DType));
 	// store offset to dimensions and strides vector in the last (not first) position of pDataDimsAndStridesOffsetHostBuffer.
 	// This way, for reading this value from a pointer to first element of image data we only have to go backwards 1 position
-	// of a uint buffer
-	dimIndexType numOfPosDataDimsAndStridesHostBuffer =
-	    dimsAndStridesArraySubbuferRoundedSize / sizeof(dimIndexType);
-	((dimIndexType*)pDataDimsAndStridesHostBuffer)[numOfPosDataDimsAndStridesHostBuffer - 1] = dataDimsAndStridesOffset;
+	// of an index1DType buffer
+	size_t numOfPosDataDimsAndStridesHostBuffer =
+	    dimsAndStridesArraySubbuferRoundedSize / sizeof(index1DType);
+	((index1DType*)pDataDimsAndStridesHostBuffer)[numOfPosDataDimsAndStridesHostBuffer - 1] = dataDimsAndStridesOffset;
 
 	// Force copy of hostBuffer to its mapped deviceBuffer
 	// (synchronization between device and mapped host memory
-	// is not automatic)
-	queue.enqueueWriteBuffer(*(pDataDimsAndStridesDeviceBuffer), CL_TRUE, 0,
-				 dimsAndStridesArraySubbuferRoundedSize,
-				 pDataDimsAndStridesHostBuffer, { });
+	// is not automatic). Zero-copy memory is synchronized by host2Device instead
+	if(hostMemoryPolicy != HOST_MEMORY_ZEROCOPY)
+	    queue.enqueueWriteBuffer(*(pDataDimsAndStridesDeviceBuffer), CL_TRUE, 0,
+				     dimsAndStridesArraySubbuferRoundedSize,
+				     pDataDimsAndStridesHostBuffer, { });
     }
     catch(cl::Error& err) {
 	BTTHROW(CLError(err), "DeviceDataProperties::copyDimsAndStridesVectorDataToMappedHostAndDeviceBuffer");
@@ -523,6 +600,10 @@ void DeviceDataProperties::device2HostCommon() {
 				  pCompleteDeviceBuffer->getInfo<CL_MEM_SIZE>() << " bytes\n");
 	DEVICEDATAPROPERTIES_CERR("dimsAndStridesArraySubbuferRoundedSize + allNDArraysRoundedSizeInBytes: " <<
 				  dimsAndStridesArraySubbuferRoundedSize + allNDArraysRoundedSizeInBytes << " bytes\n");
+	if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY) {
+	    syncMappedMemory(true, nullptr);
+	    return;
+	}
 	queue.enqueueReadBuffer(*(pCompleteDeviceBuffer), CL_TRUE, 0,
 				dimsAndStridesArraySubbuferRoundedSize + allNDArraysRoundedSizeInBytes,
 				pCompleteHostBuffer, { });
@@ -537,12 +618,17 @@ void DeviceDataProperties::device2HostCommon() {
 
 /**
  * @brief Copy data stored in device memory to host memory (from buffers or images).
- * @param[in] queueFinish true if queue.finish() method must be called to guarantee that kernel execution has finished before
+ * @param[in] queueFinish true to wait for the last writer of this data (or, if none was recorded, for the whole queue) before
  * copying data back to host memory
  */
 void DeviceDataProperties::device2Host(bool queueFinish) {
     if(queueFinish) {
-	queue.finish();
+	// The last writer may have been launched in another queue. Anything else enqueued in our own (in-order) queue
+	// completes before the (blocking) read anyway
+	if(lastWriteEvent() != nullptr)
+	    lastWriteEvent.wait();
+	else
+	    queue.finish();
     }
     if(pData == nullptr) {
 	return;
@@ -553,6 +639,220 @@ void DeviceDataProperties::device2Host(bool queueFinish) {
     device2HostCommon();
 }
 
+/**
+ * @brief Copy part of the data stored in device memory to (mapped) host memory, i.e. to the buffers returned by
+ * Data::getHostBuffer(), and to NDArray host data (if they are stored elsewhere).
+ * @param[in] range NDArrays (and region within them) to copy
+ * @param[in] blocking true to return after the copy has finished; otherwise, the returned event must be waited for before
+ * reading host memory
+ * @return event of the last enqueued read
+ */
+cl::Event DeviceDataProperties::device2Host(const DataRange& range, bool blocking) {
+    return transferRange(range, blocking, false);
+}
+
+/**
+ * @brief Copy part of the data stored in host memory to device memory. Data are taken from NDArray host data (or from mapped
+ * host memory for NDArrays without host data).
+ * @param[in] range NDArrays (and region within them) to copy
+ * @param[in] blocking true to return after the copy has finished; otherwise, host data must not be modified until the
+ * returned event completes
+ * @return event of the last enqueued write (also recorded as the last writer of this data)
+ */
+cl::Event DeviceDataProperties::host2Device(const DataRange& range, bool blocking) {
+    return transferRange(range, blocking, true);
+}
+
+/**
+ * @brief Enqueues transfers of part of the data between host and device memory.
+ *
+ * Whole NDArrays are transferred with plain buffer reads/writes (consecutive NDArrays being read with a single one, as
+ * they are contiguous in device memory) and partial regions with rectangular reads/writes. Transfers wait for the last
+ * writer of this data, which may have been enqueued in another queue, without blocking the host.
+ * @param[in] range NDArrays (and region within them) to transfer
+ * @param[in] blocking true to wait for the transfers to finish
+ * @param[in] toDevice true for host to device transfers, false for device to host ones
+ * @return event of the last enqueued transfer (our queue is in-order, so it completes after all the others)
+ */
+cl::Event DeviceDataProperties::transferRange(const DataRange& range, bool blocking, bool toDevice) {
+    cl::Event event;
+    if(pData == nullptr || pData->getNDArrays()->size() == 0)
+	return event;
+
+    dimIndexType numNDArrays = pData->getNDArrays()->size();
+    dimIndexType lastNDArray = (range.numNDArrays == 0) ? numNDArrays : range.firstNDArray + range.numNDArrays;
+    if(range.firstNDArray >= numNDArrays || lastNDArray > numNDArrays)
+	BTTHROW(std::out_of_range("NDArray range out of bounds"), "DeviceDataProperties::transferRange");
+
+    std::vector<cl::Event> waitList;
+    if(lastWriteEvent() != nullptr)
+	waitList.push_back(lastWriteEvent);
+    // Writes must not overtake commands (possibly in other queues) still reading the data
+    if(toDevice)
+	waitList.insert(waitList.end(), readEvents.begin(), readEvents.end());
+
+    // Zero-copy host data are copied straight into memory the last writer (or its readers) may still be using
+    if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY && toDevice && !waitList.empty())
+	cl::Event::waitForEvents(waitList);
+
+    try {
+	size_t elementSize = pData->getElementSize();
+	cl::size_type firstContiguousOffset = 0, contiguousSize = 0;
+
+	for(dimIndexType i = range.firstNDArray; i < lastNDArray; i++) {
+	    const NDArray* pNDArray = pData->getNDArray(i);
+	    size_t dims[3] = {NDARRAYWIDTH(pNDArray), NDARRAYHEIGHT(pNDArray), std::max<size_t>(NDARRAYDEPTH(pNDArray), 1)};
+
+	    size_t region[3];
+	    bool wholeNDArray = true;
+	    for(unsigned d = 0; d < 3; d++) {
+		region[d] = (range.region[d] != 0) ? range.region[d] : dims[d] - std::min<size_t>(range.origin[d], dims[d]);
+		if(region[d] == 0 || range.origin[d] + region[d] > dims[d])
+		    BTTHROW(std::out_of_range("region out of NDArray bounds"), "DeviceDataProperties::transferRange");
+		wholeNDArray &= (range.origin[d] == 0 && region[d] == dims[d]);
+	    }
+
+	    if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY) {
+		// Mapped host memory is device memory: only NDArray host data have to be copied into it (a single map/unmap
+		// below makes all changes visible)
+		if(toDevice)
+		    copyHostDataRegionToMappedHostBuffer(i, range.origin, region);
+		continue;
+	    }
+
+	    // NDArray host data stored apart from mapped host memory are read too: they are the source of host to device
+	    // transfers, so both copies must stay the same
+	    void* pNDArrayHost = toDevice ? nullptr : pNDArray->getHostDataAsVoidPointer();
+	    if(pNDArrayHost == getHostBuffer(i))
+		pNDArrayHost = nullptr;
+
+	    size_t sizeInBytes = pNDArray->size() * elementSize;
+	    if(wholeNDArray && !toDevice) {
+		// Gather consecutive whole NDArrays in a single read (only padding between them is read in excess)
+		cl::size_type offset = static_cast<char*>(getHostBuffer(i)) - static_cast<char*>(pCompleteHostBuffer);
+		if(contiguousSize == 0)
+		    firstContiguousOffset = offset;
+		contiguousSize = offset + sizeInBytes - firstContiguousOffset;
+		if(pNDArrayHost != nullptr) {
+		    queue.enqueueReadBuffer(*(getDeviceBuffer(i)), CL_FALSE, 0, sizeInBytes, pNDArrayHost, &waitList, &event);
+		    waitList.clear();
+		}
+		continue;
+	    }
+
+	    void* pHost = getHostBuffer(i);
+	    if(toDevice && pNDArray->getHostDataAsVoidPointer() != nullptr)
+		pHost = pNDArray->getHostDataAsVoidPointer();
+
+	    if(wholeNDArray) {
+		queue.enqueueWriteBuffer(*(getDeviceBuffer(i)), CL_FALSE, 0, sizeInBytes, pHost, &waitList, &event);
+	    }
+	    else {
+		cl::array<cl::size_type, 3> origin = {range.origin[0] * elementSize, range.origin[1], range.origin[2]};
+		cl::array<cl::size_type, 3> regionInBytes = {region[0] * elementSize, region[1], region[2]};
+		cl::size_type rowPitch = dims[0] * elementSize;
+		cl::size_type slicePitch = rowPitch * dims[1];
+
+		// Host buffers have the same layout as device ones, so origins and pitches are the same for both
+		if(toDevice)
+		    queue.enqueueWriteBufferRect(*(getDeviceBuffer(i)), CL_FALSE, origin, origin, regionInBytes, rowPitch, slicePitch,
+						 rowPitch, slicePitch, pHost, &waitList, &event);
+		else {
+		    queue.enqueueReadBufferRect(*(getDeviceBuffer(i)), CL_FALSE, origin, origin, regionInBytes, rowPitch, slicePitch,
+						rowPitch, slicePitch, pHost, &waitList, &event);
+		    if(pNDArrayHost != nullptr)
+			queue.enqueueReadBufferRect(*(getDeviceBuffer(i)), CL_FALSE, origin, origin, regionInBytes, rowPitch,
+						    slicePitch, rowPitch, slicePitch, pNDArrayHost, &waitList, &event);
+		}
+	    }
+
+	    // Later transfers are ordered after this one by our in-order queue
+	    waitList.clear();
+	}
+
+	if(hostMemoryPolicy == HOST_MEMORY_ZEROCOPY)
+	    event = syncMappedMemory(false, &waitList);
+	else if(contiguousSize != 0)
+	    queue.enqueueReadBuffer(*pCompleteDeviceBuffer, CL_FALSE, firstContiguousOffset, contiguousSize,
+				    static_cast<char*>(pCompleteHostBuffer) + firstContiguousOffset, &waitList, &event);
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "DeviceDataProperties::transferRange");
+    }
+
+    if(toDevice) {
+	lastWriteEvent = event;
+	readEvents.clear();
+    }
+    else if(event() != nullptr)
+	addReadEvent(event);
+    if(blocking)
+	event.wait();
+    return event;
+}
+
+/**
+ * @brief Records a command that reads this data in device memory, so that later writers (possibly in other queues) wait
+ * for it. Commands in the same (in-order) queue complete in order, so only the last reader of every queue is kept.
+ * @param[in] event event of the reading command
+ */
+void DeviceDataProperties::addReadEvent(const cl::Event& event) {
+    cl_command_queue eventQueue = event.getInfo<CL_EVENT_COMMAND_QUEUE>()();
+    for(cl::Event& readEvent : readEvents) {
+	if(readEvent.getInfo<CL_EVENT_COMMAND_QUEUE>()() == eventQueue) {
+	    readEvent = event;
+	    return;
+	}
+    }
+    readEvents.push_back(event);
+}
+
+/**
+ * @brief Synchronizes zero-copy device memory with its (permanently) mapped host memory by unmapping and mapping it again.
+ * Host writes are visible to the device after the unmap, and device writes to the host after the map; on CPU and unified
+ * memory devices neither of them copies anything.
+ * @param[in] blocking true to wait for the map to finish
+ * @param[in] waitList events to wait for before unmapping (nullptr for none)
+ * @return event of the map
+ */
+cl::Event DeviceDataProperties::syncMappedMemory(bool blocking, const std::vector<cl::Event>* waitList) {
+    cl::Event event;
+    queue.enqueueUnmapMemObject(*pCompleteDeviceBuffer, pCompleteHostBuffer, waitList);
+    void* pMappedHostBuffer = queue.enqueueMapBuffer(*pCompleteDeviceBuffer, blocking ? CL_TRUE : CL_FALSE, CL_MAP_READ | CL_MAP_WRITE,
+						     0, dimsAndStridesArraySubbuferRoundedSize + allNDArraysRoundedSizeInBytes,
+						     nullptr, &event);
+    // Buffers created with CL_MEM_USE_HOST_PTR are always mapped at their host pointer, so host buffers handed out
+    // before are still valid
+    assert(pMappedHostBuffer == pCompleteHostBuffer);
+    (void) pMappedHostBuffer;
+    return event;
+}
+
+/**
+ * @brief Copies a region of NDArray host data to mapped host memory
+ * @param[in] index NDArray index
+ * @param[in] origin origin of the region (columns, rows, slices), in elements
+ * @param[in] region size of the region (columns, rows, slices), in elements
+ */
+void DeviceDataProperties::copyHostDataRegionToMappedHostBuffer(dimIndexType index, const dimIndexType origin[3], const size_t region[3]) {
+    const NDArray* pNDArray = pData->getNDArray(index);
+    const char* pSource = static_cast<const char*>(pNDArray->getHostDataAsVoidPointer());
+    char* pDestination = static_cast<char*>(getHostBuffer(index));
+    // Zero-copy NDArray host data already are mapped host memory
+    if(pSource == nullptr || pSource == pDestination)
+	return;
+
+    size_t elementSize = pData->getElementSize();
+    size_t rowPitch = NDARRAYWIDTH(pNDArray) * elementSize;
+    size_t slicePitch = rowPitch * NDARRAYHEIGHT(pNDArray);
+    for(size_t z = 0; z < region[2]; z++) {
+	for(size_t y = 0; y < region[1]; y++) {
+	    size_t offset = (origin[2] + z) * slicePitch + (origin[1] + y) * rowPitch + origin[0] * elementSize;
+	    memcpy(pDestination + offset, pSource + offset, region[0] * elementSize);
+	}
+    }
+}
+
 /**
  * @brief Unbind a CLapp object (for accessing to OpenCL basic functions) from this Data object.
  *
@@ -595,9 +895,24 @@ void DeviceDataProperties::delApp() {
 	    delete(pDeviceBuffer);
 	    pDeviceBuffer = nullptr;
 	}
-	queue.enqueueUnmapMemObject(*(pCompleteDeviceBuffer), pCompleteHostBuffer);
+	cl::Event unmapEvent;
+	queue.enqueueUnmapMemObject(*(pCompleteDeviceBuffer), pCompleteHostBuffer, nullptr, &unmapEvent);
+
+	// Give the buffer back to the pool only once every command accessing it is done: its last writer and the readers
+	// since then (any of which may be in another queue), and the unmap (the next owner may use another queue). Zero-copy
+	// buffers are just dropped, as NDArrays keep using their host memory
+	std::vector<cl::Event> accessEvents = readEvents;
+	accessEvents.push_back(unmapEvent);
+	if(lastWriteEvent() != nullptr)
+	    accessEvents.push_back(lastWriteEvent);
+	cl::Event::waitForEvents(accessEvents);
+	lastWriteEvent = cl::Event();
+	readEvents.clear();
+	if(hostMemoryPolicy != HOST_MEMORY_ZEROCOPY)
+	    pBufferPool->release(*pCompleteDeviceBuffer);
 	delete(pCompleteDeviceBuffer);
 	pCompleteDeviceBuffer = nullptr;
+	pZeroCopyHostMemory = nullptr;
 	pCompleteHostBuffer = nullptr;
     }
     catch(cl::Error& err) {
@@ -0,0 +1,265 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#include <OpenCLIPER/FFTPlanCache.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <sys/stat.h>
+
+// Uncomment to show class-specific debug messages
+//#define FFTPLANCACHE_DEBUG
+
+#if !defined NDEBUG && defined FFTPLANCACHE_DEBUG
+    #define FFTPLANCACHE_CERR(x) CERR(x)
+#else
+    #define FFTPLANCACHE_CERR(x)
+    #undef FFTPLANCACHE_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Build a string which uniquely identifies a plan for a given device (the device is added by getPlan)
+ * @return the key string
+ */
+const std::string FFTPlanCache::PlanParameters::key() const {
+    std::ostringstream s;
+    s << dim << ":";
+    for(unsigned i = 0; i < static_cast<unsigned>(dim); i++)
+	s << sizes[i] << "/" << strides[i] << ",";
+    s << ":" << batchSize << ":" << batchDistance << ":" << precision << ":" << placement;
+    s << ":" << std::hexfloat << forwardScale << ":" << backwardScale << ":" << centered;
+    return s.str();
+}
+
+/**
+ * @brief Generate the source of a clFFT pre or post callback for a centered transform
+ *
+ * For even sizes, shifting the input by half its size multiplies the spectrum by (-1)^k and vice versa, so
+ * fftshift(FFT(ifftshift(x))) = (-1)^(k+N/2) FFT((-1)^n x) along every transformed dimension. Callbacks apply this
+ * checkerboard modulation while clFFT loads and stores data, so no extra pass over the volume is needed.
+ * @param[in] parameters plan description
+ * @param[in] post true to generate the post callback (centerPost), false for the pre callback (centerPre)
+ * @return callback source code
+ */
+static std::string centeredCallbackSource(const FFTPlanCache::PlanParameters& parameters, bool post) {
+    const char* complexTypeName = (parameters.precision == CLFFT_DOUBLE || parameters.precision == CLFFT_DOUBLE_FAST) ? "double2" : "float2";
+
+    // Parity of the sum of coordinates along transformed dimensions (plus N/2 along each of them in the post callback)
+    std::ostringstream parity;
+    size_t halfSizesSum = 0;
+    for(unsigned i = 0; i < static_cast<unsigned>(parameters.dim); i++) {
+	parity << "(offset / " << parameters.strides[i] << "u) % " << parameters.sizes[i] << "u + ";
+	halfSizesSum += parameters.sizes[i] / 2;
+    }
+    parity << (post ? halfSizesSum : 0) << "u";
+
+    // Each callback gets its own helper: clFFT pastes both sources into the same program
+    std::ostringstream s;
+    if(post) {
+	s << "uint centerParityPost(uint offset) { return " << parity.str() << "; }\n";
+	s << "void centerPost(__global void* output, uint outoffset, __global void* userdata, " << complexTypeName << " fftoutput) {\n";
+	s << "    ((__global " << complexTypeName << "*) output)[outoffset] = (centerParityPost(outoffset) & 1) ? -fftoutput : fftoutput;\n";
+	s << "}\n";
+    }
+    else {
+	s << "uint centerParityPre(uint offset) { return " << parity.str() << "; }\n";
+	s << complexTypeName << " centerPre(__global void* input, uint inoffset, __global void* userdata) {\n";
+	s << "    " << complexTypeName << " v = ((__global " << complexTypeName << "*) input)[inoffset];\n";
+	s << "    return (centerParityPre(inoffset) & 1) ? -v : v;\n";
+	s << "}\n";
+    }
+    return s.str();
+}
+
+/**
+ * @brief Set up the clFFT library for the given context and enable clFFT's on-disk kernel cache
+ * @param[in] context OpenCL context plans will be created in
+ */
+FFTPlanCache::FFTPlanCache(const cl::Context& context): context(context) {
+    // Let clFFT save baked kernels to (and load them from) the user's kernel cache, unless the user wants them somewhere else
+    char* home = getenv("HOME");
+    if(home && !getenv("CLFFT_CACHE_PATH")) {
+	std::string cacheSubdir = KERNEL_USER_DIR "/cache/clfft";
+
+	// Check for existent cache directories and create them if necessary
+	struct stat statBuf;
+	int err = 0;
+	unsigned slashPos = 0;
+	while(slashPos < cacheSubdir.size()) {
+	    slashPos = cacheSubdir.find('/', slashPos + 1);
+	    auto dir = std::string(home) + "/" + cacheSubdir.substr(0, slashPos);
+
+	    if((::stat(dir.c_str(), &statBuf)) == -1) {
+		if(errno == ENOENT)
+		    err |= ::mkdir(dir.c_str(), 0755);
+		else
+		    err |= 1;
+	    }
+	}
+
+	if(err == 0)
+	    setenv("CLFFT_CACHE_PATH", (std::string(home) + "/" + cacheSubdir).c_str(), 0);
+	else
+	    std::cerr << "Error creating clFFT cache directory. FFT kernels will be rebuilt every run\n";
+    }
+
+    clfftSetupData fftSetup;
+    cl_int err;
+
+    if((err = clfftInitSetupData(&fftSetup)) != CL_SUCCESS) {
+	std::string errStr = "clfftInitSetupData: ";
+	errStr += CLapp::getOpenCLErrorCodeStr(err);
+	BTTHROW(CLError(err, errStr.c_str()), "FFTPlanCache::FFTPlanCache");
+    }
+
+    if((err = clfftSetup(&fftSetup)) != CL_SUCCESS) {
+	std::string errStr = "clfftSetup: ";
+	errStr += CLapp::getOpenCLErrorCodeStr(err);
+	BTTHROW(CLError(err, errStr.c_str()), "FFTPlanCache::FFTPlanCache");
+    }
+}
+
+/**
+ * @brief Release every cached plan and the clFFT library
+ */
+FFTPlanCache::~FFTPlanCache() {
+    FFTPLANCACHE_CERR("FFT plan cache: " << hits << " hits, " << misses << " misses\n");
+
+    for(auto& plan: plans)
+	clfftDestroyPlan(&plan.second);
+    plans.clear();
+
+    clfftTeardown();
+}
+
+/**
+ * @brief Get a baked plan matching the given parameters, creating and baking it if no such plan exists yet
+ *
+ * Offsets are not part of the key, so callers must set them (clfftSetPlanOffsetIn/Out) before every enqueue.
+ * Plans are only shared among queues of the same device, as they are baked for the device of the queue they were first requested for.
+ * @param[in] parameters plan description
+ * @param[in] queue command queue the plan will be enqueued on (also used to bake a new plan)
+ * @return handle to the cached plan (owned by the cache; do not destroy it)
+ */
+clfftPlanHandle FFTPlanCache::getPlan(const PlanParameters& parameters, cl::CommandQueue& queue) {
+    const std::lock_guard<std::mutex> lock(plansMutex);
+
+    cl_device_id device = queue.getInfo<CL_QUEUE_DEVICE>()();
+    std::ostringstream deviceKey;
+    deviceKey << device << "|";
+    const std::string key = deviceKey.str() + parameters.key();
+    auto it = plans.find(key);
+    if(it != plans.end()) {
+	hits++;
+	FFTPLANCACHE_CERR("Reusing FFT plan " << key << "\n");
+	return it->second;
+    }
+    misses++;
+    FFTPLANCACHE_CERR("Baking FFT plan " << key << "\n");
+
+    clfftPlanHandle plan;
+    cl_int err;
+    std::string errStr;
+
+    //Create a default plan
+    if((err = clfftCreateDefaultPlan(&plan, context(), parameters.dim, parameters.sizes)) != CL_SUCCESS) {
+	errStr = "clfftCreateDefaultPlan: ";
+	errStr += CLapp::getOpenCLErrorCodeStr(err);
+	if(err == CLFFT_NOTIMPLEMENTED)
+	    errStr += ". Hint: data dimensions must be combinations of powers of 2, 3, 5, and 7";
+	BTTHROW(CLError(err, errStr.c_str()), "FFTPlanCache::getPlan");
+    }
+
+    // Callbacks for centered transforms
+    std::string preCallbackSource, postCallbackSource;
+    if(parameters.centered) {
+	for(unsigned i = 0; i < static_cast<unsigned>(parameters.dim); i++)
+	    if(parameters.sizes[i] % 2 != 0) {
+		clfftDestroyPlan(&plan);
+		BTTHROW(CLError(CLFFT_NOTIMPLEMENTED, "Centered FFTs are only supported for even sizes"), "FFTPlanCache::getPlan");
+	    }
+
+	preCallbackSource = centeredCallbackSource(parameters, false);
+	postCallbackSource = centeredCallbackSource(parameters, true);
+	if(callbackUserData() == nullptr)
+	    callbackUserData = cl::Buffer(context, CL_MEM_READ_WRITE, sizeof(cl_float));
+    }
+
+    // Set plan parameters and bake it. Destroy the half-built plan if anything goes wrong
+    const char* failedCall = nullptr;
+    size_t strides[3] = {parameters.strides[0], parameters.strides[1], parameters.strides[2]};
+    if((err = clfftSetPlanPrecision(plan, parameters.precision)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanPrecision: ";
+    else if((err = clfftSetLayout(plan, CLFFT_COMPLEX_INTERLEAVED, CLFFT_COMPLEX_INTERLEAVED)) != CL_SUCCESS)
+	failedCall = "clfftSetLayout: ";
+    else if((err = clfftSetResultLocation(plan, parameters.placement)) != CL_SUCCESS)
+	failedCall = "clfftSetResultLocation: ";
+    else if((err = clfftSetPlanInStride(plan, parameters.dim, strides)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanInStride: ";
+    else if((err = clfftSetPlanOutStride(plan, parameters.dim, strides)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanOutStride: ";
+    else if((err = clfftSetPlanBatchSize(plan, parameters.batchSize)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanBatchSize: ";
+    else if((err = clfftSetPlanDistance(plan, parameters.batchDistance, parameters.batchDistance)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanDistance: ";
+    else if((err = clfftSetPlanScale(plan, CLFFT_FORWARD, parameters.forwardScale)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanScale (forward): ";
+    else if((err = clfftSetPlanScale(plan, CLFFT_BACKWARD, parameters.backwardScale)) != CL_SUCCESS)
+	failedCall = "clfftSetPlanScale (backward): ";
+    else if(parameters.centered &&
+	    ((err = clfftSetPlanCallback(plan, "centerPre", preCallbackSource.c_str(), 0, PRECALLBACK, &callbackUserData(), 1)) != CL_SUCCESS))
+	failedCall = "clfftSetPlanCallback (pre): ";
+    else if(parameters.centered &&
+	    ((err = clfftSetPlanCallback(plan, "centerPost", postCallbackSource.c_str(), 0, POSTCALLBACK, &callbackUserData(), 1)) != CL_SUCCESS))
+	failedCall = "clfftSetPlanCallback (post): ";
+    else if((err = clfftBakePlan(plan, 1, &queue(), NULL, NULL)) != CL_SUCCESS)
+	failedCall = "clfftBakePlan: ";
+
+    if(failedCall) {
+	clfftDestroyPlan(&plan);
+	errStr = failedCall;
+	errStr += CLapp::getOpenCLErrorCodeStr(err);
+	BTTHROW(CLError(err, errStr.c_str()), "FFTPlanCache::getPlan");
+    }
+
+    plans[key] = plan;
+    return plan;
+}
+
+} // namespace OpenCLIPER
+
+#undef FFTPLANCACHE_DEBUG
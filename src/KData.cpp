@@ -231,13 +231,16 @@ void KData::commonCopyConstructor(const std::shared_ptr<CLapp>& pCLapp, const st
  * @param[in] coilsFileNameSuffix part of the file name before the coil number
  * @param[in] framesFileNameSuffix part of the file name before the frame number
  * @param[in] fileNameExtension extension for file names
+ * @param[in] mapFiles true to map files (also those of sensitivity maps and sampling masks) into memory instead of reading
+ * them (see Data::getRawFileMapping())
  */
 KData::KData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNamePrefix,
 	     std::vector<std::vector< dimIndexType >*>*& pArraysDims, numCoilsType numCoils,
 	     std::vector <dimIndexType>*& pDynDims, uint dataToLoad,
 	     const std::vector<std::string>& otherFieldsFileNamePrefixes, const std::string& coilsFileNameSuffix,
-	     const std::string& framesFileNameSuffix, const std::string& fileNameExtension):
+	     const std::string& framesFileNameSuffix, const std::string& fileNameExtension, bool mapFiles):
     Data() {
+    rawFileMapping = mapFiles;
     loadRawHostData(dataFileNamePrefix, otherFieldsFileNamePrefixes, dataToLoad, pArraysDims, numCoils, pDynDims,
 		    coilsFileNameSuffix, framesFileNameSuffix, fileNameExtension);
     setApp(pCLapp, true);
@@ -275,10 +278,14 @@ void KData::loadCFLData(const std::string &fileName, std::vector< dimIndexType >
  * @brief Constructor that creates an KData object from a file in matlab format (containing one ore more variables).
  * @param[in] pCLapp pointer to CLapp object (contains an initialized OpenCL environment)
  * @param[in] fileName name of the data file
+ * @param[in] asyncLoad true to load data in a background thread (see Data::waitLoadEnd())
+ * @param[in] mapFiles true to map CFL files (also those of sensitivity maps and sampling masks) into memory instead of
+ * reading them (see Data::getRawFileMapping())
  * @throw std::invalid_argument if dimensions and KData mandatory variables are missing from matlab file or KData dimensions are incorrect
  * according to dimensions variable
  */
-KData::KData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName, bool asyncLoad) : Data() {
+KData::KData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName, bool asyncLoad, bool mapFiles) : Data() {
+    rawFileMapping = mapFiles;
     if(asyncLoad) {
 	this->pFileLoaderThread = std::unique_ptr<std::thread>(new std::thread(KData::create, this, pCLapp, fileName));
     }
@@ -290,7 +297,7 @@ KData::KData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName,
 
 
 void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName) {
-    std::map<std::string, matvar_t*>* pMatlabVariablesMap;
+    std::unique_ptr<MatlabFileIndex> pMatlabFile;
     SensitivityMapsData* pSensitivityMapsData;
     SamplingMasksData* pSamplingMasksData;
     #ifdef KDATA_DEBUG
@@ -298,7 +305,8 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
     KDATA_CERR("Reading matlab file...\n");
 #endif
     try {
-    	pMatlabVariablesMap = Data::readMatlabVariablesFromFile(fileName);
+    	// Only variable headers are read here, data are read when (and if) they are needed
+    	pMatlabFile.reset(new MatlabFileIndex(fileName));
     } catch(std::invalid_argument& e) { // Not Matlab file, try CFL format file
     	std::vector<dimIndexType>* pArraySpatialDims = new std::vector<dimIndexType>;
     	std::string headerFileName;
@@ -311,7 +319,8 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 		std::string sensitivityMapsDataName = LPISupport::Utils::basename(fileName) + std::string(CFLSensMapsSuffix);
 
 		try {
-			pSensitivityMapsData = new SensitivityMapsData(pCLapp, sensitivityMapsDataName, pArraySpatialDims, thisObj->nCoils);
+			pSensitivityMapsData = new SensitivityMapsData(pCLapp, sensitivityMapsDataName, pArraySpatialDims, thisObj->nCoils,
+								       thisObj->rawFileMapping);
 			thisObj->setSensitivityMapsData(pSensitivityMapsData);
 		} catch (std::exception &e) {
 			KDATA_CERR("Warning: no sensitivity maps file " + sensitivityMapsDataName + "\n");
@@ -326,12 +335,14 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 				KDATA_CERR("Found.");
 				dimIndexType numColumns = pArraySpatialDims->at(0);
 				pArraySpatialDims->erase(pArraySpatialDims->begin()); // Remove width from spatial dimensions (row mask format)
-				pSamplingMasksData = new SamplingMasksData(pCLapp, samplingMasksDataName, pArraySpatialDims, thisObj->getDynDims(), numColumns, TYPEID_INDEX);
+				pSamplingMasksData = new SamplingMasksData(pCLapp, samplingMasksDataName, pArraySpatialDims, thisObj->getDynDims(), numColumns, TYPEID_INDEX,
+									   thisObj->rawFileMapping);
 				thisObj->setSamplingMasksData(pSamplingMasksData);
 			} else { // pixelmask format, dimensions: width x height x number of frames
 				samplingMasksDataName = LPISupport::Utils::basename(fileName) + std::string(CFLSampMasksSuffixPixelMask);
 				KDATA_CERR("Not found. Trying to open " + samplingMasksDataName + "... ");
-				pSamplingMasksData = new SamplingMasksData(pCLapp, samplingMasksDataName, pArraySpatialDims,thisObj->getDynDims(), numColumns, TYPEID_CL_UCHAR);
+				pSamplingMasksData = new SamplingMasksData(pCLapp, samplingMasksDataName, pArraySpatialDims,thisObj->getDynDims(), numColumns, TYPEID_CL_UCHAR,
+									   thisObj->rawFileMapping);
 				thisObj->setSamplingMasksData(pSamplingMasksData);
 			}
 		} catch (std::exception &e) {
@@ -356,7 +367,7 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 
     // Read of matlab variable storing number of spatial and temporal dimensions of data (if not exists it is an unrecoverable error and method aborts)
     try {
-	pDimsMatVar = pMatlabVariablesMap->at(MatVarDimsData::matVarNameDims);
+	pDimsMatVar = pMatlabFile->readVariable(MatVarDimsData::matVarNameDims);
     }
     catch(std::out_of_range& e) {
 	BTTHROW(std::invalid_argument("Error: no Dims variable in matlab file"), "KData::KData");
@@ -379,8 +390,8 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 
     // Read of matlab variable storing KData data (if not exists it is an unrecoverable error and method is aborted)
     try {
-	pKDataMatVar = pMatlabVariablesMap->at(matVarNameKData);
-	// out_of_range exception if there is no value with the key "KData" in the map
+	pKDataMatVar = pMatlabFile->getVariableInfo(matVarNameKData);
+	// out_of_range exception if there is no variable named "KData" in the file
     }
     catch(std::out_of_range& e) {
 	BTTHROW(std::invalid_argument("Error: no KData variable in matlab file"), "KData::KData");
@@ -394,12 +405,13 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 	numOfNDArraysToBeRead = 1; // At least 1 NDArray exist when there is only 1 coil and 1 time frame
     }
     KDATA_CERR("KData reading data...\n" << std::endl);
-    ((Data*)(thisObj))->loadMatlabHostData(pKDataMatVar, nSpatialDims, numOfNDArraysToBeRead);
+    // KData are read from the file one NDArray at a time, so they are never held twice in memory
+    ((Data*)(thisObj))->loadMatlabHostData(*pMatlabFile, matVarNameKData, nSpatialDims, numOfNDArraysToBeRead);
     KDATA_CERR("Done.\n");
 
     // Read of matlab variable storing sensitivity maps data (if not exists, a warning error is shown)
     try {
-	pSensitivityMapsDataMatVar = pMatlabVariablesMap->at(SensitivityMapsData::matVarNameSensitivityMaps);
+	pSensitivityMapsDataMatVar = pMatlabFile->readVariable(SensitivityMapsData::matVarNameSensitivityMaps);
 	// Create sensitivity maps and store them in class field
 	pSensitivityMapsData = new SensitivityMapsData(pCLapp, pSensitivityMapsDataMatVar, thisObj->pSpatialDimsFullySampled.get(), thisObj->nCoils);
 	thisObj->setSensitivityMapsData(pSensitivityMapsData);
@@ -411,7 +423,7 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 
     // Read of matlab variable storing sampling masks data (if not exists, a warning error is shown)
     try {
-	pSamplingMasksDataMatVar = pMatlabVariablesMap->at(SamplingMasksData::matVarNameSamplingMasks);
+	pSamplingMasksDataMatVar = pMatlabFile->readVariable(SamplingMasksData::matVarNameSamplingMasks);
 	// Create sampling masks and store them in class field
 	pSamplingMasksData = new SamplingMasksData(pCLapp, pSamplingMasksDataMatVar, thisObj->getNDArray(0)->getDims());
 	thisObj->setSamplingMasksData(pSamplingMasksData);
@@ -422,7 +434,7 @@ void KData::create(KData* thisObj, const std::shared_ptr<CLapp>& pCLapp, const s
 
     // Read of matlab variable storing trajectories data (if not exists, a warning error is shown)
     try {
-	pTrajectoriesMatVar = pMatlabVariablesMap->at(Trajectories::matVarNameTrajectories);
+	pTrajectoriesMatVar = pMatlabFile->readVariable(Trajectories::matVarNameTrajectories);
 	// Create sampling masks and store them in class field (number of spatial dimensions of sampling mask data is
 	// number of spatial dimensions of KData - 1
 	Trajectories* pTrajectoriesData = new Trajectories(pCLapp, pTrajectoriesMatVar, nSpatialDims);
@@ -597,7 +609,8 @@ void KData::loadRawHostData(const std::string &dataFileNamePrefix, const std::ve
 	SensitivityMapsData* pSensitivityMapsData =
 	    new OpenCLIPER::SensitivityMapsData(pCLapp,
 						dataFileNamePrefix + otherFieldsFileNamePrefixes.at(SENSITIVITYMAPSPREFIX),
-						pArraysDimsSensitivityMaps, numCoils, coilsFileNameSuffix, fileNameExtension);
+						pArraysDimsSensitivityMaps, numCoils, coilsFileNameSuffix, fileNameExtension,
+						rawFileMapping);
 	setSensitivityMapsData(pSensitivityMapsData);
     }
 
@@ -623,7 +636,7 @@ void KData::loadRawHostData(const std::string &dataFileNamePrefix, const std::ve
 	SamplingMasksData* pSamplingMasksData =
 	    new OpenCLIPER::SamplingMasksData(pCLapp, dataFileNamePrefix + otherFieldsFileNamePrefixes.at(SAMPLINGMASKSPREFIX),
 					      pArraysDimsSamplingMasks, pDynDimsSamplingMasks, pArraysDims->at(0)->at(WIDTHPOS) , framesFileNameSuffix,
-					      fileNameExtension);
+					      fileNameExtension, TYPEID_INDEX, rawFileMapping);
 	setSamplingMasksData(pSamplingMasksData);
     }
 
@@ -684,8 +697,39 @@ void KData::saveRawHostData(const std::string &fileNamePrefix,
 #endif
 }
 
+/**
+ * @brief Saves data (and sensitivity maps and sampling masks, if any) to files in CFL format
+ * @param[in] baseFileName name of the files without suffixes nor extension
+ */
 void KData::saveCFLData(const std::string &baseFileName) {
+	if(getElementDataType() == TYPEID_COMPLEXHALF)
+		BTTHROW(std::invalid_argument("half precision data can't be saved in CFL format (convert them with ComplexHalfConvert first)"), "KData::saveCFLData");
+	device2Host();
+	writeCFLData(baseFileName);
+}
+
+/**
+ * @brief Copies data back to host memory and saves them (and sensitivity maps and sampling masks, if any) to files in CFL
+ * format in the background. Files are written straight from host buffers, which must not be modified until the save ends
+ * (see Data::submitSave()).
+ * @param[in] baseFileName name of the files without suffixes nor extension
+ * @param[in] pWriter writer running the save (DataWriter::getDefault() if nullptr)
+ * @return future which becomes ready when files have been written (get() rethrows any error)
+ */
+std::shared_future<void> KData::saveCFLDataAsync(const std::string &baseFileName, DataWriter* pWriter) {
+	if(getElementDataType() == TYPEID_COMPLEXHALF)
+		BTTHROW(std::invalid_argument("half precision data can't be saved in CFL format (convert them with ComplexHalfConvert first)"), "KData::saveCFLDataAsync");
 	device2Host();
+	return submitSave([this, baseFileName]() {
+		writeCFLData(baseFileName);
+	}, pWriter);
+}
+
+/**
+ * @brief Writes data (already in host memory) and sensitivity maps and sampling masks (if any) to files in CFL format
+ * @param[in] baseFileName name of the files without suffixes nor extension
+ */
+void KData::writeCFLData(const std::string &baseFileName) {
 	saveRawData(baseFileName + ".cfl");
 	if (pSensitivityMapsData != nullptr)
 		pSensitivityMapsData->saveRawData(baseFileName + CFLSensMapsSuffix);
@@ -835,6 +879,43 @@ KData* KData::genTestKData(const std::shared_ptr<CLapp>& pCLapp, dimIndexType wi
  * matlab variables to be saved ot number of spatial dimensions of data is less than 1
  */
 void KData::matlabSave(const std::string &fileName) {
+    prepareMatlabSave();
+    matlabWrite(fileName);
+}
+
+/**
+ * @brief Copies data back to host memory and saves them to a file in matlab format in the background. The file is written
+ * straight from host buffers, which must not be modified until the save ends (see Data::submitSave()).
+ * @param[in] fileName name of the file tha data will be saved to
+ * @param[in] pWriter writer running the save (DataWriter::getDefault() if nullptr)
+ * @return future which becomes ready when the file has been written (get() rethrows any error, see matlabSave())
+ */
+std::shared_future<void> KData::matlabSaveAsync(const std::string &fileName, DataWriter* pWriter) {
+    prepareMatlabSave();
+    return submitSave([this, fileName]() {
+	matlabWrite(fileName);
+    }, pWriter);
+}
+
+/**
+ * @brief Copies data back to host memory and creates the matlab Dims variable (if not created yet) before saving data
+ * to a matlab file
+ */
+void KData::prepareMatlabSave() {
+    this->device2Host();
+
+    if(pMatVarDimsData == nullptr) {
+	// Create matlab Dims variable
+	pMatVarDimsData.reset(new MatVarDimsData(pCLapp, getNDArray(0)->getDims(), getAllSizesEqual(), getNCoils(), getDynDims()));
+    }
+}
+
+/**
+ * @brief Writes data (already in host memory, see prepareMatlabSave()) to a file in matlab format
+ * @param[in] fileName name of the file tha data will be saved to
+ * @throw std::invalid_argument if matlab file cannot be opened or number of spatial dimensions of data is less than 1
+ */
+void KData::matlabWrite(const std::string &fileName) {
     mat_t* matfp;
     //std::vector<dimIndexType> matVarKDataDimsVector, matVarSensMapsDimsVector, matVarSampMasksDimsVector;
     matfp = Mat_CreateVer(fileName.c_str(), NULL, MAT_FT_DEFAULT);
@@ -842,13 +923,7 @@ void KData::matlabSave(const std::string &fileName) {
 	BTTHROW(std::invalid_argument(std::string("Error creating MAT file")  + fileName), "KData::matlabSave");
     }
 
-    this->device2Host();
-
     // Save dims variable
-    if(pMatVarDimsData == nullptr) {
-	// Create matlab Dims variable
-	pMatVarDimsData.reset(new MatVarDimsData(pCLapp, getNDArray(0)->getDims(), getAllSizesEqual(), getNCoils(), getDynDims()));
-    }
     pMatVarDimsData->matlabSaveVariable(matfp);
 
     // Only image sequences with the same spatial dimensions are supported
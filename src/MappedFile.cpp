@@ -0,0 +1,122 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/MappedFile.hpp>
+#include <LPISupport/Utils.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// Uncomment to show class-specific debug messages
+//#define MAPPEDFILE_DEBUG
+
+#if !defined NDEBUG && defined MAPPEDFILE_DEBUG
+    #define MAPPEDFILE_CERR(x) CERR(x)
+#else
+    #define MAPPEDFILE_CERR(x)
+    #undef MAPPEDFILE_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Maps a whole file into host memory
+ * @param[in] fileName name of the file
+ * @throw std::invalid_argument if the file cannot be opened or mapped
+ */
+MappedFile::MappedFile(const std::string& fileName) {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if(fd == -1)
+	BTTHROW(std::invalid_argument(fileName + " cannot be read: " + strerror(errno)), "MappedFile::MappedFile");
+
+    struct stat statBuf;
+    if(::fstat(fd, &statBuf) == -1) {
+	int err = errno;
+	::close(fd);
+	BTTHROW(std::invalid_argument(fileName + " cannot be read: " + strerror(err)), "MappedFile::MappedFile");
+    }
+    fileSize = statBuf.st_size;
+
+    // mmap does not accept empty mappings
+    if(fileSize != 0) {
+	// Private writable mapping: NDArrays backed by it can be modified in host memory without touching the file
+	pData = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if(pData == MAP_FAILED) {
+	    int err = errno;
+	    pData = nullptr;
+	    ::close(fd);
+	    BTTHROW(std::invalid_argument(fileName + " cannot be mapped: " + strerror(err)), "MappedFile::MappedFile");
+	}
+
+	// Data are usually read once, front to back (e.g. when copied to the device)
+	::madvise(pData, fileSize, MADV_SEQUENTIAL);
+    }
+
+    // The mapping holds its own reference to the file
+    ::close(fd);
+    MAPPEDFILE_CERR("Mapped " << fileName << " (" << fileSize << " bytes) at " << pData << "\n");
+}
+
+/**
+ * @brief Asks the OS to start reading part of the file in the background, so that it is already in memory when it is
+ * accessed (returns immediately)
+ * @param[in] offsetInBytes offset of the first byte to read from the beginning of the file
+ * @param[in] sizeInBytes number of bytes to read
+ */
+void MappedFile::prefetch(size_t offsetInBytes, size_t sizeInBytes) const {
+    if(pData == nullptr || offsetInBytes >= fileSize)
+	return;
+    sizeInBytes = std::min(sizeInBytes, fileSize - offsetInBytes);
+
+    // madvise needs a page-aligned address
+    size_t pageSize = ::sysconf(_SC_PAGESIZE);
+    size_t alignedOffset = offsetInBytes - offsetInBytes % pageSize;
+    // Only a hint: nothing to do if it fails
+    ::madvise(static_cast<char*>(pData) + alignedOffset, sizeInBytes + offsetInBytes - alignedOffset, MADV_WILLNEED);
+}
+
+/**
+ * @brief Unmaps the file
+ */
+MappedFile::~MappedFile() {
+    if(pData != nullptr)
+	::munmap(pData, fileSize);
+}
+
+} // namespace OpenCLIPER
+
+#undef MAPPEDFILE_DEBUG
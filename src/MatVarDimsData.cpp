@@ -107,21 +107,21 @@ void MatVarDimsData::getAllDims(std::vector<dimIndexType>* pCompleteSpatialDimsV
     dimIndexType nSpatialDims, nTemporalDims, spatialDimSize, temporalDimSize;
     dimIndexType firstSpatialDimIndex, lastSpatialDimIndex, firstTemporalDimIndex, lastTemporalDimIndex;
     const ConcreteNDArray<dimIndexType>* pTypedSourceData = dynamic_cast<const ConcreteNDArray<dimIndexType>*>(this->getNDArray(0));
-    nSpatialDims = pTypedSourceData->getHostData()->at(NSD_POS);
-    numCoils = pTypedSourceData->getHostData()->at(NCOILS_POS);
-    nTemporalDims = pTypedSourceData->getHostData()->at(NTD_POS);
+    nSpatialDims = pTypedSourceData->getHostDataPointer()[NSD_POS];
+    numCoils = pTypedSourceData->getHostDataPointer()[NCOILS_POS];
+    nTemporalDims = pTypedSourceData->getHostDataPointer()[NTD_POS];
     firstTemporalDimIndex = NTD_POS + 1;
     lastTemporalDimIndex = firstTemporalDimIndex + nTemporalDims - 1;
     firstSpatialDimIndex = lastTemporalDimIndex + 1;
     lastSpatialDimIndex = firstSpatialDimIndex + nSpatialDims - 1;
     pCompleteSpatialDimsVector->resize(0);
     for(auto i = firstSpatialDimIndex; i <= lastSpatialDimIndex; i++) {
-	spatialDimSize = pTypedSourceData->getHostData()->at(i);
+	spatialDimSize = pTypedSourceData->getHostDataPointer()[i];
 	pCompleteSpatialDimsVector->push_back(spatialDimSize);
     }
     pTemporalDimsVector->resize(0);
     for(auto i = firstTemporalDimIndex; i <= lastTemporalDimIndex; i++) {
-	temporalDimSize = pTypedSourceData->getHostData()->at(i);
+	temporalDimSize = pTypedSourceData->getHostDataPointer()[i];
 	pTemporalDimsVector->push_back(temporalDimSize);
     }
 }
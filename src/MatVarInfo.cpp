@@ -140,7 +140,7 @@ MatVarInfo::MatVarInfo(ElementDataType elementDataType, dimIndexType numOfElemen
  * @param[in] nDArrayOffsetInElements offset (in number of elements) from NDArray data array beginning to start reading from
  * @param[in] pNDArrayData generic pointer to NDArray data start
  */
-void MatVarInfo::set(const dimIndexType* pDimsAndStridesInfo, dimIndexType nDArrayOffsetInElements, const NDArray* pNDArray,
+void MatVarInfo::set(const index1DType* pDimsAndStridesInfo, dimIndexType nDArrayOffsetInElements, const NDArray* pNDArray,
 	const void* pNDArrayData) {
     // First dimension in matlab is number of rows (height) and in OpenCLIPER is width (number of columns)
     // Number of dimensions in matlab (rank) is always >= 2 (a scalar has dimensions 1x1, a vector, 1xN)
@@ -0,0 +1,217 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/MatlabFileIndex.hpp>
+#include <LPISupport/Utils.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+// Uncomment to show class-specific debug messages
+//#define MATLABFILEINDEX_DEBUG
+
+#if !defined NDEBUG && defined MATLABFILEINDEX_DEBUG
+    #define MATLABFILEINDEX_CERR(x) CERR(x)
+#else
+    #define MATLABFILEINDEX_CERR(x)
+    #undef MATLABFILEINDEX_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Opens a matlab file and reads the headers (but not the data) of all its variables
+ * @param[in] fileName name of the file in matlab format
+ * @throw std::invalid_argument if the file cannot be opened or it contains an invalid variable
+ */
+MatlabFileIndex::MatlabFileIndex(const std::string& fileName): fileName(fileName) {
+    matfp = Mat_Open(fileName.c_str(), MAT_ACC_RDONLY);
+    if(matfp == NULL) {
+	BTTHROW(std::invalid_argument("Error opening MAT file '" + fileName + "'!"), "MatlabFileIndex::MatlabFileIndex");
+    }
+
+    matvar_t* matvar;
+    while((matvar = Mat_VarReadNextInfo(matfp)) != NULL) {
+	// sanity check: since rank is a signed int in matio and we use unsigned vars to store dimensions, we could be fooled by a corrupted matlab file
+	if(matvar->rank < 2 || matvar->name == NULL) {
+	    Mat_VarFree(matvar);
+	    close();
+	    BTTHROW(std::invalid_argument("invalid variable in matlab file '" + fileName + "'"), "MatlabFileIndex::MatlabFileIndex");
+	}
+	MATLABFILEINDEX_CERR("Found matlab variable " << matvar->name << " (rank " << matvar->rank << ")\n");
+	variablesInfo[matvar->name] = matvar;
+    }
+}
+
+/**
+ * @brief Closes the file
+ */
+MatlabFileIndex::~MatlabFileIndex() {
+    close();
+}
+
+/**
+ * @brief Frees the variable headers and closes the file
+ */
+void MatlabFileIndex::close() {
+    for(auto& variableInfo: variablesInfo)
+	Mat_VarFree(variableInfo.second);
+    variablesInfo.clear();
+    if(matfp != NULL) {
+	Mat_Close(matfp);
+	matfp = NULL;
+    }
+}
+
+/**
+ * @brief Gets the header of a variable (type and dimensions, but no data)
+ * @param[in] variableName name of the variable
+ * @return header of the variable (owned by this object, must not be freed)
+ * @throw std::out_of_range if the variable is not stored in the file
+ */
+matvar_t* MatlabFileIndex::getVariableInfo(const std::string& variableName) const {
+    auto it = variablesInfo.find(variableName);
+    if(it == variablesInfo.end()) {
+	BTTHROW(std::out_of_range("Variable '" + variableName + "' not found in MAT file '" + fileName + "'"), "MatlabFileIndex::getVariableInfo");
+    }
+    return it->second;
+}
+
+/**
+ * @brief Reads a whole variable (header and data) from the file
+ * @param[in] variableName name of the variable
+ * @return matlab variable (to be freed by the caller with Mat_VarFree)
+ * @throw std::out_of_range if the variable is not stored in the file
+ * @throw std::invalid_argument if the variable cannot be read
+ */
+matvar_t* MatlabFileIndex::readVariable(const std::string& variableName) const {
+    getVariableInfo(variableName);
+    matvar_t* matvar = Mat_VarRead(matfp, variableName.c_str());
+    if(matvar == NULL) {
+	BTTHROW(std::invalid_argument("Error reading variable '" + variableName + "' from MAT file '" + fileName + "'"), "MatlabFileIndex::readVariable");
+    }
+    return matvar;
+}
+
+/**
+ * @brief Reads consecutive elements of a numeric variable (in matlab order) as a new variable whose dimensions are the
+ * first dimensions of the stored one
+ * @param[in] variableName name of the variable
+ * @param[in] firstElement index of the first element to be read
+ * @param[in] numElements number of elements to be read (must be the product of the first numOfSlabDims dimensions)
+ * @param[in] numOfSlabDims number of dimensions of the slab
+ * @return matlab variable with the slab (to be freed by the caller with Mat_VarFree), or nullptr if the variable cannot
+ * be read in slabs (it must be read as a whole with readVariable())
+ * @throw std::out_of_range if the variable is not stored in the file
+ * @throw std::invalid_argument if numElements does not match the slab dimensions
+ */
+matvar_t* MatlabFileIndex::readVariableSlab(const std::string& variableName, size_t firstElement, size_t numElements,
+					    dimIndexType numOfSlabDims) const {
+    matvar_t* pInfo = getVariableInfo(variableName);
+
+    // Data are returned with the type of the variable class, whatever their type in the file is
+    enum matio_types dataType;
+    switch(pInfo->class_type) {
+	case MAT_C_SINGLE:
+	    dataType = MAT_T_SINGLE;
+	    break;
+	case MAT_C_DOUBLE:
+	    dataType = MAT_T_DOUBLE;
+	    break;
+	case MAT_C_UINT32:
+	    dataType = MAT_T_UINT32;
+	    break;
+	case MAT_C_UINT8:
+	    dataType = MAT_T_UINT8;
+	    break;
+	default:
+	    return nullptr;
+    }
+    // Mat_VarReadDataLinear takes int positions
+    if(firstElement + numElements > INT_MAX)
+	return nullptr;
+
+    // Minimum number of dimensions of matlab variables (matlab rank) is 2
+    std::vector<size_t> slabDims(std::max<dimIndexType>(2, numOfSlabDims), 1);
+    size_t slabNumElements = 1;
+    for(dimIndexType i = 0; i < numOfSlabDims && i < static_cast<dimIndexType>(pInfo->rank); i++) {
+	slabDims[i] = pInfo->dims[i];
+	slabNumElements *= pInfo->dims[i];
+    }
+    if(slabNumElements != numElements) {
+	BTTHROW(std::invalid_argument("Number of elements does not match slab dimensions of variable '" + variableName + "'"), "MatlabFileIndex::readVariableSlab");
+    }
+
+    matvar_t* pSlab = Mat_VarCreate(pInfo->name, pInfo->class_type, dataType, slabDims.size(), slabDims.data(), NULL,
+				    pInfo->isComplex ? MAT_F_COMPLEX : 0);
+    if(pSlab == NULL)
+	return nullptr;
+
+    // Allocated with malloc, since Mat_VarFree frees data with free(). If memory runs out, let the caller fall back to a
+    // full read
+    size_t sizeInBytes = numElements * Mat_SizeOf(dataType);
+    if(pInfo->isComplex) {
+	mat_complex_split_t* pComplexData = static_cast<mat_complex_split_t*>(malloc(sizeof(mat_complex_split_t)));
+	if(pComplexData != NULL) {
+	    pComplexData->Re = malloc(sizeInBytes);
+	    pComplexData->Im = malloc(sizeInBytes);
+	    if(pComplexData->Re == NULL || pComplexData->Im == NULL) {
+		free(pComplexData->Re);
+		free(pComplexData->Im);
+		free(pComplexData);
+		pComplexData = NULL;
+	    }
+	}
+	pSlab->data = pComplexData;
+    }
+    else {
+	pSlab->data = malloc(sizeInBytes);
+    }
+    if(pSlab->data == NULL) {
+	MATLABFILEINDEX_CERR("Not enough memory to read a slab of variable " << variableName << "\n");
+	Mat_VarFree(pSlab);
+	return nullptr;
+    }
+    pSlab->nbytes = sizeInBytes;
+
+    if(Mat_VarReadDataLinear(matfp, pInfo, pSlab->data, firstElement, 1, numElements) != 0) {
+	MATLABFILEINDEX_CERR("Variable " << variableName << " cannot be read in slabs\n");
+	Mat_VarFree(pSlab);
+	return nullptr;
+    }
+    return pSlab;
+}
+
+} // namespace OpenCLIPER
+
+#undef MATLABFILEINDEX_DEBUG
@@ -257,6 +257,8 @@ dimIndexType NDArray::getElementSize(ElementDataType elementDataType) {
 	return elementSize = sizeof(dimIndexType);
     if(elementDataType == TYPEID_CL_UCHAR)
 	return elementSize = sizeof(cl_uchar);
+    if(elementDataType == TYPEID_COMPLEXHALF)
+	return elementSize = sizeof(complexHalfType);
     //ostream stringstream;
     std::stringstream errorStringStream;
     errorStringStream << "NDArray::getElementSize, element data type not supported: " << elementDataType.name() << std::endl;
@@ -264,6 +266,72 @@ dimIndexType NDArray::getElementSize(ElementDataType elementDataType) {
     return 0;
 }
 
+/**
+ * @brief Converts a single precision value to half precision (IEEE 754 binary16), rounding to nearest even.
+ *
+ * Values too big for half precision become infinity and values too small become zero (with the same sign).
+ * @param[in] value single precision value
+ * @return half precision value (as its bit pattern)
+ */
+cl_half NDArray::floatToHalf(float value) {
+    uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t absBits = bits & 0x7FFFFFFF;
+    if(absBits >= 0x47800000) { // overflow, infinity or NaN
+	if(absBits > 0x7F800000) // NaN (keep it quiet)
+	    return sign | 0x7C00 | 0x0200 | ((absBits >> 13) & 0x03FF);
+	return sign | 0x7C00;
+    }
+    if(absBits < 0x38800000) { // subnormal half or zero
+	if(absBits < 0x33000000)
+	    return sign;
+	uint32_t mantissa = (absBits & 0x007FFFFF) | 0x00800000;
+	uint32_t shift = 126 - (absBits >> 23);
+	uint32_t halfBits = mantissa >> shift;
+	uint32_t remainder = mantissa & ((1u << shift) - 1);
+	uint32_t halfway = 1u << (shift - 1);
+	if(remainder > halfway || (remainder == halfway && (halfBits & 1)))
+	    halfBits++;
+	return sign | halfBits;
+    }
+    // normal half: rebias the exponent (127 -> 15) and round the mantissa from 23 to 10 bits
+    uint32_t halfBits = (absBits - 0x38000000) >> 13;
+    uint32_t remainder = absBits & 0x1FFF;
+    if(remainder > 0x1000 || (remainder == 0x1000 && (halfBits & 1)))
+	halfBits++; // a carry into the exponent is right, even if it gives infinity
+    return sign | halfBits;
+}
+
+/**
+ * @brief Converts a half precision value (IEEE 754 binary16) to single precision (exact conversion).
+ * @param[in] value half precision value (as its bit pattern)
+ * @return single precision value
+ */
+float NDArray::halfToFloat(cl_half value) {
+    uint32_t sign = (uint32_t(value) & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x03FF;
+    uint32_t bits;
+    if(exponent == 0x1F) // infinity or NaN
+	bits = sign | 0x7F800000 | (mantissa << 13);
+    else if(exponent != 0) // normal
+	bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    else if(mantissa == 0) // zero
+	bits = sign;
+    else { // subnormal half, normal float
+	exponent = 113;
+	while((mantissa & 0x0400) == 0) {
+	    mantissa <<= 1;
+	    exponent--;
+	}
+	bits = sign | (exponent << 23) | ((mantissa & 0x03FF) << 13);
+    }
+    float result;
+    ::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
 /**
  * @brief Method for creating a subclass of NDArray depending on the data type of the base element, data for the NDArray is read from
  * a file in raw format.
@@ -289,6 +357,46 @@ NDArray* NDArray::createNDArray(const std::string &completeFileName, std::vector
     else if(elementDataType == TYPEID_CL_UCHAR) {
 	pLocalNDArray = new ConcreteNDArray<cl_uchar>(completeFileName, pSpatialDims);
     }
+    else if(elementDataType == TYPEID_COMPLEXHALF) {
+	pLocalNDArray = new ConcreteNDArray<complexHalfType>(completeFileName, pSpatialDims);
+    }
+    else {
+	std::stringstream errorStringStream;
+	errorStringStream << "Element data type not supported: " << elementDataType.name() << std::endl;
+	BTTHROW(std::invalid_argument(errorStringStream.str()), "NDArray::createNDArray");
+    }
+    return pLocalNDArray;
+}
+
+/**
+ * @brief Method for creating a subclass of NDArray depending on the data type of the base element, data for the NDArray are part of
+ * a mapped file (raw or CFL format), which is used as host memory without copying it.
+ * @param[in] pMappedFile mapped file (shared by all NDArrays read from it)
+ * @param[in] offsetInBytes offset of the data of the NDArray from the beginning of the file
+ * @param[in,out] pSpatialDims vector with NDArray spatial dimensions (move semantics, ownership of the vector is transferred from
+ * caller to NDArray and parameter value will be nullptr after executing this method)
+ * @param[in] elementDataType data type of base element
+ * @return pointer to the new object subclass of NDArray
+ */
+NDArray* NDArray::createNDArray(const std::shared_ptr<MappedFile>& pMappedFile, size_t offsetInBytes, std::vector<dimIndexType>*& pSpatialDims,
+				ElementDataType elementDataType) {
+    NDArray* pLocalNDArray = nullptr;
+
+    if(elementDataType == TYPEID_COMPLEX) {
+	pLocalNDArray = new ConcreteNDArray<complexType>(pMappedFile, offsetInBytes, pSpatialDims);
+    }
+    else if(elementDataType == TYPEID_REAL) {
+	pLocalNDArray = new ConcreteNDArray<realType>(pMappedFile, offsetInBytes, pSpatialDims);
+    }
+    else if(elementDataType == TYPEID_INDEX) {
+	pLocalNDArray = new ConcreteNDArray<dimIndexType>(pMappedFile, offsetInBytes, pSpatialDims);
+    }
+    else if(elementDataType == TYPEID_CL_UCHAR) {
+	pLocalNDArray = new ConcreteNDArray<cl_uchar>(pMappedFile, offsetInBytes, pSpatialDims);
+    }
+    else if(elementDataType == TYPEID_COMPLEXHALF) {
+	pLocalNDArray = new ConcreteNDArray<complexHalfType>(pMappedFile, offsetInBytes, pSpatialDims);
+    }
     else {
 	std::stringstream errorStringStream;
 	errorStringStream << "Element data type not supported: " << elementDataType.name() << std::endl;
@@ -322,6 +430,9 @@ NDArray* NDArray::createNDArray(std::fstream &f, std::vector<dimIndexType>*& pSp
     else if(elementDataType == TYPEID_CL_UCHAR) {
 	pLocalNDArray = new ConcreteNDArray<cl_uchar>(f, pSpatialDims);
     }
+    else if(elementDataType == TYPEID_COMPLEXHALF) {
+	pLocalNDArray = new ConcreteNDArray<complexHalfType>(f, pSpatialDims);
+    }
     else {
 	std::stringstream errorStringStream;
 	errorStringStream << "Element data type not supported: " << elementDataType.name() << std::endl;
@@ -353,6 +464,9 @@ NDArray* NDArray::createNDArray(const NDArray* pSourceData, bool copyData, Eleme
     else if(elementDataType == TYPEID_CL_UCHAR) {
 	pLocalNDArray = new ConcreteNDArray<cl_uchar>(pSourceData, copyData);
     }
+    else if(elementDataType == TYPEID_COMPLEXHALF) {
+	pLocalNDArray = new ConcreteNDArray<complexHalfType>(pSourceData, copyData);
+    }
     else {
 	std::stringstream errorStringStream;
 	errorStringStream << "Element data type not supported: " << elementDataType.name() << std::endl;
@@ -424,6 +538,9 @@ NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDims, Elemen
     else if(elementDataType == TYPEID_CL_UCHAR) {
 	pLocalNDArray = new ConcreteNDArray<cl_uchar>(pSpatialDims);
     }
+    else if(elementDataType == TYPEID_COMPLEXHALF) {
+	pLocalNDArray = new ConcreteNDArray<complexHalfType>(pSpatialDims);
+    }
     else {
 	std::stringstream errorStringStream;
 	errorStringStream << "Element data type not supported: " << elementDataType.name() << std::endl;
@@ -472,6 +589,7 @@ template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDim
 template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<realType>*& pData);
 template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<dimIndexType>*& pData);
 template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<cl_uchar>*& pData);
+template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pSpatialDims, std::vector<complexHalfType>*& pData);
 
 /**
  * @brief Create an object of an NDArray subclass with given one-dimensional data
@@ -493,6 +611,7 @@ template NDArray* NDArray::createNDArray(std::vector<complexType>*& pData);
 template NDArray* NDArray::createNDArray(std::vector<realType>*& pData);
 template NDArray* NDArray::createNDArray(std::vector<dimIndexType>*& pData);
 template NDArray* NDArray::createNDArray(std::vector<cl_uchar>*& pData);
+template NDArray* NDArray::createNDArray(std::vector<complexHalfType>*& pData);
 
 } //namespace OpenCLIPER
 #undef NDARRAY_DEBUG
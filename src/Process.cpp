@@ -103,6 +103,20 @@ const std::string Process::getKernelFile() const {
     return "";
 }
 
+/**
+ * @brief Gets a kernel for this process: specialized for the shape of a Data object if shape specialization is enabled, or the
+ * generic one otherwise.
+ * @param[in] name name of the kernel
+ * @param[in] outputShape true to specialize for the shape of the output Data object instead of the input one
+ * @return the kernel
+ */
+cl::Kernel Process::getShapeKernel(const std::string& name, bool outputShape) {
+    if(shapeSpecialization)
+	return getApp()->getSpecializedKernel(name, outputShape ? getOutput() : getInput());
+    else
+	return getApp()->getKernel(name);
+}
+
 } // namespace OpenCLIPER
 
 #undef PROCESS_DEBUG
@@ -151,6 +151,120 @@ void ProcessCore::setOutput(std::shared_ptr<Data> pOutputData) {
     }
 }
 
+/**
+ * @brief Runs this process.
+ *
+ * Commands are not enqueued until the last writers of input and output data, and the readers of output data since then
+ * (any of which may have been launched in another command queue), have finished. A marker for this launch is then
+ * recorded as a reader of input data and as the new last writer of output data, so that processes bound to different
+ * queues can be chained without finishing any queue.
+ * @throw std::invalid_argument if input or output data are half precision complex data and this process does not support
+ * them (see supportsHalfData())
+ */
+void ProcessCore::launch() {
+    checkHalfData();
+    waitForDataDependencies({pInputData}, {pOutputData});
+    doLaunch();
+    cl::Event event;
+    if(queue() != nullptr) {
+	try {
+	    queue.enqueueMarkerWithWaitList(nullptr, &event);
+	}
+	catch(cl::Error& err) {
+	    BTTHROW(CLError(err), "ProcessCore::launch");
+	}
+    }
+    recordDataRead(pInputData, event);
+    recordDataWrite(pOutputData, event);
+}
+
+/**
+ * @brief Makes this process' queue wait for the commands enqueued in other queues that accessed the given data before
+ * (commands in our own queue are already ordered, since it is in-order): the last writers of data to be read (read after
+ * write), and the last writers and their readers of data to be written (write after write and write after read). Saves of
+ * data to be written still running in the background (see Data::submitSave()) are waited for as well, as they read host
+ * buffers the next commands may overwrite (e.g. with zero-copy host memory, or in-place processes)
+ * @param[in] readList data objects to be read next (null pointers are skipped)
+ * @param[in] writeList data objects to be written next (null pointers are skipped)
+ */
+void ProcessCore::waitForDataDependencies(const std::vector<std::shared_ptr<Data>>& readList,
+					  const std::vector<std::shared_ptr<Data>>& writeList) {
+    for(auto& pData: writeList) {
+	if(pData)
+	    pData->waitSaveEnd();
+    }
+    if(queue() == nullptr)
+	return;
+    std::vector<cl::Event> waitList;
+    auto addDependency = [&](const cl::Event& event) {
+	if(event() == nullptr || event.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() == CL_COMPLETE)
+	    return;
+	if(event.getInfo<CL_EVENT_COMMAND_QUEUE>()() != queue())
+	    waitList.push_back(event);
+    };
+    try {
+	for(auto& pData: readList) {
+	    if(!pData || !pData->getApp() || pData->getHandle() == INVALIDDATAHANDLE)
+		continue;
+	    addDependency(pData->getApp()->getLastWriteEvent(pData->getHandle()));
+	}
+	for(auto& pData: writeList) {
+	    if(!pData || !pData->getApp() || pData->getHandle() == INVALIDDATAHANDLE)
+		continue;
+	    addDependency(pData->getApp()->getLastWriteEvent(pData->getHandle()));
+	    for(auto& event: pData->getApp()->getReadEvents(pData->getHandle()))
+		addDependency(event);
+	}
+	if(!waitList.empty())
+	    queue.enqueueBarrierWithWaitList(&waitList);
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "ProcessCore::waitForDataDependencies");
+    }
+}
+
+/**
+ * @brief Records a reader of some data (by default, a marker enqueued after everything enqueued so far in this process'
+ * queue), which later writers in other queues will wait for. Processes reading other Data objects than their input (e.g.
+ * from their launch parameters) must record it themselves if those may be written from another queue
+ * @param[in] pData read data
+ * @param[in] event event of the last command reading pData (a marker is enqueued if null)
+ */
+void ProcessCore::recordDataRead(const std::shared_ptr<Data>& pData, const cl::Event& event) {
+    if(queue() == nullptr || !pData || !pData->getApp() || pData->getHandle() == INVALIDDATAHANDLE)
+	return;
+    try {
+	cl::Event readEvent = event;
+	if(readEvent() == nullptr)
+	    queue.enqueueMarkerWithWaitList(nullptr, &readEvent);
+	pData->getApp()->addReadEvent(pData->getHandle(), readEvent);
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "ProcessCore::recordDataRead");
+    }
+}
+
+/**
+ * @brief Records the last writer of some data (by default, a marker enqueued after everything enqueued so far in this
+ * process' queue). Processes writing other Data objects than their output (e.g. from their launch parameters) must record
+ * it themselves if those may be read from another queue
+ * @param[in] pData written data
+ * @param[in] event event of the last command writing pData (a marker is enqueued if null)
+ */
+void ProcessCore::recordDataWrite(const std::shared_ptr<Data>& pData, const cl::Event& event) {
+    if(queue() == nullptr || !pData || !pData->getApp() || pData->getHandle() == INVALIDDATAHANDLE)
+	return;
+    try {
+	cl::Event lastWriteEvent = event;
+	if(lastWriteEvent() == nullptr)
+	    queue.enqueueMarkerWithWaitList(nullptr, &lastWriteEvent);
+	pData->getApp()->setLastWriteEvent(pData->getHandle(), lastWriteEvent);
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "ProcessCore::recordDataWrite");
+    }
+}
+
 /**
  *@brief  Method for testing common errors before launching kernel (null pointers to CLapp, inputData or outputData objects)
  */
@@ -169,6 +283,22 @@ void ProcessCore::checkCommonLaunchParameters() {
     infoItems.clear();
 }
 
+/**
+ * @brief Checks that neither input nor output data are half precision complex data, unless this process supports them
+ * (see supportsHalfData())
+ * @throw std::invalid_argument if they are not supported
+ */
+void ProcessCore::checkHalfData() {
+    if(supportsHalfData())
+	return;
+    for(auto& pData: {pInputData, pOutputData}) {
+	if(pData != nullptr && pData->getElementDataType() == TYPEID_COMPLEXHALF) {
+	    BTTHROW(std::invalid_argument("half precision complex data not supported by this process (convert them with "
+		"ComplexHalfConvert first), launch aborted"), "ProcessCore::checkHalfData");
+	}
+    }
+}
+
 /**
  * @brief Method for testing if inputData object has its data stored also on device memory (otherwise, copy is requested)
  * @param[in] syncSource format used for storing data in device memory (buffers, images or both)
@@ -220,7 +350,7 @@ void ProcessCore::stopHostCodeProfiling() {
  */
 void ProcessCore::startKernelProfiling() {
     if(pProfileParameters->enable && profilingSupported) {
-	getApp()->getCommandQueue().enqueueMarkerWithWaitList(NULL, &start_ev);
+	queue.enqueueMarkerWithWaitList(NULL, &start_ev);
     }
 }
 
@@ -229,7 +359,7 @@ void ProcessCore::startKernelProfiling() {
  */
 void ProcessCore::stopKernelProfiling() {
     if(pProfileParameters->enable && profilingSupported) {
-	getApp()->getCommandQueue().enqueueMarkerWithWaitList(NULL, &stop_ev);
+	queue.enqueueMarkerWithWaitList(NULL, &stop_ev);
 	stop_ev.wait();
 	cl_ulong ev_start_time = (cl_ulong) 0;
 	cl_ulong ev_stop_time = (cl_ulong) 0;
@@ -0,0 +1,518 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/ProcessGraph.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+#include <OpenCLIPER/XData.hpp>
+#include <OpenCLIPER/KData.hpp>
+#include <OpenCLIPER/processes/ScalarMultiply.hpp>
+#include <OpenCLIPER/processes/ComplexElementProd.hpp>
+#include <OpenCLIPER/processes/ApplyMask.hpp>
+#include <OpenCLIPER/processes/ComplexAbs.hpp>
+#include <OpenCLIPER/processes/ComplexAbsPow2.hpp>
+#include <OpenCLIPER/processes/ComplexPow.hpp>
+#include <OpenCLIPER/processes/Complex2Real.hpp>
+
+#include <set>
+#include <sstream>
+#include <algorithm>
+
+// Uncomment to show class-specific debug messages
+//#define PROCESSGRAPH_DEBUG
+
+#if !defined NDEBUG && defined PROCESSGRAPH_DEBUG
+    #define PROCESSGRAPH_CERR(x) CERR(x)
+#else
+    #define PROCESSGRAPH_CERR(x)
+    #undef PROCESSGRAPH_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+/**
+ * @brief Adds a process to the graph. Processes are launched in the same order they are added.
+ *
+ * The same process object may be added more than once (e.g. with different input/output data), but it is initialized only
+ * once, so all of its nodes must be valid for the same initialization (e.g. data with the same sizes).
+ * @param[in] pProcess process to add
+ * @param[in] pIn input data for this node
+ * @param[in] pOut output data for this node (must be the same as pIn for in-place processes such as ApplyMask)
+ * @param[in] pLP launch parameters for this node (the ones set in pProcess at launch time are used if null)
+ */
+void ProcessGraph::addProcess(const std::shared_ptr<Process>& pProcess, const std::shared_ptr<Data>& pIn, const std::shared_ptr<Data>& pOut,
+			      const std::shared_ptr<LaunchParameters>& pLP) {
+    if(!pProcess || !pIn || !pOut)
+	BTTHROW(std::invalid_argument("null process or data"), "ProcessGraph::addProcess");
+
+    StageType stageType = getStageType(pProcess);
+    if(stageType == STAGE_APPLYMASK && pIn != pOut)
+	BTTHROW(std::invalid_argument("ApplyMask works in place: input and output data must be the same"), "ProcessGraph::addProcess");
+
+    nodes.push_back({pProcess, pIn, pOut, pLP, stageType});
+}
+
+/**
+ * @brief Creates a temporary Data object with the same class, sizes and element type as a given one, to be used between
+ * processes of this graph. It is allocated once and reused in every launch.
+ * @param[in] pTemplate data to copy structure from (not contents)
+ * @return the new intermediate data
+ */
+std::shared_ptr<Data> ProcessGraph::createIntermediate(const std::shared_ptr<Data>& pTemplate) {
+    std::shared_ptr<Data> pData;
+    auto pKData = std::dynamic_pointer_cast<KData>(pTemplate);
+    if(pKData)
+	pData = std::make_shared<KData>(getApp(), pKData);
+    else
+	pData = std::make_shared<XData>(getApp(), pTemplate, false);
+
+    intermediates.push_back(pData);
+    return pData;
+}
+
+/**
+ * @brief Finds chains of fusable nodes, generates and builds their kernels and initializes all other processes
+ */
+void ProcessGraph::init() {
+    fusedKernels.clear();
+    steps.clear();
+
+    // Build the execution plan: every maximal chain of two or more fusable nodes becomes a single step
+    size_t first = 0;
+    while(first < nodes.size()) {
+	size_t last = first;
+	while(last + 1 < nodes.size() && canFuse(last))
+	    last++;
+
+	if(last > first) {
+	    FusedKernel fusedKernel;
+	    fusedKernel.firstNode = first;
+	    fusedKernel.lastNode = last;
+
+	    const auto& pIn = nodes[first].pIn;
+	    const auto& pOut = nodes[last].pOut;
+	    fusedKernel.numVoxels = pOut->getNDArrayTotalSize(0);
+	    fusedKernel.inCoils = std::max(pIn->getNumCoils(), 1u);
+	    fusedKernel.inStride = getNDArrayDistance(pIn);
+	    fusedKernel.outCoils = std::max(pOut->getNumCoils(), 1u);
+	    fusedKernel.outStride = getNDArrayDistance(pOut);
+	    cl_uint numFrames = pOut->getData()->size() / fusedKernel.outCoils;
+	    fusedKernel.globalSize = cl::NDRange(fusedKernel.numVoxels, fusedKernel.outCoils, numFrames);
+
+	    steps.push_back({first, static_cast<int>(fusedKernels.size())});
+	    fusedKernels.push_back(fusedKernel);
+	    PROCESSGRAPH_CERR("Fused nodes " << first << " to " << last << '\n');
+	}
+	else
+	    steps.push_back({first, -1});
+
+	first = last + 1;
+    }
+
+    // Initialize processes which are not fused (only once per process object)
+    std::set<Process*> initializedProcesses;
+    for(auto& step: steps) {
+	if(step.fusedKernel >= 0)
+	    continue;
+
+	Node& node = nodes[step.node];
+	if(initializedProcesses.insert(node.pProcess.get()).second) {
+	    node.pProcess->setInput(node.pIn);
+	    node.pProcess->setOutput(node.pOut);
+	    if(node.pLP)
+		node.pProcess->setLaunchParameters(node.pLP);
+	    node.pProcess->init();
+	}
+    }
+
+    // Generate all fused kernels in a single program
+    if(!fusedKernels.empty()) {
+	std::ostringstream source;
+	source << "#include <OpenCLIPER/kernels/hostKernelFunctions.h>\n\n";
+	for(size_t i = 0; i < fusedKernels.size(); i++)
+	    source << getFusedKernelSource(fusedKernels[i], "fusedElementWise" + std::to_string(i));
+
+	PROCESSGRAPH_CERR("Fused kernels source:\n" << source.str() << '\n');
+	fusedProgram = getApp()->buildProgram(source.str());
+
+	for(size_t i = 0; i < fusedKernels.size(); i++)
+	    fusedKernels[i].kernel = cl::Kernel(fusedProgram, ("fusedElementWise" + std::to_string(i)).c_str());
+    }
+}
+
+/**
+ * @brief Launches all nodes (or their fused kernels) in order
+ */
+void ProcessGraph::doLaunch() {
+    if(steps.empty() && !nodes.empty())
+	BTTHROW(std::invalid_argument("launch() called before init()"), "ProcessGraph::launch");
+
+    try {
+	for(auto& step: steps) {
+	    if(step.fusedKernel >= 0) {
+		launchFusedKernel(fusedKernels[step.fusedKernel]);
+		continue;
+	    }
+
+	    Node& node = nodes[step.node];
+	    node.pProcess->setInput(node.pIn);
+	    node.pProcess->setOutput(node.pOut);
+	    if(node.pLP)
+		node.pProcess->setLaunchParameters(node.pLP);
+	    node.pProcess->launch();
+	}
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "ProcessGraph::launch");
+    }
+}
+
+/**
+ * @brief Binds this process and all of the graph processes to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void ProcessGraph::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& node: nodes)
+	node.pProcess->setCommandQueue(cq);
+}
+
+/**
+ * @brief Gets the type of element-wise operation done by a process
+ * @param[in] pProcess the process
+ * @return operation type (STAGE_NONE if the process can't be fused)
+ */
+ProcessGraph::StageType ProcessGraph::getStageType(const std::shared_ptr<Process>& pProcess) {
+    if(std::dynamic_pointer_cast<ScalarMultiply>(pProcess))
+	return STAGE_SCALARMULTIPLY;
+    if(std::dynamic_pointer_cast<ComplexElementProd>(pProcess))
+	return STAGE_COMPLEXELEMENTPROD;
+    if(std::dynamic_pointer_cast<ApplyMask>(pProcess))
+	return STAGE_APPLYMASK;
+    if(std::dynamic_pointer_cast<ComplexAbs>(pProcess))
+	return STAGE_COMPLEXABS;
+    if(std::dynamic_pointer_cast<ComplexAbsPow2>(pProcess))
+	return STAGE_COMPLEXABSPOW2;
+    if(std::dynamic_pointer_cast<ComplexPow>(pProcess))
+	return STAGE_COMPLEXPOW;
+    if(std::dynamic_pointer_cast<Complex2Real>(pProcess))
+	return STAGE_COMPLEX2REAL;
+    return STAGE_NONE;
+}
+
+/**
+ * @brief Gets the element type an element-wise operation produces from a given input element type
+ * @param[in] stageType operation type
+ * @param[in] inputType input element type
+ * @return output element type (TYPEID_INDEX if the input element type is not supported)
+ */
+ElementDataType ProcessGraph::getStageOutputType(StageType stageType, ElementDataType inputType) {
+    switch(stageType) {
+	case STAGE_SCALARMULTIPLY:
+	case STAGE_APPLYMASK:
+	    if(inputType == TYPEID_COMPLEX || inputType == TYPEID_REAL)
+		return inputType;
+	    break;
+	case STAGE_COMPLEXELEMENTPROD:
+	case STAGE_COMPLEXABS:
+	case STAGE_COMPLEXABSPOW2:
+	case STAGE_COMPLEXPOW:
+	    if(inputType == TYPEID_COMPLEX)
+		return TYPEID_COMPLEX;
+	    break;
+	case STAGE_COMPLEX2REAL:
+	    if(inputType == TYPEID_COMPLEX)
+		return TYPEID_REAL;
+	    break;
+	default:
+	    break;
+    }
+    return TYPEID_INDEX;
+}
+
+/**
+ * @brief Gets the distance (in elements) between consecutive NDArrays of a Data object, i.e. its coil stride or, if it has
+ * no coils, its first temporal dimension stride
+ * @param[in] pData the Data object
+ * @return distance between NDArrays (0 if there is only one)
+ */
+index1DType ProcessGraph::getNDArrayDistance(const std::shared_ptr<Data>& pData) {
+    return pData->getDimStride(pData->getNumSpatialDims(), 0);
+}
+
+/**
+ * @brief Checks if a node is an element-wise operation whose input and output layouts can be handled by a fused kernel
+ * @param[in] node node index
+ * @return true if the node can be part of a fused kernel
+ */
+bool ProcessGraph::isElementWise(size_t node) const {
+    const Node& n = nodes[node];
+    if(n.stageType == STAGE_NONE)
+	return false;
+
+    if(!n.pIn->getAllSizesEqual() || !n.pOut->getAllSizesEqual())
+	return false;
+
+    if(getStageOutputType(n.stageType, n.pIn->getElementDataType()) != n.pOut->getElementDataType())
+	return false;
+
+    if(n.pIn->getNDArrayTotalSize(0) != n.pOut->getNDArrayTotalSize(0))
+	return false;
+
+    // Only ComplexElementProd may expand a coil-less input into several coils (one per sensitivity map)
+    cl_uint inCoils = std::max(n.pIn->getNumCoils(), 1u);
+    cl_uint outCoils = std::max(n.pOut->getNumCoils(), 1u);
+    if(inCoils != outCoils && !(n.stageType == STAGE_COMPLEXELEMENTPROD && inCoils == 1))
+	return false;
+
+    // Fused kernels read sensitivity maps as complexType (half precision ones are left to ComplexElementProd itself)
+    if(n.stageType == STAGE_COMPLEXELEMENTPROD) {
+	auto pCEPLP = std::dynamic_pointer_cast<ComplexElementProd::LaunchParameters>(n.pLP ? n.pLP : n.pProcess->getLaunchParameters());
+	if(pCEPLP && pCEPLP->sensitivityMapsData && pCEPLP->sensitivityMapsData->getElementDataType() != TYPEID_COMPLEX)
+	    return false;
+    }
+
+    return (n.pIn->getData()->size() / inCoils == n.pOut->getData()->size() / outCoils);
+}
+
+/**
+ * @brief Checks if the data written by a node is read by the next node only, so that it needs not be stored
+ * @param[in] node node index
+ * @return true if nobody else (including later launches of this graph) needs the data written by the node
+ */
+bool ProcessGraph::isDeadAfterNextNode(size_t node) const {
+    const auto& pData = nodes[node].pOut;
+
+    // If the next node overwrites it, nobody else can read it
+    if(nodes[node + 1].pOut == pData)
+	return true;
+
+    // Otherwise it must be overwritten before it is read again
+    for(size_t i = node + 2; i < nodes.size(); i++) {
+	if(nodes[i].pIn == pData)
+	    return false;
+	if(nodes[i].pOut == pData)
+	    return true;
+    }
+
+    // If nobody overwrites it, it can only be discarded if it is a temporary not read in the next launch before being written
+    if(std::find(intermediates.begin(), intermediates.end(), pData) == intermediates.end())
+	return false;
+
+    for(size_t i = 0; i < node; i++) {
+	if(nodes[i].pIn == pData)
+	    return false;
+	if(nodes[i].pOut == pData)
+	    return true;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a node and the next one can be fused
+ * @param[in] node node index
+ * @return true if the node passes its result to the next one and nothing else prevents them from being fused
+ */
+bool ProcessGraph::canFuse(size_t node) const {
+    const Node& current = nodes[node];
+    const Node& next = nodes[node + 1];
+
+    if(!isElementWise(node) || !isElementWise(node + 1))
+	return false;
+
+    // Note that a fused kernel may safely work in place: each work item reads the same element it writes (a chain can only
+    // read fewer elements than it writes if it expands coils, and then its input and output can't be the same data)
+    return (next.pIn == current.pOut && isDeadAfterNextNode(node));
+}
+
+/**
+ * @brief Generates the source code of a fused kernel.
+ *
+ * Every work item computes one output element (voxel, coil, frame): it reads the corresponding input element (the same
+ * one for every coil if the input has no coils), applies all operations of the chain in order and writes the result.
+ * @param[in] fusedKernel fused kernel description
+ * @param[in] name kernel name
+ * @return the kernel source code
+ */
+const std::string ProcessGraph::getFusedKernelSource(const FusedKernel& fusedKernel, const std::string& name) const {
+    const auto& pIn = nodes[fusedKernel.firstNode].pIn;
+    const auto& pOut = nodes[fusedKernel.lastNode].pOut;
+    bool realInput = (pIn->getElementDataType() == TYPEID_REAL);
+    bool realOutput = (pOut->getElementDataType() == TYPEID_REAL);
+
+    std::ostringstream args, body;
+    args << "global const " << (realInput ? "realType" : "complexType") << "* input, "
+	 << "global " << (realOutput ? "realType" : "complexType") << "* output, "
+	 << "uint numVoxels, uint inCoils, index1DType inStride, uint outCoils, index1DType outStride";
+
+    body << "    uint voxel = get_global_id(0);\n"
+	 << "    uint coil = get_global_id(1);\n"
+	 << "    uint frame = get_global_id(2);\n\n"
+	 << "    index1DType inOffset = voxel + ((inCoils > 1 ? coil : 0) + frame * inCoils) * inStride;\n";
+    if(realInput)
+	body << "    complexType z = (complexType)(input[inOffset], 0);\n";
+    else
+	body << "    complexType z = input[inOffset];\n";
+
+    for(size_t i = fusedKernel.firstNode; i <= fusedKernel.lastNode; i++) {
+	switch(nodes[i].stageType) {
+	    case STAGE_SCALARMULTIPLY:
+		args << ", realType factor" << i;
+		body << "    z *= factor" << i << ";\n";
+		break;
+	    case STAGE_COMPLEXELEMENTPROD:
+		args << ", global const complexType* sensMaps" << i << ", uint conjugate" << i << ", index1DType sensMapsStride" << i;
+		body << "    {\n"
+		     << "\tcomplexType sm = sensMaps" << i << "[voxel + coil * sensMapsStride" << i << "];\n"
+		     << "\tif(conjugate" << i << ")\n"
+		     << "\t    sm.y = -sm.y;\n"
+		     << "\tz = (complexType)(z.x * sm.x - z.y * sm.y, z.x * sm.y + z.y * sm.x);\n"
+		     << "    }\n";
+		break;
+	    case STAGE_APPLYMASK:
+		args << ", global const uchar* mask" << i << ", index1DType maskStride" << i;
+		body << "    if(mask" << i << "[voxel + frame * maskStride" << i << "] == 0)\n"
+		     << "\tz = 0;\n";
+		break;
+	    case STAGE_COMPLEXABS:
+		body << "    z = (complexType)(hypot(z.x, z.y), 0);\n";
+		break;
+	    case STAGE_COMPLEXABSPOW2:
+		body << "    z = (complexType)(z.x * z.x + z.y * z.y, 0);\n";
+		break;
+	    case STAGE_COMPLEXPOW:
+		body << "    z = (complexType)(z.x * z.x - z.y * z.y, 2 * z.x * z.y);\n";
+		break;
+	    case STAGE_COMPLEX2REAL: {
+		auto pIP = std::dynamic_pointer_cast<Complex2Real::InitParameters>(nodes[i].pProcess->getInitParameters());
+		ComplexPart convType = pIP ? pIP->convType : ComplexPart::ABS;
+		switch(convType) {
+		    case ComplexPart::REAL:
+			body << "    z = (complexType)(z.x, 0);\n";
+			break;
+		    case ComplexPart::IMAG:
+			body << "    z = (complexType)(z.y, 0);\n";
+			break;
+		    case ComplexPart::ABS:
+			body << "    z = (complexType)(hypot(z.x, z.y), 0);\n";
+			break;
+		    case ComplexPart::ARG:
+			body << "    z = (complexType)(atan2(z.y, z.x), 0);\n";
+			break;
+		    default:
+			BTTHROW(std::invalid_argument("unknown Complex2Real conversion type requested"), "ProcessGraph::init");
+		}
+		break;
+	    }
+	    default:
+		BTTHROW(std::invalid_argument("process can't be fused"), "ProcessGraph::init");
+	}
+    }
+
+    body << "    output[voxel + (coil + frame * outCoils) * outStride] = " << (realOutput ? "z.x" : "z") << ";\n";
+
+    std::ostringstream source;
+    source << "kernel void " << name << "(" << args.str() << ") {\n" << body.str() << "}\n\n";
+    return source.str();
+}
+
+/**
+ * @brief Sets arguments of a fused kernel from the current launch parameters of its nodes and enqueues it
+ * @param[in] fusedKernel fused kernel description
+ */
+void ProcessGraph::launchFusedKernel(FusedKernel& fusedKernel) {
+    const auto& pIn = nodes[fusedKernel.firstNode].pIn;
+    const auto& pOut = nodes[fusedKernel.lastNode].pOut;
+    std::vector<std::shared_ptr<Data>> readData = {pIn};
+
+    cl::Kernel& k = fusedKernel.kernel;
+    cl_uint arg = 0;
+    k.setArg(arg++, *(pIn->getDeviceBuffer()));
+    k.setArg(arg++, *(pOut->getDeviceBuffer()));
+    k.setArg(arg++, fusedKernel.numVoxels);
+    k.setArg(arg++, fusedKernel.inCoils);
+    k.setArg(arg++, fusedKernel.inStride);
+    k.setArg(arg++, fusedKernel.outCoils);
+    k.setArg(arg++, fusedKernel.outStride);
+
+    for(size_t i = fusedKernel.firstNode; i <= fusedKernel.lastNode; i++) {
+	const Node& node = nodes[i];
+	auto pLP = node.pLP ? node.pLP : node.pProcess->getLaunchParameters();
+
+	switch(node.stageType) {
+	    case STAGE_SCALARMULTIPLY: {
+		// Same default as ScalarMultiply itself
+		auto pSMLP = std::dynamic_pointer_cast<ScalarMultiply::LaunchParameters>(pLP);
+		k.setArg(arg++, pSMLP ? pSMLP->factor : static_cast<realType>(0));
+		break;
+	    }
+	    case STAGE_COMPLEXELEMENTPROD: {
+		auto pCEPLP = std::dynamic_pointer_cast<ComplexElementProd::LaunchParameters>(pLP);
+		if(!pCEPLP || !pCEPLP->sensitivityMapsData)
+		    BTTHROW(std::invalid_argument("non-existing SensitivityMaps"), "ProcessGraph::launch");
+		if(pCEPLP->sensitivityMapsData->getElementDataType() != TYPEID_COMPLEX)
+		    BTTHROW(std::invalid_argument("fused kernels only support single precision SensitivityMaps"), "ProcessGraph::launch");
+
+		const auto& pSensMaps = pCEPLP->sensitivityMapsData;
+		k.setArg(arg++, *(pSensMaps->getDeviceBuffer()));
+		k.setArg(arg++, static_cast<cl_uint>(pCEPLP->conjugateSensMap == ComplexElementProd::conjugate));
+		k.setArg(arg++, static_cast<index1DType>(pSensMaps->getData()->size() > 1 ? getNDArrayDistance(pSensMaps) : 0));
+		readData.push_back(pSensMaps);
+		break;
+	    }
+	    case STAGE_APPLYMASK: {
+		auto pAMLP = std::dynamic_pointer_cast<ApplyMask::LaunchParameters>(pLP);
+		if(!pAMLP || !pAMLP->samplingMasksData)
+		    BTTHROW(std::invalid_argument("non-existing SamplingMasks"), "ProcessGraph::launch");
+
+		const auto& pMasks = pAMLP->samplingMasksData;
+		k.setArg(arg++, *(pMasks->getDeviceBuffer()));
+		k.setArg(arg++, static_cast<index1DType>(pMasks->getData()->size() > 1 ? getNDArrayDistance(pMasks) : 0));
+		readData.push_back(pMasks);
+		break;
+	    }
+	    default:
+		break;
+	}
+    }
+
+    waitForDataDependencies(readData, {pOut});
+
+    cl::Event event;
+    queue.enqueueNDRangeKernel(k, cl::NullRange, fusedKernel.globalSize, cl::NullRange, nullptr, &event);
+    for(auto& pData: readData)
+	recordDataRead(pData, event);
+    recordDataWrite(pOut, event);
+}
+
+} // namespace OpenCLIPER
+
+#undef PROCESSGRAPH_DEBUG
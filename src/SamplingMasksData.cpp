@@ -117,14 +117,16 @@ SamplingMasksData::SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, std::
  * @param[in,out] pDynDims pointer to vector of tempoeral dimensions
  * @param[in] framesFileNameSuffix name suffix for name part depending on frame index
  * @param[in] fileNameExtension extension for the name of the file
+ * @param[in] mapFiles true to map files into memory instead of reading them (see Data::getRawFileMapping())
  */
 SamplingMasksData::SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const std::string &dataFileNamePrefix,
 		std::vector<std::vector< dimIndexType >*>*& pArraysDims,
 		std::vector <dimIndexType>*& pDynDims, dimIndexType kDataNumCols,
 		const std::string& framesFileNameSuffix, const std::string& fileNameExtension,
-		ElementDataType elementDataType):
+		ElementDataType elementDataType, bool mapFiles):
 				   Data(elementDataType) {
 	this->kDataNumCols = kDataNumCols;
+	rawFileMapping = mapFiles;
 	// ROWMASK format => elementDataType of type dimIndex
 	// PIXELMASK format => elementDataType of type cl_uchar
 	if ((elementDataType != TYPEID_INDEX) && (elementDataType != TYPEID_CL_UCHAR)) {
@@ -142,9 +144,10 @@ SamplingMasksData::SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const
 SamplingMasksData::SamplingMasksData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName,
 		const std::vector<dimIndexType>* pArraySpatialDims,
 		const std::vector <dimIndexType>* pTemporalDims, dimIndexType kDataNumCols,
-		ElementDataType elementDataType):
+		ElementDataType elementDataType, bool mapFile):
 				   Data(elementDataType) {
 	this->kDataNumCols = kDataNumCols;
+	rawFileMapping = mapFile;
 	if ((elementDataType != TYPEID_INDEX) && (elementDataType != TYPEID_CL_UCHAR)) {
 		BTTHROW(std::invalid_argument("Invalid mask format (supported: ROWMASK and PIXELMASK"), "SamplingMasksData::SamplingMasksData");
 	}
@@ -356,7 +359,7 @@ void SamplingMasksData::rowmask2rowstoblank() {
 		pListOfRawsToBlankInFrame = new std::vector<dimIndexType>;
 		// Only 1 spatial dimension per NDArray
 		for(dimIndexType elementIndex = 0; elementIndex < getData()->at(i)->getDims()->at(0); elementIndex ++) {
-			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getData()->at(i))->getHostData()->at(elementIndex);
+			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getData()->at(i))->getHostDataPointer()[elementIndex];
 			switch(elementData) {
 			case 0: // if 0 line has not been captured, it must be blanked
 				pListOfRawsToBlankInFrame->push_back(elementIndex);
@@ -401,7 +404,7 @@ void SamplingMasksData::rowmask2pixelmask() {
 		// Only 1 spatial dimension per NDArray (width or number of columns of row vector)
 		pPixelMaskFormatNDArray = new std::vector<cl_uchar>; // set to nullptr during createNDArray
 		for(dimIndexType elementIndex = 0; elementIndex < NDARRAYWIDTH(getNDArray(frame)); elementIndex ++) {
-			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getNDArray(frame))->getHostData()->at(elementIndex);
+			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getNDArray(frame))->getHostDataPointer()[elementIndex];
 			switch(elementData) {
 			case 0: // if 0 line has not been captured, it must be blanked
 				pixelMaskFormatElement = 0;
@@ -459,7 +462,7 @@ void SamplingMasksData::rowstoblank2rowmask() {
 		lastLineNotProcessedId = 0;
 		// Only 1 spatial dimension per NDArray
 		for(dimIndexType elementIndex = 0; elementIndex < getData()->at(i)->getDims()->at(0); elementIndex++) {
-			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getData()->at(i))->getHostData()->at(elementIndex);
+			elementData = static_cast<const ConcreteNDArray<dimIndexType>*>(getData()->at(i))->getHostDataPointer()[elementIndex];
 			for(dimIndexType lineIndex = lastLineNotProcessedId; lineIndex < elementData; lineIndex++) {
 				pListOfStatusOfLines->push_back(1); // all lines captured previous to a non-captured line
 			}
@@ -123,17 +123,20 @@ SensitivityMapsData::SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, c
  * @param[in] numCoils number of coils used (number of sensitivity maps)
  * @param[in] coilsFileNameSuffix name suffix for name part depending on coil index
  * @param[in] fileNameExtension extension for the name of the file
+ * @param[in] mapFiles true to map files into memory instead of reading them (see Data::getRawFileMapping())
  */
 SensitivityMapsData::SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, const std::string &dataFileNamePrefix,
 	std::vector<std::vector< dimIndexType >*>*& pArraysDims,
 	numCoilsType numCoils, const std::string &coilsFileNameSuffix,
-	const std::string &fileNameExtension) : Data(TYPEID_COMPLEX) {
+	const std::string &fileNameExtension, bool mapFiles) : Data(TYPEID_COMPLEX) {
+    rawFileMapping = mapFiles;
     loadRawHostData(dataFileNamePrefix, pArraysDims, numCoils, coilsFileNameSuffix, fileNameExtension);
     setApp(pCLapp, true);
 }
 
 SensitivityMapsData::SensitivityMapsData(const std::shared_ptr<CLapp>& pCLapp, const std::string &fileName, const std::vector<dimIndexType>* pArraySpatialDims,
-		dimIndexType numCoils) : Data(TYPEID_COMPLEX) {
+		dimIndexType numCoils, bool mapFile) : Data(TYPEID_COMPLEX) {
+	rawFileMapping = mapFile;
 	setNCoils(numCoils);
 	loadRawData(fileName, pArraySpatialDims, numCoils);
 	setApp(pCLapp, true);
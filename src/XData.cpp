@@ -474,11 +474,14 @@ XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::vector<std::string
  * @param[in] framesFileNameSuffix suffix for file name part related to frames
  * @param[in] fileNameExtension extension common to all file names
  * @param[in] elementDataType Data type of vector elements stored in this object (default value is a complex type)
+ * @param[in] mapFiles true to map files into memory instead of reading them (see Data::getRawFileMapping())
  */
 XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNamePrefix,
 	     std::vector<std::vector< dimIndexType >*>*& pArraysDims, std::vector <dimIndexType>*& pDynDims,
-	     const std::string& framesFileNameSuffix, const std::string& fileNameExtension, ElementDataType elementDataType):
+	     const std::string& framesFileNameSuffix, const std::string& fileNameExtension, ElementDataType elementDataType,
+	     bool mapFiles):
     Data(elementDataType) {
+    rawFileMapping = mapFiles;
     loadRawHostData(dataFileNamePrefix, pArraysDims, pDynDims, framesFileNameSuffix, fileNameExtension);
     setApp(pCLapp, true);
 }
@@ -490,7 +493,6 @@ XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& dataFileNa
  * @param[in] fileName name of the data file
  */
 XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& fileName, ElementDataType elementDataType): Data() {
-    std::map<std::string, matvar_t*>* pMatlabVariablesMap;
     try {
 	XDATA_CERR("Trying to read image file...\n");
 	commonFieldInitialization(elementDataType);
@@ -503,13 +505,13 @@ XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& fileName,
     }
     catch(std::exception &e) {    // It is not an image file, trying to read a matlab file
 	XDATA_CERR("Trying to read matlab file...\n");
-	pMatlabVariablesMap = Data::readMatlabVariablesFromFile(fileName);
+	MatlabFileIndex matlabFile(fileName);
 	XDATA_CERR("Done\n");
 	matvar_t* pDimsMatVar = nullptr, *pXDataMatVar = nullptr;
 
 	// Read of matlab variable storing number of spatial and temporal dimensions of data (if not exists it is an unrecoverable error and method aborts)
 	try {
-	    pDimsMatVar = pMatlabVariablesMap->at(MatVarDimsData::matVarNameDims);
+	    pDimsMatVar = matlabFile.readVariable(MatVarDimsData::matVarNameDims);
 	}
 	catch(std::out_of_range& e) {
 	    BTTHROW(std::invalid_argument("Error: no Dims variable in matlab file"), "XData::XData");
@@ -526,8 +528,8 @@ XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& fileName,
 
 	// Read of matlab variable storing XData data (if not exists it is an unrecoverable error and method is aborted)
 	try {
-	    pXDataMatVar = pMatlabVariablesMap->at(matVarNameXData);
-	    // out_of_range exception if there is no value with the key "XData" in the map
+	    pXDataMatVar = matlabFile.getVariableInfo(matVarNameXData);
+	    // out_of_range exception if there is no variable named "XData" in the file
 	}
 	catch(std::out_of_range& e) {
 	    BTTHROW(std::invalid_argument("Error: no XData variable in matlab file"), "XData::XData");
@@ -553,7 +555,7 @@ XData::XData(const std::shared_ptr<CLapp>& pCLapp, const std::string& fileName,
 	// Number of XData NDArrays to be read is the product of all temporal dimensions
 	numOfNDArraysToBeRead = getDynDimsTotalSize();
 	XDATA_CERR("XData reading data...\n");
-	((Data*)(this))->loadMatlabHostData(pXDataMatVar, nSpatialDims, numOfNDArraysToBeRead);
+	((Data*)(this))->loadMatlabHostData(matlabFile, matVarNameXData, nSpatialDims, numOfNDArraysToBeRead);
 	XDATA_CERR("Done\n");
     }
     setApp(pCLapp, true);
@@ -841,31 +843,43 @@ void XData::save(const std::string& prefixName, const std::string& extension) {
     save(outputFileNames);
 }
 
-void saveRawDataForThread(std::shared_ptr<Data> xData, std::string fileName) {
-    xData->saveRawData(fileName);
-    std::string headerFileName = LPISupport::Utils::basename(fileName) + ".hdr";
-    std::dynamic_pointer_cast<XData>(xData)->saveCFLHeader(headerFileName);
-    //delete(xData);
-}
-
+/**
+ * @brief Saves data to a file in CFL format (data in <fileName>.cfl and dimensions in <fileName>.hdr)
+ * @param[in] fileName name of the files without extension
+ * @param[in] asyncSave true to write files in the background (see saveCFLDataAsync())
+ */
 void XData::saveCFLData(const std::string &fileName, bool asyncSave) {
-    device2Host();
+    if(getElementDataType() == TYPEID_COMPLEXHALF)
+	BTTHROW(std::invalid_argument("half precision data can't be saved in CFL format (convert them with ComplexHalfConvert first)"), "XData::saveCFLData");
     if (asyncSave) {
-	dataForSaving = clone(true);
-	XDATA_CERR("XData::saveCFLData(): myDataHandle="<<getHandle()<<"; dataForSaving->myDataHandle="<<dataForSaving->getHandle()<<"\n");
-	pCLapp->host2Device(dataForSaving->myDataHandle);
-	std::thread threadDataSave = std::thread(saveRawDataForThread, dataForSaving, fileName + ".cfl");
-
-	// Necesario para que la nueva thread sea independiente de la original y pueda desaparecer, liberando
-	// sus recursos, cuando acabe su función (aunque esto impide hacer un join desde la thread padre)
-	threadDataSave.detach();
+	saveCFLDataAsync(fileName);
     } else {
+	device2Host();
 	saveRawData(fileName + ".cfl");
 	std::string headerFileName = LPISupport::Utils::basename(fileName) + ".hdr";
 	saveCFLHeader(headerFileName);
     }
 }
 
+/**
+ * @brief Copies data back to host memory and saves them to a file in CFL format in the background. Files are written
+ * straight from host buffers of this object, which must not be modified until the save ends (see Data::submitSave()).
+ * @param[in] fileName name of the files without extension
+ * @param[in] pWriter writer running the save (DataWriter::getDefault() if nullptr)
+ * @return future which becomes ready when files have been written (get() rethrows any error)
+ */
+std::shared_future<void> XData::saveCFLDataAsync(const std::string &fileName, DataWriter* pWriter) {
+    if(getElementDataType() == TYPEID_COMPLEXHALF)
+	BTTHROW(std::invalid_argument("half precision data can't be saved in CFL format (convert them with ComplexHalfConvert first)"), "XData::saveCFLDataAsync");
+    device2Host();
+    XDATA_CERR("XData::saveCFLDataAsync(): myDataHandle=" << getHandle() << "\n");
+    return submitSave([this, fileName]() {
+	saveRawData(fileName + ".cfl");
+	std::string headerFileName = LPISupport::Utils::basename(fileName) + ".hdr";
+	saveCFLHeader(headerFileName);
+    }, pWriter);
+}
+
 void XData::saveCFLHeader(const std::string &fileName) {
     std::fstream f;
     LPISupport::Utils::openFile(fileName, f, std::ofstream::out|std::ofstream::trunc, "XData::saveCFLHeader");
@@ -896,19 +910,51 @@ void XData::calcDataDims() {
  * @throw std::invalid_argument if matlab file cannot be written or image data is empty
  */
 void XData::matlabSave(const std::string& fileName) {
-    mat_t* matfp;
-    matfp = Mat_CreateVer(fileName.c_str(), NULL, MAT_FT_DEFAULT);
-    if(NULL == matfp) {
-	BTTHROW(std::invalid_argument(std::string("Error creating MAT file")  + fileName), "XData::matlabSave");
-    }
+    prepareMatlabSave();
+    matlabWrite(fileName);
+}
+
+/**
+ * @brief Copies data back to host memory and saves them to a file in matlab format in the background. The file is written
+ * straight from host buffers of this object, which must not be modified until the save ends (see Data::submitSave()).
+ * @param[in] fileName name of the file tha data will be saved to
+ * @param[in] pWriter writer running the save (DataWriter::getDefault() if nullptr)
+ * @return future which becomes ready when the file has been written (get() rethrows any error, e.g. std::invalid_argument
+ * if matlab file cannot be written or image data is empty)
+ */
+std::shared_future<void> XData::matlabSaveAsync(const std::string& fileName, DataWriter* pWriter) {
+    prepareMatlabSave();
+    return submitSave([this, fileName]() {
+	matlabWrite(fileName);
+    }, pWriter);
+}
 
+/**
+ * @brief Copies data back to host memory and creates the matlab Dims variable (if not created yet) before saving data
+ * to a matlab file
+ */
+void XData::prepareMatlabSave() {
     this->device2Host();
 
-    // Save dims variable
     if(pMatVarDimsData == nullptr) {
 	// Create matlab Dims variable
 	pMatVarDimsData.reset(new MatVarDimsData(pCLapp, getNDArray(0)->getDims(), getAllSizesEqual(), 0, getDynDims()));
     }
+}
+
+/**
+ * @brief Writes data (already in host memory, see prepareMatlabSave()) to a file in matlab format
+ * @param[in] fileName name of the file tha data will be saved to
+ * @throw std::invalid_argument if matlab file cannot be written or image data is empty
+ */
+void XData::matlabWrite(const std::string& fileName) {
+    mat_t* matfp;
+    matfp = Mat_CreateVer(fileName.c_str(), NULL, MAT_FT_DEFAULT);
+    if(NULL == matfp) {
+	BTTHROW(std::invalid_argument(std::string("Error creating MAT file")  + fileName), "XData::matlabSave");
+    }
+
+    // Save dims variable
     pMatVarDimsData->matlabSaveVariable(matfp);
 
     // Saving image data
@@ -3,31 +3,31 @@
 //#define DEBUG
 
 kernel void applyMask_complex(global complexType* input, global const uchar* mask) {
-    dimIndexType dataOffset = get_global_id(0);
-    dimIndexType maskOffset = get_global_id(0);
-    dimIndexType numCoils = getNumCoils(input);
-    dimIndexType numFrames = getTemporalDimSize(input, 0); // of input for temporal dimension 0
-    dimIndexType coilStride = getCoilStride(input, 0); // of input for NDArray 0
-    dimIndexType dataFrameStride = getTemporalDimStride(input, 0, 0); // of input for temporal dimension 0, NDArray 0
-    dimIndexType maskFrameStride = getTemporalDimStride(mask, 0, 0); // of input for temporal dimension 0, NDArray 0
+    index1DType dataOffset = get_global_id(0);
+    index1DType maskOffset = get_global_id(0);
+    index1DType numCoils = getNumCoils(input);
+    index1DType numFrames = getTemporalDimSize(input, 0); // of input for temporal dimension 0
+    index1DType coilStride = getCoilStride(input, 0); // of input for NDArray 0
+    index1DType dataFrameStride = getTemporalDimStride(input, 0, 0); // of input for temporal dimension 0, NDArray 0
+    index1DType maskFrameStride = getTemporalDimStride(mask, 0, 0); // of input for temporal dimension 0, NDArray 0
     uint2 maskWord;
 #ifdef DEBUG
     if (get_global_id(0) == 0) {
 		printf("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! applyMask_kernel !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n");
-		printf("dataOffset: %u\t", dataOffset);
-		printf("maskOffset: %u\t", maskOffset);
-		printf("numCoils: %u\t", numCoils);
-		printf("numFrames: %u\t", numFrames);
-		printf("coilStride: %u\t", coilStride);
-		printf("dataFrameStride: %u\t", dataFrameStride);
-		printf("maskFrameStride: %u\n", maskFrameStride);
+		printf("dataOffset: %lu\t", (ulong) dataOffset);
+		printf("maskOffset: %lu\t", (ulong) maskOffset);
+		printf("numCoils: %lu\t", (ulong) numCoils);
+		printf("numFrames: %lu\t", (ulong) numFrames);
+		printf("coilStride: %lu\t", (ulong) coilStride);
+		printf("dataFrameStride: %lu\t", (ulong) dataFrameStride);
+		printf("maskFrameStride: %lu\n", (ulong) maskFrameStride);
 		printf("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! end applyMask_kernel !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n");
 		printf("\n");
     }
 #endif
-    for (int frame = 0; frame < numFrames; frame++) {
+    for (index1DType frame = 0; frame < numFrames; frame++) {
     	dataOffset = get_global_id(0) + frame * dataFrameStride; // increment by frameStride is not valid, coilOffset must be reset to 0
-		for (int coil = 0; coil < numCoils; coil ++) {
+		for (index1DType coil = 0; coil < numCoils; coil ++) {
 			//maskWord = select((uint2)0, (uint2)-1, (uint2)mask[maskOffset]);
 			//input[dataOffset] = as_float2(as_uint2(input[dataOffset]) & maskWord);
 			if (mask[maskOffset] == 0) {
@@ -40,31 +40,31 @@ kernel void applyMask_complex(global complexType* input, global const uchar* mas
 }
 
 kernel void applyMask_real(global realType* input, global const uchar* mask) {
-    dimIndexType dataOffset = get_global_id(0);
-    dimIndexType maskOffset = get_global_id(0);
-    dimIndexType numCoils = getNumCoils(input);
-    dimIndexType numFrames = getTemporalDimSize(input, 0); // of input for temporal dimension 0
-    dimIndexType coilStride = getCoilStride(input, 0); // of input for NDArray 0
-    dimIndexType dataFrameStride = getTemporalDimStride(input, 0, 0); // of input for temporal dimension 0, NDArray 0
-    dimIndexType maskFrameStride = getTemporalDimStride(mask, 0, 0); // of input for temporal dimension 0, NDArray 0
+    index1DType dataOffset = get_global_id(0);
+    index1DType maskOffset = get_global_id(0);
+    index1DType numCoils = getNumCoils(input);
+    index1DType numFrames = getTemporalDimSize(input, 0); // of input for temporal dimension 0
+    index1DType coilStride = getCoilStride(input, 0); // of input for NDArray 0
+    index1DType dataFrameStride = getTemporalDimStride(input, 0, 0); // of input for temporal dimension 0, NDArray 0
+    index1DType maskFrameStride = getTemporalDimStride(mask, 0, 0); // of input for temporal dimension 0, NDArray 0
     uint2 maskWord;
 #ifdef DEBUG
     if (get_global_id(0) == 0) {
 		printf("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! applyMask_kernel !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n");
-		printf("dataOffset: %u\t", dataOffset);
-		printf("maskOffset: %u\t", maskOffset);
-		printf("numCoils: %u\t", numCoils);
-		printf("numFrames: %u\t", numFrames);
-		printf("coilStride: %u\t", coilStride);
-		printf("dataFrameStride: %u\t", dataFrameStride);
-		printf("maskFrameStride: %u\n", maskFrameStride);
+		printf("dataOffset: %lu\t", (ulong) dataOffset);
+		printf("maskOffset: %lu\t", (ulong) maskOffset);
+		printf("numCoils: %lu\t", (ulong) numCoils);
+		printf("numFrames: %lu\t", (ulong) numFrames);
+		printf("coilStride: %lu\t", (ulong) coilStride);
+		printf("dataFrameStride: %lu\t", (ulong) dataFrameStride);
+		printf("maskFrameStride: %lu\n", (ulong) maskFrameStride);
 		printf("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! end applyMask_kernel !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n");
 		printf("\n");
     }
 #endif
-    for (int frame = 0; frame < numFrames; frame++) {
+    for (index1DType frame = 0; frame < numFrames; frame++) {
 		dataOffset = get_global_id(0) + frame * dataFrameStride; // increment by frameStride is not valid, coilOffset must be reset to 0
-		for (int coil = 0; coil < numCoils; coil ++) {
+		for (index1DType coil = 0; coil < numCoils; coil ++) {
 			//maskWord = select((uint2)0, (uint2)-1, (uint2)mask[maskOffset]);
 			//input[dataOffset] = as_float2(as_uint2(input[dataOffset]) & maskWord);
 			if (mask[maskOffset] == 0) {
@@ -74,4 +74,24 @@ kernel void applyMask_real(global realType* input, global const uchar* mask) {
 		}
 		maskOffset += maskFrameStride;
     }
-}
\ No newline at end of file
+}
+
+// Half precision complex elements (TYPEID_COMPLEXHALF): a pair of halfs is handled as a 32 bit word, which is zero if both halfs are
+kernel void applyMask_complexHalf(global uint* input, global const uchar* mask) {
+    index1DType maskOffset = get_global_id(0);
+    index1DType numCoils = getNumCoils(input);
+    index1DType numFrames = getTemporalDimSize(input, 0); // of input for temporal dimension 0
+    index1DType coilStride = getCoilStride(input, 0); // of input for NDArray 0
+    index1DType dataFrameStride = getTemporalDimStride(input, 0, 0); // of input for temporal dimension 0, NDArray 0
+    index1DType maskFrameStride = getTemporalDimStride(mask, 0, 0); // of input for temporal dimension 0, NDArray 0
+    for (index1DType frame = 0; frame < numFrames; frame++) {
+		index1DType dataOffset = get_global_id(0) + frame * dataFrameStride;
+		for (index1DType coil = 0; coil < numCoils; coil ++) {
+			if (mask[maskOffset] == 0) {
+				input[dataOffset] = 0;
+			}
+			dataOffset += coilStride;
+		}
+		maskOffset += maskFrameStride;
+    }
+}
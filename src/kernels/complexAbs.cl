@@ -46,16 +46,16 @@ __kernel void complexAbs(__global float2* in, __global float2* out) {
 	int j = get_global_id(1);
 	int k = get_global_id(2);
 
-	uint cols = getSpatialDimSize(in, COLUMNS, 0);
-	uint rows = getSpatialDimSize(in, ROWS, 0);
+	uint cols = SHAPE_OR(COLUMNS, getSpatialDimSize(in, COLUMNS, 0));
+	uint rows = SHAPE_OR(ROWS, getSpatialDimSize(in, ROWS, 0));
 
-	uint nCoils = getNumCoils(in);
-	uint nFrames = getTemporalDimSize(in, 0);
-	uint inCoilStride = getCoilStride(in, 0);
-	uint outCoilStride = getCoilStride(out, 0);
-	uint inFrameStride = getTemporalDimStride(in, 0, 0);
+	uint nCoils = SHAPE_OR(NUMCOILS, getNumCoils(in));
+	uint nFrames = SHAPE_OR(NUMFRAMES, getTemporalDimSize(in, 0));
+	index1DType inCoilStride = SHAPE_OR(COILSTRIDE, getCoilStride(in, 0));
+	index1DType outCoilStride = getCoilStride(out, 0);
+	index1DType inFrameStride = SHAPE_OR(FRAMESTRIDE, getTemporalDimStride(in, 0, 0));
 
-	uint idx = (k * rows * cols + j * cols + i);
+	index1DType idx = ((index1DType) k * rows * cols + (index1DType) j * cols + i);
 	for(uint frame = 0; frame < nFrames; frame++){
 		complexType inC = in[idx];
 		complexType outC = out[idx];
@@ -39,28 +39,34 @@
 
 #include <OpenCLIPER/kernels/hostKernelFunctions.h>
 
-kernel void complexElementProd_kernel(global complexType* inBuffer, global complexType* sensMaps, global complexType* outBuffer, uint conjugateMask)  {
-	uint inOffset = get_global_id(0);
-	uint outOffset = get_global_id(0);
-	uint sensMapsOffset = get_global_id(0);
+// Bits of halfStorage telling which buffers hold half precision complex elements (see LOADCOMPLEX)
+#define HALFSTORAGE_INPUT	1
+#define HALFSTORAGE_SENSMAPS	2
+#define HALFSTORAGE_OUTPUT	4
 
-	uint inCoilStride = getCoilStride(inBuffer,0);
-	uint outCoilStride = getCoilStride(outBuffer,0);
-	uint sensMapsCoilStride = getCoilStride(sensMaps,0);
+kernel void complexElementProd_kernel(global void* inBuffer, global void* sensMaps, global void* outBuffer, uint conjugateMask, uint halfStorage)  {
+	index1DType inOffset = get_global_id(0);
+	index1DType outOffset = get_global_id(0);
+	index1DType sensMapsOffset = get_global_id(0);
+
+	index1DType inCoilStride = getCoilStride(inBuffer,0);
+	// Shape specialization (if any) is done for the output, which always has the same frames as the input
+	index1DType outCoilStride = SHAPE_OR(COILSTRIDE, getCoilStride(outBuffer,0));
+	index1DType sensMapsCoilStride = getCoilStride(sensMaps,0);
 
 	// Note that the output is ALWAYS separated in coils whereas the input may consist of several coils or be the X-space image (and hence have no coils)
-	uint nCoils = getNumCoils(outBuffer);
+	uint nCoils = SHAPE_OR(NUMCOILS, getNumCoils(outBuffer));
     
-	uint nFrames = getTemporalDimSize(inBuffer, 0);
+	uint nFrames = SHAPE_OR(NUMFRAMES, getTemporalDimSize(inBuffer, 0));
 
 	for(uint frame = 0; frame < nFrames; frame++) {
 		for(uint coil = 0; coil < nCoils; coil++) {
-			complexType in = inBuffer[inOffset];
-			complexType sm = sensMaps[sensMapsOffset];
+			complexType in = LOADCOMPLEX(inBuffer, inOffset, halfStorage & HALFSTORAGE_INPUT);
+			complexType sm = LOADCOMPLEX(sensMaps, sensMapsOffset, halfStorage & HALFSTORAGE_SENSMAPS);
 			sm.y = as_float(as_uint(sm.y) ^ conjugateMask);
 
-			outBuffer[outOffset].x = in.x * sm.x - in.y * sm.y;
-			outBuffer[outOffset].y = in.x * sm.y + in.y * sm.x;
+			complexType out = (complexType)(in.x * sm.x - in.y * sm.y, in.x * sm.y + in.y * sm.x);
+			STORECOMPLEX(out, outBuffer, outOffset, halfStorage & HALFSTORAGE_OUTPUT);
 
 			inOffset += inCoilStride;
 			outOffset += outCoilStride;
@@ -0,0 +1,79 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+/*! \file fft.cl
+ *	\brief Helper kernels for the FFT process
+ */
+
+#include <OpenCLIPER/kernels/hostKernelFunctions.h>
+
+/// Value of rowMap for rows not included in the sampling mask
+#define FFT_UNSAMPLED_ROW 0xFFFFFFFFu
+
+/**
+ * Copies the rows selected by a sampling mask to a packed buffer (one contiguous row after another), so that all of them
+ * can be transformed with a single batched FFT. Launch with global size (rowLength, number of packed rows).
+ * @param[in] input data to be transformed
+ * @param[out] packed packed rows
+ * @param[in] packedRows index (in input) of every packed row
+ * @param[in] rowLength number of elements per row
+ * @param[in] rowDistance distance between consecutive rows in input
+ * @param[in] elementStride distance between consecutive elements of a row in input
+ */
+kernel void fftGatherRows(global const complexType* input, global complexType* packed, global const uint* packedRows,
+			  uint rowLength, index1DType rowDistance, index1DType elementStride) {
+    uint j = get_global_id(0);
+    uint p = get_global_id(1);
+
+    packed[(index1DType) p * rowLength + j] = input[(index1DType) packedRows[p] * rowDistance + j * elementStride];
+}
+
+/**
+ * Copies transformed packed rows back to their place in output, and sets rows not selected by the sampling mask to zero.
+ * Launch with global size (rowLength, total number of rows).
+ * @param[in] packed packed (transformed) rows
+ * @param[out] output transformed data
+ * @param[in] rowMap index (in packed) of every output row, or FFT_UNSAMPLED_ROW if the row is not selected by the sampling mask
+ * @param[in] rowLength number of elements per row
+ * @param[in] rowDistance distance between consecutive rows in output
+ * @param[in] elementStride distance between consecutive elements of a row in output
+ */
+kernel void fftScatterRows(global const complexType* packed, global complexType* output, global const uint* rowMap,
+			   uint rowLength, index1DType rowDistance, index1DType elementStride) {
+    uint j = get_global_id(0);
+    uint row = get_global_id(1);
+    uint p = rowMap[row];
+
+    output[(index1DType) row * rowDistance + j * elementStride] = (p == FFT_UNSAMPLED_ROW) ? (complexType)(0.0f, 0.0f) :
+										      packed[(index1DType) p * rowLength + j];
+}
@@ -49,9 +49,9 @@
  * @param[in] baseNumber value whose multiple nearest to numToRound is returned
  * @return rounded number (nearest multiple of baseNumber)
  */
-uint roundUp(uint numToRound, uint baseNumber) {
+index1DType roundUp(index1DType numToRound, index1DType baseNumber) {
     //assert(baseNumber);
-    uint remainder = numToRound % baseNumber;
+    index1DType remainder = numToRound % baseNumber;
     PRINTF(("remainder: %d\n", remainder));
     if(remainder == 0) {
 	return numToRound;
@@ -66,21 +66,21 @@ uint roundUp(uint numToRound, uint baseNumber) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return offset in bytes
  */
-uint getDimsAndStridesArrayOffsetInBytes(global const void* buffer) {
-    // first uint element of input buffer before data start position is offset in bytes for dimensions and strides vector
-    uint dataDimsAndStridesArrayOffset = *((global uint*) buffer - 1);
+index1DType getDimsAndStridesArrayOffsetInBytes(global const void* buffer) {
+    // first index1DType element of input buffer before data start position is offset in bytes for dimensions and strides vector
+    index1DType dataDimsAndStridesArrayOffset = *((global index1DType*) buffer - 1);
     return dataDimsAndStridesArrayOffset;
 }
 
 /**
- * @brief Return a uint pointer to the array of data dimensions and strides stored inside an OpenCL buffer
+ * @brief Return a index1DType pointer to the array of data dimensions and strides stored inside an OpenCL buffer
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return pointer to the array of dimensions and strides
  */
-global const uint* getDimsAndStridesArrayInBuffer(global const void* buffer) {
-    uint dimsAndStridesArrayOffsetInBytes = getDimsAndStridesArrayOffsetInBytes(buffer);
-    global const uint* dimsAndStridesArray;
-    dimsAndStridesArray = ((global const uint*) buffer) - (dimsAndStridesArrayOffsetInBytes / sizeof(uint));
+global const index1DType* getDimsAndStridesArrayInBuffer(global const void* buffer) {
+    index1DType dimsAndStridesArrayOffsetInBytes = getDimsAndStridesArrayOffsetInBytes(buffer);
+    global const index1DType* dimsAndStridesArray;
+    dimsAndStridesArray = ((global const index1DType*) buffer) - (dimsAndStridesArrayOffsetInBytes / sizeof(index1DType));
     return dimsAndStridesArray;
 }
 
@@ -98,18 +98,18 @@ global const struct dimsAndStridesKnownFields* getDimsAndStridesStruct(global co
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the pointer to the start of the strides information of the dimsAndStridesInfo array
  */
-global const uint* getStridesArray(global const void* buffer) {
+global const index1DType* getStridesArray(global const void* buffer) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
-    uint numOfNDArrays = getNumNDArrays(buffer);
-    uint numOfTempDims = getNumTemporalDims(buffer);
-    uint dimsArrayNumOfPos = NUMINITIALPOSITIONSDIMSINFO + numOfTempDims;
+    index1DType numOfNDArrays = getNumNDArrays(buffer);
+    index1DType numOfTempDims = getNumTemporalDims(buffer);
+    index1DType dimsArrayNumOfPos = NUMINITIALPOSITIONSDIMSINFO + numOfTempDims;
     if(pDimsAndStridesStruct->allSizesEqual == 1) {
 	dimsArrayNumOfPos += getNumSpatialDims(buffer);
     }
     else {
 	dimsArrayNumOfPos += getNumSpatialDims(buffer) * numOfNDArrays;
     }
-    return ((global const uint*) pDimsAndStridesStruct) + dimsArrayNumOfPos;
+    return ((global const index1DType*) pDimsAndStridesStruct) + dimsArrayNumOfPos;
 }
 
 
@@ -123,7 +123,7 @@ global const uint* getStridesArray(global const void* buffer) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the number of spatial dimensions in the data object
  */
-uint getNumSpatialDims(global const void* buffer) {
+index1DType getNumSpatialDims(global const void* buffer) {
     return getDimsAndStridesStruct(buffer)->numSpatialDims;
 }
 
@@ -133,15 +133,15 @@ uint getNumSpatialDims(global const void* buffer) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the number of NDArrays in the data object
  */
-uint getNumNDArrays(global const void* buffer) {
-    uint numOfNDArrays = 1;
-    uint numCoils = getNumCoils(buffer);
+index1DType getNumNDArrays(global const void* buffer) {
+    index1DType numOfNDArrays = 1;
+    index1DType numCoils = getNumCoils(buffer);
     if(numCoils > 0) {
 	numOfNDArrays *= numCoils;
     }
-    uint numSpatialDims = getNumTemporalDims(buffer);
+    index1DType numSpatialDims = getNumTemporalDims(buffer);
     if(numSpatialDims > 0) {
-	for(uint i = 0; i < numSpatialDims; i++) {
+	for(index1DType i = 0; i < numSpatialDims; i++) {
 	    numOfNDArrays *= getTemporalDimSize(buffer, i);
 	}
     }
@@ -156,24 +156,24 @@ uint getNumNDArrays(global const void* buffer) {
  * @param[in] temporalDimIndexes vector of indexes for the selected frame
  * @return the 1-dimensional index for a NDArray
  */
-uint getNDArray1DIndex(global const void* buffer, uint coilIndex, uint temporalDimIndexes[]) {
+index1DType getNDArray1DIndex(global const void* buffer, index1DType coilIndex, uint temporalDimIndexes[]) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
-    uint numCoils = pDimsAndStridesStruct->numCoils;
+    index1DType numCoils = pDimsAndStridesStruct->numCoils;
     // coilIndex value 0 can be used to ignore coil dimensions (if numCoils is 0)
     // but coilIndex must be < numCoils if numCoils != 0
     if((numCoils != 0) && (coilIndex >= numCoils)) {
 	// Invalid coil index, returns invalid NDArray 1D-index,
 	return -1;
     }
-    uint numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
-    for(uint temporalDimId = 0; temporalDimId < numTemporalDims; temporalDimId++) {
+    index1DType numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
+    for(index1DType temporalDimId = 0; temporalDimId < numTemporalDims; temporalDimId++) {
 	if(temporalDimIndexes[temporalDimId] >= getTemporalDimSize(buffer, temporalDimId)) {
 	    // Invalid temporal dim index for dimension number temporalDimId
 	    return -1;
 	}
     }
-    uint index = 0, stride = 1;
-    for(uint i = 0; i < numTemporalDims; i++) {
+    index1DType index = 0, stride = 1;
+    for(index1DType i = 0; i < numTemporalDims; i++) {
 	index += temporalDimIndexes[i] * stride;
 	stride *= (&pDimsAndStridesStruct->firstTemporalDimSize)[i];
     }
@@ -189,10 +189,10 @@ uint getNDArray1DIndex(global const void* buffer, uint coilIndex, uint temporalD
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the size of the selected NDArray
  */
-uint getNDArrayTotalSize(global const void* buffer, uint NDArray1DIndex) {
-    uint numSpatialDims = getNumSpatialDims(buffer);
-    uint acum = 1;
-    for(uint spatialDimPos = 0; spatialDimPos < numSpatialDims; spatialDimPos ++) {
+index1DType getNDArrayTotalSize(global const void* buffer, index1DType NDArray1DIndex) {
+    index1DType numSpatialDims = getNumSpatialDims(buffer);
+    index1DType acum = 1;
+    for(index1DType spatialDimPos = 0; spatialDimPos < numSpatialDims; spatialDimPos ++) {
 	acum *= getSpatialDimSize(buffer, spatialDimPos, NDArray1DIndex);
     }
     return acum;
@@ -204,13 +204,13 @@ uint getNDArrayTotalSize(global const void* buffer, uint NDArray1DIndex) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return cl_uint
  */
-uint getNDArrayStride(global const void* buffer) {
+index1DType getNDArrayStride(global const void* buffer) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
     if(pDimsAndStridesStruct->allSizesEqual == 1) {  // All NDArrays have the same size, only 1 group of strides valid for every NDArray
 	return 0;
     }
     else {
-	uint NDArrayStride;
+	index1DType NDArrayStride;
 	NDArrayStride = pDimsAndStridesStruct->numSpatialDims + pDimsAndStridesStruct->numTemporalDims;
 	if(pDimsAndStridesStruct->numCoils != 0) {
 	    NDArrayStride += 1;
@@ -228,8 +228,8 @@ uint getNDArrayStride(global const void* buffer) {
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the spatial stride for the specific spatial dimension and NDArray
  */
-uint getSpatialDimStride(global const void* buffer, uint spatialDimIndex, uint NDArray1DIndex) {
-    uint spatialDimStridePos = FirstSpatialStridePos + spatialDimIndex + getNDArrayStride(buffer) * NDArray1DIndex;
+index1DType getSpatialDimStride(global const void* buffer, index1DType spatialDimIndex, index1DType NDArray1DIndex) {
+    index1DType spatialDimStridePos = FirstSpatialStridePos + spatialDimIndex + getNDArrayStride(buffer) * NDArray1DIndex;
     return getStridesArray(buffer)[spatialDimStridePos];
 }
 
@@ -242,19 +242,19 @@ uint getSpatialDimStride(global const void* buffer, uint spatialDimIndex, uint N
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the size of the selected spatial dimension and NDArray
  */
-uint getSpatialDimSize(global const void* buffer, uint spatialDimIndex, uint NDArray1DIndex) {
+index1DType getSpatialDimSize(global const void* buffer, index1DType spatialDimIndex, index1DType NDArray1DIndex) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
-    uint numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
+    index1DType numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
     if(spatialDimIndex >= numSpatialDims) {  // XData
 	// invalid spatialDimPos, return 0 as size for it
 	return 0;
     }
-    uint numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
-    uint spatialDimSizePos = FirstTemporalDimPos + numTemporalDims + spatialDimIndex;
+    index1DType numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
+    index1DType spatialDimSizePos = FirstTemporalDimPos + numTemporalDims + spatialDimIndex;
     if(pDimsAndStridesStruct->allSizesEqual == 0) {
 	spatialDimSizePos += numSpatialDims * NDArray1DIndex;
     }
-    return ((global const uint*) pDimsAndStridesStruct)[spatialDimSizePos];
+    return ((global const index1DType*) pDimsAndStridesStruct)[spatialDimSizePos];
 }
 
 
@@ -268,7 +268,7 @@ uint getSpatialDimSize(global const void* buffer, uint spatialDimIndex, uint NDA
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the number of coils in the data object
  */
-uint getNumCoils(global const void* buffer) {
+index1DType getNumCoils(global const void* buffer) {
     return getDimsAndStridesStruct(buffer)->numCoils;
 }
 
@@ -278,7 +278,7 @@ uint getNumCoils(global const void* buffer) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the number of the coil dimension
  */
-uint getCoilDim(global const void* buffer) {
+index1DType getCoilDim(global const void* buffer) {
     if(getNumCoils(buffer) != 0)
 	return getNumSpatialDims(buffer);
     else
@@ -291,13 +291,13 @@ uint getCoilDim(global const void* buffer) {
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the coil stride for the specific NDArray
  */
-uint getCoilStride(global const void* buffer, uint NDArray1DIndex) {
+index1DType getCoilStride(global const void* buffer, index1DType NDArray1DIndex) {
     if(getNumCoils(buffer) == 0) {
 	// if number of coills is 0, coil stride does not exist, method returns 0
 	return 0;
     }
-    uint numSpatialDims = getNumSpatialDims(buffer);
-    uint coilStridePos = numSpatialDims + getNDArrayStride(buffer) * NDArray1DIndex;
+    index1DType numSpatialDims = getNumSpatialDims(buffer);
+    index1DType coilStridePos = numSpatialDims + getNDArrayStride(buffer) * NDArray1DIndex;
     return getStridesArray(buffer)[coilStridePos];
 }
 
@@ -312,7 +312,7 @@ uint getCoilStride(global const void* buffer, uint NDArray1DIndex) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the number of temporal dimensions in the data object
  */
-uint getNumTemporalDims(global const void* buffer) {
+index1DType getNumTemporalDims(global const void* buffer) {
     return getDimsAndStridesStruct(buffer)->numTemporalDims;
 }
 
@@ -322,7 +322,7 @@ uint getNumTemporalDims(global const void* buffer) {
  * @param[in] buffer OpenCL buffer storing data and their dimensions and strides array
  * @return the linear dimension number of the given temporal dimension
  */
-uint getTemporalDim(global const void* buffer, uint tempDim) {
+index1DType getTemporalDim(global const void* buffer, index1DType tempDim) {
     if(getNumTemporalDims(buffer) != 0)
 	return getNumSpatialDims(buffer) + ((getNumCoils(buffer) != 0)? 1:0) + tempDim;
     else
@@ -336,12 +336,12 @@ uint getTemporalDim(global const void* buffer, uint tempDim) {
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the frame stride for the specific frame dimension and NDArray
  */
-uint getTemporalDimStride(global const void* buffer, uint temporalDimIndex, uint NDArray1DIndex) {
+index1DType getTemporalDimStride(global const void* buffer, index1DType temporalDimIndex, index1DType NDArray1DIndex) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
-    uint firstTemporalStridePos;
-    uint numCoils = pDimsAndStridesStruct->numCoils;
-    uint numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
-    uint numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
+    index1DType firstTemporalStridePos;
+    index1DType numCoils = pDimsAndStridesStruct->numCoils;
+    index1DType numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
+    index1DType numTemporalDims = pDimsAndStridesStruct->numTemporalDims;
     // Invalid temporalDimIndex, return 0 as stride for it
     if(temporalDimIndex >= numTemporalDims) {
 	return 0;
@@ -350,7 +350,7 @@ uint getTemporalDimStride(global const void* buffer, uint temporalDimIndex, uint
     if(numCoils != 0) {
 	firstTemporalStridePos++; // first temporal stride is stored after coil stride
     }
-    uint temporalStridePosition = firstTemporalStridePos + temporalDimIndex + getNDArrayStride(buffer) * NDArray1DIndex;
+    index1DType temporalStridePosition = firstTemporalStridePos + temporalDimIndex + getNDArrayStride(buffer) * NDArray1DIndex;
     return getStridesArray(buffer)[temporalStridePosition];
 }
 
@@ -361,13 +361,13 @@ uint getTemporalDimStride(global const void* buffer, uint temporalDimIndex, uint
  * @param[in] temporalDimIndex index of the temporal dimension
  * @return size of the specified temporal dimension
  */
-uint getTemporalDimSize(global const void* buffer, uint temporalDimIndex) {
-    uint numTemporalDims = getNumTemporalDims(buffer);
+index1DType getTemporalDimSize(global const void* buffer, index1DType temporalDimIndex) {
+    index1DType numTemporalDims = getNumTemporalDims(buffer);
     if(temporalDimIndex >= numTemporalDims) {
 	// invalid frameDimPos, return 0 as size for it
 	return 0;
     }
-    uint temporalDimSizePos = FirstTemporalDimPos + temporalDimIndex;
+    index1DType temporalDimSizePos = FirstTemporalDimPos + temporalDimIndex;
     return getDimsAndStridesArrayInBuffer(buffer)[temporalDimSizePos];
 }
 
@@ -383,13 +383,13 @@ uint getTemporalDimSize(global const void* buffer, uint temporalDimIndex) {
  * @param[in] NDArray1DIndex 1D-index of the NDArray
  * @return the size of the selected dimension in the chosen NDArray
  */
-uint getDimSize(global const void* buffer, uint dimIndex, uint NDArray1DIndex) {
-    uint numSpatialDims = getNumSpatialDims(buffer);
+index1DType getDimSize(global const void* buffer, index1DType dimIndex, index1DType NDArray1DIndex) {
+    index1DType numSpatialDims = getNumSpatialDims(buffer);
     if(dimIndex < numSpatialDims)
 	return getSpatialDimSize(buffer, dimIndex, NDArray1DIndex);
     else {
 	dimIndex -= numSpatialDims;
-	uint nCoils = getNumCoils(buffer);
+	index1DType nCoils = getNumCoils(buffer);
 	if(nCoils) {
 	    if(dimIndex == 0)
 		return nCoils;
@@ -410,8 +410,8 @@ uint getDimSize(global const void* buffer, uint dimIndex, uint NDArray1DIndex) {
  * @param[in] NDArray1DIndex 1-dimensional index for selected NDArray (obtained from temporal dimensions indexes and coil index)
  * @return the stride for the first element of a NDArray object
  */
-uint getElementStride(global const void* buffer, uint NDArray1DIndex) {
-    uint elementStridePos = ElementStridePos + getNDArrayStride(buffer) * NDArray1DIndex;
+index1DType getElementStride(global const void* buffer, index1DType NDArray1DIndex) {
+    index1DType elementStridePos = ElementStridePos + getNDArrayStride(buffer) * NDArray1DIndex;
     return getStridesArray(buffer)[elementStridePos];
 }
 
@@ -424,14 +424,14 @@ uint getElementStride(global const void* buffer, uint NDArray1DIndex) {
  * @param[in] NDArray1DIndex 1D-index for the NDArray
  * @return the spatial stride for the specific spatial dimension and NDArray
  */
-uint getDimStride(global const void* buffer, uint dimIndex, uint NDArray1DIndex) {
+index1DType getDimStride(global const void* buffer, index1DType dimIndex, index1DType NDArray1DIndex) {
     global const struct dimsAndStridesKnownFields* pDimsAndStridesStruct = getDimsAndStridesStruct(buffer);
-    uint numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
+    index1DType numSpatialDims = pDimsAndStridesStruct->numSpatialDims;
     if(dimIndex < numSpatialDims)
 	return getSpatialDimStride(buffer, dimIndex, NDArray1DIndex);
     else {
 	dimIndex -= numSpatialDims;
-	uint nCoils = getNumCoils(buffer);
+	index1DType nCoils = getNumCoils(buffer);
 	if(nCoils) {
 	    if(dimIndex == 0)
 		return getCoilStride(buffer, NDArray1DIndex);
@@ -445,9 +445,9 @@ uint getDimStride(global const void* buffer, uint dimIndex, uint NDArray1DIndex)
     }
 }
 
-global const void* getNextElement(global const void* buffer, dimIndexType dimIndex, dimIndexType curNDArray, dimIndexType curOffset) {
+global const void* getNextElement(global const void* buffer, dimIndexType dimIndex, dimIndexType curNDArray, index1DType curOffset) {
     global const char* charBuffer = (global const char*) buffer;
-    dimIndexType stride = getDimStride(buffer, dimIndex, curNDArray);
+    index1DType stride = getDimStride(buffer, dimIndex, curNDArray);
     return charBuffer + curOffset + stride;
 }
 
@@ -470,6 +470,27 @@ void printVector(__constant char name[], float* vector, uint numberOfElements) {
     printf("%f)\n", vector[numberOfElements - 1]);
     printf("printVector ends\n");
 }
+
+/**
+ * Sums the contents of a local memory buffer (one element per work item in dimension 0) using a tree reduction.
+ * Works for any work-group size (not only powers of 2). Must be reached by every work item in the work group.
+ * The result is left in scratch[0]
+ * @param[in,out] scratch local memory buffer with one operand per work item
+ */
+void workgroupTreeSum(__local float* scratch) {
+    uint lid = get_local_id(0);
+    WORKGROUP_TREE_REDUCE(scratch, lid, COMBINE_SUM);
+}
+
+/**
+ * Computes the maximum of a local memory buffer (one element per work item in dimension 0) using a tree reduction.
+ * Same requirements as workgroupTreeSum. The result is left in scratch[0]
+ * @param[in,out] scratch local memory buffer with one operand per work item
+ */
+void workgroupTreeMax(__local float* scratch) {
+    uint lid = get_local_id(0);
+    WORKGROUP_TREE_REDUCE(scratch, lid, COMBINE_MAX);
+}
 #endif // __OPENCL_C_VERSION
 
 #ifdef __cplusplus
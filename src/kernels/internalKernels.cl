@@ -48,7 +48,7 @@ void atomic_add_local(volatile local float* source, const float operand) {
 //--------------------------------------------------------------------------------------------------------------------
 //                                            Complex to real
 //--------------------------------------------------------------------------------------------------------------------
-kernel void complex2real_abs(global complexType* input, global realType* output, uint batchSize, uint inBatchDistance, uint outBatchDistance) {
+kernel void complex2real_abs(global complexType* input, global realType* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
     size_t inOffset = get_global_id(0);
     size_t outOffset = inOffset;
 
@@ -59,7 +59,7 @@ kernel void complex2real_abs(global complexType* input, global realType* output,
     }
 }
 
-kernel void complex2real_real(global complexType* input, global realType* output, uint batchSize, uint inBatchDistance, uint outBatchDistance) {
+kernel void complex2real_real(global complexType* input, global realType* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
     size_t inOffset = get_global_id(0);
     size_t outOffset = inOffset;
 
@@ -70,7 +70,7 @@ kernel void complex2real_real(global complexType* input, global realType* output
     }
 }
 
-kernel void complex2real_imag(global complexType* input, global realType* output, uint batchSize, uint inBatchDistance, uint outBatchDistance) {
+kernel void complex2real_imag(global complexType* input, global realType* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
     size_t inOffset = get_global_id(0);
     size_t outOffset = inOffset;
 
@@ -81,7 +81,7 @@ kernel void complex2real_imag(global complexType* input, global realType* output
     }
 }
 
-kernel void complex2real_arg(global complexType* input, global realType* output, uint batchSize, uint inBatchDistance, uint outBatchDistance) {
+kernel void complex2real_arg(global complexType* input, global realType* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
     size_t inOffset = get_global_id(0);
     size_t outOffset = inOffset;
 
@@ -93,10 +93,38 @@ kernel void complex2real_arg(global complexType* input, global realType* output,
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------
+//                                            Complex to/from half precision complex
+//--------------------------------------------------------------------------------------------------------------------
+// Half precision complex elements are pairs of halfs (offsets are in complex elements); they are only stored as halfs,
+// vload_half2/vstore_half2 convert them so that no half arithmetic (cl_khr_fp16) is needed.
+kernel void complex2half(global complexType* input, global half* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
+    size_t inOffset = get_global_id(0);
+    size_t outOffset = inOffset;
+
+    for(uint i = 0; i < batchSize; i++) {
+	vstore_half2_rte(input[inOffset], outOffset, output);
+	inOffset += inBatchDistance;
+	outOffset += outBatchDistance;
+    }
+}
+
+kernel void half2complex(global half* input, global complexType* output, uint batchSize, index1DType inBatchDistance, index1DType outBatchDistance) {
+    size_t inOffset = get_global_id(0);
+    size_t outOffset = inOffset;
+
+    for(uint i = 0; i < batchSize; i++) {
+	output[outOffset] = vload_half2(inOffset, input);
+	inOffset += inBatchDistance;
+	outOffset += outBatchDistance;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------
 //                                            Reductions
 //--------------------------------------------------------------------------------------------------------------------
-kernel void reduce_sum(global realType* input, global realType* partialOutput, local realType* scratch, uint batchSize, uint batchDistance, uint realGlobalSize) {
+kernel void reduce_sum(global realType* input, global realType* partialOutput, local realType* scratch, uint batchSize, index1DType batchDistance, index1DType realGlobalSize) {
     size_t offset = get_global_id(0);
 
     // If globalSize % warp size !=0, some of the last work items will lie outside input buffer
@@ -141,10 +169,110 @@ kernel void reduce_sum(global realType* input, global realType* partialOutput, l
     }
 }
 
+//--------------------------------------------------------------------------------------------------------------------
+//                                            Generic reductions
+//--------------------------------------------------------------------------------------------------------------------
+// Every (operation, element type) pair gets its own kernel, generated by DEFINE_REDUCE_PARTIAL, so the operation is
+// resolved at compile time. Kernels reduce input over any subset of its dimensions, as described by layout:
+// {nReduced, nKept, size and stride of every reduced dimension, size and stride of every kept dimension}.
+// Every output element is computed by groupsPerOutput work groups; if groupsPerOutput > 1, their partial results are
+// combined by the matching DEFINE_REDUCE_FINAL kernel (one work group per output element).
+
+// Offset (in elements) in input of reduced element r, relative to its output element
+index1DType reduceInputOffset(global const index1DType* layout, index1DType r) {
+    index1DType offset = 0;
+    for(index1DType d = 0; d < layout[0]; d++) {
+	offset += (r % layout[2 + 2 * d]) * layout[3 + 2 * d];
+	r /= layout[2 + 2 * d];
+    }
+    return offset;
+}
+
+// Offset (in elements) in input of the first element reduced into output element o
+index1DType reduceOutputOffset(global const index1DType* layout, index1DType o) {
+    global const index1DType* keptLayout = layout + 2 + 2 * layout[0];
+    index1DType offset = 0;
+    for(index1DType d = 0; d < layout[1]; d++) {
+	offset += (o % keptLayout[2 * d]) * keptLayout[2 * d + 1];
+	o /= keptLayout[2 * d];
+    }
+    return offset;
+}
+
+// Element loaders (in2 is the second operand, only used by dot products)
+#define LOAD_VALUE(in1, in2, i)		((realType) (in1)[i])
+#define LOAD_COMPLEX(in1, in2, i)		((in1)[i])
+#define LOAD_ABS_REAL(in1, in2, i)		fabs((realType) (in1)[i])
+#define LOAD_ABS_COMPLEX(in1, in2, i)	hypot((in1)[i].x, (in1)[i].y)
+#define LOAD_SQR_REAL(in1, in2, i)		((realType) (in1)[i] * (realType) (in1)[i])
+#define LOAD_SQR_COMPLEX(in1, in2, i)	dot((in1)[i], (in1)[i])
+#define LOAD_DOT_REAL(in1, in2, i)		((realType) (in1)[i] * (realType) (in2)[i])
+#define LOAD_DOT_COMPLEX(in1, in2, i)	((complexType) ((in1)[i].x * (in2)[i].x + (in1)[i].y * (in2)[i].y, (in1)[i].x * (in2)[i].y - (in1)[i].y * (in2)[i].x))
+
+#define COMPLEX_ZERO			((complexType) (0, 0))
+
+// Work-group reductions use WORKGROUP_TREE_REDUCE and the COMBINE_SUM/COMBINE_MAX/COMBINE_MIN operations (hostKernelFunctions.h)
+
+#define DEFINE_REDUCE_PARTIAL(NAME, INTYPE, ACCTYPE, IDENTITY, LOAD, COMBINE) \
+kernel void reduce_##NAME(global const INTYPE* input, global const INTYPE* input2, global ACCTYPE* partialOutput, local ACCTYPE* scratch, \
+			  global const index1DType* layout, index1DType reduceSize, uint groupsPerOutput) { \
+    uint lid = get_local_id(0); \
+    index1DType out = get_group_id(0) / groupsPerOutput; \
+    uint part = get_group_id(0) % groupsPerOutput; \
+    index1DType base = reduceOutputOffset(layout, out); \
+    ACCTYPE acc = IDENTITY; \
+    for(index1DType r = (index1DType) part * get_local_size(0) + lid; r < reduceSize; r += (index1DType) groupsPerOutput * get_local_size(0)) { \
+	index1DType i = base + reduceInputOffset(layout, r); \
+	acc = COMBINE(acc, LOAD(input, input2, i)); \
+    } \
+    scratch[lid] = acc; \
+    WORKGROUP_TREE_REDUCE(scratch, lid, COMBINE); \
+    if(lid == 0) \
+	partialOutput[get_group_id(0)] = scratch[0]; \
+}
+
+#define DEFINE_REDUCE_FINAL(NAME, ACCTYPE, IDENTITY, COMBINE) \
+kernel void reduce_final_##NAME(global const ACCTYPE* partialOutput, global ACCTYPE* output, local ACCTYPE* scratch, uint groupsPerOutput) { \
+    uint lid = get_local_id(0); \
+    index1DType out = get_group_id(0); \
+    ACCTYPE acc = IDENTITY; \
+    for(uint i = lid; i < groupsPerOutput; i += get_local_size(0)) \
+	acc = COMBINE(acc, partialOutput[out * groupsPerOutput + i]); \
+    scratch[lid] = acc; \
+    WORKGROUP_TREE_REDUCE(scratch, lid, COMBINE); \
+    if(lid == 0) \
+	output[out] = scratch[0]; \
+}
+
+// Index data are accumulated as real values; maximum/minimum/L1 of complex data are computed over magnitudes
+DEFINE_REDUCE_PARTIAL(sum_real,     realType,    realType,    0,            LOAD_VALUE,        COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(sum_complex,  complexType, complexType, COMPLEX_ZERO, LOAD_COMPLEX,      COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(sum_index,    uint,        realType,    0,            LOAD_VALUE,        COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(max_real,     realType,    realType,    -INFINITY,    LOAD_VALUE,        COMBINE_MAX)
+DEFINE_REDUCE_PARTIAL(max_complex,  complexType, realType,    -INFINITY,    LOAD_ABS_COMPLEX,  COMBINE_MAX)
+DEFINE_REDUCE_PARTIAL(max_index,    uint,        realType,    -INFINITY,    LOAD_VALUE,        COMBINE_MAX)
+DEFINE_REDUCE_PARTIAL(min_real,     realType,    realType,    INFINITY,     LOAD_VALUE,        COMBINE_MIN)
+DEFINE_REDUCE_PARTIAL(min_complex,  complexType, realType,    INFINITY,     LOAD_ABS_COMPLEX,  COMBINE_MIN)
+DEFINE_REDUCE_PARTIAL(min_index,    uint,        realType,    INFINITY,     LOAD_VALUE,        COMBINE_MIN)
+DEFINE_REDUCE_PARTIAL(l1_real,      realType,    realType,    0,            LOAD_ABS_REAL,     COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(l1_complex,   complexType, realType,    0,            LOAD_ABS_COMPLEX,  COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(l1_index,     uint,        realType,    0,            LOAD_VALUE,        COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(l2sq_real,    realType,    realType,    0,            LOAD_SQR_REAL,     COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(l2sq_complex, complexType, realType,    0,            LOAD_SQR_COMPLEX,  COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(l2sq_index,   uint,        realType,    0,            LOAD_SQR_REAL,     COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(dot_real,     realType,    realType,    0,            LOAD_DOT_REAL,     COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(dot_complex,  complexType, complexType, COMPLEX_ZERO, LOAD_DOT_COMPLEX,  COMBINE_SUM)
+DEFINE_REDUCE_PARTIAL(dot_index,    uint,        realType,    0,            LOAD_DOT_REAL,     COMBINE_SUM)
+
+DEFINE_REDUCE_FINAL(sum_real,    realType,    0,            COMBINE_SUM)
+DEFINE_REDUCE_FINAL(sum_complex, complexType, COMPLEX_ZERO, COMBINE_SUM)
+DEFINE_REDUCE_FINAL(max_real,    realType,    -INFINITY,    COMBINE_MAX)
+DEFINE_REDUCE_FINAL(min_real,    realType,    INFINITY,     COMBINE_MIN)
+
 //--------------------------------------------------------------------------------------------------------------------
 //                                            Normalization
 //--------------------------------------------------------------------------------------------------------------------
-kernel void normalize_show(global realType* dataSum, global realType* input, global realType* output, uint batchSize, uint batchDistance) {
+kernel void normalize_show(global realType* dataSum, global realType* input, global realType* output, uint batchSize, index1DType batchDistance) {
     size_t offset = get_global_id(0);
 
     realType factor = 0.5 * get_global_size(0) * batchSize / *dataSum;
@@ -155,7 +283,7 @@ kernel void normalize_show(global realType* dataSum, global realType* input, glo
     }
 }
 
-kernel void scalarMultiply(realType factor, global realType* input, global realType* output, uint batchSize, uint batchDistance) {
+kernel void scalarMultiply(realType factor, global realType* input, global realType* output, uint batchSize, index1DType batchDistance) {
     size_t offset = get_global_id(0);
 
     for(uint i = 0; i < batchSize; i++) {
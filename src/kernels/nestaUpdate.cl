@@ -0,0 +1,136 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+/*! \file nestaUpdate.cl
+ *	\brief Fused vector updates of the NESTA inner loop (each one reads and writes every vector once)
+ */
+
+#include <OpenCLIPER/kernels/hostKernelFunctions.h>
+
+/**
+ * Residual update: res = in * scale - b, out = res * rescale. Also computes the sum of |res|^2 of the elements
+ * processed by each work group (grid-stride loop), to be added up by nestaSumPartials.
+ * @param[in] in encoded image A(xk)
+ * @param[in] b measured k-space data
+ * @param[out] out residual scaled for the adjoint encoding operator
+ * @param[out] partialSums one partial sum per work group
+ * @param[in] scratch local memory buffer (one float per work item)
+ * @param[in] scale scale applied to in
+ * @param[in] rescale scale applied to the residual before storing it in out
+ * @param[in] n number of elements
+ */
+__kernel void nestaResidual(__global float2* in, __global float2* b, __global float2* out, __global float* partialSums,
+			    __local float* scratch, __const float scale, __const float rescale, __const index1DType n) {
+
+	uint lid = get_local_id(0);
+	float sum = 0.0f;
+
+	for(index1DType i = get_global_id(0); i < n; i += get_global_size(0)) {
+		float2 res = in[i] * scale - b[i];
+		out[i] = res * rescale;
+		sum += dot(res, res);
+	}
+
+	scratch[lid] = sum;
+	workgroupTreeSum(scratch);
+	if(lid == 0)
+		partialSums[get_group_id(0)] = scratch[0];
+}
+
+/**
+ * Adds up the partial sums left by nestaResidual. Must be launched as a single work group.
+ * @param[out] sum result (one element)
+ * @param[in] partialSums partial sums
+ * @param[in] scratch local memory buffer (one float per work item)
+ * @param[in] n number of partial sums
+ */
+__kernel void nestaSumPartials(__global float* sum, __global float* partialSums, __local float* scratch, __const uint n) {
+
+	uint lid = get_local_id(0);
+	float acc = 0.0f;
+
+	for(uint i = lid; i < n; i += get_local_size(0))
+		acc += partialSums[i];
+
+	scratch[lid] = acc;
+	workgroupTreeSum(scratch);
+	if(lid == 0)
+		*sum = scratch[0];
+}
+
+/**
+ * yk update: df = df * dfScale + aRes, yk = xk - Lmu1 * df
+ * @param[in,out] df gradient of the smoothed objective
+ * @param[out] yk
+ * @param[in] aRes adjoint encoding operator applied to the residual
+ * @param[in] xk current estimate
+ * @param[in] dfScale scale applied to df before adding aRes
+ * @param[in] Lmu1 step size (inverse of the Lipschitz constant)
+ * @param[in] n number of elements
+ */
+__kernel void nestaYkUpdate(__global float2* df, __global float2* yk, __global float2* aRes, __global float2* xk,
+			    __const float dfScale, __const float Lmu1, __const index1DType n) {
+
+	index1DType i = get_global_id(0);
+	if(i >= n)
+		return;
+
+	float2 dfi = df[i] * dfScale + aRes[i];
+	df[i] = dfi;
+	yk[i] = xk[i] - Lmu1 * dfi;
+}
+
+/**
+ * zk and xk update: wk += apk * df, zk = xref - Lmu1 * wk, xk = tauk * zk + (1 - tauk) * yk
+ * @param[in] df gradient of the smoothed objective
+ * @param[out] xk next estimate
+ * @param[in,out] wk weighted sum of gradients
+ * @param[in] xref reference (prox-center) image
+ * @param[in] yk
+ * @param[in] apk gradient weight of this iteration
+ * @param[in] Lmu1 step size (inverse of the Lipschitz constant)
+ * @param[in] tauk combination factor of this iteration
+ * @param[in] n number of elements
+ */
+__kernel void nestaZkUpdate(__global float2* df, __global float2* xk, __global float2* wk, __global float2* xref, __global float2* yk,
+			    __const float apk, __const float Lmu1, __const float tauk, __const index1DType n) {
+
+	index1DType i = get_global_id(0);
+	if(i >= n)
+		return;
+
+	float2 wki = wk[i] + apk * df[i];
+	wk[i] = wki;
+	float2 zk = xref[i] - Lmu1 * wki;
+	xk[i] = tauk * zk + (1.0f - tauk) * yk[i];
+}
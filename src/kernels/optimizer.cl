@@ -933,6 +933,115 @@ __kernel void adjointInterpolator(__global float2* output,
     atomicAdd_g_f(&ptr[2 * (posthor + postver * tam1 + k * tam0 * tam1) + 1], aux4); // Pixel rigth-down
 }
 
+/**
+ * Computes the search radius needed by adjointInterpolatorGather: the largest displacement (in pixels, either direction)
+ * of the new mesh with respect to the original one inside the bounding box, over all frames, rounded up, plus one.
+ * The original mesh is the identity mesh, so the original position of a bounding box pixel is its own position.
+ * Must be launched as a single work group.
+ * @param[out] radius search radius (one element)
+ * @param[in] input images (only used to get dimensions)
+ * @param[in] xn new control point mesh
+ * @param[in] scratch local memory buffer (one float per work item)
+ * @param[in] firstRow first row of the bounding box (with margin)
+ * @param[in] lastRow last row of the bounding box (with margin)
+ * @param[in] firstCol first column of the bounding box (with margin)
+ * @param[in] lastCol last column of the bounding box (with margin)
+ */
+__kernel void adjointInterpolatorRadius(__global int* radius,
+					__global float2* input,
+					__global float* xn,
+					__local float* scratch,
+					__const int firstRow,
+					__const int lastRow,
+					__const int firstCol,
+					__const int lastCol) {
+
+    uint tam0 = getSpatialDimSize(input, ROWS, 0);
+    uint tam1 = getSpatialDimSize(input, COLUMNS, 0);
+    uint tam2 = getTemporalDimSize(input, 0);
+
+    uint lid = get_local_id(0);
+    uint nRows = lastRow - firstRow + 1;
+    uint nCols = lastCol - firstCol + 1;
+    uint n = nRows * nCols * tam2;
+
+    float maxDisp = 0.0f;
+    for(uint q = lid; q < n; q += get_local_size(0)) {
+	int hor = firstCol + q % nCols;
+	int ver = firstRow + (q / nCols) % nRows;
+	uint k = q / (nCols * nRows);
+
+	float nhor = xn[hor + ver * tam1 + k * tam0 * tam1 + 0 * tam0 * tam1 * tam2] - 1;
+	float nver = xn[hor + ver * tam1 + k * tam0 * tam1 + 1 * tam0 * tam1 * tam2] - 1;
+	maxDisp = fmax(maxDisp, fmax(fabs(nhor - hor), fabs(nver - ver)));
+    }
+    scratch[lid] = maxDisp;
+    workgroupTreeMax(scratch);
+
+    if(lid == 0)
+	*radius = (int)ceil(scratch[0]) + 1;
+}
+
+/**
+ * Atomic-free implementation of the adjoint for the deformation (adjoint of motion compensation).
+ * Instead of scattering every input pixel to its four neighbours, every output pixel gathers the contributions of the
+ * bounding box pixels whose new position lies at most radius pixels away, so every output element is written by exactly one work item.
+ * Adds to the output the same values as adjointInterpolator (up to floating point summation order).
+ * @param[in,out] output transformed images
+ * @param[in] input images
+ * @param[in] xn new control point mesh
+ * @param[in] radius search radius, as computed by adjointInterpolatorRadius
+ * @param[in] firstRow first row of the bounding box (with margin)
+ * @param[in] lastRow last row of the bounding box (with margin)
+ * @param[in] firstCol first column of the bounding box (with margin)
+ * @param[in] lastCol last column of the bounding box (with margin)
+ */
+__kernel void adjointInterpolatorGather(__global float2* output,
+					__global float2* input,
+					__global float* xn,
+					__global int* radius,
+					__const int firstRow,
+					__const int lastRow,
+					__const int firstCol,
+					__const int lastCol) {
+
+    uint tam0 = getSpatialDimSize(input, ROWS, 0);
+    uint tam1 = getSpatialDimSize(input, COLUMNS, 0);
+    uint tam2 = getTemporalDimSize(input, 0);
+
+    int a = get_global_id(0); // output horizontal position
+    int b = get_global_id(1); // output vertical position
+    uint k = get_global_id(2); // frame
+
+    int r = *radius;
+    int minHor = max(a - r, firstCol);
+    int maxHor = min(a + r, lastCol);
+    int minVer = max(b - r, firstRow);
+    int maxVer = min(b + r, lastRow);
+    if(minHor > maxHor || minVer > maxVer)
+	return;
+
+    float2 sum = (float2)(0.0f, 0.0f);
+    for(int ver = minVer; ver <= maxVer; ver++) {
+	for(int hor = minHor; hor <= maxHor; hor++) {
+	    float nhor = xn[hor + ver * tam1 + k * tam0 * tam1 + 0 * tam0 * tam1 * tam2] - 1; // New mesh - horizontal dimension
+	    float nver = xn[hor + ver * tam1 + k * tam0 * tam1 + 1 * tam0 * tam1 * tam2] - 1; // New mesh - vertical dimension
+
+	    int prehor = floor(nhor);
+	    int prever = floor(nver);
+	    float Whh = nhor - prehor;
+	    float Wvv = nver - prever;
+
+	    // Weight of this output pixel in the bilinear footprint of the source pixel (0 if it is not one of its four neighbours)
+	    float wh = (prehor == a) ? (1 - Whh) : ((prehor + 1 == a) ? Whh : 0.0f);
+	    float wv = (prever == b) ? (1 - Wvv) : ((prever + 1 == b) ? Wvv : 0.0f);
+
+	    sum += (wh * wv) * input[hor + ver * tam1 + k * tam0 * tam1];
+	}
+    }
+    output[a + b * tam1 + k * tam0 * tam1] += sum;
+}
+
 
 
 __kernel void auxiliarMask(__global float* Xaux,
@@ -957,7 +1066,7 @@ __kernel void auxiliarMask(__global float* Xaux,
 
 
     int idxX = (i + (int)coefg[k + 0 * dimcoefg0 + 1 * dimcoefg0 * dimcoefg1] - 1) + (j + (int)coefg[l + 0 * dimcoefg0 + 0 * dimcoefg0 * dimcoefg1] - 1) * dimX0;
-    int idxAux = j + i * dim0 + m * dim0 * dim1 + n * dim0 * dim1 * dim2;
+    int idxAux = j + i * dim1 + m * dim0 * dim1 + n * dim0 * dim1 * dim2;
     Xaux[idxAux] = (float)X[idxX];
 }
 
@@ -1024,3 +1133,68 @@ __kernel void cost6D(__global float* dH,
     }
     dH[idx] = suma;
 }
+
+
+/**
+ * Projected gradient cost for every control point: fused equivalent of auxiliarMask + auxiliarCost + cost6DReduction + cost6D,
+ * for all (l,k) control points at once. Each work group computes one element of dH by multiplying the permuted gradient by the
+ * mask around control point (l,k) and reducing the products in local memory.
+ * Global size must be (localSize * dimL * dimK, frames, nt), with local size (localSize, 1, 1).
+ * @param[out] dH total cost for each control point, frame and dimension
+ * @param[in] dVpermute permuted gradient (dp1, dp0, Cp1, Cp0, frames, nt)
+ * @param[in] X mask determining the ROI
+ * @param[in] coefg coefficients for the gradient
+ * @param[in] scratch local memory buffer (one element per work item)
+ * @param[in] dim0 dV first dimension size (dp1)
+ * @param[in] dim1 dV second dimension size (dp0)
+ * @param[in] dim3 dV fourth dimension size (Cp1, range of k)
+ * @param[in] dim4 dV fifth dimension size (Cp0, range of l)
+ * @param[in] dimcoefg0 coefg first dimension size
+ * @param[in] dimcoefg1 coefg second dimension size
+ */
+__kernel void projectedGradientCost(__global float* dH,
+				    __global float* dVpermute,
+				    __global uint* X,
+				    __global realType* coefg,
+				    __local float* scratch,
+				    __const uint dim0,
+				    __const uint dim1,
+				    __const uint dim3,
+				    __const uint dim4,
+				    __const uint dimcoefg0,
+				    __const uint dimcoefg1) {
+
+    uint lid = get_local_id(0);
+    uint controlPoint = get_group_id(0);
+    int l = controlPoint % dim4;
+    int k = controlPoint / dim4;
+    int m = get_global_id(1);
+    int n = get_global_id(2);
+    uint dim2 = get_global_size(1);
+
+    uint dimX0 = getSpatialDimSize(X, 0, 0);
+    uint dimdH1 = getSpatialDimSize(dH, 1, 0);
+    uint dimdH0 = getSpatialDimSize(dH, 0, 0);
+
+    // Mask offsets for this control point (same for every pixel in its neighbourhood)
+    int offsetRow = (int)coefg[k + 0 * dimcoefg0 + 1 * dimcoefg0 * dimcoefg1] - 1;
+    int offsetCol = (int)coefg[l + 0 * dimcoefg0 + 0 * dimcoefg0 * dimcoefg1] - 1;
+
+    uint neighbourhoodSize = dim0 * dim1;
+    uint dVOffset = l * neighbourhoodSize + k * neighbourhoodSize * dim3 + m * neighbourhoodSize * dim3 * dim4 + n * neighbourhoodSize * dim3 * dim4 * dim2;
+
+    // Every work item accumulates a strided subset of the neighbourhood. Position q of the neighbourhood holds the mask value
+    // auxiliarMask would have written there (row i < dim0 and column j < dim1, stored at j + i * dim1)
+    float partialSum = 0.0f;
+    for(uint q = lid; q < neighbourhoodSize; q += get_local_size(0)) {
+	int i = q / dim1;
+	int j = q % dim1;
+	int idxX = (i + offsetRow) + (j + offsetCol) * dimX0;
+	partialSum += dVpermute[dVOffset + q] * (float)X[idxX];
+    }
+    scratch[lid] = partialSum;
+    workgroupTreeSum(scratch);
+
+    if(lid == 0)
+	dH[l + k * dimdH1 + m * dimdH0 * dimdH1 + n * dimdH0 * dimdH1 * dim2] = scratch[0];
+}
@@ -126,7 +126,7 @@ __kernel void cost6DReduction(__global float* cost2,
     int idxcost1;
     float suma = 0.0f;
     for(int j = 0; j < dim1; j++) {
-	idxcost1 = i + j * dim1 + m * dim0 * dim1 + n * dim0 * dim1 * dim2;
+	idxcost1 = j + i * dim1 + m * dim0 * dim1 + n * dim0 * dim1 * dim2;
 	suma += cost1[idxcost1];
     }
     cost2[idx] = suma;
@@ -134,23 +134,96 @@ __kernel void cost6DReduction(__global float* cost2,
 
 
 /**
-* Determines the total cost of a given metric array.
-* Sum the metric values only in the Region Of Interest (ROI)
-* @param[out] cost total cost
+* Determines the total cost of a given metric array (first pass of a multi-pass reduction, successive ones are done by SumReduce).
+* Sum the metric values only in the Region Of Interest (ROI): every work item multiplies one metric value by its mask value
+* and every work group reduces its products in local memory, leaving one partial sum per work group
+* @param[out] partialCost partial sums (one per work group), or total cost if only one work group is launched
 * @param[in] V metric array
 * @param[in] X ROI mask, determines the subset to take into account
-* @param[in] iter current iteration in optimization loop
+* @param[in] scratch local memory buffer (one element per work item)
+* @param[in] realGlobalSize number of elements in V (global size may be greater, as it is rounded up to a multiple of local size)
+* @param[in] outputOffset offset of first output element in partialCost (current iteration if writing the total cost)
 */
-__kernel void costReduction(__global float* cost,
+__kernel void costReduction(__global float* partialCost,
 			    __global float* V,
 			    __global int* X,
-			    __const int iter) {
+			    __local float* scratch,
+			    __const index1DType realGlobalSize,
+			    __const index1DType outputOffset) {
 
-    uint dims = get_global_size(0);
+    size_t i = get_global_id(0);
+    uint lid = get_local_id(0);
 
-    cost[iter] = 0.0f;
-    // Sum of the metric values only in the ROI
-    for(int i = 0; i < dims; i++) {
-	cost[iter] += V[i] * X[i];
+    // Work items beyond the end of the input must still take part in the barriers
+    scratch[lid] = (i < realGlobalSize) ? V[i] * X[i] : 0.0f;
+    workgroupTreeSum(scratch);
+
+    if(lid == 0)
+	partialCost[outputOffset + get_group_id(0)] = scratch[0];
+}
+
+
+/**
+* Device-side version of GroupwiseRegistration::evolution() and GroupwiseRegistration::stopCondition().
+* Computes the norm of the transformation difference and the metric variation for the current iteration, adapts the weight
+* (if requested) and evaluates the stop condition, so the host does not need to read anything back every iteration.
+* Must be launched as a single work group. Once the stop flag is set, Wn is set to 0 so successive iterations (launched by the
+* host before it polls the stop flag) leave the transformation untouched, and this kernel does nothing.
+* @param[in] H values of the metric for each iteration
+* @param[in] Dif transformation matrix (displacement)
+* @param[in,out] Wn weight
+* @param[out] TdifHdif norm difference of the transformation matrix (first nmax elements) and metric variation (next nmax elements)
+* @param[in,out] stop stop flag (iteration at which the output condition has been satisfied, 0 if it has not been satisfied yet)
+* @param[in] scratch local memory buffer (one element per work item)
+* @param[in] difSize number of elements in Dif
+* @param[in] iter current iteration in optimizer
+* @param[in] p2 threshold to compare Tdif
+* @param[in] eh threshold to compare Hdif, relative to initial metric
+* @param[in] nmax max number of iterations in optimizer
+* @param[in] flagW flag for adaptive W algorithm
+*/
+__kernel void evolutionStop(__global float* H,
+			    __global float* Dif,
+			    __global float* Wn,
+			    __global float* TdifHdif,
+			    __global int* stop,
+			    __local float* scratch,
+			    __const uint difSize,
+			    __const int iter,
+			    __const float p2,
+			    __const float eh,
+			    __const int nmax,
+			    __const int flagW) {
+
+    // All work items see the same value, so this does not break barriers below
+    if(*stop)
+	return;
+
+    uint lid = get_local_id(0);
+
+    // Squared norm of the displacement: every work item accumulates a strided subset, then the work group is reduced
+    float sumSquares = 0.0f;
+    for(uint i = lid; i < difSize; i += get_local_size(0))
+	sumSquares += Dif[i] * Dif[i];
+    scratch[lid] = sumSquares;
+    workgroupTreeSum(scratch);
+
+    if(lid == 0) {
+	float Tdif = sqrt(scratch[0]);		// Norm
+	float Hdif = H[iter - 1] - H[iter];	// Metric
+	TdifHdif[iter - 1] = Tdif;
+	TdifHdif[nmax + iter - 1] = Hdif;
+
+	if(flagW) {				// Adaptation of Wn, flagW
+	    if(Hdif > 0)
+		*Wn = *Wn * 1.2f;
+	    else
+		*Wn = *Wn / 2;
+	}
+
+	if((iter == nmax) || ((Tdif < p2) && (Hdif < H[0] * eh))) {
+	    *stop = iter;
+	    *Wn = 0.0f;
+	}
     }
 }
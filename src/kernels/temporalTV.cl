@@ -58,12 +58,12 @@ __kernel void operator_tTV(__global float2* in, __global float2* out, __const ui
 	if(slices == 0)
 		slices = 1;
 
-	uint idx1 = (k * cols * rows) + (j * cols) + i;
-	uint idx2 = idx1;
-	uint idxlength = 0;
+	index1DType idx1 = ((index1DType) k * cols * rows) + ((index1DType) j * cols) + i;
+	index1DType idx2 = idx1;
+	index1DType idxlength = 0;
 
 	//First frame different
-	out[idx1]=in[idx1]-in[idx1+(numFrames-1)*cols*rows*slices];
+	out[idx1]=in[idx1]-in[idx1+(index1DType)(numFrames-1)*cols*rows*slices];
 
 	for(uint f=1; f<numFrames; f++){
 		idxlength=getTemporalDimStride(in, 0, f);
@@ -87,9 +87,9 @@ __kernel void operator_tTVadj(__global float2* in, __global float2* out, __const
 	if(slices == 0)
 		slices = 1;
 
-	uint idx1 = (k * cols * rows) + (j * cols) + i;
-	uint idx2 = idx1;
-	uint idxlength = 0;
+	index1DType idx1 = ((index1DType) k * cols * rows) + ((index1DType) j * cols) + i;
+	index1DType idx2 = idx1;
+	index1DType idxlength = 0;
 
 	for(uint f=0; f<numFrames-1; f++){
 		idxlength = getTemporalDimStride(in, 0, f);
@@ -101,8 +101,8 @@ __kernel void operator_tTVadj(__global float2* in, __global float2* out, __const
 	}
 
 	//Last frame different
-	uint idxFirst = (k * cols * rows) + (j * cols) + i;
-	uint idxLast = idxFirst+(numFrames-1)*cols*rows*slices;
+	index1DType idxFirst = ((index1DType) k * cols * rows) + ((index1DType) j * cols) + i;
+	index1DType idxLast = idxFirst+(index1DType)(numFrames-1)*cols*rows*slices;
 	out[idxLast] = in[idxFirst]-in[idxLast];
 }
 
@@ -40,10 +40,10 @@
 #include <OpenCLIPER/kernels/hostKernelFunctions.h>
 
 kernel void xImageSum_kernel(global complexType* pInBuffer, global complexType* pOutBuffer) {
-	uint inOffset = get_global_id(0);
-	uint outOffset = get_global_id(0);
-	uint inCoilStride = getCoilStride(pInBuffer,0);	
-	uint outFrameStride = getTemporalDimStride(pOutBuffer,0,0);
+	index1DType inOffset = get_global_id(0);
+	index1DType outOffset = get_global_id(0);
+	index1DType inCoilStride = getCoilStride(pInBuffer,0);	
+	index1DType outFrameStride = getTemporalDimStride(pOutBuffer,0,0);
 	uint nInFrames = getTemporalDimSize(pInBuffer, 0);
 	uint nCoils = getNumCoils(pInBuffer);
 
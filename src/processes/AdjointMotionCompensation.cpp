@@ -51,12 +51,16 @@ AdjointMotionCompensation::AdjointMotionCompensation(const std::shared_ptr<CLapp
 }
 
 void AdjointMotionCompensation::init(){
+    auto pIP = std::dynamic_pointer_cast<InitParameters>(pInitParameters);
+    if(!pIP) pIP = std::unique_ptr<InitParameters>(new InitParameters());
+
     pCopy->init();
     pInitZeroRect->init();
+    pAdjointProcess->setInitParameters(std::make_shared<AdjointInterpolator::InitParameters>(pIP->gather));
     pAdjointProcess->init();
 }
 
-void AdjointMotionCompensation::launch() {
+void AdjointMotionCompensation::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     infoItems.addInfoItem("Title", "AdjointMotionCompensation info");
@@ -86,4 +90,15 @@ void AdjointMotionCompensation::launch() {
 	BTTHROW(CLError(err), "AdjointMotionCompensation::launch");
     }
 }
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void AdjointMotionCompensation::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pCopy, pInitZeroRect, pAdjointProcess})
+	p->setCommandQueue(cq);
+}
+
 }
@@ -18,7 +18,7 @@ namespace OpenCLIPER {
 void ApplyMask::init() {
 }
 
-void ApplyMask::launch() {
+void ApplyMask::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     checkCommonLaunchParameters();
@@ -38,6 +38,8 @@ void ApplyMask::launch() {
 		    kernel = getApp()->getKernel("applyMask_complex");
 		} else if (this->getInput()->getElementDataType() == TYPEID_REAL) {
 			kernel = getApp()->getKernel("applyMask_real");
+		} else if (this->getInput()->getElementDataType() == TYPEID_COMPLEXHALF) {
+			kernel = getApp()->getKernel("applyMask_complexHalf");
 		} else {
 			BTTHROW(std::invalid_argument("Element data type not supported"), "ApplyMask::launch()")
 		}
@@ -91,7 +91,7 @@ void Complex2Real::init() {
 
 }
 
-void Complex2Real::launch() {
+void Complex2Real::doLaunch() {
     cl::Buffer* inputData = getInput()->getDeviceBuffer();
     cl::Buffer* outputData = getOutput()->getDeviceBuffer();
 
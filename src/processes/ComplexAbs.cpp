@@ -46,10 +46,10 @@ namespace OpenCLIPER {
 
 
 void ComplexAbs::init() {
-	kernel = getApp()->getKernel("complexAbs");
+	kernel = getShapeKernel("complexAbs");
 }
 
-void ComplexAbs::launch() {
+void ComplexAbs::doLaunch() {
 	startProfiling();
 	try {
 		std::vector<cl::Event> kernelsExecEventList;
@@ -46,10 +46,10 @@ namespace OpenCLIPER {
 
 
 void ComplexAbsPow2::init() {
-	kernel = getApp()->getKernel("ComplexAbsPow2");
+	kernel = getShapeKernel("ComplexAbsPow2");
 }
 
-void ComplexAbsPow2::launch() {
+void ComplexAbsPow2::doLaunch() {
 	auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
 	startProfiling();
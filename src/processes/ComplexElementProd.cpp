@@ -58,10 +58,10 @@
 namespace OpenCLIPER {
 
 void ComplexElementProd::init() {
-	kernel = getApp()->getKernel("complexElementProd_kernel");
+	kernel = getShapeKernel("complexElementProd_kernel", true);
 }
 
-void ComplexElementProd::launch() {
+void ComplexElementProd::doLaunch() {
 	auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
 	checkCommonLaunchParameters();
@@ -116,10 +116,21 @@ void ComplexElementProd::launch() {
 		// Mask to invert the sign of a float if we need to conjugate sensitivity maps
 		cl_uint conjugateMask = pLP->conjugateSensMap ? 0x80000000 : 0;
 
+		// Buffers stored in half precision (bits as defined in complexElementProd.cl), computation is always in single precision
+		cl_uint halfStorage = 0;
+		const std::shared_ptr<Data> pBuffersData[] = {getInput(), pLP->sensitivityMapsData, getOutput()};
+		for(unsigned i = 0; i < 3; i++) {
+			if(pBuffersData[i]->getElementDataType() == TYPEID_COMPLEXHALF)
+				halfStorage |= 1 << i;
+			else if(pBuffersData[i]->getElementDataType() != TYPEID_COMPLEX)
+				BTTHROW(std::invalid_argument("ComplexElementProd::launch: data must be complex (single or half precision)"), "ComplexElementProd::launch");
+		}
+
 		kernel.setArg(0, *pInputBuffer);
 		kernel.setArg(1, *pSensitivityMapsBuffer);
 		kernel.setArg(2, *pOutputBuffer);
 		kernel.setArg(3, conjugateMask);
+		kernel.setArg(4, halfStorage);
 
 		cl::NDRange globalSizes = {NDARRAYWIDTH(getInput()->getData()->at(0))* NDARRAYHEIGHT(getInput()->getData()->at(0))* NDARRAYDEPTH(getInput()->getData()->at(0))};
 
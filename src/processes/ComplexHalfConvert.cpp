@@ -0,0 +1,89 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/processes/ComplexHalfConvert.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+#include <OpenCLIPER/hostKernelFunctions.hpp>
+
+namespace OpenCLIPER {
+
+void ComplexHalfConvert::init() {
+    if(!getInput())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "OpenCLIPER::ComplexHalfConvert::init(): init() called before setInputData()"), "ComplexHalfConvert::init");
+
+    if(!getOutput())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "OpenCLIPER::ComplexHalfConvert::init(): init() called before setOutputData()"), "ComplexHalfConvert::init");
+
+    if(getInput()->getData()->size() != getOutput()->getData()->size())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "OpenCLIPER::ComplexHalfConvert::init(): inputData and outputData must have the same number of images"), "ComplexHalfConvert::init");
+
+    if(!getInput()->getAllSizesEqual())
+	BTTHROW(std::invalid_argument("OpenCLIPER::ComplexHalfConvert::init(): ComplexHalfConvert for variable-size data objects is not implemented at this time"), "ComplexHalfConvert::init");
+
+    if(getInput()->getElementDataType() == TYPEID_COMPLEX && getOutput()->getElementDataType() == TYPEID_COMPLEXHALF)
+	kernel = getApp()->getKernel("complex2half");
+    else if(getInput()->getElementDataType() == TYPEID_COMPLEXHALF && getOutput()->getElementDataType() == TYPEID_COMPLEX)
+	kernel = getApp()->getKernel("half2complex");
+    else
+	BTTHROW(std::invalid_argument("OpenCLIPER::ComplexHalfConvert::init(): conversion is only supported from complex to half precision complex data or vice versa"), "ComplexHalfConvert::init");
+
+    dimIndexType nSpatialDims = getInput()->getNumSpatialDims();
+    dimIndexType nTotalDims = nSpatialDims + (getInput()->getNumCoils() >= 2 ? 1 : 0) + getInput()->getNumTemporalDims();
+
+    batchSize = 1;
+    for(unsigned i = nSpatialDims; i < nTotalDims; i++)
+	batchSize *= getInput()->getDimSize(i, 0);
+
+    // getDimStride will return batchDistance=0 if there are spatial dimensions only
+    // Caution: strides between NDArrays for input and output may be different if NDArrays are smaller than device's alignment size
+    inBatchDistance = getInput()->getDimStride(nSpatialDims,0);
+    outBatchDistance = getOutput()->getDimStride(nSpatialDims,0);
+}
+
+void ComplexHalfConvert::doLaunch() {
+    cl::Buffer* inputData = getInput()->getDeviceBuffer();
+    cl::Buffer* outputData = getOutput()->getDeviceBuffer();
+
+    cl::NDRange globalSizes = cl::NDRange(getInput()->getNDArrayTotalSize(0));
+    cl::NDRange localSizes = cl::NDRange();
+
+    kernel.setArg(0, *inputData);
+    kernel.setArg(1, *outputData);
+    kernel.setArg(2, batchSize);
+    kernel.setArg(3, inBatchDistance);
+    kernel.setArg(4, outBatchDistance);
+
+    cl_int err;
+    if((err = queue.enqueueNDRangeKernel(kernel, cl::NullRange, globalSizes, localSizes, NULL, NULL)) != CL_SUCCESS)
+	BTTHROW(CLError(err, getApp()->getOpenCLErrorCodeStr(err)), "ComplexHalfConvert::launch");
+}
+} /* namespace OpenCLIPER */
@@ -47,11 +47,11 @@ namespace OpenCLIPER {
 
 void ComplexPow::init() {
 
-    kernel = getApp()->getKernel("complexPow");
+    kernel = getShapeKernel("complexPow");
 
 }
 
-void ComplexPow::launch() {
+void ComplexPow::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
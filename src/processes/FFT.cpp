@@ -38,11 +38,15 @@
 
 #include <OpenCLIPER/processes/FFT.hpp>
 #include <OpenCLIPER/CLapp.hpp>
+#include <OpenCLIPER/FFTPlanCache.hpp>
 #include <OpenCLIPER/hostKernelFunctions.hpp>
 #include <LPISupport/InfoItems.hpp>
 #include <OpenCLIPER/KData.hpp>
 #include <OpenCLIPER/XData.hpp>
+#include <OpenCLIPER/ConcreteNDArray.hpp>
 #include <OpenCLIPER/processes/ScalarMultiply.hpp>
+#include <algorithm>
+#include <cmath>
 
 // Uncomment to show class-specific debug messages
 //#define FFT_DEBUG
@@ -195,9 +199,65 @@ void FFT::init() {
 	}
     }
 
-    // If samplingMask is set and a transform across the first dimension is requested, do batches of 1D transforms over the first non-spatial dimension for each row included in samplingMask
+    // If samplingMask is set, gather the rows it selects into a packed buffer, transform them all with a single batched 1D FFT and scatter them back.
+    // This replaces one small transform per run of contiguous sampled rows, which is slower than the full transform for random undersampling patterns
     else {
-	BTTHROW(CLError(CLFFT_INVALID_ARG_VALUE, "AARGH! No sampling masks yet!"), "FFT::init");
+	if(pIP->dim != 0)
+	    BTTHROW(CLError(CLFFT_NOTIMPLEMENTED, "Sampling masks are only supported for transforms along the first dimension (dim=0)"), "FFT::init");
+
+	if(pIP->samplingMask->getMasksFormat() != SamplingMasksData::PIXELMASK)
+	    BTTHROW(CLError(CLFFT_NOTIMPLEMENTED, "Only sampling masks in PIXELMASK format are supported"), "FFT::init");
+
+	packedRowsMode = true;
+	FFTnDims = 1;
+
+	// Geometry of the rows in input/output
+	rowLength = getInput()->getSpatialDimSize(0, 0);
+	elementStride = getInput()->getSpatialDimStride(0, 0);
+	rowDistance = getInput()->getDimStride(1, 0);
+	nRows = 1;
+	for(unsigned i = 1; i < nTotalDims; i++)
+	    nRows *= getInput()->getDimSize(i, 0);
+
+	// A row is selected if any of its mask pixels is set. NDArrays are stored coil-first, and there is one mask per temporal frame
+	dimIndexType rowsPerNDArray = nRows / getInput()->getNumNDArrays();
+	dimIndexType numCoils = std::max(getInput()->getNumCoils(), 1u);
+	dimIndexType numMasks = pIP->samplingMask->getNumNDArrays();
+	std::vector<cl_uint> packedRows;
+	std::vector<cl_uint> rowMap(nRows, UNSAMPLED_ROW);
+	for(cl_uint row = 0; row < nRows; row++) {
+	    dimIndexType frame = std::min((row / rowsPerNDArray) / numCoils, numMasks - 1);
+	    auto pMask = static_cast<const ConcreteNDArray<cl_uchar>*>(pIP->samplingMask->getNDArray(frame));
+	    dimIndexType maskWidth = pMask->getDims()->at(WIDTHPOS);
+	    dimIndexType maskHeight = pMask->size() / maskWidth;
+	    auto maskRow = pMask->getHostDataPointer() + ((row % rowsPerNDArray) % maskHeight) * maskWidth;
+
+	    if(std::any_of(maskRow, maskRow + maskWidth, [](cl_uchar m) { return m != 0; })) {
+		rowMap[row] = packedRows.size();
+		packedRows.push_back(row);
+	    }
+	}
+	nPackedRows = packedRows.size();
+	FFT_CERR("FFT: " << nPackedRows << " of " << nRows << " rows selected by sampling mask\n");
+
+	// Packed rows are contiguous (clFFT needs at least one transform per batch, even if no row is selected)
+	strides[0] = 1;
+	fftDataSize[0] = rowLength;
+	batchSize = std::max(nPackedRows, 1u);
+	batchDistance = rowLength;
+
+	nBatches = 1;
+	batchOffsets.clear();
+	batchOffsets.push_back(0);
+
+	if(packedRows.empty())
+	    packedRows.push_back(0);
+	packedData = std::make_shared<XData>(getApp(), rowLength * batchSize, TYPEID_COMPLEX);
+	packedRowsBuffer = cl::Buffer(getApp()->getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, packedRows.size() * sizeof(cl_uint), packedRows.data());
+	rowMapBuffer = cl::Buffer(getApp()->getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, rowMap.size() * sizeof(cl_uint), rowMap.data());
+
+	gatherKernel = getApp()->getKernel("fftGatherRows");
+	scatterKernel = getApp()->getKernel("fftScatterRows");
     }
 
     // -----------------------------------------------------------------------------------------------------------------------------------------
@@ -206,6 +266,12 @@ void FFT::init() {
 
 #ifdef HAVE_ROCFFT
     if(getApp()->getHIPDevice() != -1) {
+	if(packedRowsMode)
+	    BTTHROW(CLError(CLFFT_NOTIMPLEMENTED, "Sampling masks are not supported with rocFFT yet"), "FFT::init");
+
+	if(pIP->centered || (pIP->normalization != NORMALIZE_BACKWARD))
+	    BTTHROW(CLError(CLFFT_NOTIMPLEMENTED, "Centered transforms and non-default normalizations are not supported with rocFFT yet"), "FFT::init");
+
 	rocfft_result_placement rocfftPlace;
 	if(getInput() == getOutput())
 	    rocfftPlace = rocfft_placement_inplace;
@@ -333,8 +399,9 @@ void FFT::init() {
     // -----------------------------------------------------------------------------------------------------------------------------------------
     else {
 #endif // HAVE_ROCFFT
+	// Packed rows are always transformed in-place
 	clfftResultLocation clfftPlace;
-	if(getInput() == getOutput())
+	if(packedRowsMode || (getInput() == getOutput()))
 	    clfftPlace = CLFFT_INPLACE;
 	else
 	    clfftPlace = CLFFT_OUTOFPLACE;
@@ -354,84 +421,41 @@ void FFT::init() {
 		BTTHROW(CLError(CL_INVALID_WORK_DIMENSION, "Only 1, 2 and 3-dimensional FFTs are supported"), "FFT::init");
 	}
 
-	/* Setup clFFT. */
-	clfftSetupData fftSetup;
-	cl_int err;
-
-	if((err = clfftInitSetupData(&fftSetup)) != CL_SUCCESS) {
-	    errStr = "clfftInitSetupData: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	if((err = clfftSetup(&fftSetup)) != CL_SUCCESS) {
-	    errStr = "clfftSetup: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	//Create a default plan
-	if((err = clfftCreateDefaultPlan(&clPlanHandle, (getApp()->getContext())(), clFFTnDims, fftDataSize)) != CL_SUCCESS) {
-	    errStr = "clfftCreateDefaultPlan: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    if(err == CLFFT_NOTIMPLEMENTED)
-		errStr += ". Hint: data dimensions must be combinations of powers of 2, 3, 5, and 7";
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	//Set plan parameters: precision
-	if((err = clfftSetPlanPrecision(clPlanHandle, OPENCLIPER_CLFFT_PRECISION)) != CL_SUCCESS) {
-	    errStr = "clfftSetPlanPrecision: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
+	// Get a baked plan from the CLapp-wide cache (FFTs with the same geometry share a single plan)
+	FFTPlanCache::PlanParameters planParameters;
+	planParameters.dim = clFFTnDims;
+	for(unsigned i = 0; i < FFTnDims; i++) {
+	    planParameters.sizes[i] = fftDataSize[i];
+	    planParameters.strides[i] = strides[i];
 	}
-
-	//Set plan parameters: data layout
-	if((err = clfftSetLayout(clPlanHandle, CLFFT_COMPLEX_INTERLEAVED, CLFFT_COMPLEX_INTERLEAVED)) != CL_SUCCESS) {
-	    errStr = "clfftSetLayout: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	//Set plan parameters: in place/out of place
-	if((err = clfftSetResultLocation(clPlanHandle, clfftPlace)) != CL_SUCCESS) {
-	    errStr = "clfftSetResultLocation: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	// Set plan parameters: in/out strides
-	if((err = clfftSetPlanInStride(clPlanHandle, clFFTnDims, strides)) != CL_SUCCESS) {
-	    errStr = "clfftSetPlanInStride: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-	if((err = clfftSetPlanOutStride(clPlanHandle, clFFTnDims, strides)) != CL_SUCCESS) {
-	    errStr = "clfftSetPlanOutStride: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
-
-	//Set plan parameters: batch size
-	if((err = clfftSetPlanBatchSize(clPlanHandle, batchSize)) != CL_SUCCESS) {
-	    errStr = "clfftSetPlanBatchSize: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
+	planParameters.batchSize = batchSize;
+	planParameters.batchDistance = batchDistance;
+	planParameters.precision = OPENCLIPER_CLFFT_PRECISION;
+	planParameters.placement = clfftPlace;
+	planParameters.centered = pIP->centered;
+
+	// Let clFFT scale results while storing them
+	size_t transformSize = 1;
+	for(unsigned i = 0; i < FFTnDims; i++)
+	    transformSize *= fftDataSize[i];
+	switch(pIP->normalization) {
+	    case NORMALIZE_BACKWARD:
+		planParameters.forwardScale = 1.0f;
+		planParameters.backwardScale = 1.0f / transformSize;
+		break;
+	    case NORMALIZE_NONE:
+		planParameters.forwardScale = 1.0f;
+		planParameters.backwardScale = 1.0f;
+		break;
+	    case NORMALIZE_UNITARY:
+		planParameters.forwardScale = 1.0f / std::sqrt(static_cast<double>(transformSize));
+		planParameters.backwardScale = planParameters.forwardScale;
+		break;
 	}
 
-	//Set plan parameters: batch distance
-	if((err = clfftSetPlanDistance(clPlanHandle, batchDistance, batchDistance)) != CL_SUCCESS) {
-	    errStr = "clfftSetPlanDistance: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
+	clPlanHandle = getApp()->getFFTPlanCache()->getPlan(planParameters, queue);
 
-	// Bake the plan
-	if((err = clfftBakePlan(clPlanHandle, 1, &(getApp()->getCommandQueue(0))(), NULL, NULL)) != CL_SUCCESS) {
-	    errStr = "clfftBakePlan: ";
-	    errStr += getApp()->getOpenCLErrorCodeStr(err);
-	    BTTHROW(CLError(err, errStr.c_str()), "FFT::init");
-	}
+	cl_int err;
 
 	// Get needed work buffer size
 	size_t bufferSize;
@@ -453,7 +477,7 @@ void FFT::init() {
 #endif
 }
 
-void FFT::launch() {
+void FFT::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
     checkCommonLaunchParameters();
     if(!pLP)
@@ -476,7 +500,7 @@ void FFT::launch() {
 	void* outputData = getOutput()->getHIPDeviceBuffer();
 
 	// Wait for CL queue before using HIP
-	getApp()->getCommandQueue().finish();
+	queue.finish();
 	if(pLP->dir == FORWARD) {
 	    if((err = rocfft_execute(rocPlanHandleFW, &inputData, &outputData, rocExecInfoFW)) != rocfft_status_success) {
 		errStr = "rocfft_execute (forward plan): ";
@@ -507,7 +531,32 @@ void FFT::launch() {
 	cl_mem inputData = (*(getInput()->getDeviceBuffer()))();
 	cl_mem outputData = (*(getOutput()->getDeviceBuffer()))();
 
-	for(unsigned batch = 0; batch < nBatches; batch++) {
+	// Gather rows selected by the sampling mask and transform them in-place in the packed buffer
+	if(packedRowsMode) {
+	    try {
+		cl::Event event;
+		gatherKernel.setArg(0, *(getInput()->getDeviceBuffer()));
+		gatherKernel.setArg(1, *(packedData->getDeviceBuffer()));
+		gatherKernel.setArg(2, packedRowsBuffer);
+		gatherKernel.setArg(3, rowLength);
+		gatherKernel.setArg(4, rowDistance);
+		gatherKernel.setArg(5, elementStride);
+		if(nPackedRows > 0) {
+		    queue.enqueueNDRangeKernel(gatherKernel, cl::NullRange, cl::NDRange(rowLength, nPackedRows), cl::NullRange, NULL, &event);
+		    kernelsExecEventList.push_back(event);
+		}
+	    }
+	    catch(cl::Error& err) {
+		BTTHROW(CLError(err), "FFT::launch");
+	    }
+
+	    inputData = (*(packedData->getDeviceBuffer()))();
+	    outputData = inputData;
+	}
+
+	// Nothing to transform if the sampling mask selects no rows at all
+	unsigned nTransformBatches = (packedRowsMode && (nPackedRows == 0)) ? 0 : nBatches;
+	for(unsigned batch = 0; batch < nTransformBatches; batch++) {
 
 	    // Set offsets for this batch
 	    clfftSetPlanOffsetIn(clPlanHandle, batchOffsets[batch]);
@@ -516,13 +565,31 @@ void FFT::launch() {
 	    // Launch transform
             // Note: if tmpBuffer is set to nullptr, each new call to clfftEnqueueTransform allocates a new temporary buffer, which is not freed until clfftTearDown is called!
             //       Always use a preallocated tmpBuffer if clfftGetTmpBufSize returns non-zero!
-	    if((err = clfftEnqueueTransform(clPlanHandle, static_cast<clfftDirection>(pLP->dir), 1, &(getApp()->getCommandQueue(0))(), 0, nullptr, nullptr, &inputData, &outputData,
+	    if((err = clfftEnqueueTransform(clPlanHandle, static_cast<clfftDirection>(pLP->dir), 1, &queue(), 0, nullptr, nullptr, &inputData, &outputData,
                                             clWorkBuffer? (*(clWorkBuffer->getDeviceBuffer()))() : nullptr )) != CL_SUCCESS) {
 		errStr = "clfftEnqueueTransform: ";
 		errStr += getApp()->getOpenCLErrorCodeStr(err);
 		BTTHROW(CLError(err, errStr.c_str()), "FFT::launch");
 	    }
 	}
+
+	// Put transformed rows back in place (and zero the rest)
+	if(packedRowsMode) {
+	    try {
+		cl::Event event;
+		scatterKernel.setArg(0, *(packedData->getDeviceBuffer()));
+		scatterKernel.setArg(1, *(getOutput()->getDeviceBuffer()));
+		scatterKernel.setArg(2, rowMapBuffer);
+		scatterKernel.setArg(3, rowLength);
+		scatterKernel.setArg(4, rowDistance);
+		scatterKernel.setArg(5, elementStride);
+		queue.enqueueNDRangeKernel(scatterKernel, cl::NullRange, cl::NDRange(rowLength, nRows), cl::NullRange, NULL, &event);
+		kernelsExecEventList.push_back(event);
+	    }
+	    catch(cl::Error& err) {
+		BTTHROW(CLError(err), "FFT::launch");
+	    }
+	}
 #ifdef HAVE_ROCFFT
     }
 #endif
@@ -563,11 +630,7 @@ FFT::~FFT() {
     }
     else {
 #endif
-	//Release the plan
-	clfftDestroyPlan(&clPlanHandle);
-
-	//Release clFFT library
-	clfftTeardown();
+	// The plan belongs to the CLapp's FFT plan cache, which releases it (and the clFFT library) when the CLapp is destroyed
 #ifdef HAVE_ROCFFT
     }
 #endif
@@ -72,6 +72,8 @@ GroupwiseRegistration::GroupwiseRegistration(const std::shared_ptr<CLapp>& pCLap
     pAuxiliarCost = Process::create<AuxiliarCost>(pCLapp);
     pCost6DReduction = Process::create<Cost6DReduction>(pCLapp);
     pCostReduction = Process::create<CostReduction>(pCLapp);
+    pEvolutionStop = Process::create<EvolutionStop>(pCLapp);
+    pProjectedGradientCost = Process::create<ProjectedGradientCost>(pCLapp);
     pTransformationAux = Process::create<TransformationAux>(pCLapp);
     pDeformation = Process::create<Deformation>(pCLapp);
     pDeformationAdjust = Process::create<DeformationAdjust>(pCLapp);
@@ -143,6 +145,9 @@ void GroupwiseRegistration::init() {
     
     Wn = pIP->W / areaX; // Weight normalization
     flagW = pIP->flagW; // Adaptive weight
+    deviceStop = pIP->deviceStop; // Evolution and stop condition evaluated on the device
+    stopPollInterval = (pIP->stopPollInterval != 0) ? pIP->stopPollInterval : 1;
+    fusedCost = pIP->fusedCost; // dH computed by a single kernel for all control points
     
      // Parameters for gradient descent optimization (Max number of iterations for the optimization loop, 0.01 pixels, 0.5% of initial)
     setParametersGD(pIP->nmax, pIP->et, pIP->eh);
@@ -355,6 +360,11 @@ void GroupwiseRegistration::init() {
 
     pNDArrayDims = new std::vector<std::vector<dimIndexType>*>({new std::vector<dimIndexType>({Cp1, Cp0, nFRAMES, ts->nt})});
     DifData = std::make_shared<XData>(getApp(), pNDArrayDims, TYPEID_REAL); 
+
+    
+    // XData containing Tdif (first nmax elements) and Hdif (next nmax elements), only used if evolution is computed on the device
+    if(deviceStop)
+	TdifHdifData = std::make_shared<XData>(getApp(), getParametersGD().nmax, 2, TYPEID_REAL);
     
     
     
@@ -384,7 +394,11 @@ void GroupwiseRegistration::init() {
     pAuxiliarMask->init();
     pAuxiliarCost->init();
     pCost6DReduction->init();
+    pCostReduction->setInput(VData); // CostReduction needs input size at init() to allocate its scratch buffers
+    pCostReduction->setOutput(HData);
     pCostReduction->init();
+    pEvolutionStop->init();
+    pProjectedGradientCost->init();
     pDeformationAdjust->init();
     pInitdx->init();
     pPermuteTAux->init();
@@ -547,7 +561,7 @@ bool GroupwiseRegistration::stopCondition(const float p1, const float p3, const
  * @brief Launch a non rigid 2D groupwise registration based on B-splines with motion estimation
  * @param pProfileParameters->enable flag to enable profiling
  */
-void GroupwiseRegistration::launch() {
+void GroupwiseRegistration::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
     
     infoItems.addInfoItem("Title", "GroupwiseRegistration info");
@@ -614,5 +628,21 @@ void GroupwiseRegistration::launch() {
     GROUPWISEREGISTRATION_CERR("|=============================================================================|\n" << std::endl);
     stopProfiling();
 }
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void GroupwiseRegistration::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pControlPoints, pCreateBB, pPermuteBB, pCreateBBg, pRepmatBBg, pPermuteBBg, pInitZero, pInitIT, pMetric,
+		   pSumLambdaMetric, pGradient, pPermutedV, pUpdateTransformation, pCost6D, pGradientMetric, pGradientJointAux,
+		   pGradientWithSmoothTerms, pReduction7Dto6D, pReduction6Dto5D, pReduction5Dto4D, pAuxiliarMask, pAuxiliarCost,
+		   pCost6DReduction, pCostReduction, pEvolutionStop, pProjectedGradientCost, pTransformationAux, pDeformation,
+		   pDeformationAdjust, pInitdx, pGradientInterpolator, pPermuteTAux, pShiftTAux, pRegularization, pInterpolator,
+		   pGradientRegularization, pDataNormalization})
+	p->setCommandQueue(cq);
+}
+
 }
 #undef GROUPWISEREGISTRATION_DEBUG
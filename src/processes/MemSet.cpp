@@ -64,7 +64,7 @@ void MemSet::init() {
     std::cerr << "Global size: " << globalSize << std::endl;
 }
 
-void MemSet::launch() {
+void MemSet::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
     if(!pLP) pLP = std::unique_ptr<LaunchParameters>(new LaunchParameters());
 
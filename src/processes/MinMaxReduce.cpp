@@ -0,0 +1,131 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodrí­guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos MartÃ­n Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#include <OpenCLIPER/processes/MinMaxReduce.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+#include <OpenCLIPER/XData.hpp>
+
+namespace OpenCLIPER {
+
+void MinMaxReduce::init() {
+    auto pIP = std::dynamic_pointer_cast<InitParameters>(pInitParameters);
+    if(!pIP) pIP = std::unique_ptr<InitParameters>(new InitParameters());
+
+    if(!getInput())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "init() called before setInputData()"), "MinMaxReduce::init");
+
+    if(!getOutput())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "init() called before setOutputData()"), "MinMaxReduce::init");
+
+    if((getInput()->getElementDataType() != TYPEID_REAL) && (getInput()->getElementDataType() != TYPEID_COMPLEX))
+	BTTHROW(std::invalid_argument("MinMaxReduce is only implemented for real and complex data types at this time"), "MinMaxReduce::init");
+
+    op = pIP->op;
+    if(!pMinReduce) {
+	pMinReduce = Process::create<SumReduce>(getApp());
+	pMaxReduce = Process::create<SumReduce>(getApp());
+	pMinReduce->setCommandQueue(queue);
+	pMaxReduce->setCommandQueue(queue);
+    }
+    pMinReduce->setInitParameters(std::make_shared<SumReduce::InitParameters>(SumReduce::MIN));
+    pMaxReduce->setInitParameters(std::make_shared<SumReduce::InitParameters>(SumReduce::MAX));
+
+    // MIN and MAX write their result straight to the output; MINMAX writes both results to scratch objects first
+    if(op == MINMAX) {
+	pMinData = std::make_shared<XData>(getApp(), 1, TYPEID_REAL);
+	pMaxData = std::make_shared<XData>(getApp(), 1, TYPEID_REAL);
+	pMinReduce->setOutput(pMinData);
+	pMaxReduce->setOutput(pMaxData);
+    }
+    else {
+	pMinReduce->setOutput(getOutput());
+	pMaxReduce->setOutput(getOutput());
+    }
+    initReductions();
+}
+
+// (Re)initializes the subprocesses needed by op for the current input
+void MinMaxReduce::initReductions() {
+    if(op != MAX) {
+	pMinReduce->setInput(getInput());
+	pMinReduce->init();
+    }
+    if(op != MIN) {
+	pMaxReduce->setInput(getInput());
+	pMaxReduce->init();
+    }
+    initNDArraySize = getInput()->getNDArrayTotalSize(0);
+    initNumNDArrays = getInput()->getNumNDArrays();
+}
+
+void MinMaxReduce::doLaunch() {
+    if(!getInput()->getAllSizesEqual())
+	BTTHROW(std::invalid_argument("MinMaxReduce for variable-size data objects is not implemented at this time"), "MinMaxReduce::launch");
+
+    // Input may have been replaced since init(); reduction layouts depend on its sizes
+    if((getInput()->getNDArrayTotalSize(0) != initNDArraySize) || (getInput()->getNumNDArrays() != initNumNDArrays))
+	initReductions();
+
+    startProfiling();
+    try {
+	if(op != MAX) {
+	    pMinReduce->setInput(getInput());
+	    pMinReduce->launch();
+	}
+	if(op != MIN) {
+	    pMaxReduce->setInput(getInput());
+	    pMaxReduce->launch();
+	}
+	if(op == MINMAX) {
+	    queue.enqueueCopyBuffer(*pMinData->getDeviceBuffer(), *getOutput()->getDeviceBuffer(), 0, 0, sizeof(realType));
+	    queue.enqueueCopyBuffer(*pMaxData->getDeviceBuffer(), *getOutput()->getDeviceBuffer(), 0, sizeof(realType), sizeof(realType));
+	}
+	stopProfiling();
+    }
+    catch(cl::Error& e) {
+	BTTHROW(CLError(e.err(), getApp()->getOpenCLErrorCodeStr(e.err())), "MinMaxReduce::launch");
+    }
+}
+
+/**
+ * @brief Binds this process and its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void MinMaxReduce::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pMinReduce, pMaxReduce})
+	if(p)
+	    p->setCommandQueue(cq);
+}
+
+} /* namespace OpenCLIPER */
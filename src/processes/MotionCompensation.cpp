@@ -54,7 +54,7 @@ void MotionCompensation::init(){
 
 }
 
-void MotionCompensation::launch() {
+void MotionCompensation::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     infoItems.addInfoItem("Title", "MotionCompensation info");
@@ -78,4 +78,15 @@ void MotionCompensation::launch() {
 	BTTHROW(CLError(err), "MotionCompensation::launch");
     }
 }
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void MotionCompensation::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pCopy, pProcess})
+	p->setCommandQueue(cq);
+}
+
 }
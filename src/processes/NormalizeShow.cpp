@@ -73,7 +73,7 @@ void NormalizeShow::init() {
     batchDistance = getInput()->getDimStride(nSpatialDims, 0);
 }
 
-void NormalizeShow::launch() {
+void NormalizeShow::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
     if(!(pLP->sum))
 	BTTHROW(std::invalid_argument("mandatory launch parameter 'sum' not set"), "NormalizeShow::launch");
@@ -60,7 +60,7 @@ void RSoS::init() {
 }
 
 
-void RSoS::launch() {
+void RSoS::doLaunch() {
     checkCommonLaunchParameters();
 
     infoItems.addInfoItem("Title", "RSoS info");
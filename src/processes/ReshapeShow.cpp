@@ -106,7 +106,7 @@ void ReshapeShow::init() {
     kernel = getApp()->getKernel("reshape_show");
 }
 
-void ReshapeShow::launch() {
+void ReshapeShow::doLaunch() {
     cl::NDRange globalSizes = cl::NDRange(winWidth, winHeight);
     cl::NDRange localSizes = cl::NDRange();
 
@@ -75,14 +75,17 @@ void ScalarMultiply::init() {
     for(unsigned i = nSpatialDims; i < nTotalDims; i++)
 	batchSize *= getDimSize(static_cast<const cl_uint*>(getInput()->getHostBuffer()), i, 0);
 
+    // Caution: this only works for complex and real element types! The kernel sees complex elements as pairs of reals,
+    // so both the global size and the batch distance are given in reals
+    cl_uint realsPerElement = NDArray::getElementSize(getInput()->getElementDataType()) / sizeof(realType);
+
     //getDimStride will return batchDistance=0 if there are spatial dimensions only
-    batchDistance = getDimStride(static_cast<const cl_uint*>(getInput()->getHostBuffer()), nSpatialDims, 0);
+    batchDistance = realsPerElement * getDimStride(static_cast<const cl_uint*>(getInput()->getHostBuffer()), nSpatialDims, 0);
 
-    // Caution: this only works for complex and real element types!
-    globalSize = cl::NDRange(NDArray::getElementSize(getInput()->getElementDataType()) / sizeof(realType) * getInput()->getNDArrayTotalSize(0));
+    globalSize = cl::NDRange(realsPerElement * getInput()->getNDArrayTotalSize(0));
 }
 
-void ScalarMultiply::launch() {
+void ScalarMultiply::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
     if(!pLP) pLP = std::unique_ptr<LaunchParameters>(new LaunchParameters());
 
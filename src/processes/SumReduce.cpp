@@ -42,6 +42,7 @@
 #include <OpenCLIPER/hostKernelFunctions.hpp>
 #include <LPISupport/InfoItems.hpp>
 #include <OpenCLIPER/XData.hpp>
+#include <set>
 
 namespace OpenCLIPER {
 
@@ -58,8 +59,12 @@ void SumReduce::init() {
     if(!getInput()->getAllSizesEqual())
 	BTTHROW(std::invalid_argument("SumReduce for variable-size data objects is not implemented at this time"), "SumReduce::init");
 
-    if(getInput()->getElementDataType() != TYPEID_REAL)
-        BTTHROW(std::invalid_argument("SumReduce is only implemented for real data type at this time"), "SumReduce::init");
+    // Plain sums of all the pixels of real data use the original reduction kernel; anything else goes through the generic one
+    generic = (pIP->op != SUM) || !pIP->reducedDims.empty() || (getInput()->getElementDataType() != TYPEID_REAL);
+    if(generic) {
+	initGeneric(pIP);
+	return;
+    }
 
     kernel = getApp()->getKernel("reduce_sum");
 
@@ -80,10 +85,129 @@ void SumReduce::init() {
     globalSize = cl::NDRange(localSize[0] * nWorkgroups); // globalSize must be multiple of localSize in OpenCL<2.0
 
     partialOutputs = std::make_shared<XData> (getApp(), nWorkgroups, TYPEID_REAL);
-    partialOutputs2 = std::make_shared<XData> (getApp(), (nWorkgroups > localSize[0]) ? (nWorkgroups / localSize[0]) : 1, TYPEID_REAL);
+    // Second iteration output size depends on local size chosen for nWorkgroups elements, which may differ from the first iteration one
+    cl::NDRange secondLocalSize = CLapp::calcLocalSize(kernel, getApp()->getDevice(), nWorkgroups);
+    partialOutputs2 = std::make_shared<XData> (getApp(), (nWorkgroups - 1) / secondLocalSize[0] + 1, TYPEID_REAL);
 }
 
-void SumReduce::launch() {
+void SumReduce::initGeneric(const std::shared_ptr<InitParameters>& pIP) {
+    static const std::string opNames[] = {"sum", "max", "min", "l1", "l2sq", "dot"};
+
+    std::string typeName;
+    if(getInput()->getElementDataType() == TYPEID_REAL)
+	typeName = "real";
+    else if(getInput()->getElementDataType() == TYPEID_COMPLEX)
+	typeName = "complex";
+    else if(getInput()->getElementDataType() == TYPEID_INDEX)
+	typeName = "index";
+    else
+	BTTHROW(std::invalid_argument("SumReduce is only implemented for real, complex and index data types"), "SumReduce::init");
+
+    if(pIP->op == DOT) {
+	if(!pIP->pSecondInput)
+	    BTTHROW(std::invalid_argument("dot product requested without a second operand"), "SumReduce::init");
+	if((pIP->pSecondInput->getElementDataType() != getInput()->getElementDataType()) ||
+	   (pIP->pSecondInput->getNDArrayTotalSize(0) != getInput()->getNDArrayTotalSize(0)) ||
+	   (pIP->pSecondInput->getNumNDArrays() != getInput()->getNumNDArrays()))
+	    BTTHROW(std::invalid_argument("dot product operands must have the same element type and sizes"), "SumReduce::init");
+	pSecondInput = pIP->pSecondInput;
+    }
+    else
+	pSecondInput = getInput(); // not used by the kernel, but it must be a valid buffer
+
+    bool complexResult = (getInput()->getElementDataType() == TYPEID_COMPLEX) && (pIP->op == SUM || pIP->op == DOT);
+    if(getOutput()->getElementDataType() != (complexResult ? TYPEID_COMPLEX : TYPEID_REAL))
+	BTTHROW(std::invalid_argument(std::string("output must be of ") + (complexResult ? "complex" : "real") + " data type for this reduction"), "SumReduce::init");
+    accElementSize = complexResult ? sizeof(complexType) : sizeof(realType);
+
+    kernel = getApp()->getKernel("reduce_" + opNames[pIP->op] + "_" + typeName);
+    if(pIP->op == MAX)
+	finalKernel = getApp()->getKernel("reduce_final_max_real");
+    else if(pIP->op == MIN)
+	finalKernel = getApp()->getKernel("reduce_final_min_real");
+    else
+	finalKernel = getApp()->getKernel(complexResult ? "reduce_final_sum_complex" : "reduce_final_sum_real");
+
+    // Split dimensions into reduced and kept ones and describe them to the kernel
+    dimIndexType nSpatialDims = getInput()->getNumSpatialDims();
+    dimIndexType nTotalDims = nSpatialDims + (getInput()->getNumCoils() >= 2 ? 1 : 0) + getInput()->getNumTemporalDims();
+
+    std::set<dimIndexType> reducedDims(pIP->reducedDims.begin(), pIP->reducedDims.end());
+    if(reducedDims.empty())
+	for(dimIndexType i = 0; i < nTotalDims; i++)
+	    reducedDims.insert(i);
+    if(*reducedDims.rbegin() >= nTotalDims)
+	BTTHROW(std::invalid_argument("dimension to reduce out of range"), "SumReduce::init");
+
+    std::vector<index1DType> layout({(index1DType) reducedDims.size(), (index1DType) (nTotalDims - reducedDims.size())});
+    reduceSize = 1;
+    for(dimIndexType i: reducedDims) {
+	layout.push_back(getInput()->getDimSize(i, 0));
+	layout.push_back(getInput()->getDimStride(i, 0));
+	reduceSize *= getInput()->getDimSize(i, 0);
+    }
+    nOutputs = 1;
+    for(dimIndexType i = 0; i < nTotalDims; i++) {
+	if(reducedDims.count(i) == 0) {
+	    layout.push_back(getInput()->getDimSize(i, 0));
+	    layout.push_back(getInput()->getDimStride(i, 0));
+	    nOutputs *= getInput()->getDimSize(i, 0);
+	}
+    }
+    // Sizes and strides are index1DType, as their products may not fit in 32 bits
+    try {
+	layoutBuffer = cl::Buffer(getApp()->getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, layout.size() * sizeof(index1DType), layout.data());
+    }
+    catch(cl::Error& e) {
+	BTTHROW(CLError(e.err(), getApp()->getOpenCLErrorCodeStr(e.err())), "SumReduce::init");
+    }
+
+    if(getOutput()->getNDArrayTotalSize(0) * getOutput()->getNumNDArrays() < nOutputs)
+	BTTHROW(std::invalid_argument("output is too small for the non-reduced dimensions"), "SumReduce::init");
+
+    // Several work groups per output element if there are few of them, so that the device is kept busy
+    const cl_uint maxWorkgroups = 256;
+    localSize = CLapp::calcLocalSize(kernel, getApp()->getDevice(), reduceSize);
+    groupsPerOutput = (cl_uint) std::min((index1DType) ((reduceSize - 1) / localSize[0] + 1), std::max((index1DType) 1, (index1DType) (maxWorkgroups / nOutputs)));
+    globalSize = cl::NDRange(localSize[0] * groupsPerOutput * nOutputs);
+
+    if(groupsPerOutput > 1) {
+	finalLocalSize = CLapp::calcLocalSize(finalKernel, getApp()->getDevice(), groupsPerOutput);
+	partialOutputs = std::make_shared<XData>(getApp(), nOutputs * groupsPerOutput, complexResult ? TYPEID_COMPLEX : TYPEID_REAL);
+    }
+}
+
+void SumReduce::launchGeneric() {
+    try {
+	kernel.setArg(0, *getInput()->getDeviceBuffer());
+	kernel.setArg(1, *pSecondInput->getDeviceBuffer());
+	// if only one work group per output element is used, its result is final
+	kernel.setArg(2, (groupsPerOutput > 1) ? *partialOutputs->getDeviceBuffer() : *getOutput()->getDeviceBuffer());
+	kernel.setArg(3, cl::Local(accElementSize * localSize[0]));
+	kernel.setArg(4, layoutBuffer);
+	kernel.setArg(5, reduceSize);
+	kernel.setArg(6, groupsPerOutput);
+	queue.enqueueNDRangeKernel(kernel, cl::NullRange, globalSize, localSize, NULL, NULL);
+
+	if(groupsPerOutput > 1) {
+	    finalKernel.setArg(0, *partialOutputs->getDeviceBuffer());
+	    finalKernel.setArg(1, *getOutput()->getDeviceBuffer());
+	    finalKernel.setArg(2, cl::Local(accElementSize * finalLocalSize[0]));
+	    finalKernel.setArg(3, groupsPerOutput);
+	    queue.enqueueNDRangeKernel(finalKernel, cl::NullRange, cl::NDRange(finalLocalSize[0] * nOutputs), finalLocalSize, NULL, NULL);
+	}
+    }
+    catch(cl::Error& e) {
+	BTTHROW(CLError(e.err(), getApp()->getOpenCLErrorCodeStr(e.err())), "SumReduce::launch");
+    }
+}
+
+void SumReduce::doLaunch() {
+    if(generic) {
+	launchGeneric();
+	return;
+    }
+
     cl::Buffer* inBuffer = getInput()->getDeviceBuffer();
     cl::Buffer* outBuffer = getOutput()->getDeviceBuffer();
 
@@ -113,7 +237,7 @@ void SumReduce::launch() {
     // Successive iterations: continue reducing until there is one element left
     // ------------------------------------------------------------------------
     if(nWorkgroups>=2) {
-	cl_uint realCurrentGlobalSize = nWorkgroups;
+	index1DType realCurrentGlobalSize = nWorkgroups;
         cl::NDRange currentGlobalSize;
         cl::NDRange currentLocalSize;
         size_t currentNWorkgroups;
@@ -125,8 +249,9 @@ void SumReduce::launch() {
             currentNWorkgroups = (realCurrentGlobalSize - 1) / currentLocalSize[0] + 1;
 	    currentGlobalSize = cl::NDRange(currentLocalSize[0] * currentNWorkgroups);
 
-            // set last output buffer as kernel input
+            // set last output buffer (and its size) as kernel input
             kernel.setArg(0, *scratchGlobalBuffer);
+            kernel.setArg(5, realCurrentGlobalSize);
 
             // set final output buffer as kernel output if this is the last iteration, or a temporary buffer otherwise
             if(currentNWorkgroups == 1)
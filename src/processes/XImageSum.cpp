@@ -76,7 +76,7 @@ void XImageSum::init() {
  * kernel execution times are stored.
  * @param[in] profileParameters profiling configuration
  */
-void XImageSum::launch() {
+void XImageSum::doLaunch() {
 	checkCommonLaunchParameters();
 	try {
 		cl::Buffer* pInputBuffer = getInput()->getDeviceBuffer();
@@ -47,7 +47,7 @@ void Negate::init() {
     kernel = getApp()->getKernel("negate");
 }
 
-void Negate::launch() {
+void Negate::doLaunch() {
     checkCommonLaunchParameters();
     try {
 	// Set input and output OpenCL buffers on device memory
@@ -64,16 +64,16 @@ void Negate::launch() {
 	dimIndexType deviceMemBaseAddrAlignInBytes = getApp()->getDevice().getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8;
 #endif
 	NEGATE_CERR("Negate process, deviceMemBaseAddrAlignInBytes: " << deviceMemBaseAddrAlignInBytes << std::endl);
-	NEGATE_CERR("Negate process, sizeof(dimIndexType): " << sizeof(dimIndexType) << std::endl);
+	NEGATE_CERR("Negate process, sizeof(index1DType): " << sizeof(index1DType) << std::endl);
 	NEGATE_CERR("Negate process, sizeof(realType): " << sizeof(realType) << std::endl);
 #if !defined NDEBUG && defined NEGATE_DEBUG
-	cl::NDRange offset = {CLapp::roundUp(sizeof(dimIndexType), deviceMemBaseAddrAlignInBytes) / sizeof(realType)};
+	cl::NDRange offset = {CLapp::roundUp(sizeof(index1DType), deviceMemBaseAddrAlignInBytes) / sizeof(realType)};
 #endif
 	NEGATE_CERR("Negate process, kernel offset in bytes / size of realType: " << offset[0] << std::endl);
 	NEGATE_CERR("Negate process, getting dimsAndStridesArray from host buffer (not vector)... ");
 
 #if !defined NDEBUG && defined NEGATE_DEBUG
-	const cl_uint* dimsAndStridesArray = (const cl_uint*)(getInput()->getDataDimsAndStridesHostBuffer());
+	const index1DType* dimsAndStridesArray = (const index1DType*)(getInput()->getDataDimsAndStridesHostBuffer());
 #endif
 	NEGATE_CERR("Done.\n");
 	NEGATE_CERR("======== From Negate process ========\nnsd: " << dimsAndStridesArray[0] << "\nallSizesEqual: " << dimsAndStridesArray[1] << "\nnumCoils: " << dimsAndStridesArray[2] <<
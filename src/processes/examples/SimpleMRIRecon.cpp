@@ -53,21 +53,28 @@ SimpleMRIRecon::SimpleMRIRecon(const std::shared_ptr<CLapp>& pCLapp, const std::
  * @brief Method for process initialization.
  *
  * Initializes subkernels (FFT, complex element product of x-images by conjugated sensitivity maps and
- * sum of x-images captured by all the coils at the same time frame)
+ * sum of x-images captured by all the coils at the same time frame) and the graph that runs them
  *
  */
 void SimpleMRIRecon::init() {
-    pProcInvFFT->setInput(getInput());		// Note: in-place transformation
-    pProcInvFFT->setOutput(getInput());		//
-    pProcInvFFT->init();
+    auto pInKData = std::dynamic_pointer_cast<KData>(getInput());
+    if(!pInKData)
+	BTTHROW(std::invalid_argument("input data must be a KData object"), "SimpleMRIRecon::init");
 
-    pProcSensMapProd->setInput(getInput());	// Note: in-place transformation
-    pProcSensMapProd->setOutput(getInput());	//
-    pProcSensMapProd->init();
+    pGraph = Process::create<ProcessGraph>(getApp(), getInput(), getOutput());
+    pGraph->setCommandQueue(queue);
 
-    pProcAddXImages->setInput(getInput());
-    pProcAddXImages->setOutput(getOutput());
-    pProcAddXImages->init();
+    // Step 0: Inverse FFT of K-space data (in-place transformation)
+    pGraph->addProcess(pProcInvFFT, getInput(), getInput(), std::make_shared<FFT::LaunchParameters>(FFT::BACKWARD));
+
+    // Step 1: Multiply X-space data by their sensitivity maps (in-place transformation)
+    pGraph->addProcess(pProcSensMapProd, getInput(), getInput(),
+		       std::make_shared<ComplexElementProd::LaunchParameters>(ComplexElementProd::conjugate, pInKData->getSensitivityMapsData()));
+
+    // Step 2: add all x-images in each frame together
+    pGraph->addProcess(pProcAddXImages, getInput(), getOutput());
+
+    pGraph->init();
 }
 
 /**
@@ -78,26 +85,30 @@ void SimpleMRIRecon::init() {
  * kernel execution times are stored.
  * @param[in] profileParameters profiling configuration
  */
-void SimpleMRIRecon::launch() {
+void SimpleMRIRecon::doLaunch() {
     checkCommonLaunchParameters();
-    try {
-	// Step 0: Inverse FFT of K-space data
-	auto launchParmsInvFFT = std::make_shared<FFT::LaunchParameters>(FFT::BACKWARD);
-	pProcInvFFT->setLaunchParameters(launchParmsInvFFT);
-	pProcInvFFT->launch();
-
-	// Step 1: Multiply X-space data by their sensitivity maps
-        auto pInKData = std::dynamic_pointer_cast<KData>(getInput());
-	auto sensMapsProdLP = std::make_shared<ComplexElementProd::LaunchParameters>(ComplexElementProd::conjugate, pInKData->getSensitivityMapsData());
-	pProcSensMapProd->setLaunchParameters(sensMapsProdLP);
-	pProcSensMapProd->launch();
+    if(!pGraph)
+	BTTHROW(std::invalid_argument("launch() called before init()"), "SimpleMRIRecon::launch");
 
-	// Step 2: add all x-images in each frame together
-	pProcAddXImages->launch();
+    try {
+	pGraph->launch();
     }
     catch(cl::Error& err) {
 	BTTHROW(CLError(err), "SimpleMRIRecon::launch");
     }
 }
 
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void SimpleMRIRecon::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pProcInvFFT, pProcSensMapProd, pProcAddXImages})
+	p->setCommandQueue(cq);
+    if(pGraph)
+	pGraph->setCommandQueue(cq);
+}
+
 } // namespace OpenCLIPER
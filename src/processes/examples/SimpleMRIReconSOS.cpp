@@ -62,7 +62,7 @@ void SimpleMRIReconSOS::init() {
     pRSoS->init();
 }
 
-void SimpleMRIReconSOS::launch() {
+void SimpleMRIReconSOS::doLaunch() {
     checkCommonLaunchParameters();
     try {
 	// Step 0: Inverse FFT of initial KData in place
@@ -94,7 +94,7 @@ void SimpleMRIReconSOS::launch() {
 
 	pRSoS->launch();
 
-	getApp()->getCommandQueue().finish();
+	queue.finish();
 
 	gettimeofday(&t1, 0);//Elisa
 
@@ -108,4 +108,15 @@ void SimpleMRIReconSOS::launch() {
 	BTTHROW(CLError(err), "SimpleMRIReconSOS::launch");
     }
 }
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void SimpleMRIReconSOS::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pProcInvFFT, pRSoS})
+	p->setCommandQueue(cq);
+}
+
 }
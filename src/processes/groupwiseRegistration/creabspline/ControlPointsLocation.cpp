@@ -53,7 +53,7 @@ void ControlPointsLocation::init() {
     kernel = getApp()->getKernel("controlPointsLocation");
 }
 
-void ControlPointsLocation::launch() {
+void ControlPointsLocation::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
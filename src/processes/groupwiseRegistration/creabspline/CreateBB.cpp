@@ -54,7 +54,7 @@ void CreateBB::init() {
     kernel = getApp()->getKernel("createBB");
 }
 
-void CreateBB::launch() {
+void CreateBB::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
@@ -56,7 +56,7 @@ void CreateBBg::init() {
     kernel = getApp()->getKernel("createBBg");
 }
 
-void CreateBBg::launch() {
+void CreateBBg::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void PermuteBB::init() {
     kernel = getApp()->getKernel("permuteBB");
 }
 
-void PermuteBB::launch() {
+void PermuteBB::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void PermuteBBg::init() {
     kernel = getApp()->getKernel("permuteBBg");
 }
 
-void PermuteBBg::launch() {
+void PermuteBBg::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
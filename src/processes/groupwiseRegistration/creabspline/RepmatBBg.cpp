@@ -55,7 +55,7 @@ void RepmatBBg::init() {
     kernel = getApp()->getKernel("repmatBBg");
 }
 
-void RepmatBBg::launch() {
+void RepmatBBg::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
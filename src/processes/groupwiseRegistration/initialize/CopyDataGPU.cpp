@@ -54,7 +54,7 @@ void CopyDataGPU::init() {
     kernel = getApp()->getKernel("copyDataGPU");
 }
 
-void CopyDataGPU::launch() {
+void CopyDataGPU::doLaunch() {
     checkCommonLaunchParameters();
     try {
 	const cl::Buffer* inputData = getInput()->getDeviceBuffer();
@@ -54,7 +54,7 @@ void DataNormalization::init() {
     kernel = getApp()->getKernel("dataNormalization");
 }
 
-void DataNormalization::launch() {
+void DataNormalization::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     checkCommonLaunchParameters();
@@ -54,7 +54,7 @@ void InitZero::init() {
     kernel = getApp()->getKernel("initZero");
 }
 
-void InitZero::launch() {
+void InitZero::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
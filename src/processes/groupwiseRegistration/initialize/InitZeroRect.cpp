@@ -54,7 +54,7 @@ void InitZeroRect::init() {
     kernel = getApp()->getKernel("initZeroRect");
 }
 
-void InitZeroRect::launch() {
+void InitZeroRect::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     infoItems.addInfoItem("Title", "InitZeroRect info");
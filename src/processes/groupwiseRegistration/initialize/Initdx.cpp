@@ -54,7 +54,7 @@ void Initdx::init() {
     kernel = getApp()->getKernel("initdx");
 }
 
-void Initdx::launch() {
+void Initdx::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
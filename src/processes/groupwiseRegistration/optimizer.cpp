@@ -95,6 +95,10 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
 
     
     cl::Buffer Wnobj = cl::Buffer(getApp()->getContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(float), &Wn, NULL);
+
+    // Stop flag, only used if evolution and stop condition are evaluated on the device
+    cl_int stopFlag = 0;
+    cl::Buffer stopObj = cl::Buffer(getApp()->getContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(cl_int), &stopFlag, NULL);
     OPTIMIZER_CERR("Done." << std::endl);
 
 
@@ -158,6 +162,9 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
     pCost6D->setInput(cost2Data);
     pCost6D->setOutput(dHData);
 
+    pProjectedGradientCost->setInput(dVData);
+    pProjectedGradientCost->setOutput(dHData);
+
     pUpdateTransformation->setInput(dHData);
     pUpdateTransformation->setOutput(TData);
 
@@ -178,6 +185,9 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
 
     pSumLambdaMetric->setInput(dtauallData);
     pSumLambdaMetric->setOutput(VData);
+
+    pEvolutionStop->setInput(HData);
+    pEvolutionStop->setOutput(TdifHdifData);
     OPTIMIZER_CERR("Done." << std::endl);
 
 
@@ -209,6 +219,9 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
     auto parGradientWithSmoothTerms = std::make_shared<GradientWithSmoothTerms::LaunchParameters>(dyData, dxData, ts->BBgall, ts->coefg);
     pGradientWithSmoothTerms->setLaunchParameters(parGradientWithSmoothTerms);
 
+    auto parProjectedGradientCost = std::make_shared<ProjectedGradientCost::LaunchParameters>(maskData, ts->coefg);
+    pProjectedGradientCost->setLaunchParameters(parProjectedGradientCost);
+
     auto parUpdateTransformation = std::make_shared<UpdateTransformation::LaunchParameters>(DifData, Wnobj);
     pUpdateTransformation->setLaunchParameters(parUpdateTransformation);
 
@@ -262,6 +275,9 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
     bool stop = false;
     iter = 1;
 
+    auto parEvolutionStop = std::make_shared<EvolutionStop::LaunchParameters>(DifData, Wnobj, stopObj, p2, getParametersGD().eh, getParametersGD().nmax, flagW);
+    pEvolutionStop->setLaunchParameters(parEvolutionStop);
+
     std::shared_ptr<AuxiliarMask::LaunchParameters> parAuxiliarMask;
     std::shared_ptr<AuxiliarCost::LaunchParameters> parAuxiliarCost;
     std::shared_ptr<Cost6D::LaunchParameters> parCost6D;
@@ -293,28 +309,34 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
 
 	pPermutedV->launch();
 
-	for(uint k = 0; k < dVData->getSpatialDimSize(3,0); k++) {
-	    for(uint l = 0; l < dVData->getSpatialDimSize(4,0); l++) {
+	if(fusedCost) {
+	    pProjectedGradientCost->launch(); // Output dH
+	}
+	else {
+	    for(uint k = 0; k < dVData->getSpatialDimSize(3,0); k++) {
+		for(uint l = 0; l < dVData->getSpatialDimSize(4,0); l++) {
 
-		parAuxiliarMask = std::make_shared<AuxiliarMask::LaunchParameters>(maskData, ts->coefg, l, k);
-		pAuxiliarMask->setLaunchParameters(parAuxiliarMask);
-		pAuxiliarMask->launch();    // Output XAux
+		    parAuxiliarMask = std::make_shared<AuxiliarMask::LaunchParameters>(maskData, ts->coefg, l, k);
+		    pAuxiliarMask->setLaunchParameters(parAuxiliarMask);
+		    pAuxiliarMask->launch();    // Output XAux
 
-		parAuxiliarCost = std::make_shared<AuxiliarCost::LaunchParameters>(XauxData, l, k);
-		pAuxiliarCost->setLaunchParameters(parAuxiliarCost);
-		pAuxiliarCost->launch();    // Output cost1
+		    parAuxiliarCost = std::make_shared<AuxiliarCost::LaunchParameters>(XauxData, l, k);
+		    pAuxiliarCost->setLaunchParameters(parAuxiliarCost);
+		    pAuxiliarCost->launch();    // Output cost1
 
-		pCost6DReduction->launch(); // Output cost2
+		    pCost6DReduction->launch(); // Output cost2
 
-		parCost6D = std::make_shared<Cost6D::LaunchParameters>(l, k);
-		pCost6D->setLaunchParameters(parCost6D);
-		pCost6D->launch();          // Output dH
+		    parCost6D = std::make_shared<Cost6D::LaunchParameters>(l, k);
+		    pCost6D->setLaunchParameters(parCost6D);
+		    pCost6D->launch();          // Output dH
+		}
 	    }
 	}
 
 	// Projection of gradient
 	pUpdateTransformation->launch();
-	DifData->device2Host();
+	if(!deviceStop)
+	    DifData->device2Host();
 	pInitZero->setOutput(TAuxData); // Initialize TAux
 	pInitZero->launch();
 
@@ -344,15 +366,34 @@ void GroupwiseRegistration::optimizer(std::shared_ptr<Data> TData, ArgumentsMoti
 
 	pCostReduction->setLaunchParameters(std::make_shared<CostReduction::LaunchParameters>(maskData, iter));
 	pCostReduction->launch();
-	HData->device2Host();
-
-	getApp()->getCommandQueue().enqueueReadBuffer(Wnobj, CL_TRUE, 0, sizeof(float), &Wn, NULL, NULL);
-	evolution(Tdif, Hdif, &Wn, Difbuffer, Hbuffer, iter, flagW);
-	getApp()->getCommandQueue().enqueueWriteBuffer(Wnobj, CL_TRUE, 0, sizeof(float), &Wn, NULL, NULL);
 
-	OPTIMIZER_CERR("  -------------------------------------------------------------------------------------------------- " << std::endl);
-	OPTIMIZER_CERR(" |  " << iter << "\t| " << Hbuffer[iter] << "\t" << Wn << "\t" << Tdif[iter - 1] << "\t" << Hdif[iter - 1] << "\t|\n");
-	stop = stopCondition(Tdif[iter - 1], Hdif[iter - 1], p2, p4, getParametersGD().nmax, iter);
+	if(deviceStop) {
+	    parEvolutionStop->iter = iter;
+	    pEvolutionStop->launch();
+
+	    // Read the stop flag back only every stopPollInterval iterations (and always at the last one), so the queue does not drain
+	    // between iterations. Iterations launched after the stop condition is met do not modify T (the kernel sets Wn to 0)
+	    if((iter % stopPollInterval == 0) || (iter == (int) getParametersGD().nmax)) {
+		queue.enqueueReadBuffer(stopObj, CL_TRUE, 0, sizeof(cl_int), &stopFlag, NULL, NULL);
+		stop = (stopFlag != 0);
+		argsMC->stopIter = stopFlag;
+		OPTIMIZER_CERR("  -------------------------------------------------------------------------------------------------- " << std::endl);
+		OPTIMIZER_CERR(" |  " << iter << "\t| stop flag polled on device: " << stopFlag << "\t\t\t\t\t\t|\n");
+	    }
+	}
+	else {
+	    HData->device2Host();
+
+	    queue.enqueueReadBuffer(Wnobj, CL_TRUE, 0, sizeof(float), &Wn, NULL, NULL);
+	    evolution(Tdif, Hdif, &Wn, Difbuffer, Hbuffer, iter, flagW);
+	    queue.enqueueWriteBuffer(Wnobj, CL_TRUE, 0, sizeof(float), &Wn, NULL, NULL);
+
+	    OPTIMIZER_CERR("  -------------------------------------------------------------------------------------------------- " << std::endl);
+	    OPTIMIZER_CERR(" |  " << iter << "\t| " << Hbuffer[iter] << "\t" << Wn << "\t" << Tdif[iter - 1] << "\t" << Hdif[iter - 1] << "\t|\n");
+	    stop = stopCondition(Tdif[iter - 1], Hdif[iter - 1], p2, p4, getParametersGD().nmax, iter);
+	    if(stop)
+		argsMC->stopIter = iter;
+	}
 	iter = iter + 1;
     }
     OPTIMIZER_CERR("  ================================================================================================== " << std::endl);
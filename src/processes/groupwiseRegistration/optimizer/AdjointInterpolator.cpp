@@ -51,10 +51,23 @@
 namespace OpenCLIPER {
 
 void AdjointInterpolator::init() {
+    auto pIP = std::dynamic_pointer_cast<InitParameters>(pInitParameters);
+    if(!pIP) pIP = std::unique_ptr<InitParameters>(new InitParameters());
+
     kernel = getApp()->getKernel("adjointInterpolator");
+    gather = pIP->gather;
+    if(gather) {
+	radiusKernel = getApp()->getKernel("adjointInterpolatorRadius");
+	gatherKernel = getApp()->getKernel("adjointInterpolatorGather");
+	radiusBuffer = cl::Buffer(getApp()->getContext(), CL_MEM_READ_WRITE, sizeof(cl_int));
+
+	// Radius kernel runs as a single work group
+	size_t maxLocalSize = radiusKernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(getApp()->getDevice());
+	radiusLocalSize = cl::NDRange(std::min(maxLocalSize, (size_t) 256));
+    }
 }
 
-void AdjointInterpolator::launch() {
+void AdjointInterpolator::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     checkCommonLaunchParameters();
@@ -94,6 +107,42 @@ void AdjointInterpolator::launch() {
 	const cl::Buffer* originalData = getInput()->getDeviceBuffer();
 	const cl::Buffer* transformedData = getOutput()->getDeviceBuffer();
 
+	if(gather && isIdentityMesh(pLP->xData)) {
+	    // Same row/column ranges as r1margin and r2margin
+	    cl_int firstRow = (pLP->bound_box->at(1) - margin[0] - 1) - 1;
+	    cl_int lastRow = firstRow + longr1margin - 1;
+	    cl_int firstCol = (pLP->bound_box->at(0) - margin[1] - 1) - 1;
+	    cl_int lastCol = firstCol + longr2margin - 1;
+
+	    radiusKernel.setArg(0, radiusBuffer);
+	    radiusKernel.setArg(1, *originalData);
+	    radiusKernel.setArg(2, *(pLP->xnData)->getDeviceBuffer());
+	    radiusKernel.setArg(3, cl::Local(radiusLocalSize[0] * sizeof(cl_float)));
+	    radiusKernel.setArg(4, firstRow);
+	    radiusKernel.setArg(5, lastRow);
+	    radiusKernel.setArg(6, firstCol);
+	    radiusKernel.setArg(7, lastCol);
+	    queue.enqueueNDRangeKernel(radiusKernel, cl::NullRange, radiusLocalSize, radiusLocalSize, NULL, &event);
+	    kernelsExecEventList.push_back(event);
+
+	    gatherKernel.setArg(0, *transformedData);
+	    gatherKernel.setArg(1, *originalData);
+	    gatherKernel.setArg(2, *(pLP->xnData)->getDeviceBuffer());
+	    gatherKernel.setArg(3, radiusBuffer);
+	    gatherKernel.setArg(4, firstRow);
+	    gatherKernel.setArg(5, lastRow);
+	    gatherKernel.setArg(6, firstCol);
+	    gatherKernel.setArg(7, lastCol);
+	    cl::NDRange gatherGlobalWorkSize = cl::NDRange(width, height, numFrames);
+	    queue.enqueueNDRangeKernel(gatherKernel, cl::NullRange, gatherGlobalWorkSize, cl::NullRange, NULL, &event);
+	    kernelsExecEventList.push_back(event);
+
+	    stopProfiling();
+	    if(pProfileParameters->enable)
+		getKernelGroupExecutionTimes(kernelsExecEventList, "OpenCLIPER::AdjointInterpolator::launch kernel", "OpenCLIPER::AdjointInterpolator::launch group of kernels");
+	    return;
+	}
+
 	cl::NDRange globalWorkSize = cl::NDRange(longr1margin, longr2margin, getInput()->getDynDimsTotalSize());
 
 	kernel.setArg(0, *transformedData);
@@ -115,6 +164,43 @@ void AdjointInterpolator::launch() {
     }
 }
 
+/**
+ * @brief Checks whether the original mesh is the identity mesh (the only one supported by the gather implementation)
+ *
+ * The gather kernels take the original position of every bounding box pixel to be the pixel itself, i.e.
+ * x(row, col, 0) = col + 1 and x(row, col, 1) = row + 1 (1-based, as built by GroupwiseRegistration).
+ * The result is cached, so the mesh is only read back from the device when a different mesh is given.
+ * @param[in] xData original mesh
+ * @return true if xData is the identity mesh for the input images, false otherwise
+ */
+bool AdjointInterpolator::isIdentityMesh(const std::shared_ptr<Data>& xData) {
+    if(checkedMesh.lock() == xData)
+	return checkedMeshIsIdentity;
+
+    checkedMesh = xData;
+    checkedMeshIsIdentity = false;
+
+    dimIndexType tam0 = getInput()->getSpatialDimSize(0, 0);
+    dimIndexType tam1 = getInput()->getSpatialDimSize(1, 0);
+    if(xData->getElementDataType() != TYPEID_INDEX || xData->getNDArray(0)->size() < 2 * tam0 * tam1) {
+	ADJOINTINTERPOLATOR_CERR("AdjointInterpolator: unexpected mesh type or size, using scatter implementation" << std::endl);
+	return false;
+    }
+
+    xData->device2Host();
+    const dimIndexType* x = (const dimIndexType*) xData->getHostBuffer(0);
+    for(dimIndexType c = 0; c < tam1; c++) {
+	for(dimIndexType r = 0; r < tam0; r++) {
+	    if(x[r + c * tam0] != c + 1 || x[r + c * tam0 + tam0 * tam1] != r + 1) {
+		ADJOINTINTERPOLATOR_CERR("AdjointInterpolator: mesh is not the identity mesh, using scatter implementation" << std::endl);
+		return false;
+	    }
+	}
+    }
+    checkedMeshIsIdentity = true;
+    return true;
+}
+
 }
 
 #undef ADJOINTINTERPOLATOR_DEBUG
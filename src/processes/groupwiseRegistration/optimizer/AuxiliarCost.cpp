@@ -54,7 +54,7 @@ void AuxiliarCost::init() {
     kernel = getApp()->getKernel("auxiliarCost");
 }
 
-void AuxiliarCost::launch() {
+void AuxiliarCost::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
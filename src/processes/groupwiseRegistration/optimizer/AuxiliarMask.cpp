@@ -54,7 +54,7 @@ void AuxiliarMask::init() {
     kernel = getApp()->getKernel("auxiliarMask");
 }
 
-void AuxiliarMask::launch() {
+void AuxiliarMask::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void Cost6D::init() {
     kernel = getApp()->getKernel("cost6D");
 }
 
-void Cost6D::launch() {
+void Cost6D::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -72,7 +72,7 @@ void Deformation::init() {
     r2Data = std::make_shared<XData>(getApp(), r2NDArray, TYPEID_INDEX);
 }
 
-void Deformation::launch() {
+void Deformation::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
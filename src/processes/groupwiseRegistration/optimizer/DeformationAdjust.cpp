@@ -54,7 +54,7 @@ void DeformationAdjust::init() {
     kernel = getApp()->getKernel("transformationAdjust");
 }
 
-void DeformationAdjust::launch() {
+void DeformationAdjust::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -0,0 +1,97 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/EvolutionStop.hpp>
+
+#include <algorithm>
+
+// Uncomment to show class-specific debug messages
+//#define EVOLUTIONSTOP_DEBUG
+
+#if !defined NDEBUG && defined EVOLUTIONSTOP_DEBUG
+    #define EVOLUTIONSTOP_CERR(x) CERR(x)
+#else
+    #define EVOLUTIONSTOP_CERR(x)
+    #undef EVOLUTIONSTOP_DEBUG
+#endif
+
+// Upper bound for the single work group used by the evolutionStop kernel (the displacement array is small)
+#define EVOLUTIONSTOP_MAXLOCALSIZE 256
+
+namespace OpenCLIPER {
+
+void EvolutionStop::init() {
+    kernel = getApp()->getKernel("evolutionStop");
+
+    size_t maxLocalSize = kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(getApp()->getDevice());
+    localSize = cl::NDRange(std::min(maxLocalSize, (size_t) EVOLUTIONSTOP_MAXLOCALSIZE));
+}
+
+void EvolutionStop::doLaunch() {
+    auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
+
+    startProfiling();
+    try {
+	std::vector<cl::Event> kernelsExecEventList;
+	cl::Event event;
+
+	const cl::Buffer* HData = getInput()->getDeviceBuffer();
+	const cl::Buffer* TdifHdifData = getOutput()->getDeviceBuffer();
+	const cl::Buffer* DifData = (pLP->DifData)->getDeviceBuffer();
+
+	kernel.setArg(0, *HData);
+	kernel.setArg(1, *DifData);
+	kernel.setArg(2, pLP->Wnobj);
+	kernel.setArg(3, *TdifHdifData);
+	kernel.setArg(4, pLP->stopObj);
+	kernel.setArg(5, cl::Local(sizeof(cl_float) * localSize[0]));
+	kernel.setArg(6, (cl_uint) (pLP->DifData)->getNDArrayTotalSize(0));
+	kernel.setArg(7, pLP->iter);
+	kernel.setArg(8, pLP->p2);
+	kernel.setArg(9, pLP->eh);
+	kernel.setArg(10, pLP->nmax);
+	kernel.setArg(11, pLP->flagW);
+
+	queue.enqueueNDRangeKernel(kernel, cl::NullRange, localSize, localSize, NULL, &event);
+	kernelsExecEventList.push_back(event);
+	stopProfiling();
+	if(pProfileParameters->enable)
+	    getKernelGroupExecutionTimes(kernelsExecEventList, "OpenCLIPER::EvolutionStop::launch kernel", "OpenCLIPER::EvolutionStop::launch group of kernels");
+
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "EvolutionStop::launch");
+    }
+}
+}
+
+#undef EVOLUTIONSTOP_DEBUG
@@ -54,7 +54,7 @@ void Gradient::init() {
     kernel = getApp()->getKernel("gradient");
 }
 
-void Gradient::launch() {
+void Gradient::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
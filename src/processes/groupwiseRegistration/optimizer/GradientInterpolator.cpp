@@ -73,7 +73,7 @@ void GradientInterpolator::init() {
     
 }
 
-void GradientInterpolator::launch() {
+void GradientInterpolator::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void GradientJointAux::init() {
     kernel = getApp()->getKernel("gradientJointAux");
 }
 
-void GradientJointAux::launch() {
+void GradientJointAux::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void GradientMetric::init() {
     kernel = getApp()->getKernel("gradientMetric");
 }
 
-void GradientMetric::launch() {
+void GradientMetric::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void GradientRegularization::init() {
     kernel = getApp()->getKernel("gradientRegularization");
 }
 
-void GradientRegularization::launch() {
+void GradientRegularization::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void GradientWithSmoothTerms::init() {
     kernel = getApp()->getKernel("gradientJoint");
 }
 
-void GradientWithSmoothTerms::launch() {
+void GradientWithSmoothTerms::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
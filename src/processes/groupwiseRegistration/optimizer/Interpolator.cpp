@@ -54,7 +54,7 @@ void Interpolator::init() {
     kernel = getApp()->getKernel("interpolator");
 }
 
-void Interpolator::launch() {
+void Interpolator::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     checkCommonLaunchParameters();
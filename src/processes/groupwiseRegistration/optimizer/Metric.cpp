@@ -54,7 +54,7 @@ void Metric::init() {
     kernel = getApp()->getKernel("metric");
 }
 
-void Metric::launch() {
+void Metric::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
@@ -54,7 +54,7 @@ void PermuteTAux::init() {
     kernel = getApp()->getKernel("permuteTAux");
 }
 
-void PermuteTAux::launch() {
+void PermuteTAux::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
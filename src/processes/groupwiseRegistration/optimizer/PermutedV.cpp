@@ -54,7 +54,7 @@ void PermutedV::init() {
     kernel = getApp()->getKernel("permutedV");
 }
 
-void PermutedV::launch() {
+void PermutedV::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
@@ -0,0 +1,103 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/ProjectedGradientCost.hpp>
+
+#include <algorithm>
+
+// Uncomment to show class-specific debug messages
+//#define PROJECTEDGRADIENTCOST_DEBUG
+
+#if !defined NDEBUG && defined PROJECTEDGRADIENTCOST_DEBUG
+    #define PROJECTEDGRADIENTCOST_CERR(x) CERR(x)
+#else
+    #define PROJECTEDGRADIENTCOST_CERR(x)
+    #undef PROJECTEDGRADIENTCOST_DEBUG
+#endif
+
+// Upper bound for work group size: every work group reduces the neighbourhood of a single control point, which is small
+#define PROJECTEDGRADIENTCOST_MAXLOCALSIZE 128
+
+namespace OpenCLIPER {
+
+void ProjectedGradientCost::init() {
+    kernel = getApp()->getKernel("projectedGradientCost");
+}
+
+void ProjectedGradientCost::doLaunch() {
+    auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
+
+    startProfiling();
+    try {
+	std::vector<cl::Event> kernelsExecEventList;
+	cl::Event event;
+
+	const cl::Buffer* dVpermutedData = getInput()->getDeviceBuffer(1);
+	const cl::Buffer* dHData = getOutput()->getDeviceBuffer();
+
+	// dV dimensions: (dp1, dp0, frames, Cp1, Cp0, nt)
+	const std::vector<cl_uint> dataSize = *(getInput()->getNDArray(0)->getDims());
+	cl_uint neighbourhoodSize = dataSize[0] * dataSize[1];
+
+	size_t maxLocalSize = kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(getApp()->getDevice());
+	size_t localSize = std::min(std::min(maxLocalSize, (size_t) PROJECTEDGRADIENTCOST_MAXLOCALSIZE), (size_t) neighbourhoodSize);
+
+	// One work group per control point (k,l) in dimension 0
+	cl::NDRange globalWorkSize = cl::NDRange(localSize * dataSize[3] * dataSize[4], dataSize[2], dataSize[5]);
+	cl::NDRange localWorkSize = cl::NDRange(localSize, 1, 1);
+
+	kernel.setArg(0, *dHData);
+	kernel.setArg(1, *dVpermutedData);
+	kernel.setArg(2, *(pLP->maskData)->getDeviceBuffer());
+	kernel.setArg(3, *(pLP->coefg)->getDeviceBuffer());
+	kernel.setArg(4, cl::Local(sizeof(cl_float) * localSize));
+	kernel.setArg(5, dataSize[0]);
+	kernel.setArg(6, dataSize[1]);
+	kernel.setArg(7, dataSize[3]);
+	kernel.setArg(8, dataSize[4]);
+	kernel.setArg(9, (pLP->coefg)->getSpatialDimSize(0,0));
+	kernel.setArg(10, (pLP->coefg)->getSpatialDimSize(1,0));
+
+	queue.enqueueNDRangeKernel(kernel, cl::NullRange, globalWorkSize, localWorkSize, NULL, &event);
+	kernelsExecEventList.push_back(event);
+	stopProfiling();
+	if(pProfileParameters->enable)
+	    getKernelGroupExecutionTimes(kernelsExecEventList, "OpenCLIPER::ProjectedGradientCost::launch kernel", "OpenCLIPER::ProjectedGradientCost::launch group of kernels");
+
+    }
+    catch(cl::Error& err) {
+	BTTHROW(CLError(err), "ProjectedGradientCost::launch");
+    }
+}
+}
+
+#undef PROJECTEDGRADIENTCOST_DEBUG
@@ -72,7 +72,7 @@ void Regularization::init() {
     r2Data = std::make_shared<XData>(getApp(), r2NDArray, TYPEID_INDEX);
 }
 
-void Regularization::launch() {
+void Regularization::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
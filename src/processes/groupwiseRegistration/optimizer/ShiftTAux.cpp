@@ -54,7 +54,7 @@ void ShiftTAux::init() {
     kernel = getApp()->getKernel("shiftTAux");
 }
 
-void ShiftTAux::launch() {
+void ShiftTAux::doLaunch() {
     startProfiling();
     try {
 	std::vector<cl::Event> kernelsExecEventList;
@@ -73,7 +73,7 @@ void SumLambdaMetric::init() {
 
 }
 
-void SumLambdaMetric::launch() {
+void SumLambdaMetric::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -74,7 +74,7 @@ void TransformationAux::init() {
 
 }
 
-void TransformationAux::launch() {
+void TransformationAux::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
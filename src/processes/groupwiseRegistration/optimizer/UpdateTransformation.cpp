@@ -54,7 +54,7 @@ void UpdateTransformation::init() {
     kernel = getApp()->getKernel("updateTransformation");
 }
 
-void UpdateTransformation::launch() {
+void UpdateTransformation::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
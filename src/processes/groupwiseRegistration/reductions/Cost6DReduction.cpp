@@ -54,7 +54,7 @@ void Cost6DReduction::init() {
     kernel = getApp()->getKernel("cost6DReduction");
 }
 
-void Cost6DReduction::launch() {
+void Cost6DReduction::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
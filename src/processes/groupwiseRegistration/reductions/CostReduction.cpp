@@ -37,6 +37,7 @@
  *      Author: Elena Martin Gonzalez
  */
 #include <OpenCLIPER/processes/groupwiseRegistration/reductions/CostReduction.hpp>
+#include <OpenCLIPER/XData.hpp>
 
 // Uncomment to show class-specific debug messages
 //#define COSTREDUCTION_DEBUG
@@ -51,10 +52,33 @@
 namespace OpenCLIPER {
 
 void CostReduction::init() {
+    if(!getInput())
+	BTTHROW(CLError(CL_INVALID_MEM_OBJECT, "init() called before setInputData()"), "CostReduction::init");
+
     kernel = getApp()->getKernel("costReduction");
+
+    realGlobalSize = getInput()->getNDArrayTotalSize(0);
+    localSize = CLapp::calcLocalSize(kernel, getApp()->getDevice(), realGlobalSize);
+    nWorkgroups = (realGlobalSize - 1) / localSize[0] + 1;
+    globalSize = cl::NDRange(localSize[0] * nWorkgroups); // globalSize must be multiple of localSize in OpenCL<2.0
+
+    // Partial sums of the first pass are reduced by SumReduce, and the result is then copied to the current iteration's cost
+    if(nWorkgroups >= 2) {
+	partialOutputs = std::make_shared<XData> (getApp(), nWorkgroups, TYPEID_REAL);
+	pTotalCost = std::make_shared<XData> (getApp(), 1, TYPEID_REAL);
+	if(!pSumReduce) {
+	    pSumReduce = Process::create<SumReduce>(getApp());
+	    pSumReduce->setCommandQueue(queue);
+	}
+	pSumReduce->setInput(partialOutputs);
+	pSumReduce->setOutput(pTotalCost);
+	pSumReduce->init();
+    }
+
+    COSTREDUCTION_CERR("CostReduction: " << realGlobalSize << " elements, " << nWorkgroups << " workgroups of " << localSize[0] << " work items\n");
 }
 
-void CostReduction::launch() {
+void CostReduction::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -62,19 +86,36 @@ void CostReduction::launch() {
 	std::vector<cl::Event> kernelsExecEventList;
 	cl::Event event;
 
-	const cl::Buffer* VData = getInput()->getDeviceBuffer();
-	const cl::Buffer* HData = getOutput()->getDeviceBuffer();
-
-	const std::vector<cl_uint> dataSize = *(getInput()->getNDArray(0)->getDims());
-	cl::NDRange globalWorkSize = cl::NDRange(dataSize[0] * dataSize[1]);
+	cl::Buffer* VData = getInput()->getDeviceBuffer();
+	cl::Buffer* HData = getOutput()->getDeviceBuffer();
 
-	kernel.setArg(0, *HData);
+	// First pass: multiply by mask and reduce the whole metric array to <nWorkgroups> elements
+	// ---------------------------------------------------------------------------------------
 	kernel.setArg(1, *VData);
 	kernel.setArg(2, *(pLP->maskData)->getDeviceBuffer());
-	kernel.setArg(3, pLP->iter);
+	kernel.setArg(3, cl::Local(sizeof(cl_float) * localSize[0]));
+	kernel.setArg(4, realGlobalSize);
 
-	queue.enqueueNDRangeKernel(kernel, cl::NullRange, globalWorkSize, cl::NullRange, NULL, &event);
+	if(nWorkgroups >= 2) {
+	    kernel.setArg(0, *partialOutputs->getDeviceBuffer());	// if more than one pass is needed, set output to a temporary scratch buffer
+	    kernel.setArg(5, (index1DType) 0);
+	}
+	else {
+	    kernel.setArg(0, *HData);			// if only one pass is needed, write the total cost for this iteration
+	    kernel.setArg(5, (index1DType) pLP->iter);
+	}
+
+	queue.enqueueNDRangeKernel(kernel, cl::NullRange, globalSize, localSize, NULL, &event);
 	kernelsExecEventList.push_back(event);
+
+	// Successive passes: SumReduce reduces the partial sums, which are then stored as the total cost for this iteration
+	// ----------------------------------------------------------------------------------------------------------------
+	if(nWorkgroups >= 2) {
+	    pSumReduce->launch();
+	    queue.enqueueCopyBuffer(*pTotalCost->getDeviceBuffer(), *HData, 0, pLP->iter * sizeof(cl_float), sizeof(cl_float), NULL, &event);
+	    kernelsExecEventList.push_back(event);
+	}
+
 	stopProfiling();
 	if(pProfileParameters->enable)
 	    getKernelGroupExecutionTimes(kernelsExecEventList, "OpenCLIPER::CostReduction::launch kernel", "OpenCLIPER::CostReduction::launch group of kernels");
@@ -84,6 +125,16 @@ void CostReduction::launch() {
     	BTTHROW(CLError(err), "CostReduction::launch");
     }
 }
+
+/**
+ * @brief Binds this process and its SumReduce subprocess to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void CostReduction::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    if(pSumReduce)
+	pSumReduce->setCommandQueue(cq);
+}
 }
 
 #undef COSTREDUCTION_DEBUG
@@ -54,7 +54,7 @@ void Reduction7Dto6D::init() {
     kernel = getApp()->getKernel("reduction7Dto6D");
 }
 
-void Reduction7Dto6D::launch() {
+void Reduction7Dto6D::doLaunch() {
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
     startProfiling();
@@ -54,7 +54,7 @@ void ReductionSum::init() {
     kernel = getApp()->getKernel("reductionsum");
 }
 
-void ReductionSum::launch() {
+void ReductionSum::doLaunch() {
 
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
@@ -67,8 +67,8 @@ NestaUp::NestaUp(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<Pro
 	pMotionCompensation = Process::create<MotionCompensation>(pCLapp, pProfileParameters);
 	pAdjointMotionCompensation = Process::create<AdjointMotionCompensation>(pCLapp, pProfileParameters);
 	pCopy = Process::create<CopyDataGPU>(pCLapp, pProfileParameters);
-	pComplexAbsPow2 = Process::create<ComplexAbsPow2>(pCLapp);
-	pComplexAbs = Process::create<ComplexAbs>(pCLapp);
+	pNestaUpdate = Process::create<NestaUpdate>(pCLapp, pProfileParameters);
+	pMaxReduce = Process::create<MinMaxReduce>(pCLapp);
 
 }
 
@@ -83,8 +83,10 @@ void NestaUp::init() {
 	pAuxFFT = std::make_shared<KData>(getApp(), std::dynamic_pointer_cast<KData>(getInput()), false, false);
 
 	// Initialize subprocesses
+	// Unitary FFT: A and At carry the 1/sqrt(N) and sqrt(N) scalings NESTA needs, so no extra scaling passes are required
 	pFFTOutOfPlace->setInput(getInput());
 	pFFTOutOfPlace->setOutput(pAuxFFT);
+	pFFTOutOfPlace->setInitParameters(std::make_shared<FFT::InitParameters>(-1, nullptr, false, FFT::NORMALIZE_UNITARY));
 	pFFTOutOfPlace->init();
 
 	pDataAndSensitivityMapsProduct->init();
@@ -101,8 +103,14 @@ void NestaUp::init() {
 	pTemporalTVt->setInitParameters(std::make_shared<TemporalTV::InitParameters>(TemporalTV::ADJOINT));
 	pTemporalTVt->init();
     
-	pComplexAbsPow2->init();
-	pComplexAbs->init();
+	pNestaUpdate->init();
+
+	// Maximum magnitude of an image, kept on the device
+	pMaxData = std::make_shared<XData>(getApp(), 1, TYPEID_REAL);
+	pMaxReduce->setInput(getOutput());
+	pMaxReduce->setOutput(pMaxData);
+	pMaxReduce->setInitParameters(std::make_shared<MinMaxReduce::InitParameters>(MinMaxReduce::MAX));
+	pMaxReduce->init();
 }
 
 
@@ -300,7 +308,7 @@ float NestaUp::myNormest(uint rows, uint cols, uint slices, uint NumFrames,  Arg
 
 	cl_int status;
 	cl_command_queue queue;
-	queue = (getApp()->getCommandQueue(0))();
+	queue = (this->queue)();
 	cl_event event;
 
 	float* norm = new float[1]();
@@ -439,7 +447,7 @@ float NestaUp::myNormest(uint rows, uint cols, uint slices, uint NumFrames,  Arg
 }
 
 
-void NestaUp::launch() {
+void NestaUp::doLaunch() {
 	auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
 	infoItems.addInfoItem("Title", "NestaUp info");
@@ -447,7 +455,6 @@ void NestaUp::launch() {
 
 	std::shared_ptr<SensitivityMapsData> sensitivityMapsData = std::dynamic_pointer_cast<KData>(getInput())->getSensitivityMapsData();
 	std::shared_ptr<SamplingMasksData> samplingMasksData = std::dynamic_pointer_cast<KData>(getInput())->getSamplingMasksData();
-	std::shared_ptr<Data> pInputKData = std::make_shared<KData>(getApp(), std::dynamic_pointer_cast<KData>(getInput()), false, true);
 
 	uint cols = NDARRAYWIDTH(getInput()->getNDArray(0));
 	uint rows = NDARRAYHEIGHT(getInput()->getNDArray(0));
@@ -455,34 +462,17 @@ void NestaUp::launch() {
 	if(slices==0)
 		slices = 1;
 	uint numFrames = getInput()->getDynDimsTotalSize();
-	uint numCoils = (std::dynamic_pointer_cast<KData>(getInput()))->getNCoils();
     
-	cl_command_queue queue = (getApp()->getCommandQueue(0))();
-	cl_event calcEvents[3];
+	cl_command_queue queue = (this->queue)();
+	cl_event calcEvents[2];
 	cl_event readEvents[3];
 	cl_int status;
     
-	//Copies complex-float elements from inputBuffer to pOriginalInputKDataBuffer.
-	cl_mem inputBuffer;
-	cl_mem pOriginalInputKDataBuffer;
-	inputBuffer = (*(getInput()->getDeviceBuffer()))();
-	pOriginalInputKDataBuffer = (*(pInputKData->getDeviceBuffer()))();
-	status = CLBlastCcopy(rows * cols * slices * numFrames * numCoils, inputBuffer, 0, 1, pOriginalInputKDataBuffer, 0, 1, &queue, NULL);
-	if(status != CL_SUCCESS)
-	    BTTHROW(CLError(status),"NestaUp: CLBlastCcopy() failed");
-
-	
 	cl_float2 f;
-	f.x = sqrt(float(cols*rows*slices));
-	f.y = 0.0f;
-    
-	status = CLBlastCscal(rows * cols * slices * numFrames * numCoils, f, pOriginalInputKDataBuffer, 0, 1, &queue, NULL);
-	if(status != CL_SUCCESS)
-	    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
 
 	// Soluci�n del adjunto para inicializar Nesta en la primera reconstrucci�n (sin MC)
 	if(pLP->argsMC == nullptr) {
-		operatorAt(pInputKData, sensitivityMapsData, getOutput(), pAuxFFT);
+		operatorAt(getInput(), sensitivityMapsData, getOutput(), pAuxFFT);
 	}
 
 	std::shared_ptr<Data> pAuxMC = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
@@ -493,78 +483,37 @@ void NestaUp::launch() {
 	std::shared_ptr<Data> pWkXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), true); // Cambiado a true, mejora funcionamiento, pero revisar si es necesario
 	std::shared_ptr<Data> pXkXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 	std::shared_ptr<Data> pYkXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
-	std::shared_ptr<Data> pZkXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 	std::shared_ptr<Data> pUkXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 	std::shared_ptr<Data> pAuxFxXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 	std::shared_ptr<Data> pDfXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 	std::shared_ptr<Data> pResKData = std::make_shared<KData>(getApp(), std::dynamic_pointer_cast<KData>(getInput()), false, true);
 	std::shared_ptr<Data> pAuxResKData = std::make_shared<KData>(getApp(), std::dynamic_pointer_cast<KData>(getInput()), false, true);
 	std::shared_ptr<Data> pAResXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
-	std::shared_ptr<Data> pOutputAbsXData = std::make_shared<XData>(getApp(), std::dynamic_pointer_cast<XData>(getOutput()), false);
 
 	cl_mem fxObj = clCreateBuffer((getApp()->getContext())(), CL_MEM_READ_WRITE, sizeof(cl_float2), NULL, NULL);
 	cl_mem normResObj = clCreateBuffer((getApp()->getContext())(), CL_MEM_READ_WRITE, sizeof(cl_float2), NULL, NULL);
 	cl_mem normUkObj = clCreateBuffer((getApp()->getContext())(), CL_MEM_READ_WRITE, sizeof(cl_float2), NULL, NULL);
-	cl_mem l2normObj = clCreateBuffer((getApp()->getContext())(), CL_MEM_READ_WRITE, sizeof(cl_float2), NULL, NULL);
+	cl::Buffer l2normBuffer(getApp()->getContext(), CL_MEM_READ_WRITE, sizeof(cl_float));
 
 	cl_mem pXrefBuffer;
 	cl_mem pXkBuffer;
 	cl_mem pYkBuffer;
-	cl_mem pZkBuffer;
 	cl_mem pAuxFxBuffer;
 	cl_mem pUkBuffer;
-	cl_mem pResBuffer;
-	cl_mem pDfBuffer;
-	cl_mem pAResBuffer;
 	cl_mem pWkBuffer;
 
-	// Image maximum calculation (host operation)
-
-	getOutput()->device2Host();
-	pComplexAbs->setInput(getOutput());
-	pComplexAbs->setOutput(pOutputAbsXData);
-	pComplexAbs->launch();
-
-	pOutputAbsXData->device2Host();
-	float maxXref = LONG_MIN;
-	dimIndexType width, height, depth;
-	for(uint i = 0; i < pOutputAbsXData->getNumNDArrays(); i++) {
-		width = NDARRAYWIDTH(pOutputAbsXData->getData()->at(i));
-		height = NDARRAYHEIGHT(pOutputAbsXData->getData()->at(i));
-		depth = NDARRAYDEPTH(pOutputAbsXData->getData()->at(i));
-		if(depth == 0)
-			depth = 1;
-		complexType* pComplexArray = (complexType*) pOutputAbsXData->getHostBuffer(i);
-		for(dimIndexType index1D = 0;  index1D < height * width * depth; index1D++) {
-			float pixelSearch = pComplexArray[index1D].real();
-			if(pixelSearch > maxXref)
-				maxXref = pixelSearch;
-		}
-	}
+	// Image maximum calculation (only the result is read back)
+	realType maxValue;
+	pMaxReduce->setInput(getOutput());
+	pMaxReduce->launch();
+	this->queue.enqueueReadBuffer(*pMaxData->getDeviceBuffer(), CL_TRUE, 0, sizeof(realType), &maxValue);
+	float maxXref = maxValue;
+
+	pMaxReduce->setInput(pUx_RefImage);
+	pMaxReduce->launch();
+	this->queue.enqueueReadBuffer(*pMaxData->getDeviceBuffer(), CL_TRUE, 0, sizeof(realType), &maxValue);
+	float maxUXref = maxValue;
 
-	pOutputAbsXData = NULL;
-
-	// Image maximum calculation (host operation)
-	pUx_RefImage->device2Host();
-	pComplexAbs->setInput(pUx_RefImage);
-	pComplexAbs->setOutput(pUx_RefImage);
-	pComplexAbs->launch();
-
-	pUx_RefImage->device2Host();
-	float maxUXref = LONG_MIN;
-	for(uint i = 0; i < pUx_RefImage->getNumNDArrays(); i++) {
-		width = NDARRAYWIDTH(pUx_RefImage->getData()->at(i));
-		height = NDARRAYHEIGHT(pUx_RefImage->getData()->at(i));
-		depth = NDARRAYDEPTH(pUx_RefImage->getData()->at(i));
-		if(depth == 0)
-			depth = 1;
-		complexType* pComplexArray = (complexType*) pUx_RefImage->getHostBuffer(i);
-		for(dimIndexType index1D = 0;  index1D < height * width * depth; index1D++) {
-			float pixelSearch = pComplexArray[index1D].real();
-			if(pixelSearch > maxUXref)
-				maxUXref = pixelSearch;
-		}
-	}
 	pUx_RefImage = NULL;
 
 	//Initizalize variables
@@ -634,12 +583,6 @@ void NestaUp::launch() {
 		if(status != CL_SUCCESS)
 		    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
 
-		//Scales a complex-float pZkBuffer by a complex-fliat constant (initialize to zero).
-		pZkBuffer = (*(pZkXData->getDeviceBuffer()))();
-		status = CLBlastCscal(rows * cols * slices * numFrames, f, pZkBuffer, 0, 1, &queue, NULL);
-		if(status != CL_SUCCESS)
-		    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
-
 		Ak = 0.0f;
 		Lmu = normU / mu;
 		fmean[miniter-1] = LONG_MAX;
@@ -695,103 +638,35 @@ void NestaUp::launch() {
 			//Apply sparse operator (adjoint)
 			operatorUt(pUkXData, pDfXData, pAuxMC, pLP->argsMC);
 
-			f.x = -1.0f;
-			f.y = 0.0f;
-
-			pDfBuffer = (*(pDfXData->getDeviceBuffer()))();
-			status = CLBlastCscal(rows * cols * slices * numFrames, f, pDfBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
-
-
 			////----END PERFORM L1 CONSTRAINT----////
 
 			//Apply encoding operator
 			operatorA(pXkXData, sensitivityMapsData, samplingMasksData, pResKData, pAuxFFT);
 
-			f.x = 1/(sqrt(cols*rows*slices));
-			f.y = 0.0f;
-
-			pResBuffer = (*(pResKData->getDeviceBuffer()))();
-			status = CLBlastCscal(rows * cols * slices * numFrames * numCoils, f, pResBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
-
-			f.x = -1.0f;
-			f.y = 0.0f;
-
-			//Scale vector pInitialKImageBuffer of complex-float elements and add to pResBuffer.
-			cl_mem pInputBuffer = (*(getInput()->getDeviceBuffer()))();
-			status = CLBlastCaxpy(rows * cols * slices * numFrames * numCoils,  f, pInputBuffer, 0, 1, pResBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
-
-			//Copies complex-float elements from pResBuffer to pAuxResBuffer.
-			pResBuffer = (*(pResKData->getDeviceBuffer()))();
-			cl_mem pAuxResBuffer = (*(pAuxResKData->getDeviceBuffer()))();
-			status = CLBlastCcopy(rows * cols * slices * numFrames * numCoils, pResBuffer, 0, 1, pAuxResBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCcopy() failed");
-
-
-			//computes the euclidean norm of pResBuffer containing float-complex elements
-			pComplexAbsPow2->setInput(pResKData);
-			pComplexAbsPow2->setOutput(pResKData);
-			pComplexAbsPow2->launch();
-
-			//computes the absolute value of all elements in the pResBuffer
-			pResBuffer = (*(pResKData->getDeviceBuffer()))();
-			status = CLBlastScsum(rows * cols * slices * numFrames * numCoils, l2normObj, 0, pResBuffer, 0, 1, &queue, &(calcEvents[2]));
-			if(status!=CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCcsum() failed");
-
-
-			f.x = sqrt(float(cols*rows*slices));
-			f.y = 0.0f;
-			status = CLBlastCscal(rows * cols * slices * numFrames * numCoils, f, pAuxResBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-    		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
+			//Residual (A(xk) - input) in one pass: its squared norm goes to l2normBuffer and the residual to pAuxResKData
+			pNestaUpdate->setInput(pResKData);
+			pNestaUpdate->setOutput(pAuxResKData);
+			pNestaUpdate->setLaunchParameters(std::make_shared<NestaUpdate::ResidualParameters>(getInput(), 1.0f, 1.0f, l2normBuffer));
+			pNestaUpdate->launch();
 
 			//Apply encoding operator (adjoint)
 			operatorAt(pAuxResKData, sensitivityMapsData, pAResXData, pAuxFFT);
 
-			//Scales a complex-float pDfBuffer by a complex-float constant.
-			f.x = lambda;
-			f.y = 0;
-			pDfBuffer = (*(pDfXData->getDeviceBuffer()))();
-			status = CLBlastCscal(rows * cols * slices * numFrames, f, pDfBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCsscal() failed");
-
-			//Scale vector pAResBuffer of complex-float elements and add to pDfBuffer.
-			f.x = 1.0f;
-			f.y = 0;
-			pAResBuffer = (*(pAResXData->getDeviceBuffer()))();
-			status = CLBlastCaxpy(rows * cols * slices * numFrames, f, pAResBuffer, 0, 1, pDfBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
-		    
 			//--- Updating yk ---//
 
-			//Copies complex-float elements from pXkBuffer to pYkBuffer.
-			status = CLBlastCcopy(rows * cols * slices * numFrames, pXkBuffer, 0, 1, pYkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCcopy() failed");
-
-			//Scale vector pDfBuffer of complex-float elements and add to pYkBuffer.
-			f.x = -Lmu1;
-			f.y = 0;
-			status = CLBlastCaxpy(rows * cols * slices * numFrames, f, pDfBuffer, 0, 1, pYkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
+			//pDfXData holds Ut(uk) here: df = -lambda * Ut(uk) + A'(res), yk = xk - df/Lmu in one pass
+			pNestaUpdate->setInput(pDfXData);
+			pNestaUpdate->setOutput(pYkXData);
+			pNestaUpdate->setLaunchParameters(std::make_shared<NestaUpdate::YkParameters>(pAResXData, pXkXData, -lambda, Lmu1));
+			pNestaUpdate->launch();
 
 			//-------------------------//
 			//---Stopping criterion ---//
 
-			clWaitForEvents(3, calcEvents);
+			clWaitForEvents(2, calcEvents);
 			status = clEnqueueReadBuffer(queue, normUkObj, CL_FALSE, 0, sizeof(cl_float), normUk, 0, NULL, &(readEvents[0]));
 			status = clEnqueueReadBuffer(queue, fxObj, CL_FALSE, 0, sizeof(cl_float), fx, 0, NULL, &(readEvents[1]));
-			status = clEnqueueReadBuffer(queue, l2normObj, CL_FALSE, 0, sizeof(cl_float), l2term, 0, NULL, &(readEvents[2]));
+			status = clEnqueueReadBuffer(queue, l2normBuffer(), CL_FALSE, 0, sizeof(cl_float), l2term, 0, NULL, &(readEvents[2]));
 			clWaitForEvents(3, readEvents);
 
 			l1term[0] = fx[0] - (mu / 2.0f) * pow(normUk[0], 2);
@@ -830,49 +705,11 @@ void NestaUp::launch() {
 			Ak = Ak + apk;
 			tauk = 2.0f / (k + 3.0f);
 
-			f.x = apk;
-			f.y = 0;
-
-			//Scale vector pDfBuffer of complex-float elements and add to pWkBuffer.
-			status = CLBlastCaxpy(rows * cols * slices * numFrames, f, pDfBuffer, 0, 1, pWkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
-
-			//Copies complex-float elements from pXrefBuffer to pZkBuffer.
-			pXrefBuffer = (*(getOutput()->getDeviceBuffer()))();
-			status = CLBlastCcopy(rows * cols * slices * numFrames, pXrefBuffer, 0, 1, pZkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCcopy() failed");
-
-			//Scale vector pWkBuffer of complex-float elements and add to pZkBuffer.
-			f.x = -Lmu1;
-			f.y = 0;
-			status = CLBlastCaxpy(rows * cols * slices * numFrames, f, pWkBuffer, 0, 1, pZkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
-
-			//-------------------//
-			//--- Updating xk ---//
-
-			//Copies complex-float elements from pZkBuffer to pXkBuffer.
-			status = CLBlastCcopy(rows * cols * slices * numFrames, pZkBuffer, 0, 1, pXkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCcopy() failed");
-
-			//Scales a complex-float pXkBuffer by a complex-float constant.
-			f.x = tauk;
-			f.y = 0;
-			status = CLBlastCscal(rows * cols * slices * numFrames, f, pXkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCscal() failed");
-
-			f.x = (1.0f - tauk);
-			f.y = 0;
-
-			//Scale vector pYkBuffer of complex-float elements and add to pXkBuffer.
-			status = CLBlastCaxpy(rows * cols * slices * numFrames, f, pYkBuffer, 0, 1, pXkBuffer, 0, 1, &queue, NULL);
-			if(status != CL_SUCCESS)
-		    	    BTTHROW(CLError(status),"NestaUp: CLBlastCaxpy() failed");
+			//wk += apk * df, zk = xref - wk/Lmu, xk = tauk * zk + (1 - tauk) * yk in one pass
+			pNestaUpdate->setInput(pDfXData);
+			pNestaUpdate->setOutput(pXkXData);
+			pNestaUpdate->setLaunchParameters(std::make_shared<NestaUpdate::ZkParameters>(pWkXData, getOutput(), pYkXData, apk, Lmu1, tauk));
+			pNestaUpdate->launch();
 
 			if((k + 1) % (pLP->verbose) == 0) {
 				NESTAUP_CERR("Iter: " << (k + 1) << " ~ fmu: " << fx[0] << " ~ Rel. Variation of fmu: " << qp << std::endl);
@@ -908,5 +745,18 @@ void NestaUp::launch() {
 	stopProfiling();
 
 }
+
+/**
+ * @brief Binds this process and all of its subprocesses to a command queue
+ * @param[in] cq command queue (must belong to the CLapp's context)
+ */
+void NestaUp::setCommandQueue(const cl::CommandQueue& cq) {
+    Process::setCommandQueue(cq);
+    for(auto& p: {pFFTOutOfPlace, pDataAndSensitivityMapsProduct, pDataAndSamplingMasksProduct, pXImagesAllCoilSameFrameAddition,
+		   pTemporalTV, pTemporalTVt, pVectorNormalization, pMotionCompensation, pAdjointMotionCompensation, pCopy,
+		   pNestaUpdate, pMaxReduce})
+	p->setCommandQueue(cq);
+}
+
 }
 #undef NESTAUP_DEBUG
@@ -0,0 +1,139 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodríguez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Martín González,
+ *                    Elisa Moya Sáez,
+ *                    Marcos Martín Fernández and
+ *                    Carlos Alberola López
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicación
+ *  Universidad de Valladolid
+ *  Paseo de Belén 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+
+#include <OpenCLIPER/processes/nesta/NestaUpdate.hpp>
+#include <OpenCLIPER/CLapp.hpp>
+
+// Uncomment to show class-specific debug messages
+//#define NESTAUPDATE_DEBUG
+
+#if !defined NDEBUG && defined NESTAUPDATE_DEBUG
+    #define NESTAUPDATE_CERR(x) CERR(x)
+#else
+    #define NESTAUPDATE_CERR(x)
+    #undef NESTAUPDATE_DEBUG
+#endif
+
+namespace OpenCLIPER {
+
+void NestaUpdate::init() {
+	residualKernel = getApp()->getKernel("nestaResidual");
+	sumKernel = getApp()->getKernel("nestaSumPartials");
+	ykKernel = getApp()->getKernel("nestaYkUpdate");
+	zkKernel = getApp()->getKernel("nestaZkUpdate");
+
+	// Both reduction kernels share the same work-group size, so the local scratch buffer has the same size too
+	size_t maxLocalSize = std::min(residualKernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(getApp()->getDevice()),
+				       sumKernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(getApp()->getDevice()));
+	reductionLocalSize = cl::NDRange(std::min(maxLocalSize, (size_t) 256));
+	partialSums = cl::Buffer(getApp()->getContext(), CL_MEM_READ_WRITE, maxReductionGroups * sizeof(cl_float));
+}
+
+/**
+ * @brief Number of elements of a data object (all of its NDArrays are assumed to be the same size and contiguous)
+ * @param[in] pData data object
+ * @return total number of elements
+ */
+index1DType NestaUpdate::numElements(const std::shared_ptr<Data>& pData) {
+	return static_cast<index1DType>(pData->getNDArrayTotalSize(0)) * pData->getNumNDArrays();
+}
+
+void NestaUpdate::doLaunch() {
+	startProfiling();
+	try {
+		std::vector<cl::Event> kernelsExecEventList;
+		cl::Event event;
+
+		index1DType n = numElements(getInput());
+
+		if(auto pRP = std::dynamic_pointer_cast<ResidualParameters>(pLaunchParameters)) {
+			cl_uint localSize = reductionLocalSize[0];
+			cl_uint nGroups = std::min<index1DType>(maxReductionGroups, (n + localSize - 1) / localSize);
+
+			residualKernel.setArg(0, *getInput()->getDeviceBuffer());
+			residualKernel.setArg(1, *pRP->b->getDeviceBuffer());
+			residualKernel.setArg(2, *getOutput()->getDeviceBuffer());
+			residualKernel.setArg(3, partialSums);
+			residualKernel.setArg(4, cl::Local(localSize * sizeof(cl_float)));
+			residualKernel.setArg(5, pRP->scale);
+			residualKernel.setArg(6, pRP->rescale);
+			residualKernel.setArg(7, n);
+			queue.enqueueNDRangeKernel(residualKernel, cl::NullRange, cl::NDRange(nGroups * localSize), reductionLocalSize, NULL, &event);
+			kernelsExecEventList.push_back(event);
+
+			sumKernel.setArg(0, pRP->sumBuffer);
+			sumKernel.setArg(1, partialSums);
+			sumKernel.setArg(2, cl::Local(localSize * sizeof(cl_float)));
+			sumKernel.setArg(3, nGroups);
+			queue.enqueueNDRangeKernel(sumKernel, cl::NullRange, reductionLocalSize, reductionLocalSize, NULL, &event);
+			kernelsExecEventList.push_back(event);
+		}
+		else if(auto pYP = std::dynamic_pointer_cast<YkParameters>(pLaunchParameters)) {
+			ykKernel.setArg(0, *getInput()->getDeviceBuffer());
+			ykKernel.setArg(1, *getOutput()->getDeviceBuffer());
+			ykKernel.setArg(2, *pYP->aRes->getDeviceBuffer());
+			ykKernel.setArg(3, *pYP->xk->getDeviceBuffer());
+			ykKernel.setArg(4, pYP->dfScale);
+			ykKernel.setArg(5, pYP->Lmu1);
+			ykKernel.setArg(6, n);
+			queue.enqueueNDRangeKernel(ykKernel, cl::NullRange, cl::NDRange(n), cl::NullRange, NULL, &event);
+			kernelsExecEventList.push_back(event);
+		}
+		else if(auto pZP = std::dynamic_pointer_cast<ZkParameters>(pLaunchParameters)) {
+			zkKernel.setArg(0, *getInput()->getDeviceBuffer());
+			zkKernel.setArg(1, *getOutput()->getDeviceBuffer());
+			zkKernel.setArg(2, *pZP->wk->getDeviceBuffer());
+			zkKernel.setArg(3, *pZP->xref->getDeviceBuffer());
+			zkKernel.setArg(4, *pZP->yk->getDeviceBuffer());
+			zkKernel.setArg(5, pZP->apk);
+			zkKernel.setArg(6, pZP->Lmu1);
+			zkKernel.setArg(7, pZP->tauk);
+			zkKernel.setArg(8, n);
+			queue.enqueueNDRangeKernel(zkKernel, cl::NullRange, cl::NDRange(n), cl::NullRange, NULL, &event);
+			kernelsExecEventList.push_back(event);
+		}
+		else
+			BTTHROW(std::invalid_argument("launch parameters not set or of unknown type"), "NestaUpdate::launch");
+
+		stopProfiling();
+		if(pProfileParameters->enable)
+			getKernelGroupExecutionTimes(kernelsExecEventList, "OpenCLIPER::NestaUpdate::launch kernel", "OpenCLIPER::NestaUpdate::launch group of kernels");
+	}
+	catch(cl::Error& err) {
+		BTTHROW(CLError(err), "NestaUpdate::launch");
+	}
+}
+
+} // namespace OpenCLIPER
+
+#undef NESTAUPDATE_DEBUG
@@ -56,7 +56,7 @@ void TemporalTV::init() {
 
 }
 
-void TemporalTV::launch() {
+void TemporalTV::doLaunch() {
 	startProfiling();
 	try {
 		std::vector<cl::Event> kernelsExecEventList;
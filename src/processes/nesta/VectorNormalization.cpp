@@ -53,7 +53,7 @@ void VectorNormalization::init() {
 
 }
 
-void VectorNormalization::launch() {
+void VectorNormalization::doLaunch() {
 	auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
 
 	startProfiling();
@@ -39,7 +39,7 @@ void ArrayAddProcess::init() {
     kernel = getApp()->getKernel("arrayAdd_kernel");
 }
 
-void ArrayAddProcess::launch() {
+void ArrayAddProcess::doLaunch() {
     checkCommonLaunchParameters();
     // Set input and output OpenCL buffers on device memory
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
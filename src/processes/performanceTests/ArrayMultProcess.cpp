@@ -38,7 +38,7 @@ void ArrayMultProcess::init() {
     kernel = getApp()->getKernel("arrayMult_kernel");
 }
 
-void ArrayMultProcess::launch() {
+void ArrayMultProcess::doLaunch() {
     checkCommonLaunchParameters();
     // Set input and output OpenCL buffers on device memory
     auto pLP = std::dynamic_pointer_cast<LaunchParameters>(pLaunchParameters);
@@ -0,0 +1,241 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * TestUtils.hpp
+ *
+ * Helpers shared by the test programs which check processes against host computations: creation of the CLapp object,
+ * Data objects filled with random values and comparison of device results with host references.
+ */
+#ifndef TESTUTILS_HPP
+#define TESTUTILS_HPP
+
+#include <LPISupport/Utils.hpp>
+#include <OpenCLIPER/XData.hpp>
+#include <OpenCLIPER/ProgramConfig.hpp>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace OpenCLIPER {
+namespace TestUtils {
+
+/// Host copy of the contents of a Data object (one vector per NDArray)
+template<typename T>
+using HostData = std::vector<std::vector<T>>;
+
+/**
+ * @brief Gets a random value
+ * @param[in] dist distribution of real values (both parts of complex values follow it)
+ * @param[in,out] gen random number generator
+ * @return the value
+ */
+template<typename T>
+T randomValue(std::uniform_real_distribution<realType>& dist, std::mt19937& gen);
+
+template<>
+inline realType randomValue<realType>(std::uniform_real_distribution<realType>& dist, std::mt19937& gen) {
+    return dist(gen);
+}
+
+template<>
+inline complexType randomValue<complexType>(std::uniform_real_distribution<realType>& dist, std::mt19937& gen) {
+    realType re = dist(gen);
+    return complexType(re, dist(gen));
+}
+
+/**
+ * @brief Generates random values uniformly distributed in [-range, range) (both parts of complex values)
+ * @param[in] frameSize number of values of every frame
+ * @param[in] nFrames number of frames
+ * @param[in,out] gen random number generator
+ * @param[in] range maximum absolute value of the generated values
+ * @return the values
+ */
+template<typename T>
+HostData<T> randomHostData(index1DType frameSize, dimIndexType nFrames, std::mt19937& gen, realType range = 1.0) {
+    std::uniform_real_distribution<realType> dist(-range, range);
+    HostData<T> hostData(nFrames, std::vector<T>(frameSize));
+    for(auto& frame: hostData)
+	for(auto& v: frame)
+	    v = randomValue<T>(dist, gen);
+    return hostData;
+}
+
+/**
+ * @brief Creates an XData object with one frame per vector of host data
+ * @param[in] pCLapp pointer to CLapp object
+ * @param[in] spatialDims spatial dimensions of every frame
+ * @param[in] hostData values of every frame
+ * @return the new XData object
+ */
+template<typename T>
+std::shared_ptr<XData> createXData(const std::shared_ptr<CLapp>& pCLapp, const std::vector<dimIndexType>& spatialDims,
+				   const HostData<T>& hostData) {
+    auto pData = new std::vector<std::vector<T>*>();
+    for(auto& frame: hostData)
+	pData->push_back(new std::vector<T>(frame));
+    auto pSpatialDims = new std::vector<dimIndexType>(spatialDims);
+    auto pTempDims = new std::vector<dimIndexType>({(dimIndexType) hostData.size()});
+    return std::make_shared<XData>(pCLapp, pSpatialDims, pTempDims, pData);
+}
+
+/**
+ * @brief Creates an XData object with nFrames NDArrays of the given spatial dimensions, filled with random values
+ * uniformly distributed in [-range, range) (both parts of complex values)
+ * @param[in] pCLapp pointer to CLapp object
+ * @param[in] spatialDims spatial dimensions of every frame
+ * @param[in] nFrames number of frames (length of the single temporal dimension)
+ * @param[out] hostData copy of the generated values
+ * @param[in,out] gen random number generator
+ * @param[in] range maximum absolute value of the generated values
+ * @return the new XData object
+ */
+template<typename T>
+std::shared_ptr<XData> createRandomXData(const std::shared_ptr<CLapp>& pCLapp, const std::vector<dimIndexType>& spatialDims,
+					 dimIndexType nFrames, HostData<T>& hostData, std::mt19937& gen, realType range = 1.0) {
+    index1DType frameSize = 1;
+    for(auto dim: spatialDims)
+	frameSize *= dim;
+    hostData = randomHostData<T>(frameSize, nFrames, gen, range);
+    return createXData(pCLapp, spatialDims, hostData);
+}
+
+/**
+ * @brief Copies data of a Data object from device to host memory and returns them
+ * @param[in] pData Data object (elements of type T)
+ * @return values of every NDArray
+ */
+template<typename T>
+HostData<T> readHostData(const std::shared_ptr<Data>& pData) {
+    pData->device2Host();
+    HostData<T> values;
+    for(dimIndexType n = 0; n < pData->getNumNDArrays(); n++) {
+	const T* p = (const T*) pData->getHostBuffer(n);
+	values.emplace_back(p, p + pData->getNDArrayTotalSize(n));
+    }
+    return values;
+}
+
+/**
+ * @brief Prints the result of a check
+ * @param[in] ok result of the check
+ * @param[in] title description of the check
+ * @return ok
+ */
+inline bool report(bool ok, const std::string& title) {
+    std::cerr << title << (ok ? " OK" : " FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * @brief Compares values with a reference, printing the maximum relative error (|value - reference| / max(1, |reference|))
+ * @param[in] values values to be checked
+ * @param[in] reference expected values
+ * @param[in] title description of the check
+ * @param[in] tolerance maximum relative error allowed
+ * @return true if both have the same size and the maximum relative error is below tolerance
+ */
+template<typename T>
+bool checkClose(const HostData<T>& values, const HostData<T>& reference, const std::string& title, double tolerance = 1e-4) {
+    bool sameSize = (values.size() == reference.size());
+    double maxError = 0;
+    for(size_t k = 0; sameSize && k < values.size(); k++) {
+	sameSize = (values[k].size() == reference[k].size());
+	for(size_t i = 0; sameSize && i < values[k].size(); i++)
+	    maxError = std::max(maxError, (double) std::abs(values[k][i] - reference[k][i]) / std::max(1.0, (double) std::abs(reference[k][i])));
+    }
+    if(!sameSize)
+	return report(false, title + ": sizes differ");
+    return report(maxError < tolerance, title + ": max relative error " + std::to_string(maxError));
+}
+
+/**
+ * @brief Compares data of a Data object (copied back from the device) with a reference
+ * @param[in] pData Data object (elements of type T)
+ * @param[in] reference expected values of every NDArray
+ * @param[in] title description of the check
+ * @param[in] tolerance maximum relative error allowed
+ * @return true if the maximum relative error is below tolerance
+ */
+template<typename T>
+bool checkClose(const std::shared_ptr<Data>& pData, const HostData<T>& reference, const std::string& title, double tolerance = 1e-4) {
+    return checkClose(readHostData<T>(pData), reference, title, tolerance);
+}
+
+/**
+ * @brief Creates a CLapp object for the platform and device selected in the command line, runs a test with it and prints
+ * its result
+ * @param[in] argc number of command line arguments
+ * @param[in] argv command line arguments
+ * @param[in] test function running the checks (returns true if all of them passed)
+ * @param[in] setDeviceTraits function changing the device traits before the CLapp object is created (optional)
+ * @return EXIT_SUCCESS if the test passed, EXIT_FAILURE if a check failed or an exception was thrown
+ */
+inline int runTest(int argc, char* argv[], const std::function<bool(const std::shared_ptr<CLapp>&)>& test,
+		   const std::function<void(CLapp::DeviceTraits&)>& setDeviceTraits = nullptr) {
+    bool passed;
+    try {
+	// Get a new OpenCLIPER app and initialize computing device
+	std::unique_ptr<ProgramConfig> pProgramConfig(new ProgramConfig(argc, argv));
+	auto pConfigTraits = std::dynamic_pointer_cast<ProgramConfig::ConfigTraits>(pProgramConfig->getConfigTraits());
+	CLapp::PlatformTraits platformTraits = pConfigTraits->platformTraits;
+	CLapp::DeviceTraits deviceTraits = pConfigTraits->deviceTraits;
+	if(setDeviceTraits)
+	    setDeviceTraits(deviceTraits);
+	auto pCLapp = CLapp::create(platformTraits, deviceTraits);
+
+	passed = test(pCLapp);
+    }
+    catch(cl::BuildError& e) {
+	CLapp::dumpBuildError(e);
+	return EXIT_FAILURE;
+    }
+    catch(CLError& e) {
+	std::cerr << CLapp::getOpenCLErrorInfoStr(e, argv[0]);
+	return EXIT_FAILURE;
+    }
+    catch(std::exception& e) {
+	LPISupport::Utils::showExceptionInfo(e, argv[0]);
+	return EXIT_FAILURE;
+    }
+    std::cerr << (passed ? "Test passed" : "Test FAILED") << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace TestUtils
+} // namespace OpenCLIPER
+
+#endif // TESTUTILS_HPP
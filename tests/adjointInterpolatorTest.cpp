@@ -0,0 +1,142 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * adjointInterpolatorTest.cpp
+ *
+ * Checks that AdjointInterpolator (both the atomic scatter and the gather implementations) is the adjoint of
+ * Interpolator, i.e. <A x, y> = <x, A^H y> for random images x, y and a random deformation, with the identity
+ * original mesh and with a shifted one (for which the gather implementation must fall back to the scatter one).
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/Interpolator.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/AdjointInterpolator.hpp>
+#include <sstream>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType N = 64;	// image width and height
+static const dimIndexType nFrames = 4;
+
+// Creates the original mesh, shifted shift pixels horizontally (shift = 0 gives the identity mesh)
+static std::shared_ptr<XData> createMesh(const std::shared_ptr<CLapp>& pCLapp, dimIndexType shift) {
+    auto x = new std::vector<dimIndexType>(N * N * 2);
+    for(dimIndexType c = 0; c < N; c++) {
+	for(dimIndexType r = 0; r < N; r++) {
+	    x->at(r + c * N + 0 * N * N) = c + 1 + shift;
+	    x->at(r + c * N + 1 * N * N) = r + 1;
+	}
+    }
+    auto pDims = new std::vector<dimIndexType>({N, N, 2});
+    return std::make_shared<XData>(pCLapp, pDims, x);
+}
+
+// Creates a new mesh: the identity plus a random displacement of up to maxDisp pixels
+static std::shared_ptr<XData> createNewMesh(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen, realType maxDisp) {
+    std::uniform_real_distribution<realType> dist(-maxDisp, maxDisp);
+    auto xn = new std::vector<realType>(N * N * nFrames * 2);
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	for(dimIndexType r = 0; r < N; r++) {
+	    for(dimIndexType c = 0; c < N; c++) {
+		xn->at(c + r * N + k * N * N + 0 * N * N * nFrames) = c + 1 + dist(gen);
+		xn->at(c + r * N + k * N * N + 1 * N * N * nFrames) = r + 1 + dist(gen);
+	    }
+	}
+    }
+    auto pDims = new std::vector<dimIndexType>({N, N, nFrames, 2});
+    return std::make_shared<XData>(pCLapp, pDims, xn);
+}
+
+// Computes <a, b> = sum(conj(a) * b)
+static std::complex<double> dotProduct(const std::shared_ptr<XData>& a, const std::shared_ptr<XData>& b) {
+    auto hostA = readHostData<complexType>(a);
+    auto hostB = readHostData<complexType>(b);
+    std::complex<double> sum = 0;
+    for(dimIndexType k = 0; k < nFrames; k++)
+	for(index1DType i = 0; i < N * N; i++)
+	    sum += std::conj(std::complex<double>(hostA[k][i])) * std::complex<double>(hostB[k][i]);
+    return sum;
+}
+
+static bool testAdjoint(const std::shared_ptr<CLapp>& pCLapp) {
+    bool passed = true;
+    std::mt19937 gen(1234);
+    HostData<complexType> x, y;
+    auto pX = createRandomXData(pCLapp, {N, N}, nFrames, x, gen);
+    auto pY = createRandomXData(pCLapp, {N, N}, nFrames, y, gen);
+    HostData<complexType> zero(nFrames, std::vector<complexType>(N * N));
+    auto pXn = createNewMesh(pCLapp, gen, 2.0);
+    std::vector<dimIndexType> boundBox({20, 20, 44, 44}); // first column, first row, last column, last row
+
+    auto pInterpolator = Process::create<Interpolator>(pCLapp);
+    pInterpolator->init();
+    auto pScatter = Process::create<AdjointInterpolator>(pCLapp);
+    pScatter->setInitParameters(std::make_shared<AdjointInterpolator::InitParameters>(false));
+    pScatter->init();
+    auto pGather = Process::create<AdjointInterpolator>(pCLapp);
+    pGather->setInitParameters(std::make_shared<AdjointInterpolator::InitParameters>(true));
+    pGather->init();
+
+    for(dimIndexType shift: {0, 1}) {
+	auto pMesh = createMesh(pCLapp, shift);
+
+	// A x
+	auto pAx = createXData(pCLapp, {N, N}, zero);
+	pInterpolator->setInput(pX);
+	pInterpolator->setOutput(pAx);
+	pInterpolator->setLaunchParameters(std::make_shared<Interpolator::LaunchParameters>(pXn, pMesh, &boundBox));
+	pInterpolator->launch();
+	std::complex<double> lhs = dotProduct(pAx, pY);
+
+	for(auto& pAdjoint: {pScatter, pGather}) {
+	    // A^H y
+	    auto pAHy = createXData(pCLapp, {N, N}, zero);
+	    pAdjoint->setInput(pY);
+	    pAdjoint->setOutput(pAHy);
+	    pAdjoint->setLaunchParameters(std::make_shared<AdjointInterpolator::LaunchParameters>(pXn, pMesh, &boundBox));
+	    pAdjoint->launch();
+	    std::complex<double> rhs = dotProduct(pX, pAHy);
+
+	    double relError = std::abs(lhs - rhs) / std::abs(lhs);
+	    std::ostringstream title;
+	    title << (pAdjoint == pScatter ? "scatter" : "gather") << ", " << (shift ? "shifted" : "identity") << " mesh: <Ax,y> = " << lhs <<
+		     ", <x,A^H y> = " << rhs << ", relative error " << relError;
+	    passed = report(relError < 1e-4, title.str()) && passed;
+	}
+    }
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, testAdjoint);
+}
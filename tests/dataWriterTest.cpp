@@ -0,0 +1,140 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * dataWriterTest.cpp
+ *
+ * Checks background saves of Data objects: saves of objects owned by a shared_ptr run in a DataWriter and host/device
+ * transfers and processes writing the object wait for them, saves of objects not owned by a shared_ptr run synchronously, and errors are reported
+ * through the returned future in both cases.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/ConcreteNDArray.hpp>
+#include <OpenCLIPER/processes/ScalarMultiply.hpp>
+#include <fstream>
+#include <chrono>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType width = 64;
+static const dimIndexType height = 48;
+static const dimIndexType nFrames = 4;
+
+// Checks that a saved CFL data file contains the expected values
+static bool checkFile(const std::string& fileName, const HostData<realType>& hostData) {
+    std::ifstream f(fileName, std::ifstream::binary);
+    HostData<realType> fileData(nFrames, std::vector<realType>(width * height));
+    for(auto& frame: fileData)
+	f.read(reinterpret_cast<char*>(frame.data()), frame.size() * sizeof(realType));
+    return report(f && fileData == hostData, "contents of " + fileName);
+}
+
+static bool isReady(const std::shared_future<void>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Returns true if getting the result of the future throws
+static bool throws(const std::shared_future<void>& future) {
+    try {
+	future.get();
+    }
+    catch(std::exception&) {
+	return true;
+    }
+    return false;
+}
+
+// Save of an object owned by a shared_ptr: run by the writer, and transfers through the object wait for it
+static bool testSharedSave(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen) {
+    HostData<realType> hostData;
+    auto pXData = createRandomXData(pCLapp, {width, height}, nFrames, hostData, gen);
+
+    auto saved = pXData->saveCFLDataAsync("dataWriterTest_shared");
+
+    // Device data are doubled in place: launching the process must wait for the save, as it may overwrite the host
+    // buffers being written (e.g. with zero-copy host memory), and so must copying them back
+    auto pScale = Process::create<ScalarMultiply>(pCLapp, pXData, pXData);
+    pScale->init();
+    pScale->setLaunchParameters(std::make_shared<ScalarMultiply::LaunchParameters>(2.0));
+    pScale->launch();
+    bool passed = isReady(saved);
+    pXData->device2Host();
+    saved.get();
+    passed &= checkFile("dataWriterTest_shared.cfl", hostData);
+
+    // Whole host to device copy, after another save: NDArray host data are changed and must reach the device
+    saved = pXData->saveCFLDataAsync("dataWriterTest_shared");
+    auto pNDArray = dynamic_cast<const ConcreteNDArray<realType>*>(pXData->getNDArray(0));
+    realType* pNDArrayHost = (realType*) pNDArray->getHostDataAsVoidPointer();
+    for(index1DType i = 0; i < width * height; i++)
+	pNDArrayHost[i] = 3 * hostData[0][i];
+    pXData->host2Device();
+    passed &= isReady(saved);
+    pXData->device2Host();
+    HostData<realType> reference(hostData);
+    for(auto& v: reference[0])
+	v *= 3;
+    passed = checkClose(pXData, reference, "whole host to device copy after a save", 1e-5) && passed;
+
+    // Errors are reported by the future
+    passed &= throws(pXData->saveCFLDataAsync("dataWriterTestNonExistentDir/dataWriterTest_shared"));
+    return report(passed, "shared_ptr owned save");
+}
+
+// Save of an object not owned by a shared_ptr: run synchronously, before saveCFLDataAsync() returns
+static bool testUnsharedSave(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen) {
+    HostData<realType> hostData = randomHostData<realType>(width * height, nFrames, gen);
+    std::vector<std::vector<realType>*>* pData = new std::vector<std::vector<realType>*>();
+    for(auto& frame: hostData)
+	pData->push_back(new std::vector<realType>(frame));
+    std::vector<dimIndexType>* pSpatialDims = new std::vector<dimIndexType>({width, height});
+    std::vector<dimIndexType>* pTempDims = new std::vector<dimIndexType>({nFrames});
+    XData xData(pCLapp, pSpatialDims, pTempDims, pData);
+
+    auto saved = xData.saveCFLDataAsync("dataWriterTest_unshared");
+    bool passed = isReady(saved) && !throws(saved);
+    passed &= checkFile("dataWriterTest_unshared.cfl", hostData);
+
+    // Errors are reported by the future, not thrown by saveCFLDataAsync()
+    saved = xData.saveCFLDataAsync("dataWriterTestNonExistentDir/dataWriterTest_unshared");
+    passed &= isReady(saved) && throws(saved);
+    return report(passed, "unowned object save");
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	bool passed = testSharedSave(pCLapp, gen);
+	return testUnsharedSave(pCLapp, gen) && passed;
+    });
+}
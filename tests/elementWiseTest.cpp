@@ -0,0 +1,140 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * elementWiseTest.cpp
+ *
+ * Checks element-wise kernels that address 3D multi-frame data (ComplexAbs, ComplexAbsPow2, ComplexPow, TemporalTV and
+ * the NESTA yk update) against results computed on the host.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/ComplexAbs.hpp>
+#include <OpenCLIPER/processes/ComplexAbsPow2.hpp>
+#include <OpenCLIPER/processes/ComplexPow.hpp>
+#include <OpenCLIPER/processes/nesta/TemporalTV.hpp>
+#include <OpenCLIPER/processes/nesta/NestaUpdate.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+// Frames are a multiple of 4 KiB, so that they are contiguous in device memory (TemporalTV assumes so)
+static const dimIndexType width = 32;
+static const dimIndexType height = 32;
+static const dimIndexType depth = 2;
+static const dimIndexType nFrames = 4;
+static const index1DType frameSize = width * height * depth;
+
+// Creates a set of nFrames width x height x depth complex images with random values
+static std::shared_ptr<XData> createData(const std::shared_ptr<CLapp>& pCLapp, HostData<complexType>& hostData, std::mt19937& gen) {
+    return createRandomXData(pCLapp, {width, height, depth}, nFrames, hostData, gen);
+}
+
+// Launches a process from pIn to a new output and compares the result with f applied to every input element
+static bool testUnary(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<Process>& pProcess, const std::shared_ptr<XData>& pIn,
+		      const HostData<complexType>& hostData, const std::function<complexType(complexType)>& f, const std::string& title) {
+    auto pOut = std::make_shared<XData>(pCLapp, pIn, false);
+    pProcess->setInput(pIn);
+    pProcess->setOutput(pOut);
+    pProcess->init();
+    pProcess->launch();
+
+    HostData<complexType> reference(hostData);
+    for(auto& frame: reference)
+	for(auto& v: frame)
+	    v = f(v);
+    return checkClose(pOut, reference, title);
+}
+
+static bool testTemporalTV(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<XData>& pIn, const HostData<complexType>& hostData) {
+    bool passed = true;
+    for(auto dir: {TemporalTV::FORWARD, TemporalTV::ADJOINT}) {
+	auto pOut = std::make_shared<XData>(pCLapp, pIn, false);
+	auto pTV = Process::create<TemporalTV>(pCLapp, pIn, pOut);
+	pTV->setInitParameters(std::make_shared<TemporalTV::InitParameters>(dir));
+	pTV->init();
+	pTV->launch();
+
+	// Circular differences between consecutive frames (forward) and their adjoint
+	HostData<complexType> reference(hostData);
+	for(dimIndexType k = 0; k < nFrames; k++) {
+	    for(index1DType i = 0; i < frameSize; i++) {
+		if(dir == TemporalTV::FORWARD)
+		    reference[k][i] = hostData[k][i] - hostData[(k + nFrames - 1) % nFrames][i];
+		else
+		    reference[k][i] = hostData[(k + 1) % nFrames][i] - hostData[k][i];
+	    }
+	}
+	passed = checkClose(pOut, reference, (dir == TemporalTV::FORWARD) ? "TemporalTV FORWARD" : "TemporalTV ADJOINT") && passed;
+    }
+    return passed;
+}
+
+static bool testNestaYkUpdate(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen) {
+    const cl_float dfScale = 0.75, Lmu1 = 0.25;
+    HostData<complexType> df, aRes, xk;
+    auto pDf = createData(pCLapp, df, gen);
+    auto pARes = createData(pCLapp, aRes, gen);
+    auto pXk = createData(pCLapp, xk, gen);
+    auto pYk = std::make_shared<XData>(pCLapp, pXk, false);
+
+    auto pUpdate = Process::create<NestaUpdate>(pCLapp, pDf, pYk);
+    pUpdate->init();
+    pUpdate->setLaunchParameters(std::make_shared<NestaUpdate::YkParameters>(pARes, pXk, dfScale, Lmu1));
+    pUpdate->launch();
+
+    HostData<complexType> dfReference(df), ykReference(xk);
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	for(index1DType i = 0; i < frameSize; i++) {
+	    dfReference[k][i] = df[k][i] * dfScale + aRes[k][i];
+	    ykReference[k][i] = xk[k][i] - Lmu1 * dfReference[k][i];
+	}
+    }
+    bool passed = checkClose(pDf, dfReference, "NestaUpdate yk (df)");
+    return checkClose(pYk, ykReference, "NestaUpdate yk (yk)") && passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	HostData<complexType> hostData;
+	auto pIn = createData(pCLapp, hostData, gen);
+
+	bool passed = testUnary(pCLapp, Process::create<ComplexAbs>(pCLapp), pIn, hostData,
+				[](complexType v) { return complexType(std::abs(v), 0); }, "ComplexAbs");
+	passed = testUnary(pCLapp, Process::create<ComplexAbsPow2>(pCLapp), pIn, hostData,
+			   [](complexType v) { return complexType(std::norm(v), 0); }, "ComplexAbsPow2") && passed;
+	passed = testUnary(pCLapp, Process::create<ComplexPow>(pCLapp), pIn, hostData,
+			   [](complexType v) { return v * v; }, "ComplexPow") && passed;
+	passed = testTemporalTV(pCLapp, pIn, hostData) && passed;
+	return testNestaYkUpdate(pCLapp, gen) && passed;
+    });
+}
@@ -0,0 +1,85 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * fftPlanCacheTest.cpp
+ *
+ * Checks that the FFT plan cache keys plans by device: equivalent plans requested through queues of the same device
+ * share one baked plan, and FFT processes bound to different queues get the same results.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/FFTPlanCache.hpp>
+#include <OpenCLIPER/processes/FFT.hpp>
+#include <algorithm>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static bool testPlanCache(const std::shared_ptr<CLapp>& pCLapp) {
+    auto pCache = pCLapp->getFFTPlanCache();
+
+    FFTPlanCache::PlanParameters parameters;
+    parameters.sizes[0] = 64;
+    parameters.batchSize = 16;
+    parameters.batchDistance = 64;
+
+    clfftPlanHandle plan0 = pCache->getPlan(parameters, pCLapp->getCommandQueue(0, 0));
+    clfftPlanHandle plan1 = pCache->getPlan(parameters, pCLapp->getCommandQueue(0, 1));
+    bool passed = report((plan0 == plan1) && (pCache->getMisses() == 1) && (pCache->getHits() == 1),
+			 "Same plan through two queues of the same device: " + std::to_string(pCache->getMisses()) + " misses, " +
+			 std::to_string(pCache->getHits()) + " hits");
+
+    // FFTs enqueued on different queues of the same device share the plan and give the same result
+    std::mt19937 gen(1234);
+    HostData<complexType> hostData;
+    auto pIn = createRandomXData(pCLapp, {64, 64}, 4, hostData, gen);
+    std::vector<HostData<complexType>> outputs;
+    for(size_t q = 0; q < 2; q++) {
+	auto pOut = std::make_shared<XData>(pCLapp, pIn, false);
+	auto fft = Process::create<FFT>(pCLapp);
+	fft->setCommandQueue(pCLapp->getCommandQueue(0, q));
+	fft->setInput(pIn);
+	fft->setOutput(pOut);
+	fft->init();
+	fft->launch();
+	pCLapp->getCommandQueue(0, q).finish();
+	outputs.push_back(readHostData<complexType>(pOut));
+    }
+    return checkClose(outputs[0], outputs[1], "FFT on two queues of the same device", 1e-6) && passed;
+}
+
+int main(int argc, char* argv[]) {
+    // At least two queues, so that plans can be requested through different queues of the same device
+    return runTest(argc, argv, testPlanCache, [](CLapp::DeviceTraits& deviceTraits) {
+	deviceTraits.queuesPerDevice = std::max(deviceTraits.queuesPerDevice, 2u);
+    });
+}
@@ -33,17 +33,167 @@
 #include <LPISupport/Utils.hpp>
 #include <OpenCLIPER/XData.hpp>
 #include <OpenCLIPER/KData.hpp>
+#include <OpenCLIPER/ConcreteNDArray.hpp>
 #include <OpenCLIPER/processes/FFT.hpp>
 #include <iostream>
 #include <string>
 #include <OpenCLIPER/ProgramConfig.hpp>
 #include <OpenCLIPER/buildconfig.hpp>
 #include <LPISupport/Timer.hpp>
+#include <algorithm>
+#include <random>
 
 
 using namespace OpenCLIPER;
+
+// Reads all the NDArrays of a Data object (complex elements) back from the device, one after another
+static std::vector<std::complex<double>> readAll(const std::shared_ptr<Data>& pData) {
+    pData->device2Host();
+    std::vector<std::complex<double>> values;
+    for(dimIndexType n = 0; n < pData->getNumNDArrays(); n++) {
+	const complexType* p = (const complexType*) pData->getHostBuffer(n);
+	values.insert(values.end(), p, p + pData->getNDArrayTotalSize(n));
+    }
+    return values;
+}
+
+// Prints and returns whether max|a - scale * b| / max|b| is small enough
+static bool checkClose(const std::vector<std::complex<double>>& a, const std::vector<std::complex<double>>& b, double scale, const std::string& title) {
+    double maxError = 0, maxValue = 0;
+    for(size_t i = 0; i < a.size(); i++) {
+	maxError = std::max(maxError, std::abs(a[i] - scale * b[i]));
+	maxValue = std::max(maxValue, std::abs(scale * b[i]));
+    }
+    bool ok = (a.size() == b.size()) && (maxError <= 1e-4 * std::max(maxValue, 1.0));
+    std::cerr << title << ": max error " << maxError << " (max value " << maxValue << ")" << (ok ? " OK" : " FAILED") << std::endl;
+    return ok;
+}
+
+// Runs an FFT of pIn with the given parameters and returns its output
+template<typename D>
+static std::shared_ptr<D> runFFT(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<D>& pIn,
+				 const std::shared_ptr<FFT::InitParameters>& initParms, FFT::Direction dir) {
+    auto pOut = std::make_shared<D>(pCLapp, pIn, false);
+    auto fft = Process::create<FFT>(pCLapp);
+    fft->setInput(pIn);
+    fft->setOutput(pOut);
+    fft->setInitParameters(initParms);
+    fft->init();
+    fft->setLaunchParameters(std::make_shared<FFT::LaunchParameters>(dir));
+    fft->launch();
+    return pOut;
+}
+
+// Checks that a row transform restricted to the rows selected by the sampling masks matches the transform of every row
+// at selected rows, and is zero at the others
+static bool checkSamplingMask(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<KData>& pIn) {
+    auto pMasks = pIn->getSamplingMasksData();
+    if(!pMasks || pMasks->getMasksFormat() != SamplingMasksData::PIXELMASK) {
+	std::cerr << "Input data have no PIXELMASK sampling masks, skipping sampling mask check\n";
+	return true;
+    }
+    auto full = readAll(runFFT(pCLapp, pIn, std::make_shared<FFT::InitParameters>(0), FFT::Direction::BACKWARD));
+    auto masked = readAll(runFFT(pCLapp, pIn, std::make_shared<FFT::InitParameters>(0, pMasks), FFT::Direction::BACKWARD));
+
+    // Expected result: same row selection as FFT::init (one mask per frame, NDArrays stored coil-first)
+    index1DType rowLength = pIn->getSpatialDimSize(0, 0);
+    index1DType rowsPerNDArray = pIn->getNDArrayTotalSize(0) / rowLength;
+    dimIndexType numCoils = std::max(pIn->getNumCoils(), 1u);
+    dimIndexType numMasks = pMasks->getNumNDArrays();
+    std::vector<std::complex<double>> expected(full.size(), 0.0);
+    index1DType nSelected = 0;
+    for(index1DType row = 0; row < full.size() / rowLength; row++) {
+	dimIndexType frame = std::min((dimIndexType) ((row / rowsPerNDArray) / numCoils), numMasks - 1);
+	auto pMask = static_cast<const ConcreteNDArray<cl_uchar>*>(pMasks->getNDArray(frame));
+	dimIndexType maskWidth = pMask->getDims()->at(WIDTHPOS);
+	dimIndexType maskHeight = pMask->size() / maskWidth;
+	auto maskRow = pMask->getHostDataPointer() + ((row % rowsPerNDArray) % maskHeight) * maskWidth;
+	if(std::any_of(maskRow, maskRow + maskWidth, [](cl_uchar m) { return m != 0; })) {
+	    std::copy(full.begin() + row * rowLength, full.begin() + (row + 1) * rowLength, expected.begin() + row * rowLength);
+	    nSelected++;
+	}
+    }
+    std::cerr << nSelected << " of " << full.size() / rowLength << " rows selected by sampling masks\n";
+    return checkClose(masked, expected, 1.0, "Row transform with sampling masks vs. full row transform");
+}
+
+// Creates nFrames random complex images of width x height pixels, circularly shifted by half their size if shifted is true
+// (fftshift and ifftshift are the same for even sizes)
+static std::shared_ptr<XData> createTestImages(const std::shared_ptr<CLapp>& pCLapp, dimIndexType width, dimIndexType height, dimIndexType nFrames,
+					       bool shifted) {
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<realType> dist(-1.0, 1.0);
+    auto pData = new std::vector<std::vector<complexType>*>();
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	auto pFrame = new std::vector<complexType>(width * height);
+	for(dimIndexType y = 0; y < height; y++)
+	    for(dimIndexType x = 0; x < width; x++) {
+		complexType value(dist(gen), dist(gen));
+		if(shifted)
+		    pFrame->at((x + width / 2) % width + ((y + height / 2) % height) * width) = value;
+		else
+		    pFrame->at(x + y * width) = value;
+	    }
+	pData->push_back(pFrame);
+    }
+    auto pSpatialDims = new std::vector<dimIndexType>({width, height});
+    auto pTempDims = new std::vector<dimIndexType>({nFrames});
+    return std::make_shared<XData>(pCLapp, pSpatialDims, pTempDims, pData);
+}
+
+// Checks centered transforms against fftshift(FFT(ifftshift(x))), and the scaling of every normalization option,
+// including that the unitary transform preserves the norm and is inverted by the unitary backward transform
+static bool checkCenteredAndNormalization(const std::shared_ptr<CLapp>& pCLapp) {
+    const dimIndexType width = 64, height = 48, nFrames = 2;
+    const double N = width * height;
+    bool passed = true;
+    auto pX = createTestImages(pCLapp, width, height, nFrames, false);
+    auto pShiftedX = createTestImages(pCLapp, width, height, nFrames, true);
+
+    // Centered transforms
+    for(auto dir: {FFT::Direction::FORWARD, FFT::Direction::BACKWARD}) {
+	auto centered = readAll(runFFT(pCLapp, pX, std::make_shared<FFT::InitParameters>(-1, nullptr, true), dir));
+	auto plainOfShifted = readAll(runFFT(pCLapp, pShiftedX, std::make_shared<FFT::InitParameters>(), dir));
+	std::vector<std::complex<double>> expected(plainOfShifted.size());
+	for(dimIndexType k = 0; k < nFrames; k++)
+	    for(dimIndexType y = 0; y < height; y++)
+		for(dimIndexType x = 0; x < width; x++)
+		    expected[(x + width / 2) % width + ((y + height / 2) % height) * width + k * width * height] = plainOfShifted[x + y * width + k * width * height];
+	passed = checkClose(centered, expected, 1.0, std::string("Centered ") + (dir == FFT::Direction::FORWARD ? "forward" : "backward") +
+			    " transform vs. fftshift(FFT(ifftshift(x)))") && passed;
+    }
+
+    // Normalizations, compared to the default one (forward transform unscaled, backward transform scaled by 1/N)
+    auto forward = readAll(runFFT(pCLapp, pX, std::make_shared<FFT::InitParameters>(), FFT::Direction::FORWARD));
+    auto backward = readAll(runFFT(pCLapp, pX, std::make_shared<FFT::InitParameters>(), FFT::Direction::BACKWARD));
+    auto noneParms = std::make_shared<FFT::InitParameters>(-1, nullptr, false, FFT::NORMALIZE_NONE);
+    auto unitaryParms = std::make_shared<FFT::InitParameters>(-1, nullptr, false, FFT::NORMALIZE_UNITARY);
+    passed = checkClose(readAll(runFFT(pCLapp, pX, noneParms, FFT::Direction::FORWARD)), forward, 1.0, "NORMALIZE_NONE forward transform") && passed;
+    passed = checkClose(readAll(runFFT(pCLapp, pX, noneParms, FFT::Direction::BACKWARD)), backward, N, "NORMALIZE_NONE backward transform") && passed;
+    auto pUnitaryForward = runFFT(pCLapp, pX, unitaryParms, FFT::Direction::FORWARD);
+    auto unitaryForward = readAll(pUnitaryForward);
+    passed = checkClose(unitaryForward, forward, 1.0 / sqrt(N), "NORMALIZE_UNITARY forward transform") && passed;
+    passed = checkClose(readAll(runFFT(pCLapp, pX, unitaryParms, FFT::Direction::BACKWARD)), backward, sqrt(N), "NORMALIZE_UNITARY backward transform") && passed;
+
+    // Unitary transform: forward + backward gives back the input, and the norm is preserved
+    auto x = readAll(pX);
+    passed = checkClose(readAll(runFFT(pCLapp, pUnitaryForward, unitaryParms, FFT::Direction::BACKWARD)), x, 1.0,
+			"NORMALIZE_UNITARY forward + backward transform vs. input") && passed;
+    double normX = 0, normY = 0;
+    for(size_t i = 0; i < x.size(); i++) {
+	normX += std::norm(x[i]);
+	normY += std::norm(unitaryForward[i]);
+    }
+    normX = sqrt(normX);
+    normY = sqrt(normY);
+    bool ok = std::abs(normY - normX) <= 1e-4 * normX;
+    std::cerr << "NORMALIZE_UNITARY norm preservation: |x| = " << normX << ", |FFT(x)| = " << normY << (ok ? " OK" : " FAILED") << std::endl;
+    return ok && passed;
+}
+
 int main(int argc, char* argv[]) {
     std::shared_ptr<CLapp> pCLapp;
+    bool passed = true;
 
     try {
 	// Step 0: get a new OpenCLIPER app, initialize computing device and load OpenCL kernel(s)
@@ -76,6 +226,10 @@ int main(int argc, char* argv[]) {
 	    pIn->show(&sp);
 	}
 
+	// Check transform options against the plain transform
+	passed = checkSamplingMask(pCLapp, pIn) && passed;
+	passed = checkCenteredAndNormalization(pCLapp) && passed;
+
 	// Create empty output buffer
 	auto pOut = std::make_shared<KData>(pCLapp, pIn);
 
@@ -137,11 +291,15 @@ int main(int argc, char* argv[]) {
     }
     catch(cl::BuildError& e) {
 	CLapp::dumpBuildError(e);
+	return EXIT_FAILURE;
     }
     catch(CLError& e) {
 	std::cerr << CLapp::getOpenCLErrorInfoStr(e, argv[0]);
+	return EXIT_FAILURE;
     }
     catch(std::exception& e) {
  	LPISupport::Utils::showExceptionInfo(e, argv[0]);
+	return EXIT_FAILURE;
     }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
 }
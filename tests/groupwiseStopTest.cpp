@@ -0,0 +1,98 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * groupwiseStopTest.cpp
+ *
+ * Runs GroupwiseRegistration on a synthetic sequence (a blob moving between frames) evaluating the optimizer's evolution
+ * and stop condition on the host and on the device (polling the stop flag every iteration and every few iterations), and
+ * checks that every run stops at the same iteration with the same transformation.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/GroupwiseRegistration.hpp>
+#include <cmath>
+#include <sstream>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType size = 64;
+static const dimIndexType nFrames = 6;
+
+// Gaussian blob whose center moves one pixel per frame (along both axes)
+static HostData<complexType> movingBlob() {
+    HostData<complexType> hostData(nFrames, std::vector<complexType>(size * size));
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	realType center = size / 2.0 - nFrames / 2.0 + k;
+	for(dimIndexType j = 0; j < size; j++)
+	    for(dimIndexType i = 0; i < size; i++) {
+		realType r2 = (i - center) * (i - center) + (j - center) * (j - center);
+		hostData[k][i + j * size] = complexType(std::exp(-r2 / 50.0), 0.0);
+	    }
+    }
+    return hostData;
+}
+
+// Runs the registration and returns the iteration at which the optimizer stopped (and the resulting transformation)
+static int registration(const std::shared_ptr<CLapp>& pCLapp, bool deviceStop, uint stopPollInterval, HostData<realType>& T) {
+    int Dp[2] = {4, 4};
+    auto pIn = createXData(pCLapp, {size, size}, movingBlob());
+    auto pRegistration = Process::create<GroupwiseRegistration>(pCLapp);
+    pRegistration->setInput(pIn);
+    pRegistration->setInitParameters(std::make_shared<GroupwiseRegistration::InitParameters>(1.f, true, 20, 3, Dp, 30, 0.01f, 0.005f,
+						std::vector<realType>({0.f, 0.005f, 0.f, 0.5f}), deviceStop, stopPollInterval));
+    pRegistration->init();
+
+    ArgumentsMotionCompensation argsMC;
+    pRegistration->setLaunchParameters(std::make_shared<GroupwiseRegistration::LaunchParameters>(&argsMC, nullptr, 0));
+    pRegistration->launch();
+    T = readHostData<realType>(argsMC.TData);
+    return argsMC.stopIter;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	HostData<realType> hostT;
+	int hostStopIter = registration(pCLapp, false, 1, hostT);
+	bool passed = report(hostStopIter > 0, "host stop condition met at iteration " + std::to_string(hostStopIter));
+	for(uint stopPollInterval: {1, 4}) {
+	    HostData<realType> deviceT;
+	    int deviceStopIter = registration(pCLapp, true, stopPollInterval, deviceT);
+	    std::ostringstream title;
+	    title << "device stop condition (polled every " << stopPollInterval << " iterations) met at iteration " << deviceStopIter;
+	    passed = report(deviceStopIter == hostStopIter, title.str()) && passed;
+	    passed = checkClose(deviceT, hostT, "transformation with device stop condition (polled every " +
+				std::to_string(stopPollInterval) + " iterations)") && passed;
+	}
+	return passed;
+    });
+}
@@ -0,0 +1,126 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * halfConvertTest.cpp
+ *
+ * Checks conversions of complex data to half precision complex data and back (ComplexHalfConvert), and that processes
+ * which do not support half precision data reject them.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/ComplexHalfConvert.hpp>
+#include <OpenCLIPER/processes/ScalarMultiply.hpp>
+#include <OpenCLIPER/processes/ComplexAbs.hpp>
+#include <OpenCLIPER/processes/nesta/TemporalTV.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+// Frames are a multiple of 4 KiB, so that they are contiguous in device memory (TemporalTV assumes so)
+static const dimIndexType width = 64;
+static const dimIndexType height = 32;
+static const dimIndexType nFrames = 3;
+static const index1DType frameSize = width * height;
+
+// Converts to half precision on the device, compares with the host conversion and converts back to single precision
+static bool testRoundTrip(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen, std::shared_ptr<XData>& pHalf) {
+    HostData<complexType> hostData;
+    auto pIn = createRandomXData(pCLapp, {width, height}, nFrames, hostData, gen, 100.0);
+    pHalf = std::make_shared<XData>(pCLapp, pIn, TYPEID_COMPLEXHALF);
+    auto pBack = std::make_shared<XData>(pCLapp, pIn, TYPEID_COMPLEX);
+
+    auto pToHalf = Process::create<ComplexHalfConvert>(pCLapp, pIn, pHalf);
+    pToHalf->init();
+    pToHalf->launch();
+    auto pToSingle = Process::create<ComplexHalfConvert>(pCLapp, pHalf, pBack);
+    pToSingle->init();
+    pToSingle->launch();
+
+    // Both the kernel and the host round to nearest even, so half precision values must be the same
+    pHalf->device2Host();
+    bool halfOK = true;
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	const cl_half* pHost = (const cl_half*) pHalf->getHostBuffer(k);
+	for(index1DType i = 0; i < frameSize; i++) {
+	    halfOK &= (pHost[2 * i] == NDArray::floatToHalf(hostData[k][i].real()));
+	    halfOK &= (pHost[2 * i + 1] == NDArray::floatToHalf(hostData[k][i].imag()));
+	}
+    }
+    report(halfOK, "complex to half precision complex");
+
+    // Half precision has an 11 bit significand: relative rounding errors are at most 2^-11 (for each part of the values)
+    bool backOK = checkClose(pBack, hostData, "half precision complex to complex", 1.0 / 2048 * std::sqrt(2.0));
+    return halfOK && backOK;
+}
+
+// Checks that initializing and launching a process throws std::invalid_argument
+static bool testRejected(const std::function<void()>& initAndLaunch, const std::string& title) {
+    bool rejected = false;
+    try {
+	initAndLaunch();
+    }
+    catch(std::invalid_argument&) {
+	rejected = true;
+    }
+    return report(rejected, title + " rejects half precision data");
+}
+
+static bool testRejections(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<XData>& pHalf) {
+    bool passed = true;
+    passed = testRejected([&]() {
+	auto pScale = Process::create<ScalarMultiply>(pCLapp, pHalf, pHalf);
+	pScale->init();
+	pScale->setLaunchParameters(std::make_shared<ScalarMultiply::LaunchParameters>(2.0));
+	pScale->launch();
+    }, "ScalarMultiply") && passed;
+    passed = testRejected([&]() {
+	auto pAbs = Process::create<ComplexAbs>(pCLapp, pHalf, std::make_shared<XData>(pCLapp, pHalf, TYPEID_REAL));
+	pAbs->init();
+	pAbs->launch();
+    }, "ComplexAbs") && passed;
+    passed = testRejected([&]() {
+	auto pTV = Process::create<TemporalTV>(pCLapp, pHalf, std::make_shared<XData>(pCLapp, pHalf, false));
+	pTV->setInitParameters(std::make_shared<TemporalTV::InitParameters>(TemporalTV::FORWARD));
+	pTV->init();
+	pTV->launch();
+    }, "TemporalTV") && passed;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	std::shared_ptr<XData> pHalf;
+	bool passed = testRoundTrip(pCLapp, gen, pHalf);
+	return testRejections(pCLapp, pHalf) && passed;
+    });
+}
@@ -0,0 +1,108 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * hostMemoryPolicyTest.cpp
+ *
+ * Checks whole and ranged host/device transfers of Data objects allocated with every host memory policy (device, pinned,
+ * zero-copy and auto), and that zero-copy device memory is used as NDArray host storage.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/ConcreteNDArray.hpp>
+#include <OpenCLIPER/processes/ScalarMultiply.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType width = 40;
+static const dimIndexType height = 24;
+static const dimIndexType nFrames = 3;
+
+// Rectangular region of frame 1 updated through a ranged transfer
+static const dimIndexType regionX = 5, regionY = 3, regionWidth = 17, regionHeight = 9;
+static const realType regionValue = 100;
+
+static bool inRegion(index1DType i) {
+    dimIndexType x = i % width, y = i / width;
+    return x >= regionX && x < regionX + regionWidth && y >= regionY && y < regionY + regionHeight;
+}
+
+static bool testPolicy(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen, HostMemoryPolicy policy, const std::string& policyName) {
+    HostData<realType> hostData;
+    auto pData = createRandomXData(pCLapp, {width, height}, nFrames, hostData, gen);
+    pData->setHostMemoryPolicy(policy);
+
+    // Whole transfers: device data are doubled in place and read back
+    auto pScale = Process::create<ScalarMultiply>(pCLapp, pData, pData);
+    pScale->init();
+    pScale->setLaunchParameters(std::make_shared<ScalarMultiply::LaunchParameters>(2.0));
+    pScale->launch();
+    HostData<realType> reference(hostData);
+    for(auto& frame: reference)
+	for(auto& v: frame)
+	    v *= 2;
+    bool passed = checkClose(pData, reference, policyName + " whole transfers", 1e-5);
+
+    // Ranged transfers: a region of NDArray host data of frame 1 is uploaded and the whole frame read back
+    auto pNDArray = dynamic_cast<const ConcreteNDArray<realType>*>(pData->getNDArray(1));
+    realType* pNDArrayHost = (realType*) pNDArray->getHostDataAsVoidPointer();
+    // Zero-copy device memory is NDArray host storage itself
+    if(policy == HOST_MEMORY_ZEROCOPY)
+	passed = report(pNDArrayHost == pData->getHostBuffer(1), policyName + " NDArray host data in device memory") && passed;
+    for(index1DType i = 0; i < width * height; i++) {
+	if(inRegion(i)) {
+	    pNDArrayHost[i] = regionValue;
+	    reference[1][i] = regionValue;
+	}
+    }
+    pData->host2Device(DataRange::rect(1, 1, regionX, regionY, 0, regionWidth, regionHeight));
+    pData->device2Host(DataRange(1, 1));
+
+    const realType* pHost = (const realType*) pData->getHostBuffer(1);
+    HostData<realType> frame1(1, std::vector<realType>(pHost, pHost + width * height));
+    passed = checkClose(frame1, HostData<realType>(1, reference[1]), policyName + " ranged transfers", 1e-5) && passed;
+
+    // NDArray host data are updated by ranged device to host transfers as well
+    HostData<realType> nDArrayFrame1(1, std::vector<realType>(pNDArrayHost, pNDArrayHost + width * height));
+    return checkClose(nDArrayFrame1, HostData<realType>(1, reference[1]), policyName + " ranged transfers to NDArray host data",
+		      1e-5) && passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	bool passed = testPolicy(pCLapp, gen, HOST_MEMORY_DEVICE, "HOST_MEMORY_DEVICE");
+	passed = testPolicy(pCLapp, gen, HOST_MEMORY_PINNED, "HOST_MEMORY_PINNED") && passed;
+	passed = testPolicy(pCLapp, gen, HOST_MEMORY_ZEROCOPY, "HOST_MEMORY_ZEROCOPY") && passed;
+	return testPolicy(pCLapp, gen, HOST_MEMORY_AUTO, "HOST_MEMORY_AUTO") && passed;
+    });
+}
@@ -0,0 +1,118 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * lazyKernelLoadingTest.cpp
+ *
+ * Checks lazy kernel loading: kernels generated by macros (the generic reductions) are found, kernels of different files
+ * can be requested from several threads at once, and unknown kernels are still reported as errors.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/SumReduce.hpp>
+#include <OpenCLIPER/processes/ComplexAbs.hpp>
+#include <OpenCLIPER/processes/nesta/TemporalTV.hpp>
+#include <OpenCLIPER/processes/nesta/NestaUpdate.hpp>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType width = 40;
+static const dimIndexType height = 24;
+
+// Reduction whose kernels (reduce_max_real, reduce_final_max_real) are declared through DEFINE_REDUCE_* macros
+static bool testMacroKernels(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen) {
+    HostData<realType> hostData;
+    auto pIn = createRandomXData(pCLapp, {width, height}, 1, hostData, gen);
+    realType reference = *std::max_element(hostData[0].begin(), hostData[0].end());
+    auto pOut = std::make_shared<XData>(pCLapp, 1, TYPEID_REAL);
+    auto pReduce = Process::create<SumReduce>(pCLapp, pIn, pOut);
+    pReduce->setInitParameters(std::make_shared<SumReduce::InitParameters>(SumReduce::MAX));
+    pReduce->init();
+    pReduce->launch();
+    pOut->device2Host();
+
+    realType result = *(const realType*) pOut->getHostBuffer(0);
+    return report(result == reference, "SumReduce MAX with lazily loaded kernels: " + std::to_string(result) + " (expected " +
+		  std::to_string(reference) + ")");
+}
+
+// Kernels from different files requested concurrently
+static bool testConcurrentLoading(const std::shared_ptr<CLapp>& pCLapp) {
+    // Creating the processes registers their kernel files
+    Process::create<ComplexAbs>(pCLapp);
+    Process::create<TemporalTV>(pCLapp);
+    Process::create<NestaUpdate>(pCLapp);
+
+    const std::vector<std::string> names = {"complexAbs", "operator_tTV", "operator_tTVadj", "nestaResidual", "nestaYkUpdate",
+					    "reduce_l1_complex", "complex2real_abs", "scalarMultiply"};
+    std::atomic<unsigned> failures(0);
+    std::vector<std::thread> threads;
+    for(auto& name: names) {
+	threads.emplace_back([&pCLapp, &failures, name]() {
+	    try {
+		pCLapp->getKernel(name);
+	    }
+	    catch(std::exception& e) {
+		std::cerr << "getKernel(\"" << name << "\") failed: " << e.what() << std::endl;
+		failures++;
+	    }
+	});
+    }
+    for(auto& thread: threads)
+	thread.join();
+
+    return report(failures == 0, "Concurrent lazy loading of " + std::to_string(names.size()) + " kernels");
+}
+
+static bool testUnknownKernel(const std::shared_ptr<CLapp>& pCLapp) {
+    bool ok = false;
+    try {
+	pCLapp->getKernel("noSuchKernel");
+    }
+    catch(CLError& e) {
+	ok = true;
+    }
+    return report(ok, "Unknown kernel reported");
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	pCLapp->setLazyKernelLoading(true);
+	std::mt19937 gen(1234);
+	bool passed = testMacroKernels(pCLapp, gen);
+	passed = testConcurrentLoading(pCLapp) && passed;
+	return testUnknownKernel(pCLapp) && passed;
+    });
+}
@@ -0,0 +1,138 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * processGraphTest.cpp
+ *
+ * Checks that chains of element-wise processes run through a ProcessGraph are fused into a single kernel and give the
+ * same results as launching every process on its own.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/ProcessGraph.hpp>
+#include <OpenCLIPER/processes/ScalarMultiply.hpp>
+#include <OpenCLIPER/processes/ComplexPow.hpp>
+#include <OpenCLIPER/processes/ComplexAbsPow2.hpp>
+#include <OpenCLIPER/processes/Complex2Real.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType width = 64;
+static const dimIndexType height = 48;
+static const dimIndexType nFrames = 3;
+
+// Compares the results of the fused graph and of the individually launched processes
+template<typename T>
+static bool compare(const std::shared_ptr<XData>& pFused, const std::shared_ptr<XData>& pUnfused, const std::string& title) {
+    return checkClose(pFused, readHostData<T>(pUnfused), title);
+}
+
+// ScalarMultiply -> ComplexPow -> ComplexAbsPow2, all complex
+static bool testComplexChain(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<XData>& pIn) {
+    auto pScaleLP = std::make_shared<ScalarMultiply::LaunchParameters>(0.5);
+
+    // Fused
+    auto pFused = std::make_shared<XData>(pCLapp, pIn, false);
+    auto pGraph = Process::create<ProcessGraph>(pCLapp, pIn, pFused);
+    auto pTmp1 = pGraph->createIntermediate(pIn);
+    auto pTmp2 = pGraph->createIntermediate(pIn);
+    pGraph->addProcess(Process::create<ScalarMultiply>(pCLapp), pIn, pTmp1, pScaleLP);
+    pGraph->addProcess(Process::create<ComplexPow>(pCLapp), pTmp1, pTmp2);
+    pGraph->addProcess(Process::create<ComplexAbsPow2>(pCLapp), pTmp2, pFused);
+    pGraph->init();
+    pGraph->launch();
+
+    // Unfused
+    auto pUnfused = std::make_shared<XData>(pCLapp, pIn, false);
+    auto pStep1 = std::make_shared<XData>(pCLapp, pIn, false);
+    auto pStep2 = std::make_shared<XData>(pCLapp, pIn, false);
+    auto pScale = Process::create<ScalarMultiply>(pCLapp, pIn, pStep1);
+    pScale->init();
+    pScale->setLaunchParameters(pScaleLP);
+    pScale->launch();
+    auto pPow = Process::create<ComplexPow>(pCLapp, pStep1, pStep2);
+    pPow->init();
+    pPow->launch();
+    auto pAbsPow2 = Process::create<ComplexAbsPow2>(pCLapp, pStep2, pUnfused);
+    pAbsPow2->init();
+    pAbsPow2->launch();
+
+    bool passed = report(pGraph->getNumFusedKernels() == 1, "ScalarMultiply -> ComplexPow -> ComplexAbsPow2: " +
+			 std::to_string(pGraph->getNumFusedKernels()) + " fused kernel(s)");
+    return compare<complexType>(pFused, pUnfused, "ScalarMultiply -> ComplexPow -> ComplexAbsPow2") && passed;
+}
+
+// ScalarMultiply -> Complex2Real, complex to real
+static bool testComplex2RealChain(const std::shared_ptr<CLapp>& pCLapp, const std::shared_ptr<XData>& pIn, ComplexPart convType, const std::string& convName) {
+    auto pScaleLP = std::make_shared<ScalarMultiply::LaunchParameters>(2.0);
+    auto pC2RIP = std::make_shared<Complex2Real::InitParameters>(convType);
+
+    // Fused
+    auto pFused = std::make_shared<XData>(pCLapp, pIn, TYPEID_REAL);
+    auto pGraph = Process::create<ProcessGraph>(pCLapp, pIn, pFused);
+    auto pTmp = pGraph->createIntermediate(pIn);
+    auto pC2RFused = Process::create<Complex2Real>(pCLapp);
+    pC2RFused->setInitParameters(pC2RIP);
+    pGraph->addProcess(Process::create<ScalarMultiply>(pCLapp), pIn, pTmp, pScaleLP);
+    pGraph->addProcess(pC2RFused, pTmp, pFused);
+    pGraph->init();
+    pGraph->launch();
+
+    // Unfused
+    auto pUnfused = std::make_shared<XData>(pCLapp, pIn, TYPEID_REAL);
+    auto pStep = std::make_shared<XData>(pCLapp, pIn, false);
+    auto pScale = Process::create<ScalarMultiply>(pCLapp, pIn, pStep);
+    pScale->init();
+    pScale->setLaunchParameters(pScaleLP);
+    pScale->launch();
+    auto pC2R = Process::create<Complex2Real>(pCLapp, pStep, pUnfused);
+    pC2R->setInitParameters(pC2RIP);
+    pC2R->init();
+    pC2R->launch();
+
+    std::string title = "ScalarMultiply -> Complex2Real " + convName;
+    bool passed = report(pGraph->getNumFusedKernels() == 1, title + ": " + std::to_string(pGraph->getNumFusedKernels()) + " fused kernel(s)");
+    return compare<realType>(pFused, pUnfused, title) && passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	HostData<complexType> hostData;
+	auto pIn = createRandomXData(pCLapp, {width, height}, nFrames, hostData, gen);
+	bool passed = testComplexChain(pCLapp, pIn);
+	passed = testComplex2RealChain(pCLapp, pIn, ComplexPart::REAL, "REAL") && passed;
+	passed = testComplex2RealChain(pCLapp, pIn, ComplexPart::IMAG, "IMAG") && passed;
+	passed = testComplex2RealChain(pCLapp, pIn, ComplexPart::ABS, "ABS") && passed;
+	return testComplex2RealChain(pCLapp, pIn, ComplexPart::ARG, "ARG") && passed;
+    });
+}
@@ -0,0 +1,150 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * projectedGradientCostTest.cpp
+ *
+ * Checks the fused ProjectedGradientCost process against the per-control-point chain it replaces in the registration
+ * optimizer (AuxiliarMask, AuxiliarCost, Cost6DReduction and Cost6D) and against a host computation, with a non-square
+ * spline neighbourhood and a non-square mask.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/ConcreteNDArray.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/AuxiliarMask.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/AuxiliarCost.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/Cost6D.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/optimizer/ProjectedGradientCost.hpp>
+#include <OpenCLIPER/processes/groupwiseRegistration/reductions/Cost6DReduction.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+// Neighbourhood (rows, columns) of every control point, control points, frames and spatial dimensions of the displacement
+static const dimIndexType nRows = 7;
+static const dimIndexType nCols = 11;
+static const dimIndexType nControlPoints = 5;
+static const dimIndexType nFrames = 3;
+static const dimIndexType nt = 2;
+// Mask (ROI) size
+static const dimIndexType maskRows = 40;
+static const dimIndexType maskCols = 48;
+
+// Mask offsets of control point k (rows) and l (columns), stored in coefg as the optimizer does
+static realType rowOffset(dimIndexType k) { return 3 * k; }
+static realType colOffset(dimIndexType l) { return 4 * l; }
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	index1DType neighbourhoodSize = nRows * nCols;
+	index1DType dVSize = neighbourhoodSize * nControlPoints * nControlPoints * nFrames * nt;
+
+	// Gradient (first NDArray) and permuted gradient (second one): only the permuted one is read
+	auto dVHostData = randomHostData<realType>(dVSize, 2, gen);
+	auto pData = new std::vector<std::vector<realType>*>({new std::vector<realType>(dVHostData[0]), new std::vector<realType>(dVHostData[1])});
+	auto pDVDims = new std::vector<std::vector<dimIndexType>*>({
+	    new std::vector<dimIndexType>({nRows, nCols, nFrames, nControlPoints, nControlPoints, nt}),
+	    new std::vector<dimIndexType>({nRows, nCols, nControlPoints, nControlPoints, nFrames, nt})});
+	auto pDVTempDims = new std::vector<dimIndexType>({2});
+	std::shared_ptr<Data> pDV = std::make_shared<XData>(pCLapp, pDVDims, pDVTempDims, pData);
+
+	std::uniform_int_distribution<dimIndexType> maskDist(0, 1);
+	auto pMask = new std::vector<dimIndexType>(maskRows * maskCols);
+	for(auto& v: *pMask)
+	    v = maskDist(gen);
+	std::vector<dimIndexType> mask(*pMask);
+	auto pMaskDims = new std::vector<dimIndexType>({maskRows, maskCols});
+	NDArray* pMaskNDArray = new ConcreteNDArray<dimIndexType>(pMaskDims, pMask);
+	std::shared_ptr<Data> pMaskData = std::make_shared<XData>(pCLapp, pMaskNDArray, TYPEID_INDEX);
+
+	// coefg(l, 0, 0) holds column offsets and coefg(k, 0, 1) row offsets (plus 1, as they are 1-based)
+	auto pCoefg = new std::vector<realType>(nControlPoints * 2 * 2);
+	for(dimIndexType c = 0; c < nControlPoints; c++) {
+	    pCoefg->at(c) = colOffset(c) + 1;
+	    pCoefg->at(c + 2 * nControlPoints) = rowOffset(c) + 1;
+	}
+	auto pCoefgDims = new std::vector<dimIndexType>({nControlPoints, 2, 2});
+	std::shared_ptr<Data> pCoefgData = std::make_shared<XData>(pCLapp, pCoefgDims, pCoefg);
+
+	auto newData = [&](const std::vector<dimIndexType>& dims) -> std::shared_ptr<Data> {
+	    auto pDims = new std::vector<std::vector<dimIndexType>*>({new std::vector<dimIndexType>(dims)});
+	    return std::make_shared<XData>(pCLapp, pDims, TYPEID_REAL);
+	};
+	auto pXaux = newData({nRows, nCols, nFrames, nt});
+	auto pCost1 = newData({nRows, nCols, nFrames, nt});
+	auto pCost2 = newData({nRows, nFrames, nt});
+	auto pUnfusedDH = newData({nControlPoints, nControlPoints, nFrames, nt});
+	auto pFusedDH = newData({nControlPoints, nControlPoints, nFrames, nt});
+
+	// Per-control-point chain, as launched by the optimizer
+	auto pAuxiliarMask = Process::create<AuxiliarMask>(pCLapp, pDV, pXaux);
+	auto pAuxiliarCost = Process::create<AuxiliarCost>(pCLapp, pDV, pCost1);
+	auto pCost6DReduction = Process::create<Cost6DReduction>(pCLapp, pCost1, pCost2);
+	auto pCost6D = Process::create<Cost6D>(pCLapp, pCost2, pUnfusedDH);
+	for(auto& p: std::initializer_list<std::shared_ptr<Process>>({pAuxiliarMask, pAuxiliarCost, pCost6DReduction, pCost6D}))
+	    p->init();
+	for(dimIndexType k = 0; k < nControlPoints; k++) {
+	    for(dimIndexType l = 0; l < nControlPoints; l++) {
+		pAuxiliarMask->setLaunchParameters(std::make_shared<AuxiliarMask::LaunchParameters>(pMaskData, pCoefgData, l, k));
+		pAuxiliarMask->launch();
+		pAuxiliarCost->setLaunchParameters(std::make_shared<AuxiliarCost::LaunchParameters>(pXaux, l, k));
+		pAuxiliarCost->launch();
+		pCost6DReduction->launch();
+		pCost6D->setLaunchParameters(std::make_shared<Cost6D::LaunchParameters>(l, k));
+		pCost6D->launch();
+	    }
+	}
+
+	auto pProjectedGradientCost = Process::create<ProjectedGradientCost>(pCLapp, pDV, pFusedDH);
+	pProjectedGradientCost->setLaunchParameters(std::make_shared<ProjectedGradientCost::LaunchParameters>(pMaskData, pCoefgData));
+	pProjectedGradientCost->init();
+	pProjectedGradientCost->launch();
+
+	// Host reference: row i and column j of the neighbourhood of control point (l, k) are stored at j + i * nCols
+	HostData<realType> reference(1, std::vector<realType>(nControlPoints * nControlPoints * nFrames * nt));
+	for(dimIndexType n = 0; n < nt; n++)
+	    for(dimIndexType m = 0; m < nFrames; m++)
+		for(dimIndexType k = 0; k < nControlPoints; k++)
+		    for(dimIndexType l = 0; l < nControlPoints; l++) {
+			index1DType dVOffset = neighbourhoodSize * (l + nControlPoints * (k + nControlPoints * (m + nFrames * n)));
+			double sum = 0.0;
+			for(dimIndexType i = 0; i < nRows; i++)
+			    for(dimIndexType j = 0; j < nCols; j++)
+				sum += dVHostData[1][dVOffset + j + i * nCols] * mask[(i + rowOffset(k)) + (j + colOffset(l)) * maskRows];
+			reference[0][l + nControlPoints * (k + nControlPoints * (m + nFrames * n))] = sum;
+		    }
+
+	bool passed = checkClose(pUnfusedDH, reference, "per-control-point processes against host");
+	passed = checkClose(pFusedDH, reference, "ProjectedGradientCost against host") && passed;
+	return checkClose(pFusedDH, readHostData<realType>(pUnfusedDH), "ProjectedGradientCost against per-control-point processes") && passed;
+    });
+}
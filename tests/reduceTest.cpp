@@ -0,0 +1,150 @@
+/* Copyright (C) 2018 Federico Simmross Wattenberg,
+ *                    Manuel Rodr�guez Cayetano,
+ *                    Javier Royuela del Val,
+ *                    Elena Mart�n Gonz�lez,
+ *                    Elisa Moya S�ez,
+ *                    Marcos Mart�n Fern�ndez and
+ *                    Carlos Alberola L�pez
+ *
+ * This file is part of OpenCLIPER.
+ *
+ * OpenCLIPER is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3 of the License.
+ *
+ * OpenCLIPER is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenCLIPER; If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *  Contact:
+ *
+ *  Federico Simmross Wattenberg
+ *  E.T.S.I. Telecomunicaci�n
+ *  Universidad de Valladolid
+ *  Paseo de Bel�n 15
+ *  47011 Valladolid, Spain.
+ *  fedsim@tel.uva.es
+ */
+/*
+ * reduceTest.cpp
+ *
+ * Checks SumReduce (every operation, for real and complex data, over all dimensions, over spatial dimensions only and
+ * over the temporal dimension only) and MinMaxReduce against reductions computed on the host.
+ */
+#include "TestUtils.hpp"
+#include <OpenCLIPER/processes/SumReduce.hpp>
+#include <OpenCLIPER/processes/MinMaxReduce.hpp>
+
+using namespace OpenCLIPER;
+using namespace OpenCLIPER::TestUtils;
+
+static const dimIndexType width = 40;
+static const dimIndexType height = 24;
+static const dimIndexType nFrames = 3;
+
+// Host reference: reduces hostData (and hostData2 for DOT) over the spatial dimensions (perFrame), the temporal
+// dimension (perPixel) or all of them, as SumReduce does
+template<typename T>
+static std::vector<std::complex<double>> hostReduce(const HostData<T>& hostData, const HostData<T>& hostData2,
+						    SumReduce::Operation op, bool perFrame, bool perPixel) {
+    index1DType nOutputs = perFrame ? nFrames : (perPixel ? width * height : 1);
+    std::vector<std::complex<double>> result(nOutputs, (op == SumReduce::MAX) ? -INFINITY : ((op == SumReduce::MIN) ? INFINITY : 0.0));
+    for(dimIndexType k = 0; k < nFrames; k++) {
+	for(index1DType i = 0; i < width * height; i++) {
+	    std::complex<double> v(hostData[k][i]), v2(hostData2[k][i]);
+	    index1DType o = perFrame ? k : (perPixel ? i : 0);
+	    switch(op) {
+		case SumReduce::SUM:
+		    result[o] += v;
+		    break;
+		case SumReduce::MAX:
+		    result[o] = std::max(result[o].real(), std::is_same<T, realType>::value ? v.real() : std::abs(v));
+		    break;
+		case SumReduce::MIN:
+		    result[o] = std::min(result[o].real(), std::is_same<T, realType>::value ? v.real() : std::abs(v));
+		    break;
+		case SumReduce::L1:
+		    result[o] += std::abs(v);
+		    break;
+		case SumReduce::L2SQUARED:
+		    result[o] += std::norm(v);
+		    break;
+		case SumReduce::DOT:
+		    result[o] += std::conj(v) * v2;
+		    break;
+	    }
+	}
+    }
+    return result;
+}
+
+// Compares device output (real or complex, a single NDArray) with the host reference
+static bool compare(const std::shared_ptr<XData>& pOut, bool complexResult, const std::vector<std::complex<double>>& reference, const std::string& title) {
+    if(complexResult)
+	return checkClose(pOut, HostData<complexType>(1, std::vector<complexType>(reference.begin(), reference.end())), title);
+    HostData<realType> realReference(1);
+    for(auto& v: reference)
+	realReference[0].push_back(v.real());
+    return checkClose(pOut, realReference, title);
+}
+
+template<typename T>
+static bool testSumReduce(const std::shared_ptr<CLapp>& pCLapp, std::mt19937& gen, ElementDataType elementDataType, const std::string& typeName) {
+    static const std::string opNames[] = {"SUM", "MAX", "MIN", "L1", "L2SQUARED", "DOT"};
+    bool passed = true;
+    HostData<T> hostData, hostData2;
+    auto pIn = createRandomXData(pCLapp, {width, height}, nFrames, hostData, gen);
+    auto pIn2 = createRandomXData(pCLapp, {width, height}, nFrames, hostData2, gen);
+
+    for(auto op: {SumReduce::SUM, SumReduce::MAX, SumReduce::MIN, SumReduce::L1, SumReduce::L2SQUARED, SumReduce::DOT}) {
+	bool complexResult = (elementDataType == TYPEID_COMPLEX) && (op == SumReduce::SUM || op == SumReduce::DOT);
+	for(int mode = 0; mode < 3; mode++) {
+	    bool perFrame = (mode == 1), perPixel = (mode == 2);
+	    std::vector<dimIndexType> reducedDims;
+	    if(perFrame)
+		reducedDims = {0, 1};
+	    else if(perPixel)
+		reducedDims = {2};
+	    auto reference = hostReduce(hostData, hostData2, op, perFrame, perPixel);
+	    auto pOut = std::make_shared<XData>(pCLapp, (dimIndexType) reference.size(), complexResult ? TYPEID_COMPLEX : TYPEID_REAL);
+
+	    auto pReduce = Process::create<SumReduce>(pCLapp);
+	    pReduce->setInput(pIn);
+	    pReduce->setOutput(pOut);
+	    pReduce->setInitParameters(std::make_shared<SumReduce::InitParameters>(op, reducedDims, pIn2));
+	    pReduce->init();
+	    pReduce->launch();
+	    passed = compare(pOut, complexResult, reference, "SumReduce " + opNames[op] + " " + typeName +
+			     (perFrame ? " per frame" : (perPixel ? " per pixel" : " all dimensions"))) && passed;
+	}
+    }
+
+    // MinMaxReduce, with input changed between launches
+    auto pOut = std::make_shared<XData>(pCLapp, 2, TYPEID_REAL);
+    auto pMinMax = Process::create<MinMaxReduce>(pCLapp);
+    pMinMax->setInput(pIn);
+    pMinMax->setOutput(pOut);
+    pMinMax->setInitParameters(std::make_shared<MinMaxReduce::InitParameters>(MinMaxReduce::MINMAX));
+    pMinMax->init();
+    for(auto& data: {std::make_pair(pIn, &hostData), std::make_pair(pIn2, &hostData2)}) {
+	pMinMax->setInput(data.first);
+	pMinMax->launch();
+	auto reference = hostReduce(*data.second, *data.second, SumReduce::MIN, false, false);
+	reference.push_back(hostReduce(*data.second, *data.second, SumReduce::MAX, false, false)[0]);
+	passed = compare(pOut, false, reference, "MinMaxReduce MINMAX " + typeName) && passed;
+    }
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    return runTest(argc, argv, [](const std::shared_ptr<CLapp>& pCLapp) {
+	std::mt19937 gen(1234);
+	bool passed = testSumReduce<realType>(pCLapp, gen, TYPEID_REAL, "real");
+	return testSumReduce<complexType>(pCLapp, gen, TYPEID_COMPLEX, "complex") && passed;
+    });
+}